@@ -65,7 +65,7 @@ void e_InitColorEditor( void )
 
 static void e_ColorEditorLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
   
   if ( app.keyboard[ SDL_SCANCODE_ESCAPE ] == 1 )
   {
@@ -13,6 +13,9 @@
 #include "defs.h"
 #include "editor.h"
 #include "init_editor.h"
+#include "glyph_atlas.h"
+#include "jobs.h"
+#include "text_cache.h"
 #include "world_editor.h"
 #include "item_editor.h"
 #include "entity_editor.h"
@@ -24,7 +27,7 @@ static void eDraw( float );
 
 GlyphArray_t* game_glyphs = NULL;
 aColor_t master_colors[MAX_COLOR_GROUPS][48] = {0};
-float zoom_level = 2.0f;
+float zoom_level = ZOOM_DEFAULT;
 
 void e_InitEditor( void )
 {
@@ -33,8 +36,10 @@ void e_InitEditor( void )
   
   if ( game_glyphs == NULL )
   {
-    game_glyphs = e_InitGlyphs( "resources/fonts/CodePage437.png",
-                               9, 16 );
+    const char* glyph_pages[GLYPH_NUM_PAGES] = GLYPH_PAGE_FILES;
+    game_glyphs = e_LoadGlyphAtlas( GLYPH_ATLAS_FILE, glyph_pages,
+                                    GLYPH_NUM_PAGES, GLYPH_WIDTH,
+                                    GLYPH_HEIGHT );
 
   }
 
@@ -82,7 +87,7 @@ void e_InitEditor( void )
 
 static void eLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
 
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
@@ -111,7 +116,12 @@ static void eDraw( float dt )
 
 void e_DestroyEditor( void )
 {
-  free( game_glyphs );
+  g_ShutdownJobs();
+  e_FreeClipboard();
+  e_FreePrefabs();
+  e_DestroyItemEditor();
+  e_FreeGlyphAtlas( game_glyphs );
+  g_ClearTextCache();
 }
 
 void e_Mainloop( void )
@@ -121,15 +131,18 @@ void e_Mainloop( void )
     const float delta_time = a_GetDeltaTime();
 
     // Update logic and draw using the SAME delta time
-    app.delegate.logic( delta_time );
-    app.delegate.draw( delta_time );
+    PROF_PHASE( PROF_PHASE_LOGIC ) app.delegate.logic( delta_time );
+    PROF_PHASE( PROF_PHASE_DRAW ) app.delegate.draw( delta_time );
+    g_ProfDrawOverlay();
 
     // 4. Log with a UNIQUE IDENTIFIER
 //    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG, 1, 10.0,
 //                      "[e_MainLoop(void)] Delta Time; %.7f - Should be Limited to 1 per 10 seconds [void]", delta_time);
 
     // 5. Present the scene
-    a_PresentScene();
+    PROF_PHASE( PROF_PHASE_PRESENT ) a_PresentScene();
+
+    g_ProfFrame();
 }
 
 int main( void )
@@ -140,6 +153,7 @@ int main( void )
   d_SetGlobalLogger(logger);
   d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
   a_Init( SCREEN_WIDTH, SCREEN_HEIGHT, "Archimedes" );
+  g_InitJobs( 0 );
 
   e_InitEditor();
 
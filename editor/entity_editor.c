@@ -64,7 +64,7 @@ void e_InitEntityEditor( void )
 
 static void e_EntityEditorLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
   
   if ( app.keyboard[ SDL_SCANCODE_ESCAPE ] == 1 )
   {
@@ -1,19 +1,46 @@
 #include <stdio.h>
+#include <string.h>
 
 #include "Archimedes.h"
+#include "defs.h"
 #include "editor.h"
+#include "item_db.h"
+#include "text_cache.h"
 #include "world_editor.h"
 #include "entity_editor.h"
 #include "color_editor.h"
 #include "ui_editor.h"
 
+#define ITEM_LIST_ROWS 24
+
 static void e_ItemEditorLogic( float );
 static void e_ItemEditorDraw( float );
+static void ie_DuplicateItem( void );
+
+static const char* item_type_labels[] = { "weapon", "armor", "key",
+                                          "consumable", "ammunition" };
+
+/*
+ * The database is loaded the first time the tab opens and kept while
+ * switching tabs, so edits survive until they are saved or reloaded
+ */
+static int items_loaded = 0;
+static int selected_item = 0;
+static char item_status[128] = { 0 };
 
 void e_InitItemEditor( void )
 {
   app.delegate.logic = e_ItemEditorLogic;
   app.delegate.draw  = e_ItemEditorDraw;
+
+  if ( !items_loaded )
+  {
+    int count = load_item_database( ITEM_DB_FILE, ITEM_DB_CACHE_FILE );
+    snprintf( item_status, sizeof( item_status ), count < 0 ?
+              "Failed to load %s" : "Loaded %s", ITEM_DB_FILE );
+    items_loaded = 1;
+    selected_item = 0;
+  }
   
   a_InitWidgets( "resources/widgets/editor/items.json" );
   
@@ -56,7 +83,7 @@ void e_InitItemEditor( void )
 
 static void e_ItemEditorLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
   
   if ( app.keyboard[ SDL_SCANCODE_ESCAPE ] == 1 )
   {
@@ -64,18 +91,127 @@ static void e_ItemEditorLogic( float dt )
     e_InitEditor();
   }
 
+  int count = get_item_def_count();
+
+  if ( app.keyboard[SDL_SCANCODE_UP] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_UP] = 0;
+    if ( selected_item > 0 ) selected_item--;
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_DOWN] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_DOWN] = 0;
+    if ( selected_item < count - 1 ) selected_item++;
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_D] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_D] = 0;
+    ie_DuplicateItem();
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_DELETE] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_DELETE] = 0;
+
+    const ItemDef_t* def = get_item_def( selected_item );
+    if ( def != NULL )
+    {
+      char id[ITEM_DEF_ID_LENGTH];
+      snprintf( id, sizeof( id ), "%s", def->id );
+      remove_item_def( id );
+      snprintf( item_status, sizeof( item_status ), "Removed %s", id );
+
+      if ( selected_item > 0 && selected_item >= count - 1 ) selected_item--;
+    }
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_S] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_S] = 0;
+    snprintf( item_status, sizeof( item_status ),
+              save_item_database( ITEM_DB_FILE ) ? "Saved %s" :
+              "Failed to save %s", ITEM_DB_FILE );
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_R] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_R] = 0;
+    items_loaded = 0;
+    e_InitItemEditor();
+  }
+
   a_DoWidget();
 }
 
 static void e_ItemEditorDraw( float dt )
 {
-  a_DrawFilledRect( 100, 100, 32, 32, 0, 0, 255, 255 );
-  a_DrawFilledRect( 300, 300, 32, 32, 0, 255, 0, 255 );
+  char line[160];
+  int count = get_item_def_count();
+
+  // scroll so the selected item stays in view
+  int first = selected_item - ( ITEM_LIST_ROWS / 2 );
+  if ( first > count - ITEM_LIST_ROWS ) first = count - ITEM_LIST_ROWS;
+  if ( first < 0 ) first = 0;
+
+  for ( int i = first; i < count && i < first + ITEM_LIST_ROWS; i++ )
+  {
+    const ItemDef_t* def = get_item_def( i );
+    int y = 100 + ( ( i - first ) * 20 );
+
+    if ( i == selected_item )
+    {
+      a_DrawFilledRect( 95, y, 700, 20, 0, 0, 255, 255 );
+    }
+
+    snprintf( line, sizeof( line ), "%c %-24s %-28s %s", def->glyph,
+              def->id, def->name, item_type_labels[def->type] );
+    g_DrawCachedText( line, 100, y, white, app.font_type,
+                      TEXT_ALIGN_LEFT );
+  }
+
+  snprintf( line, sizeof( line ), "%d items, D duplicate, DEL remove, "
+            "S save, R reload", count );
+  g_DrawCachedText( line, 100, 600, yellow, app.font_type, TEXT_ALIGN_LEFT );
+  g_DrawCachedText( item_status, 100, 620, white, app.font_type,
+                    TEXT_ALIGN_LEFT );
 
   a_DrawWidgets();
 }
 
 void e_DestroyItemEditor( void )
 {
+  destroy_item_database();
+  items_loaded = 0;
+}
+
+/*
+ * Copies the selected item under the first free "<id>_N"
+ */
+static void ie_DuplicateItem( void )
+{
+  const ItemDef_t* def = get_item_def( selected_item );
+  if ( def == NULL ) return;
+
+  ItemDef_t copy = *def;
+
+  for ( int n = 2; n < 1000; n++ )
+  {
+    char id[ITEM_DEF_ID_LENGTH];
+    snprintf( id, sizeof( id ), "%.*s_%d", ITEM_DEF_ID_LENGTH - 5, def->id,
+              n );
+
+    if ( find_item_def( id ) == NULL )
+    {
+      memcpy( copy.id, id, ITEM_DEF_ID_LENGTH );
+      break;
+    }
+  }
+
+  if ( strcmp( copy.id, def->id ) != 0 && set_item_def( &copy ) )
+  {
+    snprintf( item_status, sizeof( item_status ), "Added %s", copy.id );
+  }
 }
 
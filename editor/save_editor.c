@@ -12,6 +12,7 @@
 
 #include "init_editor.h"
 #include "defs.h"
+#include "world_editor.h"
 
 int SaveWorld( World_t* world, const char* filename )
 {
@@ -23,7 +24,9 @@ int SaveWorld( World_t* world, const char* filename )
     return 1;
   }
   
+  // zeroed so the padding byte is the same in every save
   FileHeader_t header;
+  memset( &header, 0, sizeof( FileHeader_t ) );
   memcpy( header.magic, MAGIC_NUMBER, 8 );
   header.version       = FILE_VERSION;
   header.world_width   = world->world_width;
@@ -54,6 +57,23 @@ int SaveWorld( World_t* world, const char* filename )
     }
   }
 
+  size_t num_of_thumbnail_bytes = world->region_width * world->region_height *
+    world->local_width * world->local_height;
+  uint8_t* thumbnails = ( uint8_t* )malloc( num_of_thumbnail_bytes );
+  if ( thumbnails == NULL )
+  {
+    printf( "Failed to allocate memory for thumbnails\n" );
+    fclose( file );
+    return 1;
+  }
+
+  for ( int i = 0; i < ( world->world_width * world->world_height ); i++ )
+  {
+    wet_CopyThumbnail( world, i, thumbnails );
+    fwrite( thumbnails, 1, num_of_thumbnail_bytes, file );
+  }
+
+  free( thumbnails );
   fclose( file );
 
   return 0;
@@ -332,3 +352,60 @@ int LoadPartialRegion( WorldPosition_t* pos, World_t* world, const char* filenam
 
   return 0;
 }
+
+uint8_t* LoadThumbnails( const char* filename )
+{
+  FILE* file;
+
+  file = fopen( filename, "rb");
+  if ( file == NULL )
+  {
+    printf( "Failed to read %s\n", filename );
+    return NULL;
+  }
+
+  FileHeader_t header;
+  fread( &header, sizeof( FileHeader_t ), 1, file );
+
+  if ( memcmp( header.magic, MAGIC_NUMBER, 8 ) != 0 ||
+       header.version < 2 || header.version > FILE_VERSION )
+  {
+    fclose( file );
+    return NULL;
+  }
+
+  size_t num_of_world_tiles  = header.world_width * header.world_height;
+  size_t num_of_region_tiles = header.region_width * header.region_height;
+  size_t num_of_local_tiles  = header.local_width * header.local_height *
+    header.z_height;
+  size_t num_of_thumbnail_bytes = num_of_world_tiles * num_of_region_tiles *
+    header.local_width * header.local_height;
+
+  // the thumbnails come after every tile, skip straight to them
+  long offset = sizeof( FileHeader_t ) + ( sizeof( World_t ) *
+    num_of_world_tiles ) + ( num_of_world_tiles * num_of_region_tiles *
+    ( sizeof( RegionCell_t ) + ( sizeof( GameTile_t ) *
+    num_of_local_tiles ) ) );
+
+  uint8_t* thumbnails = ( uint8_t* )malloc( num_of_thumbnail_bytes );
+  if ( thumbnails == NULL )
+  {
+    printf( "Failed to allocate memory for thumbnails\n" );
+    fclose( file );
+    return NULL;
+  }
+
+  if ( fseek( file, offset, SEEK_SET ) != 0 ||
+       fread( thumbnails, 1, num_of_thumbnail_bytes, file ) !=
+       num_of_thumbnail_bytes )
+  {
+    printf( "Failed to read thumbnails from %s\n", filename );
+    free( thumbnails );
+    fclose( file );
+    return NULL;
+  }
+
+  fclose( file );
+
+  return thumbnails;
+}
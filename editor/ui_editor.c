@@ -109,7 +109,7 @@ void e_InitUIEditor( void )
 
 static void e_UIEditorLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
   
   if ( app.keyboard[ SDL_SCANCODE_ESCAPE ] == 1 )
   {
@@ -0,0 +1,79 @@
+/*
+ * world_batch.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+/*
+ * Runs world editor scripts with no window, see e_RunWorldScript().
+ *
+ *   worldbatch [--threads N] SCRIPT...
+ *
+ * The scripts run in order on the same world, the first one that fails
+ * stops the run and the exit status is 1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "init_editor.h"
+#include "jobs.h"
+#include "world_editor.h"
+
+// the editor keeps these in editor.c and world_editor.c, which need a window
+World_t* map = NULL;
+GlyphArray_t* game_glyphs = NULL;
+aColor_t master_colors[MAX_COLOR_GROUPS][48] = {0};
+float zoom_level = ZOOM_DEFAULT;
+
+int main( int argc, char** argv )
+{
+  int threads = 0;
+  int first_script = 1;
+
+  if ( argc > 2 && strcmp( argv[1], "--threads" ) == 0 )
+  {
+    threads = atoi( argv[2] );
+    first_script = 3;
+  }
+
+  if ( first_script >= argc )
+  {
+    fprintf( stderr, "usage: %s [--threads N] SCRIPT...\n", argv[0] );
+    return 1;
+  }
+
+  g_InitJobs( threads );
+
+  int status = 0;
+  uint64_t start = g_ProfNow();
+
+  for ( int i = first_script; i < argc && status == 0; i++ )
+  {
+    status = e_RunWorldScript( argv[i] );
+  }
+
+  if ( status == 0 )
+  {
+    printf( "Ran %d scripts in %.2f ms\n", argc - first_script,
+            ( g_ProfNow() - start ) / 1000000.0 );
+  }
+
+  g_ShutdownJobs();
+  e_FreeClipboard();
+  e_FreePrefabs();
+
+  if ( map != NULL )
+  {
+    free_world( map, ( map->world_width * map->world_height ),
+                     ( map->region_width * map->region_height ) );
+  }
+
+  return status == 0 ? 0 : 1;
+}
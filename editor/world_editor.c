@@ -20,6 +20,7 @@
 #include "item_editor.h"
 #include "save_editor.h"
 #include "structs.h"
+#include "text_cache.h"
 #include "ui_editor.h"
 #include "world_editor.h"
 
@@ -116,13 +117,28 @@ void we_Load( void )
 {
   if ( map == NULL ) 
   {
-    map = LoadPartialWorld( "resources/world/map.dat" );
+    wez_ResetLod();
+    wed_ResetDepth();
+    wet_ResetThumbnails();
+    weu_ResetUndo();
+    wea_ResetSummaries();
+    weq_ResetQuery();
+    PROF_ZONE( "load_world" ) map = LoadPartialWorld( "resources/world/map.dat" );
+
+    if ( map != NULL )
+    {
+      uint8_t* thumbnails = LoadThumbnails( "resources/world/map.dat" );
+      if ( thumbnails != NULL )
+      {
+        wet_AdoptThumbnails( map, thumbnails );
+      }
+    }
   }
 }
 
 static void e_WorldEditorLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
   
   if ( map!= NULL )
   {
@@ -161,6 +177,7 @@ static void e_WorldEditorLogic( float dt )
   }
   
   e_LevelZHeightCheck( &current_pos );
+  e_UpdateZoom();
   highlighted_pos.level = current_pos.level;
   highlighted_pos.local_z = current_pos.local_z;
 
@@ -188,33 +205,22 @@ static void e_WorldEditorDraw( float dt )
 {
   if ( map != NULL )
   {
-    int draw_size = 0;
-    switch ( current_pos.level )
+    if ( e_IsLodView( current_pos.level ) )
     {
-      case WORLD_LEVEL:
-        draw_size = map->world_width * map->world_height;
-        break;
-
-      case REGION_LEVEL:
-        draw_size = map->region_width * map->region_height;
-        break;
-
-      case LOCAL_LEVEL:
-        draw_size = map->local_width * map->local_height;
-        break;
+      wez_DrawLodView( map, current_pos );
     }
 
-    for ( uint16_t i = 0; i < draw_size; i++ )
+    else
     {
-      we_DrawWorldCell( i, map, current_pos, highlighted_pos );
+      we_DrawWorldCells( map, current_pos, highlighted_pos );
     }
 
 
     snprintf( pos_text, 50, "%d,%d,%d,%d,%d\n", current_pos.world_index,
               current_pos.region_index, current_pos.local_index,
               current_pos.level, current_pos.local_z );
-    a_DrawText( pos_text, 750, 10, 255, 255, 255, app.font_type,
-                TEXT_ALIGN_CENTER, 0 );
+    g_DrawCachedText( pos_text, 750, 10, white, app.font_type,
+                      TEXT_ALIGN_CENTER );
 
   }
 
@@ -226,6 +232,12 @@ static void e_WorldEditorDraw( float dt )
 
 void e_DestroyWorldEditor( void )
 {
+  wez_ResetLod();
+  wed_ResetDepth();
+  wet_ResetThumbnails();
+  weu_ResetUndo();
+  wea_ResetSummaries();
+  weq_ResetQuery();
   free_world( map, ( map->world_width * map->world_height ),
                    ( map->region_width * map->region_height ) );
   map = NULL;
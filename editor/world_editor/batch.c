@@ -0,0 +1,604 @@
+/*
+ * world_editor/batch.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "init_editor.h"
+#include "save_editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * One command per line, words separated by spaces, # starts a comment.
+ * Every command calls the same function the edit mode does, so a script
+ * is journaled, summarised and thumbnailed exactly like hand edits are.
+ */
+#define BATCH_MAX_LINE  512
+#define BATCH_MAX_WORDS 16
+
+typedef struct
+{
+  const char* name;
+  int num_args;
+  int needs_map;
+  int ( *run )( char** args );
+} BatchCommand_t;
+
+static int wex_New( char** args );
+static int wex_Generate( char** args );
+static int wex_Load( char** args );
+static int wex_Save( char** args );
+static int wex_Fill( char** args );
+static int wex_Replace( char** args );
+static int wex_ReplaceAll( char** args );
+static int wex_Flood( char** args );
+static int wex_Copy( char** args );
+static int wex_Paste( char** args );
+static int wex_Prefabs( char** args );
+static int wex_PrefabSave( char** args );
+static int wex_Stamp( char** args );
+static int wex_Undo( char** args );
+static int wex_Redo( char** args );
+
+static const BatchCommand_t commands[] =
+{
+  { "new",         4,  0, wex_New },
+  { "generate",    1,  1, wex_Generate },
+  { "load",        1,  0, wex_Load },
+  { "save",        1,  1, wex_Save },
+  { "fill",        12, 1, wex_Fill },
+  { "replace",     15, 1, wex_Replace },
+  { "replace_all", 8,  1, wex_ReplaceAll },
+  { "flood",       10, 1, wex_Flood },
+  { "copy",        9,  1, wex_Copy },
+  { "paste",       6,  1, wex_Paste },
+  { "prefabs",     1,  0, wex_Prefabs },
+  { "prefab_save", 1,  0, wex_PrefabSave },
+  { "stamp",       9,  1, wex_Stamp },
+  { "undo",        0,  1, wex_Undo },
+  { "redo",        0,  1, wex_Redo }
+};
+
+static const int world_sizes[3][2] =
+{
+  { WORLD_WIDTH_SMALL,  WORLD_HEIGHT_SMALL },
+  { WORLD_WIDTH_MEDIUM, WORLD_HEIGHT_MEDIUM },
+  { WORLD_WIDTH_LARGE,  WORLD_HEIGHT_LARGE }
+};
+
+static const int region_sizes[3][2] =
+{
+  { REGION_WIDTH_SMALL,  REGION_HEIGHT_SMALL },
+  { REGION_WIDTH_MEDIUM, REGION_HEIGHT_MEDIUM },
+  { REGION_WIDTH_LARGE,  REGION_HEIGHT_LARGE }
+};
+
+static const int local_sizes[3][2] =
+{
+  { LOCAL_WIDTH_SMALL,  LOCAL_HEIGHT_SMALL },
+  { LOCAL_WIDTH_MEDIUM, LOCAL_HEIGHT_MEDIUM },
+  { LOCAL_WIDTH_LARGE,  LOCAL_HEIGHT_LARGE }
+};
+
+static const int z_sizes[3] =
+{
+  Z_HEIGHT_SMALL, Z_HEIGHT_MEDIUM, Z_HEIGHT_LARGE
+};
+
+static int wex_Split( char* line, char** words );
+static int wex_Int( const char* word, int* value );
+static int wex_Size( const char* word );
+static void wex_LevelSize( int level, int* width, int* height, int* depth );
+static int wex_Level( const char* word );
+static int wex_Position( char** args, WorldPosition_t* pos );
+static int wex_Rect( char** args, TileRect_t* rect );
+static int wex_Tile( char** args, int* glyph, int* bg, int* fg );
+static void wex_FreeMap( void );
+
+int e_RunWorldScript( const char* filename )
+{
+  FILE* file = fopen( filename, "r" );
+  if ( file == NULL )
+  {
+    printf( "Failed to open %s\n", filename );
+    return -1;
+  }
+
+  char line[BATCH_MAX_LINE];
+  char* words[BATCH_MAX_WORDS];
+  int line_number = 0;
+  int num_commands = sizeof( commands ) / sizeof( commands[0] );
+
+  while ( fgets( line, sizeof( line ), file ) != NULL )
+  {
+    line_number++;
+
+    int num_words = wex_Split( line, words );
+    if ( num_words == 0 ) continue;
+
+    const BatchCommand_t* command = NULL;
+    for ( int i = 0; i < num_commands; i++ )
+    {
+      if ( strcmp( words[0], commands[i].name ) == 0 )
+      {
+        command = &commands[i];
+        break;
+      }
+    }
+
+    if ( command == NULL )
+    {
+      printf( "%s:%d: unknown command %s\n", filename, line_number,
+              words[0] );
+      fclose( file );
+      return line_number;
+    }
+
+    if ( num_words - 1 != command->num_args )
+    {
+      printf( "%s:%d: %s takes %d arguments, got %d\n", filename,
+              line_number, command->name, command->num_args, num_words - 1 );
+      fclose( file );
+      return line_number;
+    }
+
+    if ( command->needs_map && map == NULL )
+    {
+      printf( "%s:%d: %s needs a world, use new or load first\n", filename,
+              line_number, command->name );
+      fclose( file );
+      return line_number;
+    }
+
+    uint64_t start = g_ProfNow();
+
+    if ( !command->run( &words[1] ) )
+    {
+      printf( "%s:%d: %s failed\n", filename, line_number, command->name );
+      fclose( file );
+      return line_number;
+    }
+
+    printf( "%s:%d: %s %.2f ms\n", filename, line_number, command->name,
+            ( g_ProfNow() - start ) / 1000000.0 );
+  }
+
+  fclose( file );
+
+  return 0;
+}
+
+static int wex_New( char** args )
+{
+  int world  = wex_Size( args[0] );
+  int region = wex_Size( args[1] );
+  int local  = wex_Size( args[2] );
+  int z      = wex_Size( args[3] );
+
+  if ( world < 0 || region < 0 || local < 0 || z < 0 ) return 0;
+
+  wex_FreeMap();
+  map = init_world( world_sizes[world][0], world_sizes[world][1],
+                    region_sizes[region][0], region_sizes[region][1],
+                    local_sizes[local][0], local_sizes[local][1],
+                    z_sizes[z] );
+
+  return map != NULL;
+}
+
+static int wex_Generate( char** args )
+{
+  int seed;
+  if ( !wex_Int( args[0], &seed ) ) return 0;
+
+  weg_GenerateWorld( map, ( uint32_t )seed );
+
+  return 1;
+}
+
+static int wex_Load( char** args )
+{
+  wex_FreeMap();
+  map = LoadWorld( args[0] );
+
+  return map != NULL;
+}
+
+static int wex_Save( char** args )
+{
+  return SaveWorld( map, args[0] ) == 0;
+}
+
+/*
+ * fill <level> <world> <region> <x> <y> <z> <w> <h> <d> <glyph> <bg> <fg>
+ */
+static int wex_Fill( char** args )
+{
+  TileRect_t rect;
+  int glyph, bg, fg;
+
+  if ( !wex_Rect( args, &rect ) || !wex_Tile( &args[9], &glyph, &bg, &fg ) )
+  {
+    return 0;
+  }
+
+  e_FillRect( map, rect, glyph, bg, fg );
+
+  return 1;
+}
+
+/*
+ * replace <box> <glyph> <bg> <fg> <new glyph> <new bg> <new fg>
+ */
+static int wex_Replace( char** args )
+{
+  TileRect_t rect;
+  int match_glyph, match_bg, match_fg;
+  int glyph, bg, fg;
+
+  if ( !wex_Rect( args, &rect ) ||
+       !wex_Tile( &args[9], &match_glyph, &match_bg, &match_fg ) ||
+       !wex_Tile( &args[12], &glyph, &bg, &fg ) )
+  {
+    return 0;
+  }
+
+  GameTile_t match = { .glyph = match_glyph, .bg = match_bg,
+    .fg = match_fg };
+
+  e_ReplaceRect( map, rect, match, glyph, bg, fg );
+
+  return 1;
+}
+
+/*
+ * replace_all <world> <region> <glyph> <bg> <fg> <new glyph> <new bg>
+ * <new fg>, a world or region of -1 takes all of them
+ */
+static int wex_ReplaceAll( char** args )
+{
+  int world_index, region_index;
+  int match_glyph, match_bg, match_fg;
+  int glyph, bg, fg;
+
+  if ( !wex_Int( args[0], &world_index ) ||
+       !wex_Int( args[1], &region_index ) ||
+       !wex_Tile( &args[2], &match_glyph, &match_bg, &match_fg ) ||
+       !wex_Tile( &args[5], &glyph, &bg, &fg ) )
+  {
+    return 0;
+  }
+
+  // -1 takes every world cell / region
+  if ( world_index < -1 ||
+       world_index >= map->world_width * map->world_height ||
+       region_index < -1 ||
+       region_index >= map->region_width * map->region_height )
+  {
+    printf( "World cell %d region %d is outside of the world\n", world_index,
+            region_index );
+    return 0;
+  }
+
+  TileQuery_t query;
+
+  e_MatchAnyTile( &query );
+  query.glyph  = match_glyph;
+  query.fg_min = query.fg_max = match_fg;
+  query.bg_min = query.bg_max = match_bg;
+
+  printf( "replaced %d tiles\n", e_ReplaceTiles( map, &query, world_index,
+                                                  region_index, glyph, bg,
+                                                  fg ) );
+
+  return 1;
+}
+
+/*
+ * flood <level> <world> <region> <x> <y> <z> <glyph> <bg> <fg> <bounded>
+ */
+static int wex_Flood( char** args )
+{
+  WorldPosition_t pos;
+  int glyph, bg, fg, bounded;
+
+  if ( !wex_Position( args, &pos ) || !wex_Tile( &args[6], &glyph, &bg, &fg ) ||
+       !wex_Int( args[9], &bounded ) )
+  {
+    return 0;
+  }
+
+  printf( "filled %d tiles\n", e_FloodFill( map, pos, glyph, bg, fg,
+                                             bounded ) );
+
+  return 1;
+}
+
+static int wex_Copy( char** args )
+{
+  TileRect_t rect;
+
+  return wex_Rect( args, &rect ) && e_CopyClipboard( map, rect );
+}
+
+static int wex_Paste( char** args )
+{
+  WorldPosition_t pos;
+
+  if ( !wex_Position( args, &pos ) || e_GetClipboard() == NULL ) return 0;
+
+  e_PasteClipboard( map, pos );
+
+  return 1;
+}
+
+static int wex_Prefabs( char** args )
+{
+  return e_OpenPrefabs( args[0] ) >= 0;
+}
+
+/*
+ * prefab_save <name>, the clipboard goes into the open library
+ */
+static int wex_PrefabSave( char** args )
+{
+  return e_SavePrefab( args[0], e_GetClipboard() );
+}
+
+/*
+ * stamp <name> <position> <rotation> <mirror>, rotation is 0, 90, 180 or
+ * 270 degrees clockwise
+ */
+static int wex_Stamp( char** args )
+{
+  WorldPosition_t pos;
+  int rotation, mirror;
+  int index = e_FindPrefab( args[0] );
+
+  if ( index < 0 )
+  {
+    printf( "Unknown prefab %s\n", args[0] );
+    return 0;
+  }
+
+  if ( !wex_Position( &args[1], &pos ) || !wex_Int( args[7], &rotation ) ||
+       !wex_Int( args[8], &mirror ) )
+  {
+    return 0;
+  }
+
+  if ( rotation % 90 != 0 )
+  {
+    printf( "Rotation %d is not a multiple of 90\n", rotation );
+    return 0;
+  }
+
+  int transform = ( ( rotation / 90 ) & TRANSFORM_ROTATE_MASK ) |
+    ( mirror ? TRANSFORM_MIRROR : 0 );
+
+  e_StampPrefab( map, index, pos, transform );
+
+  return 1;
+}
+
+static int wex_Undo( char** args )
+{
+  ( void )args;
+
+  return e_Undo( map );
+}
+
+static int wex_Redo( char** args )
+{
+  ( void )args;
+
+  return e_Redo( map );
+}
+
+static int wex_Split( char* line, char** words )
+{
+  char* comment = strchr( line, '#' );
+  if ( comment != NULL )
+  {
+    *comment = '\0';
+  }
+
+  int num_words = 0;
+  char* word = strtok( line, " \t\r\n" );
+
+  while ( word != NULL && num_words < BATCH_MAX_WORDS )
+  {
+    words[num_words++] = word;
+    word = strtok( NULL, " \t\r\n" );
+  }
+
+  return num_words;
+}
+
+static int wex_Int( const char* word, int* value )
+{
+  char* end;
+  long parsed = strtol( word, &end, 0 );
+
+  if ( *word == '\0' || *end != '\0' )
+  {
+    printf( "Failed to read a number from %s\n", word );
+    return 0;
+  }
+
+  *value = ( int )parsed;
+
+  return 1;
+}
+
+static int wex_Size( const char* word )
+{
+  if ( strcmp( word, "small" ) == 0 )  return 0;
+  if ( strcmp( word, "medium" ) == 0 ) return 1;
+  if ( strcmp( word, "large" ) == 0 )  return 2;
+
+  printf( "Unknown size %s, use small, medium or large\n", word );
+
+  return -1;
+}
+
+static int wex_Level( const char* word )
+{
+  if ( strcmp( word, "world" ) == 0 )  return WORLD_LEVEL;
+  if ( strcmp( word, "region" ) == 0 ) return REGION_LEVEL;
+  if ( strcmp( word, "local" ) == 0 )  return LOCAL_LEVEL;
+
+  printf( "Unknown level %s, use world, region or local\n", word );
+
+  return -1;
+}
+
+/*
+ * <level> <world> <region> <x> <y> <z>, x and y in cells of the level
+ */
+static int wex_Position( char** args, WorldPosition_t* pos )
+{
+  int level = wex_Level( args[0] );
+  int values[5];
+
+  if ( level < 0 ) return 0;
+
+  for ( int i = 0; i < 5; i++ )
+  {
+    if ( !wex_Int( args[1 + i], &values[i] ) ) return 0;
+  }
+
+  if ( values[0] < 0 || values[0] >= map->world_width * map->world_height ||
+       values[1] < 0 ||
+       values[1] >= map->region_width * map->region_height )
+  {
+    printf( "Position %d, %d is outside of the world\n", values[0],
+            values[1] );
+    return 0;
+  }
+
+  int width, height, depth;
+  wex_LevelSize( level, &width, &height, &depth );
+
+  if ( values[2] < 0 || values[2] >= width || values[3] < 0 ||
+       values[3] >= height || values[4] < 0 || values[4] >= depth )
+  {
+    printf( "Cell %d %d %d is outside of a %dx%dx%d level\n", values[2],
+            values[3], values[4], width, height, depth );
+    return 0;
+  }
+
+  *pos = ( WorldPosition_t ){ .level = level, .world_index = values[0],
+    .region_index = values[1], .x = values[2], .y = values[3],
+    .local_z = values[4] };
+
+  return 1;
+}
+
+/*
+ * A position followed by <w> <h> <d>
+ */
+static int wex_Rect( char** args, TileRect_t* rect )
+{
+  WorldPosition_t pos;
+  int w, h, d;
+
+  if ( !wex_Position( args, &pos ) || !wex_Int( args[6], &w ) ||
+       !wex_Int( args[7], &h ) || !wex_Int( args[8], &d ) )
+  {
+    return 0;
+  }
+
+  // Boxes running past the edge are clipped later, they only have to fit
+  int width, height, depth;
+  wex_LevelSize( pos.level, &width, &height, &depth );
+
+  if ( w < 1 || w > width || h < 1 || h > height || d < 1 || d > depth )
+  {
+    printf( "Box %dx%dx%d does not fit a %dx%dx%d level\n", w, h, d, width,
+            height, depth );
+    return 0;
+  }
+
+  *rect = ( TileRect_t ){ .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .x = pos.x, .y = pos.y,
+    .z = pos.local_z, .w = w, .h = h, .d = d };
+
+  return 1;
+}
+
+/*
+ * <glyph> <bg> <fg>, the same order every edit function takes them in
+ */
+static int wex_Tile( char** args, int* glyph, int* bg, int* fg )
+{
+  if ( !wex_Int( args[0], glyph ) || !wex_Int( args[1], bg ) ||
+       !wex_Int( args[2], fg ) )
+  {
+    return 0;
+  }
+
+  if ( *glyph < 0 || *glyph >= GAME_MAX_GLYPHS || *bg < 0 || *bg > 255 ||
+       *fg < 0 || *fg > 255 )
+  {
+    printf( "Tile %d %d %d is out of range\n", *glyph, *bg, *fg );
+    return 0;
+  }
+
+  return 1;
+}
+
+/*
+ * Cells of one level, only the local level has more than one z
+ */
+static void wex_LevelSize( int level, int* width, int* height, int* depth )
+{
+  *depth = 1;
+
+  switch ( level )
+  {
+    case WORLD_LEVEL:
+      *width  = map->world_width;
+      *height = map->world_height;
+      break;
+
+    case REGION_LEVEL:
+      *width  = map->region_width;
+      *height = map->region_height;
+      break;
+
+    default:
+      *width  = map->local_width;
+      *height = map->local_height;
+      *depth  = map->z_height;
+      break;
+  }
+}
+
+static void wex_FreeMap( void )
+{
+  wez_ResetLod();
+  wed_ResetDepth();
+  wet_ResetThumbnails();
+  weu_ResetUndo();
+  wea_ResetSummaries();
+  weq_ResetQuery();
+
+  if ( map != NULL )
+  {
+    free_world( map, ( map->world_width * map->world_height ),
+                     ( map->region_width * map->region_height ) );
+  }
+
+  map = NULL;
+}
@@ -0,0 +1,330 @@
+/*
+ * world_editor/brush.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * a_DoInput() only leaves the last mouse position of the frame, so a fast
+ * drag would paint a dotted line. The brush peeks at every motion event
+ * still queued before a_DoInput() takes them, joins consecutive points with
+ * Bresenham lines and stamps the brush along them into a mask. The frame's
+ * stamps of a stroke are written as one box, and a stroke from press to
+ * release is one undo transaction.
+ */
+static int brush_size  = 1;
+static int brush_round = 0;
+
+static int stroke_active = 0;
+static int stroke_x = -1, stroke_y = -1;
+
+// cells stamped this frame, one byte per cell of the level
+static uint8_t* brush_mask = NULL;
+static int brush_mask_size = 0;
+static int mask_min_x = INT32_MAX, mask_min_y = INT32_MAX;
+static int mask_max_x = -1, mask_max_y = -1;
+
+static SDL_Event* brush_events = NULL;
+static int brush_events_size = 0;
+
+static int web_PointToCell( World_t* map, uint8_t level, int px, int py,
+                            int* cell_x, int* cell_y );
+static void web_StrokeTo( World_t* map, uint8_t level, int px, int py );
+static void web_Stamp( int cx, int cy, int width, int height );
+static void web_Flush( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                       int fg );
+
+void e_BrushInput( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                   int fg )
+{
+  if ( map == NULL ) return;
+
+  // the button up would not be seen from the LOD view
+  if ( e_IsLodView( pos.level ) )
+  {
+    e_EndBrushStroke( map, pos, glyph, bg, fg );
+    return;
+  }
+
+  int width = 0, height = 0;
+  we_GridSize( map, pos.level, &width, &height );
+
+  if ( brush_mask_size < width * height )
+  {
+    uint8_t* temp = realloc( brush_mask, width * height );
+    if ( temp == NULL )
+    {
+      printf( "Failed to allocate memory for brush mask\n" );
+      return;
+    }
+
+    brush_mask = temp;
+    brush_mask_size = width * height;
+    memset( brush_mask, 0, brush_mask_size );
+  }
+
+  SDL_PumpEvents();
+
+  int count = SDL_PeepEvents( NULL, 0, SDL_PEEKEVENT, SDL_MOUSEMOTION,
+                              SDL_MOUSEBUTTONUP );
+  if ( count <= 0 ) return;
+
+  if ( count > brush_events_size )
+  {
+    SDL_Event* temp = realloc( brush_events, sizeof( SDL_Event ) * count );
+    if ( temp == NULL )
+    {
+      printf( "Failed to allocate memory for brush events\n" );
+      return;
+    }
+
+    brush_events = temp;
+    brush_events_size = count;
+  }
+
+  count = SDL_PeepEvents( brush_events, count, SDL_PEEKEVENT,
+                          SDL_MOUSEMOTION, SDL_MOUSEBUTTONUP );
+
+  for ( int i = 0; i < count; i++ )
+  {
+    SDL_Event* event = &brush_events[i];
+
+    switch ( event->type )
+    {
+      case SDL_MOUSEBUTTONDOWN:
+        if ( event->button.button != BRUSH_BUTTON || stroke_active ) break;
+
+        e_BeginTransaction();
+        stroke_active = 1;
+        stroke_x = stroke_y = -1;
+        web_StrokeTo( map, pos.level, event->button.x, event->button.y );
+        break;
+
+      case SDL_MOUSEMOTION:
+        if ( !stroke_active ) break;
+
+        web_StrokeTo( map, pos.level, event->motion.x, event->motion.y );
+        break;
+
+      case SDL_MOUSEBUTTONUP:
+        if ( event->button.button != BRUSH_BUTTON || !stroke_active ) break;
+
+        web_StrokeTo( map, pos.level, event->button.x, event->button.y );
+        e_EndBrushStroke( map, pos, glyph, bg, fg );
+        break;
+    }
+  }
+
+  web_Flush( map, pos, glyph, bg, fg );
+}
+
+void e_EndBrushStroke( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                       int fg )
+{
+  if ( !stroke_active ) return;
+
+  if ( map != NULL )
+  {
+    web_Flush( map, pos, glyph, bg, fg );
+  }
+
+  e_EndTransaction();
+  stroke_active = 0;
+  stroke_x = stroke_y = -1;
+}
+
+void e_BrushSizeStep( int step )
+{
+  brush_size += step;
+
+  if ( brush_size < 1 )              brush_size = 1;
+  if ( brush_size > BRUSH_MAX_SIZE ) brush_size = BRUSH_MAX_SIZE;
+}
+
+void e_ToggleBrushShape( void )
+{
+  brush_round = !brush_round;
+}
+
+void e_DrawBrushCursor( World_t* map, WorldPosition_t pos )
+{
+  if ( map == NULL || e_IsLodView( pos.level ) ) return;
+
+  int width = 0, height = 0;
+  int x, y, w, h;
+  int lo = -( ( brush_size - 1 ) / 2 );
+
+  we_GridSize( map, pos.level, &width, &height );
+  e_GetCellSize( INDEX_2( pos.x, pos.y, height ), width, height,
+                 &x, &y, &w, &h );
+
+  a_DrawRect( x + ( lo * w ), y + ( lo * h ), brush_size * w,
+              brush_size * h, 255, 255, 0, 255 );
+}
+
+static int web_PointToCell( World_t* map, uint8_t level, int px, int py,
+                            int* cell_x, int* cell_y )
+{
+  int width = 0, height = 0;
+  uint8_t grid_x, grid_y;
+
+  we_GridSize( map, level, &width, &height );
+
+  if ( !e_GetCellAtPoint( px, py, width, height, SCREEN_ORIGIN_X,
+                          SCREEN_ORIGIN_Y, GLYPH_WIDTH * e_GetGlyphScale(),
+                          GLYPH_HEIGHT * e_GetGlyphScale(), &grid_x, &grid_y,
+                          1 ) )
+  {
+    return 0;
+  }
+
+  *cell_x = grid_x;
+  *cell_y = grid_y;
+
+  return 1;
+}
+
+/*
+ * Stamp every cell of the line from the previous point, a point off the
+ * grid breaks the stroke so it does not jump across when it comes back
+ */
+static void web_StrokeTo( World_t* map, uint8_t level, int px, int py )
+{
+  int x1, y1;
+  int width = 0, height = 0;
+
+  if ( !web_PointToCell( map, level, px, py, &x1, &y1 ) )
+  {
+    stroke_x = stroke_y = -1;
+    return;
+  }
+
+  if ( x1 == stroke_x && y1 == stroke_y ) return;
+
+  we_GridSize( map, level, &width, &height );
+
+  int x0 = stroke_x < 0 ? x1 : stroke_x;
+  int y0 = stroke_y < 0 ? y1 : stroke_y;
+  int dx = abs( x1 - x0 ), sx = x0 < x1 ? 1 : -1;
+  int dy = -abs( y1 - y0 ), sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+
+  for ( ;; )
+  {
+    web_Stamp( x0, y0, width, height );
+    if ( x0 == x1 && y0 == y1 ) break;
+
+    int e2 = 2 * err;
+    if ( e2 >= dy )
+    {
+      err += dy;
+      x0  += sx;
+    }
+
+    if ( e2 <= dx )
+    {
+      err += dx;
+      y0  += sy;
+    }
+  }
+
+  stroke_x = x1;
+  stroke_y = y1;
+}
+
+/*
+ * Square or round footprint brush_size cells across, an even size is
+ * centred between cells so it grows to the right and down
+ */
+static void web_Stamp( int cx, int cy, int width, int height )
+{
+  int lo = -( ( brush_size - 1 ) / 2 );
+  int hi = brush_size / 2;
+  int odd = brush_size & 1;
+
+  for ( int dx = lo; dx <= hi; dx++ )
+  {
+    int x = cx + dx;
+    if ( x < 0 || x >= width ) continue;
+
+    for ( int dy = lo; dy <= hi; dy++ )
+    {
+      int y = cy + dy;
+      if ( y < 0 || y >= height ) continue;
+
+      if ( brush_round )
+      {
+        int rx = ( 2 * dx ) - !odd, ry = ( 2 * dy ) - !odd;
+        if ( ( rx * rx ) + ( ry * ry ) > brush_size * brush_size ) continue;
+      }
+
+      brush_mask[INDEX_2( x, y, height )] = 1;
+
+      if ( x < mask_min_x ) mask_min_x = x;
+      if ( y < mask_min_y ) mask_min_y = y;
+      if ( x > mask_max_x ) mask_max_x = x;
+      if ( y > mask_max_y ) mask_max_y = y;
+    }
+  }
+}
+
+static void web_Flush( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                       int fg )
+{
+  if ( mask_max_x < mask_min_x ) return;
+
+  int width = 0, height = 0;
+  we_GridSize( map, pos.level, &width, &height );
+
+  TileRect_t rect = { .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .x = mask_min_x, .y = mask_min_y,
+    .z = pos.local_z, .w = mask_max_x - mask_min_x + 1,
+    .h = mask_max_y - mask_min_y + 1, .d = 1 };
+
+  if ( e_ClipRect( map, &rect ) )
+  {
+    size_t stride = e_TileStride( rect.level );
+
+    e_TilesWillChange( map, rect );
+
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      uint8_t* tile = ( uint8_t* )e_RectColumn( map, rect, x, rect.z );
+      uint8_t* mask = &brush_mask[INDEX_2( x, rect.y, height )];
+
+      for ( int y = 0; y < rect.h; y++, tile += stride )
+      {
+        if ( !mask[y] ) continue;
+
+        ( ( GameTile_t* )tile )->glyph = glyph;
+        ( ( GameTile_t* )tile )->bg    = bg;
+        ( ( GameTile_t* )tile )->fg    = fg;
+      }
+    }
+
+    e_TilesChanged( map, rect );
+  }
+
+  // every frame starts from a clear mask
+  for ( int x = mask_min_x; x <= mask_max_x; x++ )
+  {
+    memset( &brush_mask[INDEX_2( x, mask_min_y, height )], 0,
+            mask_max_y - mask_min_y + 1 );
+  }
+
+  mask_min_x = mask_min_y = INT32_MAX;
+  mask_max_x = mask_max_y = -1;
+}
+
@@ -0,0 +1,276 @@
+/*
+ * world_editor/clipboard.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * The clipboard owns a copy of the tiles, so pasting never reads the map it
+ * is writing to and a copy outlives the world it came from. Copied areas
+ * are mostly a handful of distinct tiles, each is kept once in the palette
+ * and every tile is an index into it.
+ */
+static Clipboard_t clipboard = { 0 };
+
+static uint32_t wecb_Hash( GameTile_t* tile );
+static int wecb_Index( Clipboard_t* tiles, int k );
+static void wecb_Layout( Clipboard_t* tiles, int transform, int* w, int* h,
+                         int* k0, int* du, int* dv );
+
+int e_CopyClipboard( World_t* map, TileRect_t rect )
+{
+  if ( map == NULL || !e_ClipRect( map, &rect ) ) return 0;
+
+  int count = rect.w * rect.h * rect.d;
+  int table_size = 64;
+  while ( table_size < count * 2 ) table_size <<= 1;
+
+  GameTile_t* tiles = malloc( sizeof( GameTile_t ) * count );
+  GameTile_t* palette = malloc( sizeof( GameTile_t ) * count );
+  uint16_t* cells = malloc( sizeof( uint16_t ) * count );
+  int* table = malloc( sizeof( int ) * table_size );
+
+  if ( tiles == NULL || palette == NULL || cells == NULL || table == NULL )
+  {
+    printf( "Failed to allocate memory for clipboard\n" );
+    free( tiles );
+    free( palette );
+    free( cells );
+    free( table );
+    return 0;
+  }
+
+  memset( table, -1, sizeof( int ) * table_size );
+  e_CopyRect( map, rect, tiles );
+
+  int num_palette = 0;
+
+  for ( int k = 0; k < count; k++ )
+  {
+    uint32_t slot = wecb_Hash( &tiles[k] ) & ( table_size - 1 );
+
+    while ( table[slot] >= 0 &&
+            !e_SameTile( &palette[table[slot]], &tiles[k] ) )
+    {
+      slot = ( slot + 1 ) & ( table_size - 1 );
+    }
+
+    if ( table[slot] < 0 )
+    {
+      if ( num_palette > UINT16_MAX )
+      {
+        printf( "Failed to copy, too many distinct tiles\n" );
+        free( tiles );
+        free( palette );
+        free( cells );
+        free( table );
+        return 0;
+      }
+
+      table[slot] = num_palette;
+      palette[num_palette++] = tiles[k];
+    }
+
+    cells[k] = table[slot];
+  }
+
+  free( tiles );
+  free( table );
+
+  e_FreeClipboard();
+
+  clipboard.w = rect.w;
+  clipboard.h = rect.h;
+  clipboard.d = rect.d;
+  clipboard.num_palette = num_palette;
+
+  GameTile_t* shrunk = realloc( palette, sizeof( GameTile_t ) * num_palette );
+  if ( shrunk != NULL )
+  {
+    palette = shrunk;
+  }
+
+  clipboard.palette = palette;
+
+  // one byte per tile covers nearly every copy
+  clipboard.wide = ( num_palette > 256 );
+  if ( !clipboard.wide )
+  {
+    uint8_t* narrow = ( uint8_t* )cells;
+
+    for ( int k = 0; k < count; k++ )
+    {
+      narrow[k] = ( uint8_t )cells[k];
+    }
+
+    uint16_t* temp = realloc( cells, count );
+    if ( temp != NULL )
+    {
+      cells = temp;
+    }
+  }
+
+  clipboard.cells = cells;
+
+  return 1;
+}
+
+void e_PasteClipboard( World_t* map, WorldPosition_t pos )
+{
+  if ( clipboard.cells == NULL ) return;
+
+  e_PasteTiles( map, &clipboard, pos, 0 );
+}
+
+void e_PasteTiles( World_t* map, Clipboard_t* tiles, WorldPosition_t pos,
+                   int transform )
+{
+  if ( map == NULL || tiles == NULL || tiles->cells == NULL ) return;
+
+  int w, h, k0, du, dv;
+  wecb_Layout( tiles, transform, &w, &h, &k0, &du, &dv );
+
+  TileRect_t dst = { .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .x = pos.x, .y = pos.y,
+    .z = pos.local_z, .w = w, .h = h, .d = tiles->d };
+
+  if ( !e_ClipRect( map, &dst ) ) return;
+
+  size_t stride = e_TileStride( dst.level );
+  int layer = tiles->w * tiles->h;
+
+  e_TilesWillChange( map, dst );
+
+  for ( int z = 0; z < dst.d; z++ )
+  {
+    for ( int u = 0; u < dst.w; u++ )
+    {
+      uint8_t* to = ( uint8_t* )e_RectColumn( map, dst, dst.x + u,
+                                              dst.z + z );
+      int k = ( z * layer ) + k0 + ( u * du );
+
+      for ( int v = 0; v < dst.h; v++, to += stride, k += dv )
+      {
+        *( GameTile_t* )to = tiles->palette[wecb_Index( tiles, k )];
+      }
+    }
+  }
+
+  e_TilesChanged( map, dst );
+}
+
+Clipboard_t* e_GetClipboard( void )
+{
+  return clipboard.cells != NULL ? &clipboard : NULL;
+}
+
+void e_TransformedSize( Clipboard_t* tiles, int transform, int* w, int* h )
+{
+  int k0, du, dv;
+
+  wecb_Layout( tiles, transform, w, h, &k0, &du, &dv );
+}
+
+GameTile_t* e_TransformedTile( Clipboard_t* tiles, int transform, int x,
+                               int y, int z )
+{
+  int w, h, k0, du, dv;
+
+  wecb_Layout( tiles, transform, &w, &h, &k0, &du, &dv );
+
+  return &tiles->palette[wecb_Index( tiles, ( z * tiles->w * tiles->h ) +
+                                     k0 + ( x * du ) + ( y * dv ) )];
+}
+
+void e_FreeClipboard( void )
+{
+  free( clipboard.palette );
+  free( clipboard.cells );
+
+  clipboard = ( Clipboard_t ){ 0 };
+}
+
+/*
+ * FNV-1a over the fields, the padding of GameTile_t is not reliably zeroed
+ */
+static uint32_t wecb_Hash( GameTile_t* tile )
+{
+  uint8_t fields[] = { tile->glyph & 0xFF, tile->glyph >> 8,
+    tile->temperature, tile->elevation, tile->is_passable, tile->fg,
+    tile->bg };
+  uint32_t hash = 2166136261u;
+
+  for ( size_t i = 0; i < sizeof( fields ); i++ )
+  {
+    hash = ( hash ^ fields[i] ) * 16777619u;
+  }
+
+  return hash;
+}
+
+static int wecb_Index( Clipboard_t* tiles, int k )
+{
+  if ( tiles->wide )
+  {
+    return ( ( uint16_t* )tiles->cells )[k];
+  }
+
+  return ( ( uint8_t* )tiles->cells )[k];
+}
+
+/*
+ * Where the tiles land once mirrored ( x flipped ) and then rotated
+ * clockwise: w, h is the size on the map and the cell under column u, row
+ * v of the first layer is k0 + u * du + v * dv, so a paste walks every
+ * orientation with the same two additions
+ */
+static void wecb_Layout( Clipboard_t* tiles, int transform, int* w, int* h,
+                         int* k0, int* du, int* dv )
+{
+  int sw = tiles->w, sh = tiles->h;
+  int x0 = 0, xu = 1, xv = 0;
+  int y0 = 0, yu = 0, yv = 1;
+
+  switch ( transform & TRANSFORM_ROTATE_MASK )
+  {
+    case TRANSFORM_ROTATE_90:
+      x0 = 0;      xu = 0;  xv = 1;
+      y0 = sh - 1; yu = -1; yv = 0;
+      break;
+
+    case TRANSFORM_ROTATE_180:
+      x0 = sw - 1; xu = -1; xv = 0;
+      y0 = sh - 1; yu = 0;  yv = -1;
+      break;
+
+    case TRANSFORM_ROTATE_270:
+      x0 = sw - 1; xu = 0;  xv = -1;
+      y0 = 0;      yu = 1;  yv = 0;
+      break;
+  }
+
+  if ( transform & TRANSFORM_MIRROR )
+  {
+    x0 = sw - 1 - x0;
+    xu = -xu;
+    xv = -xv;
+  }
+
+  *w  = ( transform & 1 ) ? sh : sw;
+  *h  = ( transform & 1 ) ? sw : sh;
+  *k0 = ( x0 * sh ) + y0;
+  *du = ( xu * sh ) + yu;
+  *dv = ( xv * sh ) + yv;
+}
@@ -6,8 +6,12 @@
  ************************************************************************
  */
 
+#include <stdio.h>
+#include <time.h>
+
 #include "Archimedes.h"
 #include "init_editor.h"
+#include "profiler.h"
 #include "structs.h"
 #include "world_editor.h"
 
@@ -46,7 +50,7 @@ void we_Creation( void )
 
 static void we_CreationLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
 
   if ( app.keyboard[ SDL_SCANCODE_ESCAPE ] == 1 )
   {
@@ -188,6 +192,13 @@ void wec_GenerateWorld( void )
     break;
   }
 
+  wez_ResetLod();
+  wed_ResetDepth();
+  wet_ResetThumbnails();
+  weu_ResetUndo();
+  wea_ResetSummaries();
+  weq_ResetQuery();
+
   if ( map != NULL )
   {
     free_world( map, ( map->world_width * map->world_height ),
@@ -198,5 +209,14 @@ void wec_GenerateWorld( void )
                     new_region_height, new_local_width, new_local_height,
                     new_z_height );
 
+  if ( map != NULL )
+  {
+    uint32_t seed = ( uint32_t )time( NULL );
+
+    weg_GenerateWorld( map, seed );
+    printf( "Generated world with seed %u\n", seed );
+    wet_QueueThumbnails( map );
+  }
+
 }
 
@@ -0,0 +1,179 @@
+/*
+ * world_editor/depth.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "glyphs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * One mask per local column of a region, bit z is set when the tile at that
+ * z is not empty. The top visible tile at or below any z is then a few bit
+ * tests instead of a walk down the z slices.
+ */
+static uint16_t** depth_cache = NULL;
+static World_t* depth_map = NULL;
+static int depth_count = 0;
+
+static int composite_view = 0;
+
+static uint16_t* wed_GetRegionMasks( World_t* map, int world_index,
+                                     int region_index );
+
+int e_IsCompositeView( uint8_t level )
+{
+  return ( composite_view && level == LOCAL_LEVEL );
+}
+
+void e_ToggleCompositeView( void )
+{
+  composite_view = !composite_view;
+}
+
+void wed_ResetDepth( void )
+{
+  if ( depth_cache != NULL )
+  {
+    for ( int i = 0; i < depth_count; i++ )
+    {
+      free( depth_cache[i] );
+    }
+
+    free( depth_cache );
+  }
+
+  depth_cache = NULL;
+  depth_map   = NULL;
+  depth_count = 0;
+}
+
+static uint16_t* wed_GetRegionMasks( World_t* map, int world_index,
+                                     int region_index )
+{
+  int region_count = map->region_width * map->region_height;
+
+  if ( depth_map != map )
+  {
+    wed_ResetDepth();
+
+    depth_count = map->world_width * map->world_height * region_count;
+    depth_cache = ( uint16_t** )calloc( depth_count, sizeof( uint16_t* ) );
+    if ( depth_cache == NULL )
+    {
+      printf( "Failed to allocate memory for depth_cache\n" );
+      depth_count = 0;
+      return NULL;
+    }
+
+    depth_map = map;
+  }
+
+  int slot = ( world_index * region_count ) + region_index;
+  if ( depth_cache[slot] != NULL ) return depth_cache[slot];
+
+  if ( map[world_index].regions == NULL ||
+       map[world_index].regions[region_index].tiles == NULL )
+  {
+    return NULL;
+  }
+
+  int plane = map->local_width * map->local_height;
+  GameTile_t* tiles = map[world_index].regions[region_index].tiles;
+  uint16_t* masks = ( uint16_t* )calloc( plane, sizeof( uint16_t ) );
+  if ( masks == NULL )
+  {
+    printf( "Failed to allocate memory for region depth masks\n" );
+    return NULL;
+  }
+
+  for ( int z = 0; z < map->z_height && z < DEPTH_MAX_Z; z++ )
+  {
+    for ( int i = 0; i < plane; i++ )
+    {
+      if ( tiles[( z * plane ) + i].glyph != GLYPH_SPACE )
+      {
+        masks[i] |= ( 1u << z );
+      }
+    }
+  }
+
+  depth_cache[slot] = masks;
+
+  return masks;
+}
+
+int wed_TopZ( World_t* map, int world_index, int region_index, int index,
+              int z )
+{
+  if ( z >= DEPTH_MAX_Z ) return z;
+
+  uint16_t* masks = wed_GetRegionMasks( map, world_index, region_index );
+  if ( masks == NULL ) return z;
+
+  for ( int k = z; k >= 0; k-- )
+  {
+    if ( masks[index] & ( 1u << k ) ) return k;
+  }
+
+  return -1;
+}
+
+void wed_TilesChanged( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || depth_map != map || depth_cache == NULL )
+  {
+    return;
+  }
+
+  int slot = ( rect.world_index * map->region_width * map->region_height ) +
+    rect.region_index;
+  uint16_t* masks = depth_cache[slot];
+  if ( masks == NULL ) return;
+
+  int plane = map->local_width * map->local_height;
+  GameTile_t* tiles = map[rect.world_index].regions[rect.region_index].tiles;
+
+  for ( int x = rect.x; x < rect.x + rect.w && x < map->local_width; x++ )
+  {
+    for ( int y = rect.y; y < rect.y + rect.h && y < map->local_height; y++ )
+    {
+      int index = INDEX_2( x, y, map->local_height );
+
+      for ( int z = rect.z; z < rect.z + rect.d && z < DEPTH_MAX_Z; z++ )
+      {
+        if ( tiles[( z * plane ) + index].glyph != GLYPH_SPACE )
+        {
+          masks[index] |= ( 1u << z );
+        }
+
+        else
+        {
+          masks[index] &= ~( 1u << z );
+        }
+      }
+    }
+  }
+}
+
+aColor_t wed_ShadeColor( aColor_t color, int depth )
+{
+  float shade = 1.0f - ( depth * DEPTH_SHADE_STEP );
+  if ( shade < DEPTH_SHADE_MIN ) shade = DEPTH_SHADE_MIN;
+
+  color.r = ( uint8_t )( color.r * shade );
+  color.g = ( uint8_t )( color.g * shade );
+  color.b = ( uint8_t )( color.b * shade );
+
+  return color;
+}
+
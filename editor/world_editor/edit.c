@@ -13,6 +13,7 @@
 #include "editor.h"
 #include "glyphs.h"
 #include "structs.h"
+#include "text_cache.h"
 #include "world_editor.h"
 
 static void we_EditLogic( float dt );
@@ -27,8 +28,10 @@ uint8_t selected_glyph_x = 0, selected_glyph_y = 0;
 uint8_t selected_fg_x = 0, selected_fg_y = 0;
 uint8_t selected_bg_x = 0, selected_bg_y = 0;
 int editor_mode = 0;
-GameTileArray_t* clipboard = NULL;
 static char* pos_text;
+static int stamp_index = 0;
+static int stamp_transform = 0;
+static char stamp_text[PREFAB_NAME_LENGTH + 16];
 
 char* wem_strings[WEM_MAX+1] =
 {
@@ -38,6 +41,8 @@ char* wem_strings[WEM_MAX+1] =
   "WEM_PASTE",
   "WEM_MASS_CHANGE",
   "WEM_SELECT",
+  "WEM_FILL",
+  "WEM_STAMP",
   "WEM_MAX"
 };
 
@@ -59,6 +64,11 @@ void we_Edit( void )
   
   pos_text = malloc( sizeof(char) * 50 );
 
+  if ( e_PrefabCount() == 0 )
+  {
+    e_OpenPrefabs( PREFAB_FILE );
+  }
+
   selected_pos = (WorldPosition_t){ .world_index = 0, .region_index = 0,
     .local_index = 0, .level = 0, .local_z = 0 };
   snprintf(pos_text, 50, "%d,%d,%d,%d,%d\n", selected_pos.world_index,
@@ -69,7 +79,13 @@ void we_Edit( void )
 
 static void we_EditLogic( float dt )
 {
-  a_DoInput();
+  // the brush needs the motion events a_DoInput is about to drop
+  if ( editor_mode == WEM_BRUSH )
+  {
+    e_BrushInput( map, selected_pos, glyph_index, bg_index, fg_index );
+  }
+
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
 
   if ( map != NULL )
   {
@@ -100,6 +116,14 @@ static void we_EditLogic( float dt )
     {
       if ( editor_mode == WEM_NONE )
       {
+        TileRect_t painted = { .level = selected_pos.level,
+          .world_index = selected_pos.world_index,
+          .region_index = selected_pos.region_index, .x = selected_pos.x,
+          .y = selected_pos.y, .z = selected_pos.local_z, .w = 1, .h = 1,
+          .d = 1 };
+
+        e_TilesWillChange( map, painted );
+
         switch ( selected_pos.level ) {
           case WORLD_LEVEL:
             map[selected_pos.world_index].tile.glyph = glyph_index;
@@ -134,15 +158,34 @@ static void we_EditLogic( float dt )
 
             break;
         }
+
+        e_TilesChanged( map, painted );
       }
       
+      if ( editor_mode == WEM_FILL )
+      {
+        // shift lets the fill spread through the z levels
+        int bounded = !( app.keyboard[SDL_SCANCODE_LSHIFT] ||
+                         app.keyboard[SDL_SCANCODE_RSHIFT] );
+
+        PROF_ZONE( "fill" ) e_FloodFill( map, selected_pos, glyph_index,
+                                         bg_index, fg_index, bounded );
+      }
+
       if ( editor_mode == WEM_PASTE )
       {
-        e_PasteGameTile( map, highlighted_pos, clipboard );
+        PROF_ZONE( "paste" ) e_PasteClipboard( map, highlighted_pos );
         editor_mode = WEM_NONE;
 
       }
 
+      if ( editor_mode == WEM_STAMP )
+      {
+        PROF_ZONE( "stamp" ) e_StampPrefab( map, stamp_index,
+                                            highlighted_pos,
+                                            stamp_transform );
+      }
+
     }
   }
   
@@ -155,16 +198,17 @@ static void we_EditLogic( float dt )
     {
       if ( editor_mode == WEM_MASS_CHANGE )
       {
-        GameTileArray_t* temp = e_GetSelectGrid( map, selected_pos, highlighted_pos );
-        e_ChangeGameTile( map, selected_pos, temp, glyph_index,
-                               bg_index, fg_index );
+        TileRect_t rect = e_SelectRect( map, selected_pos, highlighted_pos );
+        PROF_ZONE( "mass_change" ) e_FillRect( map, rect, glyph_index,
+                                               bg_index, fg_index );
 
         editor_mode = WEM_NONE;
       }
 
       if ( editor_mode == WEM_COPY )
       {
-        clipboard = e_GetSelectGrid( map, selected_pos, highlighted_pos );
+        e_CopyClipboard( map, e_SelectRect( map, selected_pos,
+                                            highlighted_pos ) );
         editor_mode = WEM_PASTE;
       }
 
@@ -206,8 +250,139 @@ static void we_EditLogic( float dt )
 
     editor_mode = WEM_BRUSH;
   }
+
+  if ( app.keyboard[SDL_SCANCODE_F] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_F] = 0;
+
+    editor_mode = WEM_FILL;
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_T] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_T] = 0;
+
+    editor_mode = WEM_STAMP;
+  }
+
+  // the clipboard goes into the prefab library under the next free name
+  if ( app.keyboard[SDL_SCANCODE_N] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_N] = 0;
+
+    if ( e_GetClipboard() != NULL )
+    {
+      char name[PREFAB_NAME_LENGTH];
+      int n = e_PrefabCount();
+
+      do
+      {
+        snprintf( name, sizeof( name ), "prefab_%d", n++ );
+      } while ( e_FindPrefab( name ) >= 0 );
+
+      if ( e_SavePrefab( name, e_GetClipboard() ) )
+      {
+        stamp_index = e_FindPrefab( name );
+        printf( "Saved prefab %s\n", name );
+      }
+    }
+  }
+
+  // every tile like the selected one takes the current glyph and colours,
+  // shift keeps it to the selected world cell
+  if ( app.keyboard[SDL_SCANCODE_R] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_R] = 0;
+
+    if ( map != NULL && selected_pos.level == LOCAL_LEVEL &&
+         map[selected_pos.world_index].regions != NULL )
+    {
+      GameTile_t* match = &map[selected_pos.world_index].
+        regions[selected_pos.region_index].tiles[selected_pos.local_index];
+      int scope = ( app.keyboard[SDL_SCANCODE_LSHIFT] ||
+                    app.keyboard[SDL_SCANCODE_RSHIFT] ) ?
+        selected_pos.world_index : -1;
+      TileQuery_t query;
+
+      e_MatchAnyTile( &query );
+      query.glyph  = match->glyph;
+      query.fg_min = query.fg_max = match->fg;
+      query.bg_min = query.bg_max = match->bg;
+
+      PROF_ZONE( "replace_all" ) e_ReplaceTiles( map, &query, scope, -1,
+                                                 glyph_index, bg_index,
+                                                 fg_index );
+    }
+  }
+
+  if ( editor_mode == WEM_BRUSH )
+  {
+    if ( app.keyboard[SDL_SCANCODE_LEFTBRACKET] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_LEFTBRACKET] = 0;
+      e_BrushSizeStep( -1 );
+    }
+
+    if ( app.keyboard[SDL_SCANCODE_RIGHTBRACKET] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_RIGHTBRACKET] = 0;
+      e_BrushSizeStep( 1 );
+    }
+
+    if ( app.keyboard[SDL_SCANCODE_BACKSLASH] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_BACKSLASH] = 0;
+      e_ToggleBrushShape();
+    }
+  }
+
+  if ( editor_mode == WEM_STAMP && e_PrefabCount() > 0 )
+  {
+    if ( app.keyboard[SDL_SCANCODE_LEFTBRACKET] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_LEFTBRACKET] = 0;
+      stamp_index = ( stamp_index + e_PrefabCount() - 1 ) % e_PrefabCount();
+    }
+
+    if ( app.keyboard[SDL_SCANCODE_RIGHTBRACKET] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_RIGHTBRACKET] = 0;
+      stamp_index = ( stamp_index + 1 ) % e_PrefabCount();
+    }
+
+    // E turns the stamp clockwise, backslash mirrors it
+    if ( app.keyboard[SDL_SCANCODE_E] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_E] = 0;
+      stamp_transform = ( stamp_transform & TRANSFORM_MIRROR ) |
+        ( ( stamp_transform + 1 ) & TRANSFORM_ROTATE_MASK );
+    }
+
+    if ( app.keyboard[SDL_SCANCODE_BACKSLASH] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_BACKSLASH] = 0;
+      stamp_transform ^= TRANSFORM_MIRROR;
+    }
+  }
   
+  // before e_LevelZHeightCheck, plain Z toggles the composite view
+  if ( app.keyboard[SDL_SCANCODE_LCTRL] || app.keyboard[SDL_SCANCODE_RCTRL] )
+  {
+    if ( app.keyboard[SDL_SCANCODE_Z] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_Z] = 0;
+      e_Undo( map );
+    }
+
+    if ( app.keyboard[SDL_SCANCODE_Y] == 1 )
+    {
+      app.keyboard[SDL_SCANCODE_Y] = 0;
+      e_Redo( map );
+    }
+  }
+
   e_LevelZHeightCheck( &selected_pos );
+  e_UpdateZoom();
   highlighted_pos.local_z = selected_pos.local_z;
   highlighted_pos.level = selected_pos.level;
   
@@ -217,10 +392,6 @@ static void we_EditLogic( float dt )
     switch ( editor_mode )
     {
       case WEM_NONE:
-        if ( clipboard != NULL )
-        {
-          free( clipboard );
-        }
         free( pos_text );
 
         e_InitWorldEditor();
@@ -245,9 +416,23 @@ static void we_EditLogic( float dt )
       case WEM_SELECT:
         editor_mode = WEM_NONE;
         break;
+
+      case WEM_FILL:
+        editor_mode = WEM_NONE;
+        break;
+
+      case WEM_STAMP:
+        editor_mode = WEM_NONE;
+        break;
     }
   }
 
+  // Esc or another mode key may have left the brush mid-stroke
+  if ( editor_mode != WEM_BRUSH )
+  {
+    e_EndBrushStroke( map, selected_pos, glyph_index, bg_index, fg_index );
+  }
+
   a_DoWidget();
 
 }
@@ -256,39 +441,35 @@ static void we_EditDraw( float dt )
 {
   if ( map != NULL )
   {
-    int draw_size = 0;
-    switch ( selected_pos.level )
+    if ( e_IsLodView( selected_pos.level ) )
     {
-      case WORLD_LEVEL:
-        draw_size = map->world_width * map->world_height;         
-        break;
-
-      case REGION_LEVEL:
-        draw_size = map->region_width * map->region_height;
-        break;
-
-      case LOCAL_LEVEL:
-        draw_size = map->local_width * map->local_height;                      
-        break;
+      wez_DrawLodView( map, selected_pos );
     }
 
-    for ( uint16_t i = 0; i < draw_size; i++ )
+    else
     {
-      we_DrawWorldCell( i, map, selected_pos, highlighted_pos );
-    }
+      we_DrawWorldCells( map, selected_pos, highlighted_pos );
 
-    if ( editor_mode == WEM_SELECT || editor_mode == WEM_COPY ||
-      editor_mode == WEM_MASS_CHANGE )
-    {
-      e_DrawSelectGrid( map, selected_pos, highlighted_pos );
-    }
+      if ( editor_mode == WEM_SELECT || editor_mode == WEM_COPY ||
+        editor_mode == WEM_MASS_CHANGE )
+      {
+        e_DrawSelectGrid( map, selected_pos, highlighted_pos );
+      }
 
-    if ( editor_mode == WEM_PASTE )
-    {
-      if ( clipboard != NULL )
+      if ( editor_mode == WEM_BRUSH )
       {
-        e_DrawPastePreview(map, highlighted_pos, clipboard );
+        e_DrawBrushCursor( map, highlighted_pos );
+      }
 
+      if ( editor_mode == WEM_PASTE )
+      {
+        e_DrawPastePreview( map, highlighted_pos, e_GetClipboard(), 0 );
+      }
+
+      if ( editor_mode == WEM_STAMP )
+      {
+        e_DrawPastePreview( map, highlighted_pos, e_GetPrefab( stamp_index ),
+                            stamp_transform );
       }
     }
 
@@ -393,6 +574,28 @@ static void we_EditDraw( float dt )
 
   we_DrawEditorHotKeys( 1215, 164, GLYPH_UPPER_S, GLYPH_UPPER_S, GLYPH_UPPER_L,
                        GLYPH_UPPER_C, GLYPH_UPPER_T );
+
+  we_DrawEditorHotKeys( 1215, 180, GLYPH_UPPER_F, GLYPH_UPPER_F, GLYPH_UPPER_I,
+                       GLYPH_UPPER_L, GLYPH_UPPER_L );
+
+  we_DrawEditorHotKeys( 1215, 196, GLYPH_UPPER_T, GLYPH_UPPER_S, GLYPH_UPPER_T,
+                       GLYPH_UPPER_M, GLYPH_UPPER_P );
+
+  we_DrawEditorHotKeys( 1215, 212, GLYPH_UPPER_R, GLYPH_UPPER_R, GLYPH_UPPER_E,
+                       GLYPH_UPPER_P, GLYPH_UPPER_L );
+
+  // prefab browser, the selected prefab seen from above
+  if ( editor_mode == WEM_STAMP && e_PrefabName( stamp_index ) != NULL )
+  {
+    a_DrawFilledRect( 1120, 540, 154, 106, 0, 0, 0, 255 );
+    e_DrawPrefabPreview( stamp_index, 1123, 543, 148, 100 );
+
+    snprintf( stamp_text, sizeof( stamp_text ), "%s %d/%d",
+              e_PrefabName( stamp_index ), stamp_index + 1,
+              e_PrefabCount() );
+    g_DrawCachedText( stamp_text, 1197, 650, white, app.font_type,
+                      TEXT_ALIGN_CENTER );
+  }
   
   if ( editor_mode != WEM_NONE )
   {
@@ -404,8 +607,8 @@ static void we_EditDraw( float dt )
            selected_pos.region_index, selected_pos.local_index, selected_pos.level,
            selected_pos.local_z );
   
-  a_DrawText( pos_text, 1170, 680, 255, 255, 255, app.font_type,
-             TEXT_ALIGN_CENTER, 0 );
+  g_DrawCachedText( pos_text, 1170, 680, white, app.font_type,
+                    TEXT_ALIGN_CENTER );
 
   a_DrawWidgets();
 
@@ -0,0 +1,450 @@
+/*
+ * world_editor/fill.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * The fill runs in two passes. The first claims the area span by span, a
+ * span being a run of matching tiles along y, which is also the contiguous
+ * direction in memory. Claimed tiles are marked in a per region bitmap and
+ * grow that region's bounding box, nothing is written yet. The second pass
+ * then writes every claimed tile once, one undo box per region, so a fill
+ * over many regions is still one transaction of a few entries.
+ *
+ * At LOCAL_LEVEL x and y are global, every loaded region of every world
+ * cell is one big grid and unloaded regions act like walls.
+ */
+static World_t* fill_map = NULL;
+static uint8_t fill_level = 0;
+static int fill_world_index = 0;
+static int fill_width  = 0;
+static int fill_height = 0;
+static int fill_depth  = 0;
+static GameTile_t fill_target;
+
+static FillRegion_t** fill_slots = NULL;
+static int fill_num_slots = 0;
+static int* fill_touched = NULL;
+static int fill_num_touched = 0;
+
+static FillSeed_t* fill_stack = NULL;
+static int fill_stack_count = 0;
+static int fill_stack_size  = 0;
+
+static int wef_Setup( World_t* map, WorldPosition_t pos );
+static void wef_Reset( void );
+static GameTile_t* wef_Tile( int x, int y, int z, int* slot, int* bit );
+static FillRegion_t* wef_Region( int slot );
+static int wef_Open( GameTile_t* tile, int slot, int bit );
+static int wef_Claim( int x, int y, int z );
+static void wef_Push( int x, int y, int z );
+static void wef_ScanLine( int x, int y0, int y1, int z );
+static int wef_Write( FillRegion_t* region, int glyph, int bg, int fg );
+
+int e_FloodFill( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                 int fg, int bounded )
+{
+  if ( map == NULL || !wef_Setup( map, pos ) ) return 0;
+
+  int x = pos.x, y = pos.y, z = 0;
+
+  if ( fill_level == LOCAL_LEVEL )
+  {
+    int cell_x = ( pos.world_index / map->world_height ) * map->region_width +
+      ( pos.region_index / map->region_height );
+    int cell_y = ( pos.world_index % map->world_height ) * map->region_height +
+      ( pos.region_index % map->region_height );
+
+    x = ( cell_x * map->local_width ) + pos.x;
+    y = ( cell_y * map->local_height ) + pos.y;
+    z = pos.local_z;
+  }
+
+  int slot, bit;
+  GameTile_t* start = wef_Tile( x, y, z, &slot, &bit );
+
+  if ( start == NULL || ( start->glyph == glyph && start->bg == bg &&
+                          start->fg == fg ) )
+  {
+    wef_Reset();
+    return 0;
+  }
+
+  fill_target = *start;
+  wef_Push( x, y, z );
+
+  while ( fill_stack_count > 0 )
+  {
+    FillSeed_t seed = fill_stack[--fill_stack_count];
+
+    if ( !wef_Claim( seed.x, seed.y, seed.z ) ) continue;
+
+    int y0 = seed.y, y1 = seed.y;
+    while ( y0 > 0 && wef_Claim( seed.x, y0 - 1, seed.z ) )
+    {
+      y0--;
+    }
+
+    while ( y1 + 1 < fill_height && wef_Claim( seed.x, y1 + 1, seed.z ) )
+    {
+      y1++;
+    }
+
+    if ( seed.x > 0 )
+    {
+      wef_ScanLine( seed.x - 1, y0, y1, seed.z );
+    }
+
+    if ( seed.x + 1 < fill_width )
+    {
+      wef_ScanLine( seed.x + 1, y0, y1, seed.z );
+    }
+
+    if ( !bounded && seed.z > 0 )
+    {
+      wef_ScanLine( seed.x, y0, y1, seed.z - 1 );
+    }
+
+    if ( !bounded && seed.z + 1 < fill_depth )
+    {
+      wef_ScanLine( seed.x, y0, y1, seed.z + 1 );
+    }
+  }
+
+  int filled = 0;
+
+  e_BeginTransaction();
+  for ( int i = 0; i < fill_num_touched; i++ )
+  {
+    filled += wef_Write( fill_slots[fill_touched[i]], glyph, bg, fg );
+  }
+  e_EndTransaction();
+
+  wef_Reset();
+
+  return filled;
+}
+
+static int wef_Setup( World_t* map, WorldPosition_t pos )
+{
+  fill_map   = map;
+  fill_level = pos.level;
+  fill_world_index = pos.world_index;
+  fill_depth = 1;
+  fill_num_slots = 1;
+
+  switch ( pos.level )
+  {
+    case WORLD_LEVEL:
+      fill_width  = map->world_width;
+      fill_height = map->world_height;
+      break;
+
+    case REGION_LEVEL:
+      if ( map[pos.world_index].regions == NULL ) return 0;
+      fill_width  = map->region_width;
+      fill_height = map->region_height;
+      break;
+
+    case LOCAL_LEVEL:
+      fill_width  = map->world_width * map->region_width * map->local_width;
+      fill_height = map->world_height * map->region_height *
+        map->local_height;
+      fill_depth  = map->z_height;
+      fill_num_slots = map->world_width * map->world_height *
+        map->region_width * map->region_height;
+      break;
+
+    default:
+      return 0;
+  }
+
+  fill_slots   = calloc( fill_num_slots, sizeof( FillRegion_t* ) );
+  fill_touched = malloc( sizeof( int ) * fill_num_slots );
+  if ( fill_slots == NULL || fill_touched == NULL )
+  {
+    printf( "Failed to allocate memory for flood fill\n" );
+    wef_Reset();
+    return 0;
+  }
+
+  fill_num_touched = 0;
+  fill_stack_count = 0;
+
+  return 1;
+}
+
+static void wef_Reset( void )
+{
+  for ( int i = 0; i < fill_num_touched; i++ )
+  {
+    free( fill_slots[fill_touched[i]]->visited );
+    free( fill_slots[fill_touched[i]] );
+  }
+
+  free( fill_slots );
+  free( fill_touched );
+  free( fill_stack );
+
+  fill_slots       = NULL;
+  fill_touched     = NULL;
+  fill_stack       = NULL;
+  fill_num_slots   = 0;
+  fill_num_touched = 0;
+  fill_stack_count = 0;
+  fill_stack_size  = 0;
+  fill_map         = NULL;
+}
+
+/*
+ * Tile at global x, y, z of the fill level, NULL when its region is not
+ * loaded. `slot` is the region it is in and `bit` its place in the region.
+ */
+static GameTile_t* wef_Tile( int x, int y, int z, int* slot, int* bit )
+{
+  World_t* map = fill_map;
+
+  switch ( fill_level )
+  {
+    case WORLD_LEVEL:
+      *slot = 0;
+      *bit  = INDEX_2( x, y, map->world_height );
+      return &map[*bit].tile;
+
+    case REGION_LEVEL:
+      *slot = 0;
+      *bit  = INDEX_2( x, y, map->region_height );
+      return &map[fill_world_index].regions[*bit].tile;
+  }
+
+  int cell_x = x / map->local_width, cell_y = y / map->local_height;
+  int world_index = INDEX_2( cell_x / map->region_width,
+                             cell_y / map->region_height, map->world_height );
+  if ( map[world_index].regions == NULL ) return NULL;
+
+  int region_index = INDEX_2( cell_x % map->region_width,
+                              cell_y % map->region_height,
+                              map->region_height );
+  GameTile_t* tiles = map[world_index].regions[region_index].tiles;
+  if ( tiles == NULL ) return NULL;
+
+  *slot = ( world_index * map->region_width * map->region_height ) +
+    region_index;
+  *bit  = ( z * map->local_width * map->local_height ) +
+    INDEX_2( x % map->local_width, y % map->local_height, map->local_height );
+
+  return &tiles[*bit];
+}
+
+static FillRegion_t* wef_Region( int slot )
+{
+  if ( fill_slots[slot] != NULL ) return fill_slots[slot];
+
+  int tiles = fill_width * fill_height;
+  if ( fill_level == LOCAL_LEVEL )
+  {
+    tiles = fill_map->local_width * fill_map->local_height * fill_depth;
+  }
+
+  FillRegion_t* region = malloc( sizeof( FillRegion_t ) );
+  if ( region == NULL )
+  {
+    printf( "Failed to allocate memory for flood fill region\n" );
+    return NULL;
+  }
+
+  region->visited = calloc( ( tiles + 7 ) / 8, sizeof( uint8_t ) );
+  if ( region->visited == NULL )
+  {
+    printf( "Failed to allocate memory for flood fill region\n" );
+    free( region );
+    return NULL;
+  }
+
+  region->slot  = slot;
+  region->min_x = region->min_y = region->min_z = UINT8_MAX;
+  region->max_x = region->max_y = region->max_z = 0;
+
+  fill_slots[slot] = region;
+  fill_touched[fill_num_touched++] = slot;
+
+  return region;
+}
+
+/*
+ * Matches the clicked tile and is not claimed yet
+ */
+static int wef_Open( GameTile_t* tile, int slot, int bit )
+{
+  if ( tile == NULL || tile->glyph != fill_target.glyph ||
+       tile->fg != fill_target.fg || tile->bg != fill_target.bg )
+  {
+    return 0;
+  }
+
+  FillRegion_t* region = fill_slots[slot];
+
+  return ( region == NULL ||
+           !( region->visited[bit >> 3] & ( 1u << ( bit & 7 ) ) ) );
+}
+
+static int wef_Claim( int x, int y, int z )
+{
+  int slot, bit;
+  GameTile_t* tile = wef_Tile( x, y, z, &slot, &bit );
+
+  if ( !wef_Open( tile, slot, bit ) ) return 0;
+
+  FillRegion_t* region = wef_Region( slot );
+  if ( region == NULL ) return 0;
+
+  region->visited[bit >> 3] |= ( 1u << ( bit & 7 ) );
+
+  if ( fill_level == LOCAL_LEVEL )
+  {
+    x %= fill_map->local_width;
+    y %= fill_map->local_height;
+  }
+
+  if ( x < region->min_x ) region->min_x = x;
+  if ( y < region->min_y ) region->min_y = y;
+  if ( z < region->min_z ) region->min_z = z;
+  if ( x > region->max_x ) region->max_x = x;
+  if ( y > region->max_y ) region->max_y = y;
+  if ( z > region->max_z ) region->max_z = z;
+
+  return 1;
+}
+
+static void wef_Push( int x, int y, int z )
+{
+  if ( fill_stack_count == fill_stack_size )
+  {
+    int new_size = fill_stack_size == 0 ? 256 : fill_stack_size * 2;
+    FillSeed_t* temp = realloc( fill_stack, sizeof( FillSeed_t ) * new_size );
+    if ( temp == NULL )
+    {
+      printf( "Failed to allocate memory for flood fill stack\n" );
+      return;
+    }
+
+    fill_stack      = temp;
+    fill_stack_size = new_size;
+  }
+
+  fill_stack[fill_stack_count++] = ( FillSeed_t ){ .x = x, .y = y, .z = z };
+}
+
+/*
+ * One seed per run of open tiles of line x alongside the span y0 to y1
+ */
+static void wef_ScanLine( int x, int y0, int y1, int z )
+{
+  int in_run = 0;
+
+  for ( int y = y0; y <= y1; y++ )
+  {
+    int slot, bit;
+    GameTile_t* tile = wef_Tile( x, y, z, &slot, &bit );
+
+    if ( wef_Open( tile, slot, bit ) )
+    {
+      if ( !in_run )
+      {
+        wef_Push( x, y, z );
+      }
+
+      in_run = 1;
+    }
+
+    else
+    {
+      in_run = 0;
+    }
+  }
+}
+
+static int wef_Write( FillRegion_t* region, int glyph, int bg, int fg )
+{
+  World_t* map = fill_map;
+  int region_count = map->region_width * map->region_height;
+
+  TileRect_t rect = { .level = fill_level, .world_index = fill_world_index,
+    .region_index = 0, .x = region->min_x, .y = region->min_y,
+    .z = region->min_z, .w = region->max_x - region->min_x + 1,
+    .h = region->max_y - region->min_y + 1,
+    .d = region->max_z - region->min_z + 1 };
+
+  if ( fill_level == LOCAL_LEVEL )
+  {
+    rect.world_index  = region->slot / region_count;
+    rect.region_index = region->slot % region_count;
+  }
+
+  else
+  {
+    rect.z = 0;
+    rect.d = 1;
+  }
+
+  e_TilesWillChange( map, rect );
+
+  int filled = 0;
+  int plane  = map->local_width * map->local_height;
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      for ( int y = rect.y; y < rect.y + rect.h; y++ )
+      {
+        GameTile_t* tile;
+        int bit;
+
+        switch ( fill_level )
+        {
+          case WORLD_LEVEL:
+            bit  = INDEX_2( x, y, map->world_height );
+            tile = &map[bit].tile;
+            break;
+
+          case REGION_LEVEL:
+            bit  = INDEX_2( x, y, map->region_height );
+            tile = &map[rect.world_index].regions[bit].tile;
+            break;
+
+          default:
+            bit  = ( z * plane ) + INDEX_2( x, y, map->local_height );
+            tile = &map[rect.world_index].regions[rect.region_index].
+              tiles[bit];
+            break;
+        }
+
+        if ( region->visited[bit >> 3] & ( 1u << ( bit & 7 ) ) )
+        {
+          tile->glyph = glyph;
+          tile->bg    = bg;
+          tile->fg    = fg;
+          filled++;
+        }
+      }
+    }
+  }
+
+  e_TilesChanged( map, rect );
+
+  return filled;
+}
+
@@ -0,0 +1,424 @@
+/*
+ * world_editor/generate.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "glyphs.h"
+#include "jobs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+enum
+{
+  BIOME_DEEP_WATER,
+  BIOME_WATER,
+  BIOME_SEABED,
+  BIOME_BEACH,
+  BIOME_SNOW,
+  BIOME_TUNDRA,
+  BIOME_TAIGA,
+  BIOME_GRASSLAND,
+  BIOME_FOREST,
+  BIOME_HILLS,
+  BIOME_DESERT,
+  BIOME_SAVANNA,
+  BIOME_JUNGLE,
+  BIOME_MOUNTAIN,
+  BIOME_PEAK,
+  BIOME_ROCK,
+  BIOME_AIR
+};
+
+static const Biome_t biomes[] =
+{
+  [BIOME_DEEP_WATER] = { GLYPH_APPROXIMATELY, 2,  0,  0 },
+  [BIOME_WATER]      = { GLYPH_TILDE,         4,  1,  0 },
+  [BIOME_SEABED]     = { GLYPH_PERIOD,        16, 1,  0 },
+  [BIOME_BEACH]      = { GLYPH_PERIOD,        17, 16, 1 },
+  [BIOME_SNOW]       = { GLYPH_PERIOD,        45, 44, 1 },
+  [BIOME_TUNDRA]     = { GLYPH_COMMA,         42, 40, 1 },
+  [BIOME_TAIGA]      = { GLYPH_SPADE,         9,  6,  1 },
+  [BIOME_GRASSLAND]  = { GLYPH_QUOTATION,     10, 8,  1 },
+  [BIOME_FOREST]     = { GLYPH_CLUB,          7,  8,  1 },
+  [BIOME_HILLS]      = { GLYPH_CARET,         11, 8,  1 },
+  [BIOME_DESERT]     = { GLYPH_PERIOD,        14, 16, 1 },
+  [BIOME_SAVANNA]    = { GLYPH_COMMA,         20, 10, 1 },
+  [BIOME_JUNGLE]     = { GLYPH_SPADE,         10, 7,  1 },
+  [BIOME_MOUNTAIN]   = { GLYPH_UP_TRIANGLE,   42, 40, 0 },
+  [BIOME_PEAK]       = { GLYPH_UP_TRIANGLE,   45, 42, 0 },
+  [BIOME_ROCK]       = { GLYPH_DARK_SHADE,    40, 37, 0 },
+  [BIOME_AIR]        = { GLYPH_SPACE,         0,  36, 1 }
+};
+
+/*
+ * Every field is a pure function of the seed and the global position of a
+ * column, so a world cell comes out the same whichever worker builds it and
+ * in whatever order. Positions are in world cells, one noise period per
+ * cell at frequency 1, so a world looks alike at every size setting.
+ */
+static const float gradients[8][2] =
+{
+  { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
+  { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }
+};
+
+static World_t* gen_map = NULL;
+static uint32_t gen_seed = 0;
+static float gen_cell_w = 1.0f, gen_cell_h = 1.0f;
+static float gen_rows = 1.0f;
+
+static uint32_t weg_Hash( uint32_t seed, int x, int y );
+static void weg_NoiseLine( uint32_t seed, float x, float y, float step,
+                           int count, float weight, float* out );
+static void weg_FbmLine( uint32_t seed, float x, float y, float step,
+                         int count, int octaves, float* out );
+static void weg_SampleLine( float gx, float gy, int count,
+                            float elevation_factor, float temperature_factor,
+                            int* elevation, int* temperature, int* moisture );
+static int weg_Biome( int elevation, int temperature, int moisture );
+static void weg_SetTile( GameTile_t* tile, int biome, int elevation,
+                         int temperature );
+static void weg_GenerateRegion( int world_index, int region_index,
+                                TileSummary_t* cell );
+static void weg_GenerateCell( void* data );
+
+void weg_GenerateWorld( World_t* map, uint32_t seed )
+{
+  if ( map == NULL ) return;
+
+  // every tile is rewritten, nothing cached from the old tiles still holds
+  wez_ResetLod();
+  wed_ResetDepth();
+  wet_ResetThumbnails();
+  weu_ResetUndo();
+  wea_ResetSummaries();
+  weq_ResetQuery();
+
+  gen_map    = map;
+  gen_seed   = seed;
+  gen_cell_w = ( float )( map->region_width * map->local_width );
+  gen_cell_h = ( float )( map->region_height * map->local_height );
+  gen_rows   = ( float )map->world_height;
+
+  for ( int i = 0; i < map->world_width * map->world_height; i++ )
+  {
+    g_PushJob( weg_GenerateCell, ( void* )( intptr_t )i );
+  }
+
+  g_WaitJobs();
+  gen_map = NULL;
+}
+
+/*
+ * lowbias32 over the seed and lattice point
+ */
+static uint32_t weg_Hash( uint32_t seed, int x, int y )
+{
+  uint32_t h = seed ^ ( ( uint32_t )x * 0x27d4eb2du ) ^
+    ( ( uint32_t )y * 0x165667b1u );
+
+  h ^= h >> 16;
+  h *= 0x7feb352du;
+  h ^= h >> 15;
+  h *= 0x846ca68bu;
+  h ^= h >> 16;
+
+  return h;
+}
+
+/*
+ * Gradient noise on the integer lattice, about -1 to 1, added to `out` for
+ * count points going down from x, y. Neighbouring tiles mostly share a
+ * lattice cell, its corner hashes are only redone when the cell changes.
+ */
+static void weg_NoiseLine( uint32_t seed, float x, float y, float step,
+                           int count, float weight, float* out )
+{
+  float fx = floorf( x );
+  int ix = ( int )fx;
+  float dx = x - fx;
+  float u = dx * dx * dx * ( dx * ( ( dx * 6.0f ) - 15.0f ) + 10.0f );
+
+  int last_iy = 0;
+  const float* g00 = gradients[0];
+  const float* g10 = gradients[0];
+  const float* g01 = gradients[0];
+  const float* g11 = gradients[0];
+
+  for ( int i = 0; i < count; i++ )
+  {
+    float py = y + ( i * step );
+    float fy = floorf( py );
+    int iy = ( int )fy;
+    float dy = py - fy;
+    float v = dy * dy * dy * ( dy * ( ( dy * 6.0f ) - 15.0f ) + 10.0f );
+
+    if ( i == 0 || iy != last_iy )
+    {
+      g00 = gradients[weg_Hash( seed, ix,     iy )     & 7];
+      g10 = gradients[weg_Hash( seed, ix + 1, iy )     & 7];
+      g01 = gradients[weg_Hash( seed, ix,     iy + 1 ) & 7];
+      g11 = gradients[weg_Hash( seed, ix + 1, iy + 1 ) & 7];
+      last_iy = iy;
+    }
+
+    float n00 = ( g00[0] * dx )          + ( g00[1] * dy );
+    float n10 = ( g10[0] * ( dx - 1.0f ) ) + ( g10[1] * dy );
+    float n01 = ( g01[0] * dx )          + ( g01[1] * ( dy - 1.0f ) );
+    float n11 = ( g11[0] * ( dx - 1.0f ) ) + ( g11[1] * ( dy - 1.0f ) );
+
+    float nx0 = n00 + ( u * ( n10 - n00 ) );
+    float nx1 = n01 + ( u * ( n11 - n01 ) );
+
+    out[i] += weight * ( nx0 + ( v * ( nx1 - nx0 ) ) );
+  }
+}
+
+/*
+ * Octaves at double the frequency and half the weight, 0 to 1
+ */
+static void weg_FbmLine( uint32_t seed, float x, float y, float step,
+                         int count, int octaves, float* out )
+{
+  float weight = 1.0f, total = 0.0f;
+
+  for ( int i = 0; i < count; i++ )
+  {
+    out[i] = 0.0f;
+  }
+
+  for ( int i = 0; i < octaves; i++ )
+  {
+    weg_NoiseLine( seed + ( i * 0x9e3779b9u ), x, y, step, count, weight,
+                   out );
+    total += weight;
+    weight *= 0.5f;
+    x *= 2.0f;
+    y *= 2.0f;
+    step *= 2.0f;
+  }
+
+  for ( int i = 0; i < count; i++ )
+  {
+    float n = 0.5f + ( 0.5f * out[i] / total );
+
+    if ( n < 0.0f ) n = 0.0f;
+    if ( n > 1.0f ) n = 1.0f;
+
+    out[i] = n;
+  }
+}
+
+/*
+ * gx and gy are global local tile coordinates, count tiles are sampled down
+ * from gy. Temperature falls off toward the top and bottom edges and with
+ * height above the sea, the factors scale the result and everything is
+ * clamped to 0 - 255.
+ */
+static void weg_SampleLine( float gx, float gy, int count,
+                            float elevation_factor, float temperature_factor,
+                            int* elevation, int* temperature, int* moisture )
+{
+  float e_line[UINT8_MAX + 1], t_line[UINT8_MAX + 1], m_line[UINT8_MAX + 1];
+  float x = gx / gen_cell_w, y = gy / gen_cell_h, step = 1.0f / gen_cell_h;
+
+  weg_FbmLine( gen_seed, x * WORLDGEN_ELEVATION_FREQ,
+               y * WORLDGEN_ELEVATION_FREQ, step * WORLDGEN_ELEVATION_FREQ,
+               count, WORLDGEN_ELEVATION_OCTAVES, e_line );
+  weg_FbmLine( gen_seed ^ 0x6d6f6973u, x * WORLDGEN_MOISTURE_FREQ,
+               y * WORLDGEN_MOISTURE_FREQ, step * WORLDGEN_MOISTURE_FREQ,
+               count, WORLDGEN_MOISTURE_OCTAVES, m_line );
+  weg_FbmLine( gen_seed ^ 0x74656d70u, x * WORLDGEN_TEMPERATURE_FREQ,
+               y * WORLDGEN_TEMPERATURE_FREQ, step * WORLDGEN_TEMPERATURE_FREQ,
+               count, WORLDGEN_TEMPERATURE_OCTAVES, t_line );
+
+  for ( int i = 0; i < count; i++ )
+  {
+    // fBm bunches up around 0.5, stretch it so there are deep seas and peaks
+    float e = ( ( e_line[i] - 0.5f ) * 2.2f ) + 0.5f;
+    e = e * 255.0f * elevation_factor;
+    if ( e < 0.0f )   e = 0.0f;
+    if ( e > 255.0f ) e = 255.0f;
+
+    float py = y + ( i * step );
+    float latitude = 1.0f - ( fabsf( ( py / gen_rows ) - 0.5f ) * 2.0f );
+    float t = ( ( latitude * 0.75f ) + ( t_line[i] * 0.25f ) ) * 255.0f;
+    if ( e > WORLDGEN_SEA_LEVEL )
+    {
+      t -= ( e - WORLDGEN_SEA_LEVEL ) * 0.6f;
+    }
+
+    t *= temperature_factor;
+    if ( t < 0.0f )   t = 0.0f;
+    if ( t > 255.0f ) t = 255.0f;
+
+    elevation[i]   = ( int )e;
+    temperature[i] = ( int )t;
+    moisture[i]    = ( int )( m_line[i] * 255.0f );
+  }
+}
+
+static int weg_Biome( int elevation, int temperature, int moisture )
+{
+  if ( elevation < WORLDGEN_SEA_LEVEL - 40 ) return BIOME_DEEP_WATER;
+  if ( elevation < WORLDGEN_SEA_LEVEL )      return BIOME_WATER;
+  if ( elevation >= WORLDGEN_PEAK )          return BIOME_PEAK;
+  if ( elevation >= WORLDGEN_MOUNTAIN )      return BIOME_MOUNTAIN;
+
+  if ( temperature < 40 ) return BIOME_SNOW;
+  if ( temperature < 80 ) return moisture < 128 ? BIOME_TUNDRA : BIOME_TAIGA;
+
+  if ( elevation < WORLDGEN_SEA_LEVEL + WORLDGEN_SHORE ) return BIOME_BEACH;
+  if ( elevation >= WORLDGEN_HILLS )                     return BIOME_HILLS;
+
+  if ( temperature < 170 )
+  {
+    return moisture < 110 ? BIOME_GRASSLAND : BIOME_FOREST;
+  }
+
+  if ( moisture < 90 )  return BIOME_DESERT;
+  if ( moisture < 150 ) return BIOME_SAVANNA;
+
+  return BIOME_JUNGLE;
+}
+
+static void weg_SetTile( GameTile_t* tile, int biome, int elevation,
+                         int temperature )
+{
+  tile->glyph       = biomes[biome].glyph;
+  tile->fg          = biomes[biome].fg;
+  tile->bg          = biomes[biome].bg;
+  tile->is_passable = biomes[biome].is_passable;
+  tile->elevation   = elevation;
+  tile->temperature = temperature;
+}
+
+/*
+ * One column per local x, y. The surface sits at elevation * z_height / 256
+ * with rock under it, water up to the sea level z and air above. Each column
+ * is counted into the region's summary and the world cell's as it is
+ * written, the region tile is derived the way an edit would derive it.
+ */
+static void weg_GenerateRegion( int world_index, int region_index,
+                                TileSummary_t* cell )
+{
+  World_t* map = gen_map;
+  RegionCell_t* region = &map[world_index].regions[region_index];
+
+  int lw = map->local_width, lh = map->local_height, d = map->z_height;
+  int plane = lw * lh;
+  int wx = world_index / map->world_height;
+  int wy = world_index % map->world_height;
+  int rx = region_index / map->region_height;
+  int ry = region_index % map->region_height;
+  int sea_z = ( WORLDGEN_SEA_LEVEL * d ) / 256;
+
+  float elevation_factor   = map[world_index].elevation_factor *
+    region->elevation_factor;
+  float temperature_factor = map[world_index].temperature_factor *
+    region->temperature_factor;
+
+  TileSummary_t summary;
+  int e[UINT8_MAX + 1], t[UINT8_MAX + 1], m[UINT8_MAX + 1];
+  int gy = ( ( wy * map->region_height ) + ry ) * lh;
+
+  wea_InitSummary( &summary );
+
+  for ( int x = 0; x < lw; x++ )
+  {
+    int gx = ( ( ( wx * map->region_width ) + rx ) * lw ) + x;
+
+    weg_SampleLine( gx + 0.5f, gy + 0.5f, lh, elevation_factor,
+                    temperature_factor, e, t, m );
+
+    for ( int y = 0; y < lh; y++ )
+    {
+      int biome  = weg_Biome( e[y], t[y], m[y] );
+      int water  = ( biome == BIOME_DEEP_WATER || biome == BIOME_WATER );
+      int ground = ( e[y] * d ) / 256;
+      GameTile_t* column = &region->tiles[INDEX_2( x, y, lh )];
+      GameTile_t rock, surface, sea, air;
+
+      weg_SetTile( &rock, BIOME_ROCK, e[y], t[y] );
+      weg_SetTile( &surface, ( water && ground < sea_z ) ? BIOME_SEABED
+                                                           : biome,
+                   e[y], t[y] );
+      weg_SetTile( &sea, biome, e[y], t[y] );
+      weg_SetTile( &air, BIOME_AIR, e[y], t[y] );
+
+      for ( int z = 0; z < d; z++ )
+      {
+        if ( z < ground )
+        {
+          column[z * plane] = rock;
+        }
+
+        else if ( z == ground )
+        {
+          column[z * plane] = surface;
+        }
+
+        else if ( water && z <= sea_z )
+        {
+          column[z * plane] = sea;
+        }
+
+        else
+        {
+          column[z * plane] = air;
+        }
+      }
+
+      wea_CountColumn( map, &summary, column );
+      wea_CountColumn( map, cell, column );
+    }
+  }
+
+  wea_DeriveTile( &summary, &region->tile );
+  free( summary.bins );
+}
+
+static void weg_GenerateCell( void* data )
+{
+  int world_index = ( int )( intptr_t )data;
+  World_t* map = gen_map;
+  World_t* cell = &map[world_index];
+
+  // with no regions to derive from the cell takes the biome of its centre
+  if ( cell->regions == NULL )
+  {
+    int wx = world_index / map->world_height;
+    int wy = world_index % map->world_height;
+    int e, t, m;
+
+    weg_SampleLine( ( wx + 0.5f ) * gen_cell_w, ( wy + 0.5f ) * gen_cell_h, 1,
+                    cell->elevation_factor, cell->temperature_factor,
+                    &e, &t, &m );
+    weg_SetTile( &cell->tile, weg_Biome( e, t, m ), e, t );
+    return;
+  }
+
+  int num_regions = map->region_width * map->region_height;
+  TileSummary_t summary;
+
+  wea_InitSummary( &summary );
+
+  for ( int i = 0; i < num_regions; i++ )
+  {
+    weg_GenerateRegion( world_index, i, &summary );
+  }
+
+  wea_DeriveTile( &summary, &cell->tile );
+  free( summary.bins );
+}
+
@@ -0,0 +1,399 @@
+/*
+ * world_editor/prefab.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "glyphs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * A prefab is stored the way the clipboard holds it, palette then one
+ * index per tile, so a loaded prefab is a Clipboard_t and stamps through
+ * the same paste. The index sits after the last prefab, a save writes the
+ * new tiles where the index was and the index after them, nothing before
+ * it is ever rewritten.
+ */
+static Prefab_t* prefabs = NULL;
+static int num_prefabs = 0;
+static char prefab_filename[256] = { 0 };
+static uint32_t prefab_index_offset = 0;
+
+static size_t wepf_CellsSize( Clipboard_t* tiles );
+static int wepf_WriteIndex( FILE* file );
+static void wepf_MakePreview( Prefab_t* prefab );
+
+int e_OpenPrefabs( const char* filename )
+{
+  e_FreePrefabs();
+
+  snprintf( prefab_filename, sizeof( prefab_filename ), "%s", filename );
+  prefab_index_offset = sizeof( PrefabHeader_t );
+
+  FILE* file = fopen( filename, "rb" );
+  if ( file == NULL )
+  {
+    return 0;
+  }
+
+  PrefabHeader_t header;
+
+  if ( fread( &header, sizeof( PrefabHeader_t ), 1, file ) != 1 ||
+       memcmp( header.magic, PREFAB_MAGIC, 8 ) != 0 ||
+       header.version > PREFAB_VERSION )
+  {
+    printf( "Failed to read prefabs, %s is not a prefab library\n",
+            filename );
+    goto failed;
+  }
+
+  prefabs = calloc( header.count, sizeof( Prefab_t ) );
+  if ( header.count > 0 && prefabs == NULL )
+  {
+    printf( "Failed to allocate memory for prefabs\n" );
+    goto failed;
+  }
+
+  fseek( file, header.index_offset, SEEK_SET );
+
+  for ( uint32_t i = 0; i < header.count; i++ )
+  {
+    if ( fread( &prefabs[i].entry, sizeof( PrefabEntry_t ), 1, file ) != 1 )
+    {
+      printf( "Failed to read the prefab index of %s\n", filename );
+      goto failed;
+    }
+
+    prefabs[i].entry.name[PREFAB_NAME_LENGTH - 1] = '\0';
+  }
+
+  fclose( file );
+
+  num_prefabs = header.count;
+  prefab_index_offset = header.index_offset;
+
+  return num_prefabs;
+
+  // with no name left a save cannot write an index over the library
+failed:
+  fclose( file );
+  e_FreePrefabs();
+  prefab_filename[0] = '\0';
+
+  return -1;
+}
+
+int e_PrefabCount( void )
+{
+  return num_prefabs;
+}
+
+const char* e_PrefabName( int index )
+{
+  if ( index < 0 || index >= num_prefabs ) return NULL;
+
+  return prefabs[index].entry.name;
+}
+
+int e_FindPrefab( const char* name )
+{
+  for ( int i = 0; i < num_prefabs; i++ )
+  {
+    if ( strncmp( prefabs[i].entry.name, name, PREFAB_NAME_LENGTH ) == 0 )
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+Clipboard_t* e_GetPrefab( int index )
+{
+  if ( index < 0 || index >= num_prefabs ) return NULL;
+
+  Prefab_t* prefab = &prefabs[index];
+  if ( prefab->tiles.cells != NULL ) return &prefab->tiles;
+
+  Clipboard_t tiles = { .w = prefab->entry.w, .h = prefab->entry.h,
+    .d = prefab->entry.d, .num_palette = prefab->entry.num_palette,
+    .wide = ( prefab->entry.num_palette > 256 ) };
+  size_t cells_size = wepf_CellsSize( &tiles );
+
+  FILE* file = fopen( prefab_filename, "rb" );
+  if ( file == NULL )
+  {
+    printf( "Failed to open %s\n", prefab_filename );
+    return NULL;
+  }
+
+  tiles.palette = malloc( sizeof( GameTile_t ) * tiles.num_palette );
+  tiles.cells   = malloc( cells_size );
+
+  if ( tiles.palette == NULL || tiles.cells == NULL ||
+       fseek( file, prefab->entry.offset, SEEK_SET ) != 0 ||
+       fread( tiles.palette, sizeof( GameTile_t ), tiles.num_palette,
+              file ) != ( size_t )tiles.num_palette ||
+       fread( tiles.cells, 1, cells_size, file ) != cells_size )
+  {
+    printf( "Failed to read prefab %s\n", prefab->entry.name );
+    free( tiles.palette );
+    free( tiles.cells );
+    fclose( file );
+    return NULL;
+  }
+
+  fclose( file );
+  prefab->tiles = tiles;
+
+  return &prefab->tiles;
+}
+
+int e_SavePrefab( const char* name, Clipboard_t* tiles )
+{
+  if ( tiles == NULL || tiles->cells == NULL || prefab_filename[0] == '\0' )
+  {
+    return 0;
+  }
+
+  if ( strlen( name ) == 0 || strlen( name ) >= PREFAB_NAME_LENGTH )
+  {
+    printf( "Failed to save prefab, the name must be 1 to %d characters\n",
+            PREFAB_NAME_LENGTH - 1 );
+    return 0;
+  }
+
+  FILE* file = fopen( prefab_filename, "r+b" );
+  if ( file == NULL )
+  {
+    file = fopen( prefab_filename, "w+b" );
+  }
+
+  if ( file == NULL )
+  {
+    printf( "Failed to open %s\n", prefab_filename );
+    return 0;
+  }
+
+  size_t cells_size = wepf_CellsSize( tiles );
+  Clipboard_t copy = *tiles;
+
+  copy.palette = malloc( sizeof( GameTile_t ) * tiles->num_palette );
+  copy.cells   = malloc( cells_size );
+  if ( copy.palette == NULL || copy.cells == NULL )
+  {
+    printf( "Failed to allocate memory for prefab %s\n", name );
+    free( copy.palette );
+    free( copy.cells );
+    fclose( file );
+    return 0;
+  }
+
+  memcpy( copy.palette, tiles->palette,
+          sizeof( GameTile_t ) * tiles->num_palette );
+  memcpy( copy.cells, tiles->cells, cells_size );
+
+  int index = e_FindPrefab( name );
+  if ( index < 0 )
+  {
+    Prefab_t* temp = realloc( prefabs, sizeof( Prefab_t ) *
+                              ( num_prefabs + 1 ) );
+    if ( temp == NULL )
+    {
+      printf( "Failed to allocate memory for prefab %s\n", name );
+      free( copy.palette );
+      free( copy.cells );
+      fclose( file );
+      return 0;
+    }
+
+    prefabs = temp;
+    index = num_prefabs++;
+    memset( &prefabs[index], 0, sizeof( Prefab_t ) );
+    snprintf( prefabs[index].entry.name, PREFAB_NAME_LENGTH, "%s", name );
+  }
+
+  else
+  {
+    free( prefabs[index].tiles.palette );
+    free( prefabs[index].tiles.cells );
+    if ( prefabs[index].preview != NULL )
+    {
+      SDL_DestroyTexture( prefabs[index].preview );
+      prefabs[index].preview = NULL;
+    }
+  }
+
+  Prefab_t* prefab = &prefabs[index];
+
+  prefab->tiles = copy;
+  prefab->entry.w = copy.w;
+  prefab->entry.h = copy.h;
+  prefab->entry.d = copy.d;
+  prefab->entry.num_palette = copy.num_palette;
+  prefab->entry.offset = prefab_index_offset;
+
+  fseek( file, prefab_index_offset, SEEK_SET );
+  fwrite( copy.palette, sizeof( GameTile_t ), copy.num_palette, file );
+  fwrite( copy.cells, 1, cells_size, file );
+
+  prefab_index_offset += sizeof( GameTile_t ) * copy.num_palette +
+    cells_size;
+
+  int written = wepf_WriteIndex( file );
+  fclose( file );
+
+  return written;
+}
+
+void e_StampPrefab( World_t* map, int index, WorldPosition_t pos,
+                    int transform )
+{
+  e_PasteTiles( map, e_GetPrefab( index ), pos, transform );
+}
+
+void e_DrawPrefabPreview( int index, int x, int y, int w, int h )
+{
+  if ( e_GetPrefab( index ) == NULL ) return;
+
+  Prefab_t* prefab = &prefabs[index];
+
+  if ( prefab->preview == NULL )
+  {
+    wepf_MakePreview( prefab );
+    if ( prefab->preview == NULL ) return;
+  }
+
+  // keep the shape, whole pixels per tile when the prefab is small enough
+  float scale_x = ( float )w / prefab->tiles.w;
+  float scale_y = ( float )h / prefab->tiles.h;
+  float scale = scale_x < scale_y ? scale_x : scale_y;
+  if ( scale >= 1.0f )
+  {
+    scale = ( float )( int )scale;
+  }
+
+  int dw = prefab->tiles.w * scale;
+  int dh = prefab->tiles.h * scale;
+  SDL_Rect dest = { x + ( ( w - dw ) / 2 ), y + ( ( h - dh ) / 2 ), dw, dh };
+
+  SDL_RenderCopy( app.renderer, prefab->preview, NULL, &dest );
+}
+
+void e_FreePrefabs( void )
+{
+  for ( int i = 0; i < num_prefabs; i++ )
+  {
+    free( prefabs[i].tiles.palette );
+    free( prefabs[i].tiles.cells );
+
+    if ( prefabs[i].preview != NULL )
+    {
+      SDL_DestroyTexture( prefabs[i].preview );
+    }
+  }
+
+  free( prefabs );
+  prefabs = NULL;
+  num_prefabs = 0;
+}
+
+static size_t wepf_CellsSize( Clipboard_t* tiles )
+{
+  return ( size_t )tiles->w * tiles->h * tiles->d * ( tiles->wide ? 2 : 1 );
+}
+
+/*
+ * Index at prefab_index_offset, then the header pointing at it
+ */
+static int wepf_WriteIndex( FILE* file )
+{
+  PrefabHeader_t header = { .version = PREFAB_VERSION,
+    .count = num_prefabs, .index_offset = prefab_index_offset };
+  memcpy( header.magic, PREFAB_MAGIC, 8 );
+
+  fseek( file, prefab_index_offset, SEEK_SET );
+
+  for ( int i = 0; i < num_prefabs; i++ )
+  {
+    if ( fwrite( &prefabs[i].entry, sizeof( PrefabEntry_t ), 1, file ) != 1 )
+    {
+      printf( "Failed to write the prefab index of %s\n", prefab_filename );
+      return 0;
+    }
+  }
+
+  fseek( file, 0, SEEK_SET );
+  if ( fwrite( &header, sizeof( PrefabHeader_t ), 1, file ) != 1 )
+  {
+    printf( "Failed to write the prefab header of %s\n", prefab_filename );
+    return 0;
+  }
+
+  return 1;
+}
+
+/*
+ * Seen from above like the region thumbnails, the fg of the highest
+ * non-empty tile of each column, the bg of the bottom one if it is all air
+ */
+static void wepf_MakePreview( Prefab_t* prefab )
+{
+  Clipboard_t* tiles = &prefab->tiles;
+  uint8_t* rgba = malloc( ( size_t )tiles->w * tiles->h * 4 );
+  if ( rgba == NULL )
+  {
+    printf( "Failed to allocate memory for prefab preview\n" );
+    return;
+  }
+
+  for ( int x = 0; x < tiles->w; x++ )
+  {
+    for ( int y = 0; y < tiles->h; y++ )
+    {
+      GameTile_t* tile = e_TransformedTile( tiles, 0, x, y, 0 );
+      aColor_t color = master_colors[APOLLO_PALETE][tile->bg];
+
+      for ( int z = tiles->d - 1; z >= 0; z-- )
+      {
+        GameTile_t* top = e_TransformedTile( tiles, 0, x, y, z );
+        if ( top->glyph != GLYPH_SPACE )
+        {
+          color = master_colors[APOLLO_PALETE][top->fg];
+          break;
+        }
+      }
+
+      uint8_t* pixel = &rgba[( ( y * tiles->w ) + x ) * 4];
+      pixel[0] = color.r;
+      pixel[1] = color.g;
+      pixel[2] = color.b;
+      pixel[3] = 255;
+    }
+  }
+
+  prefab->preview = SDL_CreateTexture( app.renderer, SDL_PIXELFORMAT_RGBA32,
+                                       SDL_TEXTUREACCESS_STATIC, tiles->w,
+                                       tiles->h );
+  if ( prefab->preview == NULL )
+  {
+    printf( "Failed to create prefab preview, %s\n", SDL_GetError() );
+  }
+
+  else
+  {
+    SDL_UpdateTexture( prefab->preview, NULL, rgba, tiles->w * 4 );
+  }
+
+  free( rgba );
+}
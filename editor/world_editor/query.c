@@ -0,0 +1,397 @@
+/*
+ * world_editor/query.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "jobs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * The predicate is turned into one lookup table per byte field before the
+ * jobs start, so matching a tile is a handful of loads and ands with no
+ * branches, done a whole column at a time. A region whose mask cannot
+ * match is skipped, every region that is scanned gets an exact mask back
+ * for free.
+ */
+static RegionMask_t* query_masks = NULL;
+static QueryHit_t* query_hits = NULL;
+static World_t* query_map = NULL;
+static int query_regions = 0;
+
+static TileQuery_t query;
+static int query_region = -1;
+static uint8_t fg_ok[256], bg_ok[256];
+static uint8_t elevation_ok[256], temperature_ok[256];
+static uint8_t passable_ok[2];
+
+static int weq_Setup( World_t* map );
+static int weq_Run( World_t* map, TileQuery_t* q, int world_index,
+                    int region_index );
+static void weq_Range( uint8_t* table, int min, int max );
+static int weq_Match( GameTile_t* tile );
+static int weq_MaskMatches( RegionMask_t* mask );
+static void weq_MaskAdd( RegionMask_t* mask, GameTile_t* tile );
+static void weq_ScanRegion( World_t* map, int world_index, int region_index );
+static void weq_ScanCell( void* data );
+
+void e_MatchAnyTile( TileQuery_t* q )
+{
+  *q = ( TileQuery_t ){ .glyph = -1, .fg_max = 255, .bg_max = 255,
+    .elevation_max = 255, .temperature_max = 255, .passable = -1 };
+}
+
+int e_FindTiles( World_t* map, TileQuery_t* q, int world_index,
+                 int region_index, WorldPosition_t* first )
+{
+  if ( !weq_Run( map, q, world_index, region_index ) ) return 0;
+
+  int num_regions = map->region_width * map->region_height;
+  int plane = map->local_width * map->local_height;
+  int total = 0;
+
+  for ( int i = 0; i < map->world_width * map->world_height; i++ )
+  {
+    if ( world_index >= 0 && i != world_index ) continue;
+
+    for ( int j = 0; j < num_regions; j++ )
+    {
+      if ( region_index >= 0 && j != region_index ) continue;
+
+      QueryHit_t* hit = &query_hits[( i * num_regions ) + j];
+      if ( hit->count == 0 ) continue;
+
+      if ( total == 0 && first != NULL )
+      {
+        int index = hit->first % plane;
+
+        *first = ( WorldPosition_t ){ .world_index = i, .region_index = j,
+          .local_index = hit->first, .local_z = hit->first / plane,
+          .x = index / map->local_height, .y = index % map->local_height,
+          .level = LOCAL_LEVEL };
+      }
+
+      total += hit->count;
+    }
+  }
+
+  return total;
+}
+
+int e_ReplaceTiles( World_t* map, TileQuery_t* q, int world_index,
+                    int region_index, int glyph, int bg, int fg )
+{
+  if ( !weq_Run( map, q, world_index, region_index ) ) return 0;
+
+  int num_regions = map->region_width * map->region_height;
+  int changed = 0;
+
+  e_BeginTransaction();
+
+  for ( int i = 0; i < map->world_width * map->world_height; i++ )
+  {
+    if ( world_index >= 0 && i != world_index ) continue;
+
+    for ( int j = 0; j < num_regions; j++ )
+    {
+      if ( region_index >= 0 && j != region_index ) continue;
+
+      QueryHit_t* hit = &query_hits[( i * num_regions ) + j];
+      if ( hit->count == 0 ) continue;
+
+      TileRect_t rect = { .level = LOCAL_LEVEL, .world_index = i,
+        .region_index = j, .x = hit->min_x, .y = hit->min_y,
+        .z = hit->min_z, .w = hit->max_x - hit->min_x + 1,
+        .h = hit->max_y - hit->min_y + 1, .d = hit->max_z - hit->min_z + 1 };
+
+      e_TilesWillChange( map, rect );
+
+      for ( int z = rect.z; z < rect.z + rect.d; z++ )
+      {
+        for ( int x = rect.x; x < rect.x + rect.w; x++ )
+        {
+          GameTile_t* column = e_RectColumn( map, rect, x, z );
+
+          for ( int y = 0; y < rect.h; y++ )
+          {
+            if ( !weq_Match( &column[y] ) ) continue;
+
+            column[y].glyph = glyph;
+            column[y].bg    = bg;
+            column[y].fg    = fg;
+            changed++;
+          }
+        }
+      }
+
+      e_TilesChanged( map, rect );
+    }
+  }
+
+  e_EndTransaction();
+
+  return changed;
+}
+
+void weq_TilesChanged( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || query_map != map ||
+       !e_ClipRect( map, &rect ) )
+  {
+    return;
+  }
+
+  int slot = ( rect.world_index * map->region_width * map->region_height ) +
+    rect.region_index;
+  RegionMask_t* mask = &query_masks[slot];
+  if ( !mask->valid ) return;
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      GameTile_t* column = e_RectColumn( map, rect, x, z );
+
+      for ( int y = 0; y < rect.h; y++ )
+      {
+        weq_MaskAdd( mask, &column[y] );
+      }
+    }
+  }
+}
+
+void weq_ResetQuery( void )
+{
+  // a job of the last query may still be scanning
+  g_WaitJobs();
+
+  free( query_masks );
+  free( query_hits );
+
+  query_masks   = NULL;
+  query_hits    = NULL;
+  query_map     = NULL;
+  query_regions = 0;
+}
+
+static int weq_Setup( World_t* map )
+{
+  if ( query_map == map ) return 1;
+
+  weq_ResetQuery();
+
+  int regions = map->world_width * map->world_height * map->region_width *
+    map->region_height;
+
+  query_masks = ( RegionMask_t* )calloc( regions, sizeof( RegionMask_t ) );
+  query_hits  = ( QueryHit_t* )calloc( regions, sizeof( QueryHit_t ) );
+  if ( query_masks == NULL || query_hits == NULL )
+  {
+    printf( "Failed to allocate memory for query masks\n" );
+    free( query_masks );
+    free( query_hits );
+    query_masks = NULL;
+    query_hits  = NULL;
+    return 0;
+  }
+
+  query_map     = map;
+  query_regions = regions;
+
+  return 1;
+}
+
+static int weq_Run( World_t* map, TileQuery_t* q, int world_index,
+                    int region_index )
+{
+  if ( map == NULL || q == NULL || !weq_Setup( map ) ) return 0;
+
+  query = *q;
+  query_region = region_index;
+
+  weq_Range( fg_ok, query.fg_min, query.fg_max );
+  weq_Range( bg_ok, query.bg_min, query.bg_max );
+  weq_Range( elevation_ok, query.elevation_min, query.elevation_max );
+  weq_Range( temperature_ok, query.temperature_min, query.temperature_max );
+  passable_ok[0] = ( query.passable != 1 );
+  passable_ok[1] = ( query.passable != 0 );
+
+  memset( query_hits, 0, sizeof( QueryHit_t ) * query_regions );
+
+  for ( int i = 0; i < map->world_width * map->world_height; i++ )
+  {
+    if ( world_index >= 0 && i != world_index ) continue;
+
+    g_PushJob( weq_ScanCell, ( void* )( intptr_t )i );
+  }
+
+  g_WaitJobs();
+
+  return 1;
+}
+
+static void weq_Range( uint8_t* table, int min, int max )
+{
+  for ( int i = 0; i < 256; i++ )
+  {
+    table[i] = ( i >= min && i <= max );
+  }
+}
+
+static int weq_Match( GameTile_t* tile )
+{
+  return ( query.glyph < 0 || tile->glyph == query.glyph ) &
+    fg_ok[tile->fg] & bg_ok[tile->bg] & elevation_ok[tile->elevation] &
+    temperature_ok[tile->temperature] & passable_ok[tile->is_passable != 0];
+}
+
+static int weq_MaskMatches( RegionMask_t* mask )
+{
+  if ( query.glyph >= 0 )
+  {
+    int bit = query.glyph % GAME_MAX_GLYPHS;
+    if ( !( mask->glyphs[bit >> 3] & ( 1u << ( bit & 7 ) ) ) ) return 0;
+  }
+
+  if ( mask->elevation_max < query.elevation_min ||
+       mask->elevation_min > query.elevation_max ||
+       mask->temperature_max < query.temperature_min ||
+       mask->temperature_min > query.temperature_max )
+  {
+    return 0;
+  }
+
+  if ( query.passable == 1 && !mask->any_passable ) return 0;
+  if ( query.passable == 0 && !mask->any_blocked )  return 0;
+
+  int fg = 0, bg = 0;
+
+  for ( int i = 0; i < 256 && !( fg && bg ); i++ )
+  {
+    if ( fg_ok[i] && ( mask->fg[i >> 3] & ( 1u << ( i & 7 ) ) ) ) fg = 1;
+    if ( bg_ok[i] && ( mask->bg[i >> 3] & ( 1u << ( i & 7 ) ) ) ) bg = 1;
+  }
+
+  return ( fg && bg );
+}
+
+static void weq_MaskAdd( RegionMask_t* mask, GameTile_t* tile )
+{
+  int bit = tile->glyph % GAME_MAX_GLYPHS;
+
+  mask->glyphs[bit >> 3]  |= ( 1u << ( bit & 7 ) );
+  mask->fg[tile->fg >> 3] |= ( 1u << ( tile->fg & 7 ) );
+  mask->bg[tile->bg >> 3] |= ( 1u << ( tile->bg & 7 ) );
+
+  if ( tile->elevation < mask->elevation_min )
+  {
+    mask->elevation_min = tile->elevation;
+  }
+
+  if ( tile->elevation > mask->elevation_max )
+  {
+    mask->elevation_max = tile->elevation;
+  }
+
+  if ( tile->temperature < mask->temperature_min )
+  {
+    mask->temperature_min = tile->temperature;
+  }
+
+  if ( tile->temperature > mask->temperature_max )
+  {
+    mask->temperature_max = tile->temperature;
+  }
+
+  mask->any_passable |= ( tile->is_passable != 0 );
+  mask->any_blocked  |= ( tile->is_passable == 0 );
+}
+
+static void weq_ScanRegion( World_t* map, int world_index, int region_index )
+{
+  int slot = ( world_index * map->region_width * map->region_height ) +
+    region_index;
+  RegionMask_t* mask = &query_masks[slot];
+  QueryHit_t* hit = &query_hits[slot];
+
+  if ( mask->valid && !weq_MaskMatches( mask ) ) return;
+
+  int lh = map->local_height;
+  int plane = map->local_width * lh;
+  GameTile_t* tiles = map[world_index].regions[region_index].tiles;
+  RegionMask_t scanned = { .valid = 1, .elevation_min = 255,
+    .temperature_min = 255 };
+  uint8_t matches[UINT8_MAX + 1];
+
+  for ( int z = 0; z < map->z_height; z++ )
+  {
+    for ( int x = 0; x < map->local_width; x++ )
+    {
+      int base = ( z * plane ) + ( x * lh );
+      GameTile_t* column = &tiles[base];
+      int n = 0;
+
+      for ( int y = 0; y < lh; y++ )
+      {
+        matches[y] = weq_Match( &column[y] );
+        n += matches[y];
+      }
+
+      for ( int y = 0; y < lh; y++ )
+      {
+        weq_MaskAdd( &scanned, &column[y] );
+      }
+
+      if ( n == 0 ) continue;
+
+      int lo = 0, hi = lh - 1;
+      while ( !matches[lo] ) lo++;
+      while ( !matches[hi] ) hi--;
+
+      if ( hit->count == 0 )
+      {
+        hit->first = base + lo;
+        hit->min_x = hit->max_x = x;
+        hit->min_y = lo;
+        hit->max_y = hi;
+        hit->min_z = hit->max_z = z;
+      }
+
+      if ( x < hit->min_x )  hit->min_x = x;
+      if ( x > hit->max_x )  hit->max_x = x;
+      if ( lo < hit->min_y ) hit->min_y = lo;
+      if ( hi > hit->max_y ) hit->max_y = hi;
+      hit->max_z = z;
+      hit->count += n;
+    }
+  }
+
+  *mask = scanned;
+}
+
+static void weq_ScanCell( void* data )
+{
+  int world_index = ( int )( intptr_t )data;
+  World_t* map = query_map;
+
+  if ( map[world_index].regions == NULL ) return;
+
+  for ( int i = 0; i < map->region_width * map->region_height; i++ )
+  {
+    if ( query_region >= 0 && i != query_region ) continue;
+
+    weq_ScanRegion( map, world_index, i );
+  }
+}
+
@@ -0,0 +1,301 @@
+/*
+ * world_editor/rect.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * Box edits work column by column, the h tiles of a column are contiguous
+ * on every level since indexes are x * height + y. On the local level that
+ * makes a column one memcpy, world and region tiles are a field of a bigger
+ * struct so those step by e_TileStride().
+ */
+
+static int wer_SameStorage( TileRect_t a, TileRect_t b );
+
+TileRect_t e_SelectRect( World_t* map, WorldPosition_t pos,
+                         WorldPosition_t highlight )
+{
+  TileRect_t rect = { .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .z = pos.local_z, .d = 1 };
+
+  rect.x = pos.x < highlight.x ? pos.x : highlight.x;
+  rect.y = pos.y < highlight.y ? pos.y : highlight.y;
+  rect.w = abs( highlight.x - pos.x ) + 1;
+  rect.h = abs( highlight.y - pos.y ) + 1;
+
+  if ( map == NULL || !e_ClipRect( map, &rect ) )
+  {
+    rect.w = rect.h = rect.d = 0;
+  }
+
+  return rect;
+}
+
+/*
+ * Keep the box inside its level, boxes outside of the local level are
+ * always one tile deep
+ */
+int e_ClipRect( World_t* map, TileRect_t* rect )
+{
+  int width = 0, height = 0, depth = 1;
+
+  switch ( rect->level )
+  {
+    case WORLD_LEVEL:
+      width  = map->world_width;
+      height = map->world_height;
+      break;
+
+    case REGION_LEVEL:
+      if ( map[rect->world_index].regions == NULL ) return 0;
+      width  = map->region_width;
+      height = map->region_height;
+      break;
+
+    case LOCAL_LEVEL:
+      if ( map[rect->world_index].regions == NULL ) return 0;
+      width  = map->local_width;
+      height = map->local_height;
+      depth  = map->z_height;
+      break;
+
+    default:
+      return 0;
+  }
+
+  if ( rect->level != LOCAL_LEVEL )
+  {
+    rect->z = 0;
+    rect->d = 1;
+  }
+
+  if ( rect->x >= width || rect->y >= height || rect->z >= depth ) return 0;
+
+  if ( rect->x + rect->w > width )  rect->w = width  - rect->x;
+  if ( rect->y + rect->h > height ) rect->h = height - rect->y;
+  if ( rect->z + rect->d > depth )  rect->d = depth  - rect->z;
+
+  return ( rect->w > 0 && rect->h > 0 && rect->d > 0 );
+}
+
+GameTile_t* e_RectColumn( World_t* map, TileRect_t rect, int x, int z )
+{
+  switch ( rect.level )
+  {
+    case WORLD_LEVEL:
+      return &map[INDEX_2( x, rect.y, map->world_height )].tile;
+
+    case REGION_LEVEL:
+      return &map[rect.world_index].regions[INDEX_2( x, rect.y,
+                                                     map->region_height )].tile;
+
+    case LOCAL_LEVEL:
+      return &map[rect.world_index].regions[rect.region_index].tiles[
+        ( z * map->local_width * map->local_height ) +
+        INDEX_2( x, rect.y, map->local_height )];
+  }
+
+  return NULL;
+}
+
+size_t e_TileStride( uint8_t level )
+{
+  switch ( level )
+  {
+    case WORLD_LEVEL:
+      return sizeof( World_t );
+
+    case REGION_LEVEL:
+      return sizeof( RegionCell_t );
+
+    default:
+      return sizeof( GameTile_t );
+  }
+}
+
+/*
+ * Field by field, the padding of GameTile_t is not reliably zeroed
+ */
+int e_SameTile( GameTile_t* a, GameTile_t* b )
+{
+  return ( a->glyph == b->glyph && a->temperature == b->temperature &&
+           a->elevation == b->elevation && a->is_passable == b->is_passable &&
+           a->fg == b->fg && a->bg == b->bg );
+}
+
+void e_FillRect( World_t* map, TileRect_t rect, int glyph, int bg, int fg )
+{
+  if ( map == NULL || !e_ClipRect( map, &rect ) ) return;
+
+  size_t stride = e_TileStride( rect.level );
+
+  e_TilesWillChange( map, rect );
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      uint8_t* tile = ( uint8_t* )e_RectColumn( map, rect, x, z );
+
+      for ( int y = 0; y < rect.h; y++, tile += stride )
+      {
+        ( ( GameTile_t* )tile )->glyph = glyph;
+        ( ( GameTile_t* )tile )->bg    = bg;
+        ( ( GameTile_t* )tile )->fg    = fg;
+      }
+    }
+  }
+
+  e_TilesChanged( map, rect );
+}
+
+void e_ReplaceRect( World_t* map, TileRect_t rect, GameTile_t match,
+                    int glyph, int bg, int fg )
+{
+  if ( map == NULL || !e_ClipRect( map, &rect ) ) return;
+
+  size_t stride = e_TileStride( rect.level );
+
+  e_TilesWillChange( map, rect );
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      uint8_t* tile = ( uint8_t* )e_RectColumn( map, rect, x, z );
+
+      for ( int y = 0; y < rect.h; y++, tile += stride )
+      {
+        GameTile_t* current = ( GameTile_t* )tile;
+
+        if ( current->glyph == match.glyph && current->fg == match.fg &&
+             current->bg == match.bg )
+        {
+          current->glyph = glyph;
+          current->bg    = bg;
+          current->fg    = fg;
+        }
+      }
+    }
+  }
+
+  e_TilesChanged( map, rect );
+}
+
+int e_CopyRect( World_t* map, TileRect_t rect, GameTile_t* out )
+{
+  if ( map == NULL || !e_ClipRect( map, &rect ) ) return 0;
+
+  size_t stride = e_TileStride( rect.level );
+  int k = 0;
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      uint8_t* tile = ( uint8_t* )e_RectColumn( map, rect, x, z );
+
+      if ( stride == sizeof( GameTile_t ) )
+      {
+        memcpy( &out[k], tile, sizeof( GameTile_t ) * rect.h );
+        k += rect.h;
+        continue;
+      }
+
+      for ( int y = 0; y < rect.h; y++, tile += stride )
+      {
+        out[k++] = *( GameTile_t* )tile;
+      }
+    }
+  }
+
+  return k;
+}
+
+void e_PasteRect( World_t* map, TileRect_t src, WorldPosition_t pos )
+{
+  if ( map == NULL || !e_ClipRect( map, &src ) ) return;
+
+  TileRect_t dst = { .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .x = pos.x, .y = pos.y,
+    .z = pos.local_z, .w = src.w, .h = src.h, .d = src.d };
+
+  if ( !e_ClipRect( map, &dst ) ) return;
+
+  size_t src_stride = e_TileStride( src.level );
+  size_t dst_stride = e_TileStride( dst.level );
+
+  // a box pasted over itself is copied from the far end, like memmove
+  int step_x = 1, step_z = 1;
+  if ( wer_SameStorage( src, dst ) )
+  {
+    if ( dst.x > src.x ) step_x = -1;
+    if ( dst.z > src.z ) step_z = -1;
+  }
+
+  e_TilesWillChange( map, dst );
+
+  for ( int k = 0; k < dst.d; k++ )
+  {
+    int i_z = step_z > 0 ? k : dst.d - 1 - k;
+
+    for ( int j = 0; j < dst.w; j++ )
+    {
+      int i_x = step_x > 0 ? j : dst.w - 1 - j;
+      uint8_t* from = ( uint8_t* )e_RectColumn( map, src, src.x + i_x,
+                                                src.z + i_z );
+      uint8_t* to   = ( uint8_t* )e_RectColumn( map, dst, dst.x + i_x,
+                                                dst.z + i_z );
+
+      if ( src_stride == sizeof( GameTile_t ) &&
+           dst_stride == sizeof( GameTile_t ) )
+      {
+        memmove( to, from, sizeof( GameTile_t ) * dst.h );
+        continue;
+      }
+
+      if ( to > from )
+      {
+        for ( int y = dst.h - 1; y >= 0; y-- )
+        {
+          *( GameTile_t* )( to + y * dst_stride ) =
+            *( GameTile_t* )( from + y * src_stride );
+        }
+      }
+
+      else
+      {
+        for ( int y = 0; y < dst.h; y++ )
+        {
+          *( GameTile_t* )( to + y * dst_stride ) =
+            *( GameTile_t* )( from + y * src_stride );
+        }
+      }
+    }
+  }
+
+  e_TilesChanged( map, dst );
+}
+
+static int wer_SameStorage( TileRect_t a, TileRect_t b )
+{
+  if ( a.level != b.level ) return 0;
+  if ( a.level == WORLD_LEVEL ) return 1;
+  if ( a.world_index != b.world_index ) return 0;
+
+  return ( a.level == REGION_LEVEL || a.region_index == b.region_index );
+}
+
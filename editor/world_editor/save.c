@@ -12,6 +12,7 @@
 #include "Archimedes.h"
 #include "editor.h"
 #include "save_editor.h"
+#include "text_cache.h"
 #include "world_editor.h"
 
 static void wes_SaveLogic( float dt );
@@ -48,7 +49,7 @@ void we_Save( void )
 
 static void wes_SaveLogic( float dt )
 {
-  a_DoInput();
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
 
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
@@ -61,8 +62,8 @@ static void wes_SaveLogic( float dt )
 
 static void wes_SaveDraw( float dt )
 {
-  a_DrawText( "Save?", 635, 270, 255, 255, 255, app.font_type,
-             TEXT_ALIGN_CENTER, 0 );
+  g_DrawCachedText( "Save?", 635, 270, white, app.font_type,
+                    TEXT_ALIGN_CENTER );
 
   a_DrawWidgets();
 }
@@ -71,7 +72,7 @@ void wes_SaveYes( void )
 {
   if ( map != NULL )
   {
-    SaveWorld( map, "resources/world/map.dat" );
+    PROF_ZONE( "save_world" ) SaveWorld( map, "resources/world/map.dat" );
   }
 
   e_InitEditor();
@@ -0,0 +1,492 @@
+/*
+ * world_editor/summary.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "glyphs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+#define SUMMARY_MIN_BINS 64
+
+/*
+ * One summary per region and one per world cell, the cell is the sum of its
+ * regions. A whole world cell is counted the first time anything asks for
+ * it or writes into it, from then on writes take the old tiles of their box
+ * out and put the new ones in. A bin that drops to 0 keeps its slot until
+ * the table grows.
+ */
+static TileSummary_t* region_summaries = NULL;
+static TileSummary_t* cell_summaries = NULL;
+static World_t* summary_map = NULL;
+static int summary_cells = 0;
+static int summary_regions = 0;
+
+static int wea_Setup( World_t* map );
+static TileSummary_t* wea_Cell( World_t* map, int world_index );
+static SummaryBin_t* wea_Bin( TileSummary_t* summary, uint64_t key );
+static void wea_Add( TileSummary_t* summary, int kind, uint32_t value,
+                     int delta );
+static void wea_Tally( TileSummary_t* summary, GameTile_t* tile, int delta );
+static GameTile_t* wea_Surface( World_t* map, GameTile_t* tiles, int index );
+static void wea_TallySurface( TileSummary_t* summary, GameTile_t* tile,
+                              int delta );
+static void wea_Merge( TileSummary_t* into, TileSummary_t* from );
+static void wea_TallyRect( World_t* map, TileRect_t rect, int delta );
+
+TileSummary_t* e_RegionSummary( World_t* map, int world_index,
+                                int region_index )
+{
+  if ( wea_Cell( map, world_index ) == NULL ) return NULL;
+
+  int slot = ( world_index * map->region_width * map->region_height ) +
+    region_index;
+
+  return &region_summaries[slot];
+}
+
+TileSummary_t* e_WorldCellSummary( World_t* map, int world_index )
+{
+  return wea_Cell( map, world_index );
+}
+
+uint32_t e_SummaryCount( TileSummary_t* summary, int kind, uint32_t value )
+{
+  if ( summary == NULL || summary->bins == NULL ) return 0;
+
+  uint64_t key = ( ( uint64_t )kind << 32 ) | value;
+  SummaryBin_t* bin = wea_Bin( summary, key );
+
+  return bin->key == key ? bin->count : 0;
+}
+
+/*
+ * The value with the highest count, ties go to the lowest value so the
+ * result does not depend on the table layout
+ */
+int e_SummaryMode( TileSummary_t* summary, int kind, uint32_t* value )
+{
+  if ( summary == NULL || summary->bins == NULL ) return 0;
+
+  uint32_t best = 0;
+  uint64_t best_key = 0;
+
+  for ( int i = 0; i < summary->num_bins; i++ )
+  {
+    SummaryBin_t* bin = &summary->bins[i];
+
+    if ( ( bin->key >> 32 ) != ( uint64_t )kind || bin->count == 0 ) continue;
+
+    if ( bin->count > best || ( bin->count == best && bin->key < best_key ) )
+    {
+      best = bin->count;
+      best_key = bin->key;
+    }
+  }
+
+  if ( best == 0 ) return 0;
+
+  *value = ( uint32_t )best_key;
+
+  return 1;
+}
+
+int e_SummaryRange( TileSummary_t* summary, int kind, uint32_t* min,
+                    uint32_t* max )
+{
+  if ( summary == NULL || summary->bins == NULL ) return 0;
+
+  int found = 0;
+
+  for ( int i = 0; i < summary->num_bins; i++ )
+  {
+    SummaryBin_t* bin = &summary->bins[i];
+
+    if ( ( bin->key >> 32 ) != ( uint64_t )kind || bin->count == 0 ) continue;
+
+    uint32_t value = ( uint32_t )bin->key;
+
+    if ( !found || value < *min ) *min = value;
+    if ( !found || value > *max ) *max = value;
+    found = 1;
+  }
+
+  return found;
+}
+
+void wea_TilesWillChange( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || !e_ClipRect( map, &rect ) ) return;
+
+  // count the cell as it is before the write, then take the box out
+  if ( wea_Cell( map, rect.world_index ) == NULL ) return;
+
+  wea_TallyRect( map, rect, -1 );
+}
+
+void wea_TilesChanged( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || summary_map != map ||
+       !e_ClipRect( map, &rect ) )
+  {
+    return;
+  }
+
+  TileSummary_t* cell = &cell_summaries[rect.world_index];
+  if ( cell->bins == NULL ) return;
+
+  int slot = ( rect.world_index * map->region_width * map->region_height ) +
+    rect.region_index;
+
+  wea_TallyRect( map, rect, 1 );
+
+  wea_DeriveTile( &region_summaries[slot],
+                  &map[rect.world_index].regions[rect.region_index].tile );
+  wea_DeriveTile( cell, &map[rect.world_index].tile );
+}
+
+void wea_ResetSummaries( void )
+{
+  for ( int i = 0; i < summary_regions; i++ )
+  {
+    free( region_summaries[i].bins );
+  }
+
+  for ( int i = 0; i < summary_cells; i++ )
+  {
+    free( cell_summaries[i].bins );
+  }
+
+  free( region_summaries );
+  free( cell_summaries );
+
+  region_summaries = NULL;
+  cell_summaries   = NULL;
+  summary_map      = NULL;
+  summary_cells    = 0;
+  summary_regions  = 0;
+}
+
+/*
+ * Only what wea_DeriveTile() reads is counted, the totals and the surface,
+ * so a summary can be built cheaply while the column is being written
+ */
+void wea_CountColumn( World_t* map, TileSummary_t* summary,
+                      GameTile_t* column )
+{
+  if ( summary->bins == NULL ) return;
+
+  int plane = map->local_width * map->local_height;
+
+  for ( int z = 0; z < map->z_height; z++ )
+  {
+    GameTile_t* tile = &column[z * plane];
+
+    summary->count++;
+    summary->passable        += tile->is_passable ? 1 : 0;
+    summary->sum_elevation   += tile->elevation;
+    summary->sum_temperature += tile->temperature;
+  }
+
+  wea_TallySurface( summary, wea_Surface( map, column, 0 ), 1 );
+}
+
+static int wea_Setup( World_t* map )
+{
+  if ( summary_map == map ) return 1;
+
+  wea_ResetSummaries();
+
+  int cells   = map->world_width * map->world_height;
+  int regions = cells * map->region_width * map->region_height;
+
+  region_summaries = ( TileSummary_t* )calloc( regions,
+                                               sizeof( TileSummary_t ) );
+  cell_summaries   = ( TileSummary_t* )calloc( cells,
+                                               sizeof( TileSummary_t ) );
+  if ( region_summaries == NULL || cell_summaries == NULL )
+  {
+    printf( "Failed to allocate memory for summaries\n" );
+    free( region_summaries );
+    free( cell_summaries );
+    region_summaries = NULL;
+    cell_summaries   = NULL;
+    return 0;
+  }
+
+  summary_map     = map;
+  summary_cells   = cells;
+  summary_regions = regions;
+
+  return 1;
+}
+
+/*
+ * The summary of a world cell, counting every region of it the first time
+ */
+static TileSummary_t* wea_Cell( World_t* map, int world_index )
+{
+  if ( map == NULL || map[world_index].regions == NULL ) return NULL;
+  if ( !wea_Setup( map ) ) return NULL;
+
+  TileSummary_t* cell = &cell_summaries[world_index];
+  if ( cell->bins != NULL ) return cell;
+
+  int num_regions = map->region_width * map->region_height;
+  int plane = map->local_width * map->local_height;
+  TileSummary_t* regions = &region_summaries[world_index * num_regions];
+
+  if ( !wea_InitSummary( cell ) ) return NULL;
+
+  for ( int i = 0; i < num_regions; i++ )
+  {
+    GameTile_t* tiles = map[world_index].regions[i].tiles;
+
+    if ( !wea_InitSummary( &regions[i] ) )
+    {
+      for ( int j = 0; j < i; j++ )
+      {
+        free( regions[j].bins );
+        regions[j] = ( TileSummary_t ){ 0 };
+      }
+
+      free( cell->bins );
+      *cell = ( TileSummary_t ){ 0 };
+      return NULL;
+    }
+
+    for ( int k = 0; k < plane * map->z_height; k++ )
+    {
+      wea_Tally( &regions[i], &tiles[k], 1 );
+    }
+
+    for ( int k = 0; k < plane; k++ )
+    {
+      wea_TallySurface( &regions[i], wea_Surface( map, tiles, k ), 1 );
+    }
+
+    wea_Merge( cell, &regions[i] );
+  }
+
+  return cell;
+}
+
+int wea_InitSummary( TileSummary_t* summary )
+{
+  *summary = ( TileSummary_t ){ 0 };
+
+  summary->bins = ( SummaryBin_t* )calloc( SUMMARY_MIN_BINS,
+                                           sizeof( SummaryBin_t ) );
+  if ( summary->bins == NULL )
+  {
+    printf( "Failed to allocate memory for summary bins\n" );
+    return 0;
+  }
+
+  summary->num_bins = SUMMARY_MIN_BINS;
+
+  return 1;
+}
+
+/*
+ * The slot holding key, or the empty slot it would go in
+ */
+static SummaryBin_t* wea_Bin( TileSummary_t* summary, uint64_t key )
+{
+  uint32_t mask = summary->num_bins - 1;
+  uint32_t slot = ( uint32_t )( ( key * 0x9e3779b97f4a7c15ull ) >> 32 ) & mask;
+
+  while ( summary->bins[slot].key != 0 && summary->bins[slot].key != key )
+  {
+    slot = ( slot + 1 ) & mask;
+  }
+
+  return &summary->bins[slot];
+}
+
+static void wea_Add( TileSummary_t* summary, int kind, uint32_t value,
+                     int delta )
+{
+  uint64_t key = ( ( uint64_t )kind << 32 ) | value;
+  SummaryBin_t* bin = wea_Bin( summary, key );
+
+  if ( bin->key == 0 )
+  {
+    // keep the table at most half full, bins at 0 are dropped on the way
+    if ( ( summary->used_bins + 1 ) * 2 > summary->num_bins )
+    {
+      SummaryBin_t* old = summary->bins;
+      int old_size = summary->num_bins;
+      int live = 0;
+
+      for ( int i = 0; i < old_size; i++ )
+      {
+        if ( old[i].count > 0 ) live++;
+      }
+
+      int size = SUMMARY_MIN_BINS;
+      while ( size < ( live + 1 ) * 4 ) size <<= 1;
+
+      SummaryBin_t* bins = ( SummaryBin_t* )calloc( size,
+                                                    sizeof( SummaryBin_t ) );
+      if ( bins == NULL )
+      {
+        printf( "Failed to allocate memory for summary bins\n" );
+        return;
+      }
+
+      summary->bins = bins;
+      summary->num_bins = size;
+      summary->used_bins = live;
+
+      for ( int i = 0; i < old_size; i++ )
+      {
+        if ( old[i].count > 0 )
+        {
+          *wea_Bin( summary, old[i].key ) = old[i];
+        }
+      }
+
+      free( old );
+      bin = wea_Bin( summary, key );
+    }
+
+    bin->key = key;
+    summary->used_bins++;
+  }
+
+  bin->count += delta;
+}
+
+static void wea_Tally( TileSummary_t* summary, GameTile_t* tile, int delta )
+{
+  wea_Add( summary, SUMMARY_GLYPH,       tile->glyph,       delta );
+  wea_Add( summary, SUMMARY_FG,          tile->fg,          delta );
+  wea_Add( summary, SUMMARY_BG,          tile->bg,          delta );
+  wea_Add( summary, SUMMARY_ELEVATION,   tile->elevation,   delta );
+  wea_Add( summary, SUMMARY_TEMPERATURE, tile->temperature, delta );
+
+  summary->count           += delta;
+  summary->passable        += tile->is_passable ? delta : 0;
+  summary->sum_elevation   += ( int64_t )tile->elevation * delta;
+  summary->sum_temperature += ( int64_t )tile->temperature * delta;
+}
+
+/*
+ * The top non-empty tile of column `index`, what the overview shows
+ */
+static GameTile_t* wea_Surface( World_t* map, GameTile_t* tiles, int index )
+{
+  int plane = map->local_width * map->local_height;
+
+  for ( int z = map->z_height - 1; z >= 0; z-- )
+  {
+    GameTile_t* tile = &tiles[( z * plane ) + index];
+    if ( tile->glyph != GLYPH_SPACE ) return tile;
+  }
+
+  return NULL;
+}
+
+static void wea_TallySurface( TileSummary_t* summary, GameTile_t* tile,
+                              int delta )
+{
+  if ( tile == NULL ) return;
+
+  wea_Add( summary, SUMMARY_SURFACE,
+           ( ( uint32_t )tile->glyph << 16 ) | ( tile->fg << 8 ) | tile->bg,
+           delta );
+  summary->columns += delta;
+}
+
+static void wea_Merge( TileSummary_t* into, TileSummary_t* from )
+{
+  for ( int i = 0; i < from->num_bins; i++ )
+  {
+    SummaryBin_t* bin = &from->bins[i];
+    if ( bin->count == 0 ) continue;
+
+    wea_Add( into, bin->key >> 32, ( uint32_t )bin->key, bin->count );
+  }
+
+  into->count           += from->count;
+  into->passable        += from->passable;
+  into->columns         += from->columns;
+  into->sum_elevation   += from->sum_elevation;
+  into->sum_temperature += from->sum_temperature;
+}
+
+/*
+ * Every tile of the box, and the surface of every column it touches since a
+ * write at any z can uncover or bury the top tile
+ */
+static void wea_TallyRect( World_t* map, TileRect_t rect, int delta )
+{
+  int slot = ( rect.world_index * map->region_width * map->region_height ) +
+    rect.region_index;
+  TileSummary_t* region = &region_summaries[slot];
+  TileSummary_t* cell = &cell_summaries[rect.world_index];
+  GameTile_t* tiles = map[rect.world_index].regions[rect.region_index].tiles;
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      GameTile_t* column = e_RectColumn( map, rect, x, z );
+
+      for ( int y = 0; y < rect.h; y++ )
+      {
+        wea_Tally( region, &column[y], delta );
+        wea_Tally( cell, &column[y], delta );
+      }
+    }
+  }
+
+  for ( int x = rect.x; x < rect.x + rect.w; x++ )
+  {
+    for ( int y = rect.y; y < rect.y + rect.h; y++ )
+    {
+      GameTile_t* top = wea_Surface( map, tiles,
+                                     INDEX_2( x, y, map->local_height ) );
+
+      wea_TallySurface( region, top, delta );
+      wea_TallySurface( cell, top, delta );
+    }
+  }
+}
+
+/*
+ * The one rule for region and world cell tiles, used by edits and by
+ * generation alike: the most common surface, the rounded mean elevation and
+ * temperature and passable if at least half the tiles are
+ */
+void wea_DeriveTile( TileSummary_t* summary, GameTile_t* tile )
+{
+  uint32_t surface;
+
+  if ( summary->count == 0 ) return;
+
+  if ( e_SummaryMode( summary, SUMMARY_SURFACE, &surface ) )
+  {
+    tile->glyph = surface >> 16;
+    tile->fg    = ( surface >> 8 ) & 0xFF;
+    tile->bg    = surface & 0xFF;
+  }
+
+  tile->elevation   = ( summary->sum_elevation + ( summary->count / 2 ) ) /
+    summary->count;
+  tile->temperature = ( summary->sum_temperature + ( summary->count / 2 ) ) /
+    summary->count;
+  tile->is_passable = ( summary->passable * 2 >= summary->count );
+}
+
@@ -0,0 +1,349 @@
+/*
+ * world_editor/thumbnail.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "glyphs.h"
+#include "jobs.h"
+#include "structs.h"
+#include "world_editor.h"
+
+enum
+{
+  THUMB_MISSING,
+  THUMB_BUILDING,
+  THUMB_READY
+};
+
+/*
+ * One palette index per local column, laid out world cell by world cell
+ * and region by region, the same order as the thumbnail section of the
+ * world file. Every world cell is built by one job and uploaded into one
+ * texture that is region_width * local_width wide, so the world view draws
+ * a cell with one copy and the region view with a sub rect of it.
+ */
+static World_t* thumb_map = NULL;
+static int thumb_cells   = 0;
+static int thumb_regions = 0;
+static int thumb_plane   = 0;
+
+static uint8_t* thumb_pixels = NULL;
+static SDL_atomic_t* thumb_state = NULL;
+static SDL_atomic_t* thumb_dirty = NULL;
+static uint8_t* thumb_stale = NULL;
+static SDL_Texture** thumb_textures = NULL;
+
+static int wet_Setup( World_t* map );
+static uint8_t wet_ColumnColor( GameTile_t* tiles, int plane, int z_height,
+                                int index );
+static void wet_BuildCell( World_t* map, int world_index, uint8_t* out );
+static void wet_BuildJob( void* data );
+static void wet_Queue( int world_index );
+static int wet_Upload( World_t* map, int world_index );
+
+void wet_ResetThumbnails( void )
+{
+  // a worker may still be writing into thumb_pixels
+  g_WaitJobs();
+
+  if ( thumb_textures != NULL )
+  {
+    for ( int i = 0; i < thumb_cells; i++ )
+    {
+      if ( thumb_textures[i] != NULL )
+      {
+        SDL_DestroyTexture( thumb_textures[i] );
+      }
+    }
+  }
+
+  free( thumb_pixels );
+  free( thumb_state );
+  free( thumb_dirty );
+  free( thumb_stale );
+  free( thumb_textures );
+
+  thumb_pixels   = NULL;
+  thumb_state    = NULL;
+  thumb_dirty    = NULL;
+  thumb_stale    = NULL;
+  thumb_textures = NULL;
+  thumb_map      = NULL;
+  thumb_cells    = 0;
+  thumb_regions  = 0;
+  thumb_plane    = 0;
+}
+
+void wet_AdoptThumbnails( World_t* map, uint8_t* pixels )
+{
+  if ( !wet_Setup( map ) )
+  {
+    free( pixels );
+    return;
+  }
+
+  free( thumb_pixels );
+  thumb_pixels = pixels;
+
+  for ( int i = 0; i < thumb_cells; i++ )
+  {
+    SDL_AtomicSet( &thumb_state[i], THUMB_READY );
+    SDL_AtomicSet( &thumb_dirty[i], 1 );
+  }
+}
+
+void wet_QueueThumbnails( World_t* map )
+{
+  if ( !wet_Setup( map ) ) return;
+
+  for ( int i = 0; i < thumb_cells; i++ )
+  {
+    if ( map[i].regions != NULL &&
+         SDL_AtomicGet( &thumb_state[i] ) == THUMB_MISSING )
+    {
+      wet_Queue( i );
+    }
+  }
+}
+
+void wet_TilesChanged( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || thumb_map != map ) return;
+
+  int state = SDL_AtomicGet( &thumb_state[rect.world_index] );
+  if ( state == THUMB_MISSING ) return;
+
+  // the job may already have read these columns, build the cell again
+  // once it is done
+  if ( state == THUMB_BUILDING )
+  {
+    thumb_stale[rect.world_index] = 1;
+    return;
+  }
+
+  GameTile_t* tiles = map[rect.world_index].regions[rect.region_index].tiles;
+  uint8_t* out = thumb_pixels + ( ( ( rect.world_index * thumb_regions ) +
+                                    rect.region_index ) * thumb_plane );
+
+  for ( int x = rect.x; x < rect.x + rect.w && x < map->local_width; x++ )
+  {
+    for ( int y = rect.y; y < rect.y + rect.h && y < map->local_height; y++ )
+    {
+      int index = INDEX_2( x, y, map->local_height );
+      out[index] = wet_ColumnColor( tiles, thumb_plane, map->z_height, index );
+    }
+  }
+
+  SDL_AtomicSet( &thumb_dirty[rect.world_index], 1 );
+}
+
+void wet_CopyThumbnail( World_t* map, int world_index, uint8_t* out )
+{
+  int size = map->region_width * map->region_height * map->local_width *
+    map->local_height;
+
+  if ( thumb_map == map && !thumb_stale[world_index] &&
+       SDL_AtomicGet( &thumb_state[world_index] ) == THUMB_READY )
+  {
+    memcpy( out, thumb_pixels + ( world_index * size ), size );
+    return;
+  }
+
+  wet_BuildCell( map, world_index, out );
+}
+
+int wet_DrawThumbnail( World_t* map, WorldPosition_t pos, int index,
+                       int x, int y, int w, int h )
+{
+  int world_index = ( pos.level == WORLD_LEVEL ) ? index : pos.world_index;
+
+  if ( thumb_map != map || !wet_Upload( map, world_index ) ) return 0;
+
+  SDL_Rect dest = { x, y, w, h };
+
+  if ( pos.level == WORLD_LEVEL )
+  {
+    SDL_RenderCopy( app.renderer, thumb_textures[world_index], NULL, &dest );
+  }
+
+  else
+  {
+    SDL_Rect src = { ( index / map->region_height ) * map->local_width,
+                     ( index % map->region_height ) * map->local_height,
+                     map->local_width, map->local_height };
+
+    SDL_RenderCopy( app.renderer, thumb_textures[world_index], &src, &dest );
+  }
+
+  return 1;
+}
+
+static int wet_Setup( World_t* map )
+{
+  if ( thumb_map == map ) return 1;
+
+  wet_ResetThumbnails();
+
+  thumb_cells   = map->world_width * map->world_height;
+  thumb_regions = map->region_width * map->region_height;
+  thumb_plane   = map->local_width * map->local_height;
+
+  thumb_pixels   = calloc( thumb_cells * thumb_regions, thumb_plane );
+  thumb_state    = calloc( thumb_cells, sizeof( SDL_atomic_t ) );
+  thumb_dirty    = calloc( thumb_cells, sizeof( SDL_atomic_t ) );
+  thumb_stale    = calloc( thumb_cells, sizeof( uint8_t ) );
+  thumb_textures = calloc( thumb_cells, sizeof( SDL_Texture* ) );
+
+  if ( thumb_pixels == NULL || thumb_state == NULL || thumb_dirty == NULL ||
+       thumb_stale == NULL || thumb_textures == NULL )
+  {
+    printf( "Failed to allocate memory for region thumbnails\n" );
+    wet_ResetThumbnails();
+    return 0;
+  }
+
+  thumb_map = map;
+
+  return 1;
+}
+
+/*
+ * Seen from above, the fg of the highest non-empty tile, the bg of the
+ * bottom tile when the whole column is empty
+ */
+static uint8_t wet_ColumnColor( GameTile_t* tiles, int plane, int z_height,
+                                int index )
+{
+  for ( int z = z_height - 1; z >= 0; z-- )
+  {
+    if ( tiles[( z * plane ) + index].glyph != GLYPH_SPACE )
+    {
+      return tiles[( z * plane ) + index].fg;
+    }
+  }
+
+  return tiles[index].bg;
+}
+
+static void wet_BuildCell( World_t* map, int world_index, uint8_t* out )
+{
+  int regions = map->region_width * map->region_height;
+  int plane   = map->local_width * map->local_height;
+
+  if ( map[world_index].regions == NULL )
+  {
+    memset( out, 0, regions * plane );
+    return;
+  }
+
+  for ( int i = 0; i < regions; i++ )
+  {
+    GameTile_t* tiles = map[world_index].regions[i].tiles;
+
+    for ( int j = 0; j < plane; j++ )
+    {
+      out[( i * plane ) + j] = wet_ColumnColor( tiles, plane, map->z_height,
+                                                j );
+    }
+  }
+}
+
+static void wet_BuildJob( void* data )
+{
+  int world_index = ( int )( intptr_t )data;
+
+  wet_BuildCell( thumb_map, world_index, thumb_pixels +
+                 ( world_index * thumb_regions * thumb_plane ) );
+
+  SDL_AtomicSet( &thumb_dirty[world_index], 1 );
+  SDL_AtomicSet( &thumb_state[world_index], THUMB_READY );
+}
+
+static void wet_Queue( int world_index )
+{
+  thumb_stale[world_index] = 0;
+  SDL_AtomicSet( &thumb_state[world_index], THUMB_BUILDING );
+  g_PushJob( wet_BuildJob, ( void* )( intptr_t )world_index );
+}
+
+/*
+ * Main thread side of a world cell, requeues it if it was edited while its
+ * job ran and uploads the pixels once they changed
+ */
+static int wet_Upload( World_t* map, int world_index )
+{
+  if ( SDL_AtomicGet( &thumb_state[world_index] ) != THUMB_READY ) return 0;
+
+  if ( thumb_stale[world_index] )
+  {
+    wet_Queue( world_index );
+    return thumb_textures[world_index] != NULL;
+  }
+
+  if ( SDL_AtomicSet( &thumb_dirty[world_index], 0 ) == 0 )
+  {
+    return thumb_textures[world_index] != NULL;
+  }
+
+  int width  = map->region_width * map->local_width;
+  int height = map->region_height * map->local_height;
+
+  if ( thumb_textures[world_index] == NULL )
+  {
+    thumb_textures[world_index] = SDL_CreateTexture( app.renderer,
+                                                     SDL_PIXELFORMAT_RGBA32,
+                                                     SDL_TEXTUREACCESS_STATIC,
+                                                     width, height );
+    if ( thumb_textures[world_index] == NULL )
+    {
+      printf( "Failed to create thumbnail texture, %s\n", SDL_GetError() );
+      return 0;
+    }
+  }
+
+  uint8_t* rgba = malloc( width * height * 4 );
+  if ( rgba == NULL )
+  {
+    printf( "Failed to allocate memory for thumbnail upload\n" );
+    return 0;
+  }
+
+  uint8_t* cell = thumb_pixels + ( world_index * thumb_regions * thumb_plane );
+
+  for ( int r = 0; r < thumb_regions; r++ )
+  {
+    int base_x = ( r / map->region_height ) * map->local_width;
+    int base_y = ( r % map->region_height ) * map->local_height;
+
+    for ( int i = 0; i < thumb_plane; i++ )
+    {
+      int px = base_x + ( i / map->local_height );
+      int py = base_y + ( i % map->local_height );
+      uint8_t index = cell[( r * thumb_plane ) + i];
+      aColor_t color = master_colors[APOLLO_PALETE][index % MAX_COLOR_PALETTE];
+      uint8_t* out = rgba + ( ( ( py * width ) + px ) * 4 );
+
+      out[0] = color.r;
+      out[1] = color.g;
+      out[2] = color.b;
+      out[3] = 255;
+    }
+  }
+
+  SDL_UpdateTexture( thumb_textures[world_index], NULL, rgba, width * 4 );
+  free( rgba );
+
+  return 1;
+}
+
@@ -0,0 +1,300 @@
+/*
+ * world_editor/undo.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * Ring of entries, journal_count of them starting at journal_first.
+ * The first undo_cursor are applied and can be undone, the rest can be
+ * redone until the next edit drops them.
+ */
+static UndoEntry_t journal[UNDO_MAX_ENTRIES];
+static int journal_first = 0;
+static int journal_count = 0;
+static int undo_cursor   = 0;
+static size_t journal_bytes = 0;
+static World_t* journal_map = NULL;
+
+// old tiles of the box announced by e_TilesWillChange
+static TileRect_t pending_rect;
+static TileRun_t* pending_runs = NULL;
+static int num_pending_runs = 0;
+
+static uint32_t next_transaction = 1;
+static uint32_t open_transaction = 0;
+static int transaction_depth = 0;
+
+static int weu_Encode( World_t* map, TileRect_t rect, TileRun_t* runs );
+static void weu_Apply( World_t* map, TileRect_t rect, TileRun_t* runs,
+                       int num_runs );
+static UndoEntry_t* weu_Entry( int k );
+static void weu_DropOldest( void );
+static void weu_DropRedo( void );
+
+void e_BeginTransaction( void )
+{
+  if ( transaction_depth++ == 0 )
+  {
+    open_transaction = next_transaction++;
+  }
+}
+
+void e_EndTransaction( void )
+{
+  if ( transaction_depth > 0 )
+  {
+    transaction_depth--;
+  }
+}
+
+void weu_Snapshot( World_t* map, TileRect_t rect )
+{
+  free( pending_runs );
+  pending_runs = NULL;
+  num_pending_runs = 0;
+
+  if ( !e_ClipRect( map, &rect ) ) return;
+
+  if ( journal_map != map )
+  {
+    weu_ResetUndo();
+    journal_map = map;
+  }
+
+  pending_runs = malloc( sizeof( TileRun_t ) * rect.w * rect.h * rect.d );
+  if ( pending_runs == NULL )
+  {
+    printf( "Failed to allocate memory for undo snapshot\n" );
+    return;
+  }
+
+  pending_rect     = rect;
+  num_pending_runs = weu_Encode( map, rect, pending_runs );
+}
+
+void weu_Commit( World_t* map )
+{
+  if ( pending_runs == NULL || journal_map != map ) return;
+
+  TileRect_t rect = pending_rect;
+  TileRun_t* new_runs = malloc( sizeof( TileRun_t ) * rect.w * rect.h *
+                                rect.d );
+  if ( new_runs == NULL )
+  {
+    printf( "Failed to allocate memory for undo entry\n" );
+    return;
+  }
+
+  int num_new_runs = weu_Encode( map, rect, new_runs );
+  int num_runs = num_pending_runs + num_new_runs;
+
+  UndoEntry_t entry = { .rect = rect, .num_old_runs = num_pending_runs,
+    .num_new_runs = num_new_runs };
+  entry.transaction = transaction_depth > 0 ? open_transaction
+                                            : next_transaction++;
+  entry.runs  = malloc( sizeof( TileRun_t ) * num_runs );
+  entry.bytes = sizeof( UndoEntry_t ) + sizeof( TileRun_t ) * num_runs;
+
+  if ( entry.runs == NULL )
+  {
+    printf( "Failed to allocate memory for undo entry\n" );
+    free( new_runs );
+    return;
+  }
+
+  memcpy( entry.runs, pending_runs, sizeof( TileRun_t ) * num_pending_runs );
+  memcpy( entry.runs + num_pending_runs, new_runs,
+          sizeof( TileRun_t ) * num_new_runs );
+  free( new_runs );
+  free( pending_runs );
+  pending_runs = NULL;
+  num_pending_runs = 0;
+
+  weu_DropRedo();
+  if ( journal_count == UNDO_MAX_ENTRIES )
+  {
+    weu_DropOldest();
+  }
+
+  *weu_Entry( journal_count ) = entry;
+  journal_count++;
+  undo_cursor++;
+  journal_bytes += entry.bytes;
+
+  // always keep the newest entry, even one that is over the budget alone
+  while ( journal_bytes > UNDO_MAX_BYTES && journal_count > 1 )
+  {
+    weu_DropOldest();
+  }
+}
+
+int e_Undo( World_t* map )
+{
+  if ( map == NULL || journal_map != map || undo_cursor == 0 ) return 0;
+
+  free( pending_runs );
+  pending_runs = NULL;
+
+  uint32_t transaction = weu_Entry( undo_cursor - 1 )->transaction;
+
+  while ( undo_cursor > 0 &&
+          weu_Entry( undo_cursor - 1 )->transaction == transaction )
+  {
+    UndoEntry_t* entry = weu_Entry( --undo_cursor );
+    wea_TilesWillChange( map, entry->rect );
+    weu_Apply( map, entry->rect, entry->runs, entry->num_old_runs );
+    e_TilesChanged( map, entry->rect );
+  }
+
+  return 1;
+}
+
+int e_Redo( World_t* map )
+{
+  if ( map == NULL || journal_map != map || undo_cursor == journal_count )
+  {
+    return 0;
+  }
+
+  free( pending_runs );
+  pending_runs = NULL;
+
+  uint32_t transaction = weu_Entry( undo_cursor )->transaction;
+
+  while ( undo_cursor < journal_count &&
+          weu_Entry( undo_cursor )->transaction == transaction )
+  {
+    UndoEntry_t* entry = weu_Entry( undo_cursor++ );
+    wea_TilesWillChange( map, entry->rect );
+    weu_Apply( map, entry->rect, entry->runs + entry->num_old_runs,
+               entry->num_new_runs );
+    e_TilesChanged( map, entry->rect );
+  }
+
+  return 1;
+}
+
+void weu_ResetUndo( void )
+{
+  while ( journal_count > 0 )
+  {
+    weu_DropOldest();
+  }
+
+  free( pending_runs );
+  pending_runs = NULL;
+  num_pending_runs = 0;
+
+  journal_first = 0;
+  undo_cursor   = 0;
+  journal_bytes = 0;
+  journal_map   = NULL;
+}
+
+static int weu_Encode( World_t* map, TileRect_t rect, TileRun_t* runs )
+{
+  int num_runs = 0;
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      GameTile_t* tile = e_RectColumn( map, rect, x, z );
+      size_t stride = e_TileStride( rect.level );
+
+      for ( int y = 0; y < rect.h; y++ )
+      {
+        if ( num_runs > 0 && runs[num_runs - 1].count < UINT16_MAX &&
+             e_SameTile( &runs[num_runs - 1].tile, tile ) )
+        {
+          runs[num_runs - 1].count++;
+        }
+
+        else
+        {
+          runs[num_runs].count = 1;
+          runs[num_runs].tile  = *tile;
+          num_runs++;
+        }
+
+        tile = ( GameTile_t* )( ( uint8_t* )tile + stride );
+      }
+    }
+  }
+
+  return num_runs;
+}
+
+static void weu_Apply( World_t* map, TileRect_t rect, TileRun_t* runs,
+                       int num_runs )
+{
+  int run = 0;
+  int left = num_runs > 0 ? runs[0].count : 0;
+  size_t stride = e_TileStride( rect.level );
+
+  for ( int z = rect.z; z < rect.z + rect.d; z++ )
+  {
+    for ( int x = rect.x; x < rect.x + rect.w; x++ )
+    {
+      GameTile_t* tile = e_RectColumn( map, rect, x, z );
+
+      for ( int y = 0; y < rect.h && run < num_runs; y++ )
+      {
+        *tile = runs[run].tile;
+        tile = ( GameTile_t* )( ( uint8_t* )tile + stride );
+
+        if ( --left == 0 && ++run < num_runs )
+        {
+          left = runs[run].count;
+        }
+      }
+    }
+  }
+}
+
+static UndoEntry_t* weu_Entry( int k )
+{
+  return &journal[( journal_first + k ) % UNDO_MAX_ENTRIES];
+}
+
+static void weu_DropOldest( void )
+{
+  UndoEntry_t* entry = weu_Entry( 0 );
+
+  journal_bytes -= entry->bytes;
+  free( entry->runs );
+  memset( entry, 0, sizeof( UndoEntry_t ) );
+
+  journal_first = ( journal_first + 1 ) % UNDO_MAX_ENTRIES;
+  journal_count--;
+  if ( undo_cursor > 0 )
+  {
+    undo_cursor--;
+  }
+}
+
+static void weu_DropRedo( void )
+{
+  while ( journal_count > undo_cursor )
+  {
+    UndoEntry_t* entry = weu_Entry( --journal_count );
+
+    journal_bytes -= entry->bytes;
+    free( entry->runs );
+    memset( entry, 0, sizeof( UndoEntry_t ) );
+  }
+}
+
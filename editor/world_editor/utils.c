@@ -17,21 +17,142 @@
 #include "structs.h"
 #include "world_editor.h"
 
+
+static void we_CellStyle( int index, World_t* map, WorldPosition_t pos,
+                          WorldPosition_t highlight, int* glyph,
+                          aColor_t* bg, aColor_t* fg, int* marker );
+static void we_DrawCellFront( int index, World_t* map, WorldPosition_t pos,
+                              int x, int y, int w, int h, int glyph,
+                              aColor_t fg, int marker );
+
+enum
+{
+  CELL_MARK_CURRENT   = 1,
+  CELL_MARK_HIGHLIGHT = 2
+};
+
 void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos, WorldPosition_t highlight )
 {
   int x, y, w, h;
+  int width = 0, height = 0;
+  int glyph, marker;
+  aColor_t bg, fg;
+
+  we_GridSize( map, pos.level, &width, &height );
+  e_GetCellSize( index, width, height, &x, &y, &w, &h );
+  we_CellStyle( index, map, pos, highlight, &glyph, &bg, &fg, &marker );
+
+  a_DrawFilledRect( x, y, w, h, bg.r, bg.g, bg.b, 255 );
+  we_DrawCellFront( index, map, pos, x, y, w, h, glyph, fg, marker );
+}
+
+/*
+ * Draw the whole grid of the current level in two passes, first the
+ * backgrounds with every run of same coloured cells along a screen row
+ * merged into one rect, then the glyphs on top
+ */
+void we_DrawWorldCells( World_t* map, WorldPosition_t pos,
+                        WorldPosition_t highlight )
+{
+  int x, y, w, h;
+  int width = 0, height = 0;
+  int glyph, marker;
+  aColor_t bg, fg;
+  uint64_t prof_start = g_ProfNow();
+
+  we_GridSize( map, pos.level, &width, &height );
+
+  for ( int row = 0; row < height; row++ )
+  {
+    int run_x = 0, run_y = 0, run_w = 0, run_h = 0;
+    aColor_t run_bg = { 0 };
+
+    for ( int col = 0; col < width; col++ )
+    {
+      int index = INDEX_2( col, row, height );
+
+      e_GetCellSize( index, width, height, &x, &y, &w, &h );
+      we_CellStyle( index, map, pos, highlight, &glyph, &bg, &fg, &marker );
+
+      if ( run_w > 0 && x == run_x + run_w && bg.r == run_bg.r &&
+           bg.g == run_bg.g && bg.b == run_bg.b )
+      {
+        run_w += w;
+        continue;
+      }
+
+      if ( run_w > 0 )
+      {
+        a_DrawFilledRect( run_x, run_y, run_w, run_h,
+                          run_bg.r, run_bg.g, run_bg.b, 255 );
+      }
+
+      run_x  = x;
+      run_y  = y;
+      run_w  = w;
+      run_h  = h;
+      run_bg = bg;
+    }
+
+    if ( run_w > 0 )
+    {
+      a_DrawFilledRect( run_x, run_y, run_w, run_h,
+                        run_bg.r, run_bg.g, run_bg.b, 255 );
+    }
+  }
+
+  for ( int index = 0; index < width * height; index++ )
+  {
+    e_GetCellSize( index, width, height, &x, &y, &w, &h );
+    we_CellStyle( index, map, pos, highlight, &glyph, &bg, &fg, &marker );
+    we_DrawCellFront( index, map, pos, x, y, w, h, glyph, fg, marker );
+  }
+
+  g_ProfZoneEnd( "we_DrawWorldCells", prof_start );
+}
+
+void we_GridSize( World_t* map, uint8_t level, int* width, int* height )
+{
+  switch ( level )
+  {
+    case WORLD_LEVEL:
+      *width  = map->world_width;
+      *height = map->world_height;
+      break;
+
+    case REGION_LEVEL:
+      *width  = map->region_width;
+      *height = map->region_height;
+      break;
+
+    case LOCAL_LEVEL:
+      *width  = map->local_width;
+      *height = map->local_height;
+      break;
+
+    default:
+      break;
+  }
+}
+
+/*
+ * Glyph and colours of one cell, the cursor and the highlight take over
+ * the bg and are reported in `marker` for cells drawn from a thumbnail
+ */
+static void we_CellStyle( int index, World_t* map, WorldPosition_t pos,
+                          WorldPosition_t highlight, int* glyph,
+                          aColor_t* bg, aColor_t* fg, int* marker )
+{
   uint32_t i = 0;
   uint16_t current_index = 0;
   uint16_t highlight_index = 0;
   int current_glyph = 0;
   int current_bg = 0;
   int current_fg = 0;
+  int depth = 0;
 
   switch ( pos.level ) {
     case WORLD_LEVEL:
-      e_GetCellSize( index, map->world_width, map->world_height,
-                     &x, &y, &w, &h );
-
       i = index;
 
       current_index   = pos.world_index;
@@ -42,9 +163,6 @@ void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos, WorldPositi
       break;
 
     case REGION_LEVEL:
-      e_GetCellSize( index, map->region_width, map->region_height,
-                     &x, &y, &w, &h );
-
       i = index;
 
       current_index   = pos.region_index;
@@ -55,20 +173,30 @@ void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos, WorldPositi
       break;
 
     case LOCAL_LEVEL:
-      e_GetCellSize( index, map->local_width, map->local_height,
-                     &x, &y, &w, &h );
-
       i = ( ( pos.local_z * ( map->local_width * map->local_height ) 
         + index ) );
 
+      uint32_t tile_i = i;
+      if ( e_IsCompositeView( pos.level ) )
+      {
+        int top_z = wed_TopZ( map, pos.world_index, pos.region_index, index,
+                              pos.local_z );
+        if ( top_z >= 0 )
+        {
+          depth  = pos.local_z - top_z;
+          tile_i = ( top_z * ( map->local_width * map->local_height ) ) +
+            index;
+        }
+      }
+
       current_index   = pos.local_index;
       highlight_index = highlight.local_index;
       current_glyph   = map[pos.world_index].regions[pos.region_index].
-        tiles[i].glyph;
-      current_bg      = map[pos.world_index].regions[pos.region_index].tiles[i]
-        .bg;
-      current_fg      = map[pos.world_index].regions[pos.region_index].tiles[i]
-        .fg;
+        tiles[tile_i].glyph;
+      current_bg      = map[pos.world_index].regions[pos.region_index].
+        tiles[tile_i].bg;
+      current_fg      = map[pos.world_index].regions[pos.region_index].
+        tiles[tile_i].fg;
 
       break;
 
@@ -76,499 +204,170 @@ void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos, WorldPositi
       break;
   }
 
-  if ( i == current_index )
-  {
-    a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
-                      game_glyphs->rects[current_glyph].h * 2, 
-                      255, 255, 0, 255 );
+  *glyph  = current_glyph;
+  *bg     = master_colors[APOLLO_PALETE][current_bg];
+  *fg     = master_colors[APOLLO_PALETE][current_fg];
+  *marker = 0;
 
-    a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                      x, y, 2, master_colors[APOLLO_PALETE][current_fg] );
-  } 
+  if ( depth > 0 )
+  {
+    *bg = wed_ShadeColor( *bg, depth );
+    *fg = wed_ShadeColor( *fg, depth );
+  }
 
-  else
+  if ( i == current_index )
   {
-    a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
-                      game_glyphs->rects[current_glyph].h * 2,
-                      master_colors[APOLLO_PALETE][current_bg].r, 
-                      master_colors[APOLLO_PALETE][current_bg].g,
-                      master_colors[APOLLO_PALETE][current_bg].b, 255 );
-    
-    a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                      x, y, 2, master_colors[APOLLO_PALETE][current_fg] );
+    *bg = ( aColor_t ){ 255, 255, 0, 255 };
+    *marker |= CELL_MARK_CURRENT;
+  }
 
+  if ( i == highlight_index )
+  {
+    *bg = ( aColor_t ){ 255, 0, 255, 255 };
+    *marker |= CELL_MARK_HIGHLIGHT;
   }
-  
-  if( i == highlight_index )
+}
+
+/*
+ * Everything of a cell but its bg, the thumbnail when the overview has one
+ */
+static void we_DrawCellFront( int index, World_t* map, WorldPosition_t pos,
+                              int x, int y, int w, int h, int glyph,
+                              aColor_t fg, int marker )
+{
+  if ( pos.level != LOCAL_LEVEL &&
+       wet_DrawThumbnail( map, pos, index, x, y, w, h ) )
   {
-    a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
-                     game_glyphs->rects[current_glyph].h * 2, 
-                     255, 0, 255, 255 );
+    if ( marker & CELL_MARK_CURRENT )
+    {
+      a_DrawRect( x, y, w, h, 255, 255, 0, 255 );
+    }
 
-    a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                      x, y, 2, master_colors[APOLLO_PALETE][current_fg] );
+    if ( marker & CELL_MARK_HIGHLIGHT )
+    {
+      a_DrawRect( x, y, w, h, 255, 0, 255, 255 );
+    }
 
+    return;
   }
 
+  a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[glyph],
+                     x, y, e_GetGlyphScale(), fg );
 }
 
 void e_DrawSelectGrid( World_t* map, WorldPosition_t pos,
                                    WorldPosition_t highlight )
 {
-  int grid_w    = ( highlight.x - pos.x );
-  int grid_h    = ( highlight.y - pos.y );
-  int current_x = pos.x, current_y  = pos.y;
-  int current_z = pos.local_z;
-
-  if ( grid_w < 0 )
-  {
-    grid_w = ( pos.x - highlight.x );
-    current_x = highlight.x;
-
-  }
-
-  if ( grid_h < 0 )
-  {
-    grid_h = ( pos.y - highlight.y );
-    current_y = highlight.y;
-
-  }
+  TileRect_t rect = e_SelectRect( map, pos, highlight );
+  if ( rect.w == 0 ) return;
 
   int x, y, w, h;
-
-  int current_index = 0;
-  int current_glyph = 0;
+  int glyph, marker;
+  aColor_t bg, fg;
   int current_width = 0, current_height = 0;
-  int current_fg    = 0;
-
-  switch ( pos.level )
-  {
-    case WORLD_LEVEL:
-      current_width  = map->world_width;
-      current_height = map->world_height;
-      break;
-    
-    case REGION_LEVEL:
-      current_width  = map->region_width;
-      current_height = map->region_height;
-      break;
-    
-    case LOCAL_LEVEL:
-      current_width  = map->local_width;
-      current_height = map->local_height;
-      break;
-
-    default:
-      break;
-  }
-  
-  int k = 0;
-
-  for ( int i = 0; i < grid_w + 1; i++ )
-  {
-    for ( int j = 0; j < grid_h + 1; j++ )
-    {
-      switch ( pos.level )
-      {
-        case WORLD_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  current_height );
+  int scale = e_GetGlyphScale();
 
-          current_glyph = map[current_index].tile.glyph;
-          current_fg = map[current_index].tile.fg;
-          
-          break;
+  we_GridSize( map, pos.level, &current_width, &current_height );
 
-        case REGION_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  current_height );
+  e_GetCellSize( INDEX_2( rect.x, rect.y, current_height ),
+                 current_width, current_height, &x, &y, &w, &h );
 
-          current_glyph = map[pos.world_index].regions[current_index].
-            tile.glyph;
-          
-          current_fg = map[pos.world_index].regions[current_index].
-            tile.fg;
-          
+  // one box over the cells, the renderer does not blend so the glyphs of
+  // the selection are blitted again on top of it
+  int box_x = x, box_y = y;
+  int box_w = rect.w * w, box_h = rect.h * h;
 
-          break;
-
-        case LOCAL_LEVEL:
-          current_index = INDEX_3( ( current_y + j ), ( current_x + i ),
-                                     current_z, current_width, current_height );
-          
-          current_fg = map[pos.world_index].regions[pos.region_index].
-            tiles[current_index].fg;
-
-          current_glyph = map[pos.world_index].regions[pos.region_index].
-            tiles[current_index].glyph;
-
-          current_index -= ( map->local_width * map->local_height * pos.local_z );
-
-          break;
-
-        default:
-          break;
-      }
+  a_DrawFilledRect( box_x, box_y, box_w, box_h, 255, 0, 255,
+                    SELECT_OVERLAY_ALPHA );
 
-      e_GetCellSize( current_index, current_width, current_height,
-                     &x, &y, &w, &h );
+  for ( int i = 0; i < rect.w; i++ )
+  {
+    for ( int j = 0; j < rect.h; j++ )
+    {
+      int index = INDEX_2( rect.x + i, rect.y + j, current_height );
 
-      a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
-                       game_glyphs->rects[current_glyph].h * 2, 
-                       255, 0, 255, 255 );
+      e_GetCellSize( index, current_width, current_height, &x, &y, &w, &h );
+      we_CellStyle( index, map, pos, highlight, &glyph, &bg, &fg, &marker );
 
-      a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                        x, y, 2, master_colors[APOLLO_PALETE][current_fg] );
-      
+      a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[glyph],
+                         x, y, scale, fg );
     }
   }
 
+  a_DrawRect( box_x, box_y, box_w, box_h, 255, 0, 255, 255 );
 }
 
-GameTileArray_t* e_GetSelectGrid( World_t* map, WorldPosition_t pos,
-                                   WorldPosition_t highlight )
+void e_DrawPastePreview( World_t* map, WorldPosition_t pos,
+                         Clipboard_t* tiles, int transform )
 {
-  int grid_w    = ( highlight.x - pos.x );
-  int grid_h    = ( highlight.y - pos.y );
-  int current_x = pos.x, current_y  = pos.y;
-  int current_z = pos.local_z;
+  if ( tiles == NULL || tiles->cells == NULL ) return;
 
-  if ( grid_w < 0 )
-  {
-    grid_w = ( pos.x - highlight.x );
-    current_x = highlight.x;
+  int tiles_w, tiles_h;
+  e_TransformedSize( tiles, transform, &tiles_w, &tiles_h );
 
-  }
+  TileRect_t dst = { .level = pos.level, .world_index = pos.world_index,
+    .region_index = pos.region_index, .x = pos.x, .y = pos.y,
+    .z = pos.local_z, .w = tiles_w, .h = tiles_h, .d = 1 };
 
-  if ( grid_h < 0 )
-  {
-    grid_h = ( pos.y - highlight.y );
-    current_y = highlight.y;
+  if ( !e_ClipRect( map, &dst ) ) return;
 
-  }
+  int x = 0, y = 0, w = 0, h = 0;
+  int current_width = 0, current_height = 0;
+  int scale = e_GetGlyphScale();
 
-  GameTileArray_t* new_game_tile_array = ( GameTileArray_t* )malloc(
-    sizeof( GameTileArray_t ) );
+  we_GridSize( map, pos.level, &current_width, &current_height );
+  e_GetCellSize( INDEX_2( dst.x, dst.y, current_height ),
+                 current_width, current_height, &x, &y, &w, &h );
 
-  if ( new_game_tile_array == NULL )
-  {
-    printf( "Failed to allocate memory for new_game_tile_array\n" );
-    return NULL;
-  }
-  
-  new_game_tile_array->w            = grid_w + 1;
-  new_game_tile_array->h            = grid_h + 1;
-  new_game_tile_array->level        = pos.level;
-  new_game_tile_array->world_index  = pos.world_index;
-  new_game_tile_array->region_index = pos.region_index;
-  new_game_tile_array->local_index  = pos.local_index;
-
-  new_game_tile_array->data = ( int* )malloc( sizeof( int ) *
-                                            ( grid_w + 1 ) * ( grid_h + 1 ) *
-                                              map->z_height );
-
-  int current_index = 0;
-  
-  int k = 0;
+  // one box under the whole preview instead of a fill per cell
+  int box_x = x, box_y = y;
+  int box_w = dst.w * w, box_h = dst.h * h;
+
+  a_DrawFilledRect( box_x, box_y, box_w, box_h, 255, 0, 255,
+                    PASTE_OVERLAY_ALPHA );
 
-  for ( int i = 0; i < grid_w + 1; i++ )
+  for ( int i = 0; i < dst.w; i++ )
   {
-    for ( int j = 0; j < grid_h + 1; j++ )
+    for ( int j = 0; j < dst.h; j++ )
     {
-      switch ( pos.level )
-      {
-        case WORLD_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->world_height );
-
-          new_game_tile_array->data[k++] = current_index;
-          break;
-
-        case REGION_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->region_height );
+      GameTile_t* current_tile = e_TransformedTile( tiles, transform, i, j,
+                                                    0 );
 
-          new_game_tile_array->data[k++] = current_index;
+      e_GetCellSize( INDEX_2( dst.x + i, dst.y + j, current_height ),
+                     current_width, current_height, &x, &y, &w, &h );
 
-          break;
-
-        case LOCAL_LEVEL:
-          current_index = INDEX_3( ( current_y + j ), ( current_x + i ),
-                                     current_z, map->local_width,
-                                     map->local_height );
-          
-          new_game_tile_array->data[k++] = current_index;
-          break;
-      }
+      a_BlitTextureRect( game_glyphs->texture,
+                         game_glyphs->rects[current_tile->glyph], x, y, scale,
+                         master_colors[APOLLO_PALETE][current_tile->fg] );
     }
   }
 
-  new_game_tile_array->count = k;
-
-  return new_game_tile_array;
+  a_DrawRect( box_x, box_y, box_w, box_h, 255, 0, 255, 255 );
 }
 
-void e_ChangeGameTile( World_t* map, WorldPosition_t pos,
-                            GameTileArray_t* tile_array, int glyph_index,
-                            int bg_index, int fg_index )
-{
-  int index = 0;
-
-  for ( int i = 0; i < tile_array->count; i++ )
-  {
-    index = tile_array->data[i];
-    switch (pos.level)
-    {
-      case WORLD_LEVEL:
-        map[index].tile.glyph = glyph_index;
-       
-        map[index].tile.bg    = bg_index;
-       
-        map[index].tile.fg    = fg_index;
-        break;
-
-      case REGION_LEVEL:
-        map[pos.world_index].regions[index].tile.glyph = glyph_index;
-        
-        map[pos.world_index].regions[index].tile.bg    = bg_index;
-        
-        map[pos.world_index].regions[index].tile.fg    = fg_index;
-        break;
-
-      case LOCAL_LEVEL:
-        map[pos.world_index].regions[pos.region_index].
-          tiles[index].glyph = glyph_index;
-        
-        map[pos.world_index].regions[pos.region_index].
-          tiles[index].bg = bg_index;
-        
-        map[pos.world_index].regions[pos.region_index].
-          tiles[index].fg = fg_index;
-
-        break;
-    }
-  }
-
-  free( tile_array );
-
-}
-
-void e_PasteGameTile( World_t* map, WorldPosition_t pos,
-                       GameTileArray_t* tile_array )
+/*
+ * Every write to the map reports the box it touched here so the caches that
+ * are derived from the tiles ( LOD levels, summaries, ... ) only redo that
+ * area
+ */
+void e_TilesWillChange( World_t* map, TileRect_t rect )
 {
-  int index = 0;
-  int current_index = 0;
-  int current_x = pos.x;
-  int current_y = pos.y;
-  int k = 0;
-  
-  for ( int i = 0; i < tile_array->w; i++ )
-  {
-    for ( int j = 0; j < tile_array->h; j++ )
-    {
-      index = tile_array->data[k];
-      switch (pos.level)
-      {
-        case WORLD_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->world_height );
-
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              map[current_index].tile = map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              map[current_index].tile = 
-                map[tile_array->world_index].regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              map[current_index].tile = map[tile_array->world_index].
-                regions[tile_array->region_index].tiles[index];
-              break;
-          }
-          break;
-
-        case REGION_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->region_height );
-          
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              map[pos.world_index].regions[current_index].tile = 
-                map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              map[pos.world_index].regions[current_index].tile = 
-                map[tile_array->world_index].regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              map[pos.world_index].regions[current_index].tile =
-                map[tile_array->world_index].regions[tile_array->region_index].tiles[index];
-              break;
-          }
-          break;
-
-        case LOCAL_LEVEL:
-          current_index = INDEX_3( ( current_y + j ), ( current_x + i ),
-                                     pos.local_z, map->local_width,
-                                     map->local_height );
-          
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              map[pos.world_index].regions[pos.region_index]
-                .tiles[current_index] = map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              map[pos.world_index].regions[pos.region_index]
-                .tiles[current_index] = map[pos.world_index]
-                .regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              map[pos.world_index].regions[pos.region_index]
-                .tiles[current_index] = map[pos.world_index]
-                .regions[pos.region_index].tiles[index];
-              break;
-          }
-          break;
-      }
-      
-      if ( k < tile_array->count )
-      {
-        k++;
-      }
-    }
-
-  }
+  if ( map == NULL || rect.w == 0 || rect.h == 0 || rect.d == 0 ) return;
 
+  wea_TilesWillChange( map, rect );
+  weu_Snapshot( map, rect );
 }
 
-void e_DrawPastePreview( World_t* map, WorldPosition_t pos,
-                       GameTileArray_t* tile_array )
+void e_TilesChanged( World_t* map, TileRect_t rect )
 {
-  int index = 0;
-  int current_index = 0;
-  int current_x = pos.x;
-  int current_y = pos.y;
-  int x = 0, y = 0, w = 0, h = 0;
-  int current_width = 0, current_height = 0;
-  GameTile_t current_tile = {0};
-  int k = 0;
-  
-  for ( int i = 0; i < tile_array->w; i++ )
-  {
-    for ( int j = 0; j < tile_array->h; j++ )
-    {
-      index = tile_array->data[k];
-      switch (pos.level)
-      {
-        case WORLD_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->world_height );
-          
-          current_width  = map->world_width;
-          current_height = map->world_height;
-
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              current_tile = map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              current_tile = 
-                map[tile_array->world_index].regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              current_tile = map[tile_array->world_index].
-                regions[tile_array->region_index].tiles[index];
-              break;
-          }
-          break;
-
-        case REGION_LEVEL:
-          current_index = INDEX_2( ( current_x + i ), ( current_y + j ),
-                                  map->region_height );
-          
-          current_width  = map->region_width;
-          current_height = map->region_height;
-
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              current_tile = 
-                map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              current_tile =
-                map[tile_array->world_index].regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              current_tile =
-                map[tile_array->world_index].regions[tile_array->region_index].tiles[index];
-              break;
-          }
-          break;
-
-        case LOCAL_LEVEL:
-          current_index = INDEX_3( ( current_y + j ), ( current_x + i ),
-                                     pos.local_z, map->local_width,
-                                     map->local_height );
-          
-          current_index -= ( map->local_width * map->local_height * pos.local_z );
-          
-          current_width  = map->local_width;
-          current_height = map->local_height;
-          
-          switch ( tile_array->level ) 
-          {
-            case WORLD_LEVEL:
-              current_tile = map[index].tile;
-              break;
-
-            case REGION_LEVEL:
-              current_tile = map[tile_array->world_index]
-                .regions[index].tile;
-              break;
-
-            case LOCAL_LEVEL:
-              current_tile = map[tile_array->world_index]
-                .regions[tile_array->region_index].tiles[index];
-              break;
-          }
-          break;
-      }
-      
-      e_GetCellSize( current_index, current_width, current_height,
-                     &x, &y, &w, &h );
-
-      a_DrawFilledRect( x, y, game_glyphs->rects[current_tile.glyph].w * 2,
-                       game_glyphs->rects[current_tile.glyph].h * 2, 
-                       255, 0, 255, 255 );
-
-      a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_tile.glyph],
-                        x, y, 2, master_colors[APOLLO_PALETE][current_tile.fg] );
-      
-      
-      if ( k < tile_array->count )
-      {
-        k++;
-      }
-    }
-
-  }
-
+  if ( map == NULL || rect.w == 0 || rect.h == 0 || rect.d == 0 ) return;
+
+  weu_Commit( map );
+  wez_LodTilesChanged( map, rect );
+  wed_TilesChanged( map, rect );
+  wet_TilesChanged( map, rect );
+  wea_TilesChanged( map, rect );
+  weq_TilesChanged( map, rect );
 }
 
 void e_GetCellSize( int index, int width, int height,
@@ -576,17 +375,27 @@ void e_GetCellSize( int index, int width, int height,
 {
   int row = ( index / height );
   int col = ( index % height );
-  *x = ( ( SCREEN_WIDTH / 2 )  - ( ( width  * CELL_WIDTH ) / 2 ) )
-    + ( row * CELL_WIDTH );
-  *y = ( ( SCREEN_HEIGHT / 2 ) - ( ( height * CELL_HEIGHT ) / 2 ) )
-    + ( col * CELL_HEIGHT );
-  *w = CELL_WIDTH;
-  *h = CELL_HEIGHT;
+  int cell_width  = GLYPH_WIDTH  * e_GetGlyphScale();
+  int cell_height = GLYPH_HEIGHT * e_GetGlyphScale();
+  *x = ( ( SCREEN_WIDTH / 2 )  - ( ( width  * cell_width ) / 2 ) )
+    + ( row * cell_width );
+  *y = ( ( SCREEN_HEIGHT / 2 ) - ( ( height * cell_height ) / 2 ) )
+    + ( col * cell_height );
+  *w = cell_width;
+  *h = cell_height;
 }
 
 void e_GetCellAtMouse( int width, int height, int originx, int originy,
                        int cell_width, int cell_height, uint8_t* grid_x,
                        uint8_t* grid_y, int centered )
+{
+  e_GetCellAtPoint( app.mouse.x, app.mouse.y, width, height, originx, originy,
+                    cell_width, cell_height, grid_x, grid_y, centered );
+}
+
+int e_GetCellAtPoint( int px, int py, int width, int height, int originx,
+                      int originy, int cell_width, int cell_height,
+                      uint8_t* grid_x, uint8_t* grid_y, int centered )
 {
   int edge_x = 0;
   int edge_y = 0;
@@ -605,33 +414,44 @@ void e_GetCellAtMouse( int width, int height, int originx, int originy,
 
   }
 
-  if ( app.mouse.x > edge_x && app.mouse.x <= edge_x + ( width * cell_width ) &&
-       app.mouse.y > edge_y && app.mouse.y <= edge_y + ( height* cell_height ) )
+  if ( px > edge_x && px <= edge_x + ( width * cell_width ) &&
+       py > edge_y && py <= edge_y + ( height* cell_height ) )
   {
-    int mousex = ( ( app.mouse.x - edge_x ) / cell_width  );
-    int mousey = ( ( app.mouse.y - edge_y ) / cell_height );
+    int mousex = ( ( px - edge_x ) / cell_width  );
+    int mousey = ( ( py - edge_y ) / cell_height );
     *grid_x = mousex;
     *grid_y = mousey;
 
+    return 1;
   }
 
+  return 0;
 }
 
 void e_MapMouseCheck( WorldPosition_t* pos )
 {
+  int cell_width  = GLYPH_WIDTH  * e_GetGlyphScale();
+  int cell_height = GLYPH_HEIGHT * e_GetGlyphScale();
+
+  if ( e_IsLodView( pos->level ) )
+  {
+    wez_LodMouseCheck( map, pos );
+    return;
+  }
+
   switch (pos->level) {
     case WORLD_LEVEL: 
       e_GetCellAtMouse( map->world_width, map->world_height,
-                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, CELL_WIDTH,
-                       CELL_HEIGHT, &pos->x, &pos->y, 1 );
+                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, cell_width,
+                       cell_height, &pos->x, &pos->y, 1 );
 
       pos->world_index = INDEX_2( pos->x, pos->y, map->world_height );
       break;
 
     case REGION_LEVEL:
       e_GetCellAtMouse( map->region_width, map->region_height,
-                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, CELL_WIDTH,
-                       CELL_HEIGHT, &pos->x, &pos->y, 1 );
+                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, cell_width,
+                       cell_height, &pos->x, &pos->y, 1 );
 
       pos->region_index = INDEX_2( pos->x, pos->y,
                                          map->region_height );
@@ -639,8 +459,8 @@ void e_MapMouseCheck( WorldPosition_t* pos )
 
     case LOCAL_LEVEL:
       e_GetCellAtMouse( map->local_width, map->local_height,
-                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, CELL_WIDTH,
-                       CELL_HEIGHT, &pos->x, &pos->y, 1 );
+                       SCREEN_ORIGIN_X, SCREEN_ORIGIN_Y, cell_width,
+                       cell_height, &pos->x, &pos->y, 1 );
 
       pos->local_index = INDEX_3( pos->y, pos->x,
                                   pos->local_z, map->local_width,
@@ -680,7 +500,10 @@ void e_LevelZHeightCheck( WorldPosition_t* pos )
       if ( map[pos->world_index].regions == NULL )
       {
         printf("change level\n");
-        LoadPartialRegion( pos, map, "resources/world/map.dat" );
+        PROF_ZONE( "load_region" )
+          LoadPartialRegion( pos, map, "resources/world/map.dat" );
+
+        wet_QueueThumbnails( map );
 
       }
       pos->level++;
@@ -719,6 +542,12 @@ void e_LevelZHeightCheck( WorldPosition_t* pos )
 
   }
 
+  if ( app.keyboard[SDL_SCANCODE_Z] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_Z] = 0;
+    e_ToggleCompositeView();
+  }
+
 }
 
 void e_LoadColorPalette( aColor_t palette[MAX_COLOR_GROUPS][MAX_COLOR_PALETTE],
@@ -0,0 +1,442 @@
+/*
+ * world_editor/zoom.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Archimedes.h"
+#include "defs.h"
+#include "editor.h"
+#include "structs.h"
+#include "world_editor.h"
+
+/*
+ * Level k of a region holds one tile per 2^k x 2^k block of local tiles for
+ * every z slice, indexed like the region itself: z * ( w * h ) + x * h + y
+ */
+typedef struct
+{
+  GameTile_t* levels[LOD_MAX_LEVEL + 1];
+  uint8_t w[LOD_MAX_LEVEL + 1];
+  uint8_t h[LOD_MAX_LEVEL + 1];
+
+} RegionLod_t;
+
+static RegionLod_t** lod_cache = NULL;
+static World_t* lod_map = NULL;
+static int lod_count = 0;
+
+static int lod_first_x = 0;
+static int lod_first_y = 0;
+
+static RegionLod_t* wez_GetRegionLod( World_t* map, int world_index,
+                                      int region_index );
+static void wez_BuildBlock( World_t* map, RegionLod_t* lod,
+                            RegionCell_t* region, int level, int bx, int by,
+                            int z );
+static GameTile_t wez_GetLodTile( World_t* map, int level, int bx, int by,
+                                  int z );
+
+int e_GetGlyphScale( void )
+{
+  if ( zoom_level < 1.0f ) return 1;
+
+  return ( int )zoom_level;
+}
+
+int e_GetLodLevel( void )
+{
+  int level = 0;
+  float zoom = zoom_level;
+
+  while ( zoom < 1.0f && level < LOD_MAX_LEVEL )
+  {
+    zoom *= 2.0f;
+    level++;
+  }
+
+  return level;
+}
+
+int e_IsLodView( uint8_t level )
+{
+  return ( level == LOCAL_LEVEL && zoom_level < 1.0f );
+}
+
+void e_UpdateZoom( void )
+{
+  int step = 0;
+
+  if ( app.mouse.wheel != 0 )
+  {
+    step = ( app.mouse.wheel > 0 ) ? 1 : -1;
+    app.mouse.wheel = 0;
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_PAGEUP] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_PAGEUP] = 0;
+    step = 1;
+  }
+
+  if ( app.keyboard[SDL_SCANCODE_PAGEDOWN] == 1 )
+  {
+    app.keyboard[SDL_SCANCODE_PAGEDOWN] = 0;
+    step = -1;
+  }
+
+  if ( step > 0 && zoom_level < ZOOM_MAX )
+  {
+    zoom_level *= 2.0f;
+  }
+
+  else if ( step < 0 && zoom_level > ZOOM_MIN )
+  {
+    zoom_level /= 2.0f;
+  }
+
+}
+
+void wez_ResetLod( void )
+{
+  if ( lod_cache != NULL )
+  {
+    for ( int i = 0; i < lod_count; i++ )
+    {
+      if ( lod_cache[i] == NULL ) continue;
+
+      for ( int k = 1; k <= LOD_MAX_LEVEL; k++ )
+      {
+        free( lod_cache[i]->levels[k] );
+      }
+
+      free( lod_cache[i] );
+    }
+
+    free( lod_cache );
+  }
+
+  lod_cache = NULL;
+  lod_map   = NULL;
+  lod_count = 0;
+}
+
+/*
+ * Pick one tile to stand in for up to four children: the glyph/fg pair and the
+ * bg that occur most often win, elevation and temperature are averaged
+ */
+static GameTile_t wez_Aggregate( GameTile_t* children[4], int count )
+{
+  GameTile_t result = *children[0];
+  int best_glyph = 0, best_bg = 0;
+  int elevation = 0, temperature = 0, passable = 0;
+
+  for ( int i = 0; i < count; i++ )
+  {
+    int glyph_votes = 0, bg_votes = 0;
+
+    for ( int j = 0; j < count; j++ )
+    {
+      if ( children[j]->glyph == children[i]->glyph &&
+           children[j]->fg    == children[i]->fg )
+      {
+        glyph_votes++;
+      }
+
+      if ( children[j]->bg == children[i]->bg )
+      {
+        bg_votes++;
+      }
+    }
+
+    if ( glyph_votes > best_glyph )
+    {
+      best_glyph   = glyph_votes;
+      result.glyph = children[i]->glyph;
+      result.fg    = children[i]->fg;
+    }
+
+    if ( bg_votes > best_bg )
+    {
+      best_bg   = bg_votes;
+      result.bg = children[i]->bg;
+    }
+
+    elevation   += children[i]->elevation;
+    temperature += children[i]->temperature;
+    passable    += ( children[i]->is_passable != 0 );
+  }
+
+  result.elevation   = elevation / count;
+  result.temperature = temperature / count;
+  result.is_passable = ( passable * 2 >= count );
+
+  return result;
+}
+
+static void wez_BuildBlock( World_t* map, RegionLod_t* lod,
+                            RegionCell_t* region, int level, int bx, int by,
+                            int z )
+{
+  GameTile_t* children[4];
+  int count = 0;
+  int child_w = lod->w[level - 1];
+  int child_h = lod->h[level - 1];
+
+  for ( int i = 0; i < 2; i++ )
+  {
+    for ( int j = 0; j < 2; j++ )
+    {
+      int cx = ( bx * 2 ) + i;
+      int cy = ( by * 2 ) + j;
+
+      if ( cx >= child_w || cy >= child_h ) continue;
+
+      if ( level == 1 )
+      {
+        children[count++] = &region->tiles[INDEX_3( cy, cx, z,
+                                                     map->local_width,
+                                                     map->local_height )];
+      }
+
+      else
+      {
+        children[count++] = &lod->levels[level - 1][( z * child_w * child_h )
+          + INDEX_2( cx, cy, child_h )];
+      }
+    }
+  }
+
+  lod->levels[level][( z * lod->w[level] * lod->h[level] ) +
+    INDEX_2( bx, by, lod->h[level] )] = wez_Aggregate( children, count );
+}
+
+static RegionLod_t* wez_GetRegionLod( World_t* map, int world_index,
+                                      int region_index )
+{
+  int region_count = map->region_width * map->region_height;
+
+  if ( lod_map != map )
+  {
+    wez_ResetLod();
+
+    lod_count = map->world_width * map->world_height * region_count;
+    lod_cache = ( RegionLod_t** )calloc( lod_count, sizeof( RegionLod_t* ) );
+    if ( lod_cache == NULL )
+    {
+      printf( "Failed to allocate memory for lod_cache\n" );
+      lod_count = 0;
+      return NULL;
+    }
+
+    lod_map = map;
+  }
+
+  int slot = ( world_index * region_count ) + region_index;
+  if ( lod_cache[slot] != NULL ) return lod_cache[slot];
+
+  RegionCell_t* region = &map[world_index].regions[region_index];
+  RegionLod_t* lod = ( RegionLod_t* )calloc( 1, sizeof( RegionLod_t ) );
+  if ( lod == NULL )
+  {
+    printf( "Failed to allocate memory for region lod\n" );
+    return NULL;
+  }
+
+  lod->w[0] = map->local_width;
+  lod->h[0] = map->local_height;
+
+  for ( int k = 1; k <= LOD_MAX_LEVEL; k++ )
+  {
+    lod->w[k] = ( lod->w[k - 1] + 1 ) / 2;
+    lod->h[k] = ( lod->h[k - 1] + 1 ) / 2;
+
+    lod->levels[k] = ( GameTile_t* )malloc( sizeof( GameTile_t ) *
+                                            lod->w[k] * lod->h[k] *
+                                            map->z_height );
+    if ( lod->levels[k] == NULL )
+    {
+      printf( "Failed to allocate memory for lod level %d\n", k );
+      for ( int j = 1; j < k; j++ )
+      {
+        free( lod->levels[j] );
+      }
+      free( lod );
+      return NULL;
+    }
+
+    for ( int z = 0; z < map->z_height; z++ )
+    {
+      for ( int bx = 0; bx < lod->w[k]; bx++ )
+      {
+        for ( int by = 0; by < lod->h[k]; by++ )
+        {
+          wez_BuildBlock( map, lod, region, k, bx, by, z );
+        }
+      }
+    }
+  }
+
+  lod_cache[slot] = lod;
+
+  return lod;
+}
+
+/*
+ * Rebuild only the blocks that cover the changed tiles, level by level, so an
+ * edit costs O( area * levels ) instead of a whole region rebuild
+ */
+void wez_LodTilesChanged( World_t* map, TileRect_t rect )
+{
+  if ( rect.level != LOCAL_LEVEL || lod_map != map || lod_cache == NULL )
+  {
+    return;
+  }
+
+  int slot = ( rect.world_index * map->region_width * map->region_height ) +
+    rect.region_index;
+  RegionLod_t* lod = lod_cache[slot];
+  if ( lod == NULL ) return;
+
+  RegionCell_t* region = &map[rect.world_index].regions[rect.region_index];
+  int x0 = rect.x, y0 = rect.y;
+  int x1 = rect.x + rect.w - 1, y1 = rect.y + rect.h - 1;
+
+  for ( int k = 1; k <= LOD_MAX_LEVEL; k++ )
+  {
+    x0 >>= 1; y0 >>= 1;
+    x1 >>= 1; y1 >>= 1;
+
+    for ( int z = rect.z; z < rect.z + rect.d; z++ )
+    {
+      for ( int bx = x0; bx <= x1; bx++ )
+      {
+        for ( int by = y0; by <= y1; by++ )
+        {
+          wez_BuildBlock( map, lod, region, k, bx, by, z );
+        }
+      }
+    }
+  }
+}
+
+static GameTile_t wez_GetLodTile( World_t* map, int level, int bx, int by,
+                                  int z )
+{
+  int block_w = ( ( map->local_width  - 1 ) >> level ) + 1;
+  int block_h = ( ( map->local_height - 1 ) >> level ) + 1;
+  int gx = bx / block_w;
+  int gy = by / block_h;
+
+  int world_index  = INDEX_2( ( gx / map->region_width ),
+                              ( gy / map->region_height ), map->world_height );
+  int region_index = INDEX_2( ( gx % map->region_width ),
+                              ( gy % map->region_height ), map->region_height );
+
+  if ( map[world_index].regions == NULL )
+  {
+    return map[world_index].tile;
+  }
+
+  RegionLod_t* lod = wez_GetRegionLod( map, world_index, region_index );
+  if ( lod == NULL )
+  {
+    return map[world_index].regions[region_index].tile;
+  }
+
+  return lod->levels[level][( z * lod->w[level] * lod->h[level] ) +
+    INDEX_2( ( bx % block_w ), ( by % block_h ), lod->h[level] )];
+}
+
+/*
+ * Draw every region of the world side by side, one glyph per LOD block,
+ * centered on the current region. Only on-screen blocks are visited so the
+ * cost is bounded by the screen size, not the world size.
+ */
+void wez_DrawLodView( World_t* map, WorldPosition_t pos )
+{
+  int level   = e_GetLodLevel();
+  int block_w = ( ( map->local_width  - 1 ) >> level ) + 1;
+  int block_h = ( ( map->local_height - 1 ) >> level ) + 1;
+  int plane_w = map->world_width  * map->region_width  * block_w;
+  int plane_h = map->world_height * map->region_height * block_h;
+  int cols    = SCREEN_WIDTH  / GLYPH_WIDTH;
+  int rows    = SCREEN_HEIGHT / GLYPH_HEIGHT;
+
+  int region_x = ( ( pos.world_index / map->world_height ) *
+    map->region_width ) + ( pos.region_index / map->region_height );
+  int region_y = ( ( pos.world_index % map->world_height ) *
+    map->region_height ) + ( pos.region_index % map->region_height );
+
+  lod_first_x = ( region_x * block_w ) + ( block_w / 2 ) - ( cols / 2 );
+  lod_first_y = ( region_y * block_h ) + ( block_h / 2 ) - ( rows / 2 );
+
+  for ( int sx = 0; sx < cols; sx++ )
+  {
+    int bx = lod_first_x + sx;
+    if ( bx < 0 || bx >= plane_w ) continue;
+
+    for ( int sy = 0; sy < rows; sy++ )
+    {
+      int by = lod_first_y + sy;
+      if ( by < 0 || by >= plane_h ) continue;
+
+      GameTile_t tile = wez_GetLodTile( map, level, bx, by, pos.local_z );
+
+      a_DrawFilledRect( sx * GLYPH_WIDTH, sy * GLYPH_HEIGHT,
+                        GLYPH_WIDTH, GLYPH_HEIGHT,
+                        master_colors[APOLLO_PALETE][tile.bg].r,
+                        master_colors[APOLLO_PALETE][tile.bg].g,
+                        master_colors[APOLLO_PALETE][tile.bg].b, 255 );
+
+      a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[tile.glyph],
+                         sx * GLYPH_WIDTH, sy * GLYPH_HEIGHT, 1,
+                         master_colors[APOLLO_PALETE][tile.fg] );
+    }
+  }
+
+  a_DrawRect( ( ( region_x * block_w ) - lod_first_x ) * GLYPH_WIDTH,
+              ( ( region_y * block_h ) - lod_first_y ) * GLYPH_HEIGHT,
+              block_w * GLYPH_WIDTH, block_h * GLYPH_HEIGHT,
+              255, 255, 0, 255 );
+
+}
+
+/*
+ * Map the mouse back through the last drawn LOD view to a world, region and
+ * local cell ( the top left tile of the block under the cursor )
+ */
+void wez_LodMouseCheck( World_t* map, WorldPosition_t* pos )
+{
+  int level   = e_GetLodLevel();
+  int block_w = ( ( map->local_width  - 1 ) >> level ) + 1;
+  int block_h = ( ( map->local_height - 1 ) >> level ) + 1;
+  int bx = lod_first_x + ( app.mouse.x / GLYPH_WIDTH );
+  int by = lod_first_y + ( app.mouse.y / GLYPH_HEIGHT );
+
+  if ( bx < 0 || by < 0 ||
+       bx >= map->world_width  * map->region_width  * block_w ||
+       by >= map->world_height * map->region_height * block_h )
+  {
+    return;
+  }
+
+  int gx = bx / block_w;
+  int gy = by / block_h;
+
+  pos->world_index  = INDEX_2( ( gx / map->region_width ),
+                               ( gy / map->region_height ), map->world_height );
+  pos->region_index = INDEX_2( ( gx % map->region_width ),
+                               ( gy % map->region_height ), map->region_height );
+
+  pos->x = MIN( ( ( bx % block_w ) << level ), map->local_width  - 1 );
+  pos->y = MIN( ( ( by % block_h ) << level ), map->local_height - 1 );
+  pos->local_index = INDEX_3( pos->y, pos->x, pos->local_z, map->local_width,
+                              map->local_height );
+}
+
@@ -0,0 +1,82 @@
+/*
+ * ansi_render.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __ANSI_RENDER_H__
+#define __ANSI_RENDER_H__
+
+#include <stdio.h>
+
+#include "structs.h"
+
+/*
+ * Create a headless renderer with a `width` x `height` cell buffer
+ *
+ * -- `truecolor` selects 24 bit colour escapes, otherwise the palette is
+ *    mapped once to the nearest xterm 256 colour
+ * -- Starts with a grey ramp palette, see g_AnsiLoadPalette
+ * -- No SDL calls are made, only the C library is linked
+ */
+AnsiRenderer_t* g_AnsiCreate( int width, int height, int truecolor );
+void g_AnsiDestroy( AnsiRenderer_t* renderer );
+
+/*
+ * Load the palette from the editor's hex colour file, one RRGGBB per line
+ *
+ * -- Returns 0 on success, 1 if the file could not be opened
+ */
+int g_AnsiLoadPalette( AnsiRenderer_t* renderer, const char* filename );
+
+/*
+ * Fill the cell buffer with blank cells of background `bg`
+ */
+void g_AnsiClear( AnsiRenderer_t* renderer, uint8_t bg );
+
+/*
+ * Write one cell, out of range coordinates are ignored
+ */
+void g_AnsiPut( AnsiRenderer_t* renderer, int x, int y, uint16_t glyph,
+                uint8_t fg, uint8_t bg );
+
+/*
+ * Write an ASCII string starting at `x`, `y`
+ */
+void g_AnsiText( AnsiRenderer_t* renderer, int x, int y, const char* text,
+                 uint8_t fg, uint8_t bg );
+
+/*
+ * Draw the view of `pos.level` centered in the cell buffer
+ *
+ * -- Same cell order and lookup as we_DrawWorldCell, one tile per cell
+ * -- The cell at the level's current index gets the cursor background
+ */
+void g_AnsiDrawView( AnsiRenderer_t* renderer, World_t* map,
+                     WorldPosition_t pos );
+
+/*
+ * Emit the cells that changed since the last present to `out`
+ *
+ * -- Glyphs go out as UTF-8 through the CodePage 437 table
+ * -- Cursor moves and colour escapes are only written when needed and
+ *    the whole frame goes out in one fwrite
+ * -- The first present, or one after g_AnsiInvalidate, emits every cell
+ * -- Returns the number of bytes written
+ */
+size_t g_AnsiPresent( AnsiRenderer_t* renderer, FILE* out );
+
+/*
+ * Force the next present to redraw every cell
+ */
+void g_AnsiInvalidate( AnsiRenderer_t* renderer );
+
+/*
+ * Unicode code point of a glyph index ( CP437 code - 1 )
+ */
+uint32_t g_AnsiGlyphToUnicode( uint16_t glyph );
+
+#endif
+
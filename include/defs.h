@@ -12,7 +12,9 @@
 #include "Archimedes.h"
 
 #define MAGIC_NUMBER "CAFEBABE"
-#define FILE_VERSION 1
+// version 2 appends one thumbnail byte per local column after the tiles,
+// version 1 files still load and get their thumbnails rebuilt
+#define FILE_VERSION 2
 
 #define WORLD_WIDTH_SMALL   7
 #define WORLD_HEIGHT_SMALL  5
@@ -41,11 +43,96 @@
 #define CELL_WIDTH  18
 #define CELL_HEIGHT 32
 
+// zoom_level is screen pixels per glyph pixel, below 1 the local view is
+// drawn from the LOD levels ( one cell per 2^level x 2^level block )
+#define ZOOM_DEFAULT  2.0f
+#define ZOOM_MAX      4.0f
+#define ZOOM_MIN      0.03125f
+#define LOD_MAX_LEVEL 5
+
+// composite local view, tiles below the current z fade by DEPTH_SHADE_STEP
+// per slice, columns keep a uint16_t occupancy mask so only 16 z are seen
+#define DEPTH_MAX_Z      16
+#define DEPTH_SHADE_STEP 0.2f
+#define DEPTH_SHADE_MIN  0.3f
+
+// selection and paste preview boxes, drawn over the glyphs
+#define SELECT_OVERLAY_ALPHA 96
+#define PASTE_OVERLAY_ALPHA  192
+
+// brush strokes are painted with the same button as a single tile
+#define BRUSH_BUTTON         2
+#define BRUSH_MAX_SIZE       16
+
+// world generation, elevation and temperature are 0 - 255 before the
+// factors, frequencies are noise periods per world cell
+#define WORLDGEN_SEA_LEVEL           96
+#define WORLDGEN_SHORE               6
+#define WORLDGEN_HILLS               176
+#define WORLDGEN_MOUNTAIN            200
+#define WORLDGEN_PEAK                232
+#define WORLDGEN_ELEVATION_FREQ      0.6f
+#define WORLDGEN_MOISTURE_FREQ       0.9f
+#define WORLDGEN_TEMPERATURE_FREQ    0.4f
+#define WORLDGEN_ELEVATION_OCTAVES   8
+#define WORLDGEN_MOISTURE_OCTAVES    5
+#define WORLDGEN_TEMPERATURE_OCTAVES 3
+
+// undo journal, the oldest entries go first when either limit is reached
+#define UNDO_MAX_ENTRIES     256
+#define UNDO_MAX_BYTES       ( 8 << 20 )
+
+// prefab library, one file with the index after the last prefab
+#define PREFAB_FILE          "resources/world/prefabs.dat"
+#define PREFAB_MAGIC         "PREFABS"
+#define PREFAB_VERSION       1
+#define PREFAB_NAME_LENGTH   32
+
 #define GLYPH_WIDTH 9
 #define GLYPH_HEIGHT 16
+
+// glyph atlas, every code page is packed into the one cached texture
+#define GLYPH_ATLAS_FILE     "resources/fonts/glyphs.atlas"
+#define GLYPH_MAX_PAGES      4
+#define GAME_MAX_GLYPHS      ( GLYPH_MAX_PAGES * 256 )
+#define GLYPH_PAGE_437       0
+#define GLYPH_PAGE_737       1
+#define GLYPH_NUM_PAGES      2
+#define GLYPH_PAGE_FILES     { "resources/fonts/CodePage437.png",\
+                               "resources/fonts/CodePage737Font.png" }
+
+// cached text textures, see text_cache.h
+#define TEXT_CACHE_SIZE      128
+#define TEXT_CACHE_BUCKETS   256
+#define TEXT_CACHE_MAX_LEN   64
+
+// headless ANSI renderer, the two extra palette slots are the cursor
+// and highlight colours
+#define ANSI_PALETTE_SIZE    ( MAX_COLOR_PALETTE + 2 )
+#define ANSI_COLOR_CURSOR    ( MAX_COLOR_PALETTE )
+#define ANSI_COLOR_HIGHLIGHT ( MAX_COLOR_PALETTE + 1 )
+#define ANSI_PALETTE_FILE    "resources/assets/colorpalette/colors.hex"
+
+// threaded game loop, see draw_list.h
+#define LOGIC_HZ             60
+#define DRAW_LIST_COMMANDS   256
+#define DRAW_LIST_CELLS      1024
+#define DRAW_LIST_TEXT       512
+
+// frame profiler, see profiler.h
+#define PROF_RING_SIZE       ( 1 << 17 ) // power of two
+#define PROF_HISTORY         120         // frames kept for p50 / p99
+#define PROF_DUMP_SECONDS    5
+#define PROF_TRACE_FILE      "profile_trace.json"
+#define PROF_OVERLAY_KEY     SDL_SCANCODE_F3
+#define PROF_DUMP_KEY        SDL_SCANCODE_F4
+
+// worker pool, see jobs.h
+#define JOBS_MAX_THREADS     8
+#define JOBS_QUEUE_SIZE      64
+
 #define MAX_COLOR_GROUPS        16
 #define MAX_COLOR_PALETTE       48
-#define GAME_GLYPH_TEXTURE_SIZE 256
 #define MAX_NAME_LENGTH         32
 #define MAX_DESCRIPTION_LENGTH  256
 #define MAX_ID_LENGTH           16
@@ -56,6 +143,29 @@
 // inventory defs
 #define INVENTORY_SIZE 24
 
+// item prototype defs, handles are indexes into the prototype registry
+#define ITEM_PROTOTYPE_NONE 0xFFFF
+#define MAX_ITEM_PROTOTYPES 0xFFFF
+
+// string interning defs, no string is ever given atom 0
+#define ATOM_NONE 0
+
+// material registry defs, ids index one factor table and 0 is never registered
+#define MATERIAL_NONE 0
+#define MAX_MATERIALS 256
+
+// item pool defs, items carved from each slab of a pool
+#define ITEM_POOL_SLAB_SIZE 256
+#define ITEM_SLOT_LIVE 0
+#define ITEM_SLOT_DEAD 1
+
+// item database, the JSON source is compiled to a cache that is mapped as is
+#define ITEM_DB_FILE         "resources/items/items.json"
+#define ITEM_DB_CACHE_FILE   "resources/items/items.cache"
+#define ITEM_DEF_NAME_LENGTH 64
+#define ITEM_DEF_ID_LENGTH   32
+#define MAX_ITEM_EFFECTS     32
+
 #define INDEX_3( x, y, z, width, height ) ( ( z * ( width * height ) )\
     + ( y * height ) + x )
 
@@ -0,0 +1,85 @@
+/*
+ * draw_list.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __DRAW_LIST_H__
+#define __DRAW_LIST_H__
+
+#include "structs.h"
+
+/*
+---------------------------------------------------------------
+---                     Draw Command Lists                  ---
+---------------------------------------------------------------
+*/
+
+/*
+ * Allocate the command, cell and text arrays of `list`
+ *
+ * -- Arrays grow by doubling, a list reused every frame stops allocating
+ *    once it has seen the biggest frame
+ * -- Returns 0 on success, 1 on allocation failure
+ */
+int g_InitDrawList( DrawList_t* list );
+void g_FreeDrawList( DrawList_t* list );
+
+/*
+ * Drop every recorded command, keeps the memory
+ */
+void g_ClearDrawList( DrawList_t* list );
+
+void g_PushRect( DrawList_t* list, int x, int y, int w, int h,
+                 aColor_t color, int filled );
+
+/*
+ * Start a run of glyph cells at `x`, `y`, each next cell is `dx`, `dy`
+ * further, cells are added with g_PushGlyph
+ */
+void g_PushGlyphSpan( DrawList_t* list, int x, int y, int dx, int dy,
+                      int scale );
+void g_PushGlyph( DrawList_t* list, uint16_t glyph, aColor_t fg, aColor_t bg );
+
+/*
+ * Record text, the string is copied into the list
+ */
+void g_PushText( DrawList_t* list, const char* text, int x, int y,
+                 aColor_t color, int font_type, int align );
+
+/*
+ * Draw every command of `list` with SDL, call from the render thread
+ *
+ * -- Glyph spans draw the background rect then the glyph for each cell
+ * -- Text goes through the text cache
+ */
+void g_ReplayDrawList( DrawList_t* list, GlyphArray_t* glyphs );
+
+/*
+---------------------------------------------------------------
+---                   Double Buffered Lists                 ---
+---------------------------------------------------------------
+*/
+
+/*
+ * Two lists, the logic thread records into the back one while the render
+ * thread replays the front one
+ *
+ * -- g_BeginDrawBuffer hands the logic a cleared back list
+ * -- g_PublishDrawBuffer swaps it to the front, waiting only if the old
+ *    front is still being replayed
+ * -- g_AcquireDrawBuffer returns the latest complete list or NULL before
+ *    the first publish, pair it with g_ReleaseDrawBuffer
+ * -- Returns 0 on success, 1 on failure
+ */
+int g_InitDrawBuffers( DrawBuffers_t* buffers );
+void g_FreeDrawBuffers( DrawBuffers_t* buffers );
+DrawList_t* g_BeginDrawBuffer( DrawBuffers_t* buffers );
+void g_PublishDrawBuffer( DrawBuffers_t* buffers );
+DrawList_t* g_AcquireDrawBuffer( DrawBuffers_t* buffers );
+void g_ReleaseDrawBuffer( DrawBuffers_t* buffers );
+
+#endif
+
@@ -9,6 +9,7 @@
 #ifndef __EDITOR_H__
 #define __EDITOR_H__
 
+#include "profiler.h"
 #include "structs.h"
 
 extern GlyphArray_t* game_glyphs;
@@ -27,6 +28,14 @@ void e_GetCellAtMouse( int width, int height, int originx, int originy,
                        int cell_width, int cell_height, uint8_t* grid_x,
                        uint8_t* grid_y, int centered );
 
+/*
+ * Same as e_GetCellAtMouse() for any screen point, returns 0 and leaves
+ * grid_x / grid_y alone when the point is off the grid
+ */
+int e_GetCellAtPoint( int px, int py, int width, int height, int originx,
+                      int originy, int cell_width, int cell_height,
+                      uint8_t* grid_x, uint8_t* grid_y, int centered );
+
 void e_MapMouseCheck( WorldPosition_t* pos );
 void e_GlyphMouseCheck( int* index, uint8_t* grid_x, uint8_t* grid_y );
 void e_ColorMouseCheck( int* index, uint8_t* grid_x, uint8_t* grid_y );
@@ -34,21 +43,241 @@ void e_LevelZHeightCheck( WorldPosition_t* pos );
 void e_LoadColorPalette( aColor_t palette[MAX_COLOR_GROUPS][MAX_COLOR_PALETTE],
                        const char * filename );
 
-GameTileArray_t* e_GetSelectGrid( World_t* map, WorldPosition_t pos,
-                                   WorldPosition_t highlight );
-
 void e_DrawSelectGrid( World_t* map, WorldPosition_t pos,
                                    WorldPosition_t highlight );
 
-void e_ChangeGameTile( World_t* map, WorldPosition_t pos,
-                            GameTileArray_t* tile_array, int glyph_index,
-                            int bg_index, int fg_index );
+void e_DrawPastePreview( World_t* map, WorldPosition_t pos,
+                         Clipboard_t* tiles, int transform );
+
+int e_GetGlyphScale( void );
+int e_GetLodLevel( void );
+int e_IsLodView( uint8_t level );
+int e_IsCompositeView( uint8_t level );
+void e_ToggleCompositeView( void );
 
-void e_PasteGameTile( World_t* map, WorldPosition_t pos,
-                       GameTileArray_t* tile_array );
+/*
+ * Box edits on one level, the selection, mass change, copy and paste all
+ * go through these
+ *
+ * -- e_SelectRect() is the box between two corners on the level of `pos`,
+ *    one tile deep at its z, w is 0 when nothing is selectable
+ * -- Every box is clipped to its level first with e_ClipRect(), which
+ *    returns 0 when nothing is left
+ * -- e_RectColumn() is the first tile of column x at z, the rect.h tiles
+ *    below it are e_TileStride() bytes apart
+ * -- Fill, replace and paste loop column by column and allocate nothing
+ *    besides the undo entry, a local column is a single memcpy / memmove
+ * -- e_ReplaceRect() only changes tiles with the glyph, fg and bg of
+ *    `match`
+ * -- e_CopyRect() writes w * h * d tiles to `out`, z then x then y, and
+ *    returns how many
+ * -- e_PasteRect() copies `src` with its top left corner at `pos`, it may
+ *    overlap `src`
+ * -- e_SameTile() compares field by field, never memcmp tiles
+ */
+TileRect_t e_SelectRect( World_t* map, WorldPosition_t pos,
+                         WorldPosition_t highlight );
+int e_ClipRect( World_t* map, TileRect_t* rect );
+GameTile_t* e_RectColumn( World_t* map, TileRect_t rect, int x, int z );
+size_t e_TileStride( uint8_t level );
+int e_SameTile( GameTile_t* a, GameTile_t* b );
+void e_FillRect( World_t* map, TileRect_t rect, int glyph, int bg, int fg );
+void e_ReplaceRect( World_t* map, TileRect_t rect, GameTile_t match,
+                    int glyph, int bg, int fg );
+int e_CopyRect( World_t* map, TileRect_t rect, GameTile_t* out );
+void e_PasteRect( World_t* map, TileRect_t src, WorldPosition_t pos );
 
-void e_DrawPastePreview( World_t* map, WorldPosition_t pos,
-                       GameTileArray_t* tile_array );
+/*
+ * Call before writing the tiles of `rect` so the edit can be undone, then
+ * e_TilesChanged() with the same box once they are written
+ */
+void e_TilesWillChange( World_t* map, TileRect_t rect );
+void e_TilesChanged( World_t* map, TileRect_t rect );
+
+/*
+ * Clipboard holding a copy of the tiles, not a reference into the map
+ *
+ * -- e_CopyClipboard() keeps every distinct tile of the box once and one
+ *    palette index per tile, one byte wide unless there are more than 256
+ * -- Paste and preview only read the copy, so a box pasted over where it
+ *    was copied from comes out whole
+ * -- The copy keeps no level or world, it pastes onto any level of any
+ *    world, a box deeper than one tile keeps only its first z outside of
+ *    LOCAL_LEVEL
+ * -- e_PasteTiles() pastes any copy, the clipboard or a prefab, mirrored
+ *    and / or rotated by `transform`, the orientation is worked out once
+ *    per paste and each tile costs the same as an unrotated paste
+ * -- e_TransformedSize() is the w and h the copy covers on the map,
+ *    e_TransformedTile() the tile at x, y, z of that box
+ * -- e_GetClipboard() is NULL while nothing is copied
+ */
+enum
+{
+  TRANSFORM_ROTATE_90   = 1,
+  TRANSFORM_ROTATE_180  = 2,
+  TRANSFORM_ROTATE_270  = 3,
+  TRANSFORM_ROTATE_MASK = 3,
+  TRANSFORM_MIRROR      = 4
+};
+
+int e_CopyClipboard( World_t* map, TileRect_t rect );
+void e_PasteClipboard( World_t* map, WorldPosition_t pos );
+void e_PasteTiles( World_t* map, Clipboard_t* tiles, WorldPosition_t pos,
+                   int transform );
+void e_TransformedSize( Clipboard_t* tiles, int transform, int* w, int* h );
+GameTile_t* e_TransformedTile( Clipboard_t* tiles, int transform, int x,
+                               int y, int z );
+Clipboard_t* e_GetClipboard( void );
+void e_FreeClipboard( void );
+
+/*
+ * Library of named prefabs kept in one file, see PrefabHeader_t
+ *
+ * -- e_OpenPrefabs() only reads the index, a prefab's tiles are read the
+ *    first time e_GetPrefab() asks for it, a file that does not exist yet
+ *    opens as an empty library and is made by the first save
+ * -- e_SavePrefab() writes a copy of `tiles` over the old index and the
+ *    index after it, a name that is already taken points to the new tiles
+ * -- Stamping goes through e_PasteTiles(), so it is one undo entry like a
+ *    paste
+ * -- e_DrawPrefabPreview() fits the prefab seen from above into the box,
+ *    its texture is made once and kept until e_FreePrefabs()
+ * -- e_FindPrefab() returns -1 when there is no prefab called `name`
+ */
+int e_OpenPrefabs( const char* filename );
+int e_PrefabCount( void );
+const char* e_PrefabName( int index );
+int e_FindPrefab( const char* name );
+Clipboard_t* e_GetPrefab( int index );
+int e_SavePrefab( const char* name, Clipboard_t* tiles );
+void e_StampPrefab( World_t* map, int index, WorldPosition_t pos,
+                    int transform );
+void e_DrawPrefabPreview( int index, int x, int y, int w, int h );
+void e_FreePrefabs( void );
+
+/*
+ * Undo or redo the last transaction, every edit outside of
+ * e_BeginTransaction() / e_EndTransaction() is a transaction of its own
+ *
+ * -- Costs time in the size of the edit, not of the region
+ * -- Returns 1 if anything changed
+ */
+int e_Undo( World_t* map );
+int e_Redo( World_t* map );
+void e_BeginTransaction( void );
+void e_EndTransaction( void );
+
+/*
+ * Brush strokes for WEM_BRUSH, call e_BrushInput() every frame before
+ * a_DoInput() while the mode is active
+ *
+ * -- Peeks at every queued mouse event, the points in between are joined
+ *    with Bresenham lines so fast drags leave no gaps
+ * -- The cells stamped in one frame are written as one box, press to
+ *    release of BRUSH_BUTTON is one undo transaction
+ * -- e_EndBrushStroke() writes and closes a stroke still in progress, it
+ *    must be called whenever the brush stops getting input before the
+ *    button is released ( Esc, another mode, the LOD view )
+ * -- e_BrushSizeStep() grows or shrinks the footprint between 1 and
+ *    BRUSH_MAX_SIZE cells, e_ToggleBrushShape() switches square / round
+ */
+void e_BrushInput( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                   int fg );
+void e_EndBrushStroke( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                       int fg );
+void e_BrushSizeStep( int step );
+void e_ToggleBrushShape( void );
+void e_DrawBrushCursor( World_t* map, WorldPosition_t pos );
+
+/*
+ * Region and world cell summaries, kept up to date by every write that goes
+ * through e_TilesWillChange() / e_TilesChanged()
+ *
+ * -- Glyph, fg, bg, elevation and temperature are counted over every tile,
+ *    SUMMARY_SURFACE over the top non-empty tile of each column with the
+ *    value ( glyph << 16 ) | ( fg << 8 ) | bg
+ * -- A world cell is summarised on first use, after that an edit costs
+ *    time in the size of the box, never a rescan of the region
+ * -- The region tile and the world cell tile above an edit are derived
+ *    from the summaries, the surface majority gives glyph, fg and bg, the
+ *    means elevation and temperature, half or more passable tiles make
+ *    it passable
+ * -- e_SummaryCount() of 0 means the region has no such tile, so searches
+ *    can skip it without looking at the tiles
+ */
+enum
+{
+  SUMMARY_GLYPH = 1,
+  SUMMARY_FG,
+  SUMMARY_BG,
+  SUMMARY_ELEVATION,
+  SUMMARY_TEMPERATURE,
+  SUMMARY_SURFACE
+};
+
+TileSummary_t* e_RegionSummary( World_t* map, int world_index,
+                                int region_index );
+TileSummary_t* e_WorldCellSummary( World_t* map, int world_index );
+uint32_t e_SummaryCount( TileSummary_t* summary, int kind, uint32_t value );
+int e_SummaryMode( TileSummary_t* summary, int kind, uint32_t* value );
+int e_SummaryRange( TileSummary_t* summary, int kind, uint32_t* min,
+                    uint32_t* max );
+
+/*
+ * Find or replace every local tile matching a predicate, across the whole
+ * world or a subtree of it
+ *
+ * -- world_index and region_index of -1 take every world cell / region
+ * -- e_MatchAnyTile() fills a query that matches everything, narrow it from
+ *    there
+ * -- Every region keeps a mask of the glyphs, colours and ranges it holds,
+ *    regions that cannot match are skipped without reading their tiles
+ * -- The rest are scanned on the worker pool one world cell per job, the
+ *    writes of a replace are then done in one transaction, one box per
+ *    region
+ * -- e_FindTiles() returns the number of matches and the first one in
+ *    `first` when it is not NULL
+ */
+void e_MatchAnyTile( TileQuery_t* query );
+int e_FindTiles( World_t* map, TileQuery_t* query, int world_index,
+                 int region_index, WorldPosition_t* first );
+int e_ReplaceTiles( World_t* map, TileQuery_t* query, int world_index,
+                    int region_index, int glyph, int bg, int fg );
+
+/*
+ * Bucket fill, every tile connected to the one at `pos` with the same
+ * glyph, fg and bg takes the new glyph, bg and fg
+ *
+ * -- Scanline fill on an explicit stack, every tile is claimed at most once
+ *    and written once
+ * -- At LOCAL_LEVEL the fill crosses into every loaded neighbouring region,
+ *    `bounded` keeps it on the z of `pos`, otherwise it spreads up and down
+ * -- One transaction, a single undo reverts the whole fill
+ * -- Returns the number of tiles changed
+ */
+int e_FloodFill( World_t* map, WorldPosition_t pos, int glyph, int bg,
+                 int fg, int bounded );
+
+/*
+ * Apply a script of edits to the current map, one command per line
+ *
+ * -- new <world> <region> <local> <z> makes an empty world of small,
+ *    medium or large sizes, load / save <file> read and write map files
+ * -- generate <seed> fills the world with weg_GenerateWorld()
+ * -- A box is <level> <world> <region> <x> <y> <z> <w> <h> <d>, a position
+ *    the first six of those, level is world, region or local
+ * -- fill <box> <glyph> <bg> <fg>, replace <box> <glyph> <bg> <fg> <glyph>
+ *    <bg> <fg>, replace_all <world> <region> <glyph> <bg> <fg> <glyph> <bg>
+ *    <fg>, flood <position> <glyph> <bg> <fg> <bounded>, copy <box>,
+ *    paste <position>, undo and redo
+ * -- prefabs <file> opens a prefab library, prefab_save <name> adds the
+ *    clipboard to it, stamp <name> <position> <degrees> <mirror> places one
+ * -- Each command calls the same function as the edit mode, so undo,
+ *    summaries and thumbnails follow a script like they follow the mouse
+ * -- Returns 0 when every command ran, otherwise the line that failed, -1
+ *    if the script could not be opened
+ */
+int e_RunWorldScript( const char* filename );
 
 #endif
 
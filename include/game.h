@@ -8,6 +8,8 @@
 
 #include "Archimedes.h"
 #include "structs.h"
+#include "draw_list.h"
+#include "glyph_atlas.h"
 
 #ifndef __GAME_H__
 #define __GAME_H__
@@ -30,11 +32,12 @@ void e_GetCellAtMouse( int width, int height, int originx, int originy,
 
 void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos );
 
-
-GlyphArray_t* e_InitGlyphs( const char* filename, int glyph_width,
-                            int glyph_height );
-
 void e_MapMouseCheck( World_t* map, WorldPosition_t* pos );
 
+/*
+ * Record the current view as one glyph span per grid column
+ */
+void g_RecordWorldView( DrawList_t* list, World_t* map, WorldPosition_t pos );
+
 #endif
 
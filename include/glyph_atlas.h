@@ -0,0 +1,46 @@
+/*
+ * glyph_atlas.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __GLYPH_ATLAS_H__
+#define __GLYPH_ATLAS_H__
+
+#include "structs.h"
+
+/*
+ * Load the glyph atlas, building it from the code page PNGs if needed
+ *
+ * `atlas_filename` - Binary atlas cache to read, (re)written on rebuild
+ * `page_filenames` - Code page font strips, packed in this order
+ * `num_pages` - Number of code pages, at most GLYPH_MAX_PAGES
+ * `glyph_width` - Width of one glyph in the font strips
+ * `glyph_height` - Height of one glyph in the font strips
+ *
+ * -- The cache holds the packed RGBA pixels and the rect table, loading it
+ *    is one read and one texture upload
+ * -- The cache is rebuilt when any source PNG changed size or mtime, when
+ *    the page list differs or when the file is missing or corrupt
+ * -- A missing source PNG is not an error as long as the cache is valid
+ * -- Glyphs of page p start at glyphs->page_start[p], see e_GlyphIndex
+ * -- Returns NULL on failure
+ */
+GlyphArray_t* e_LoadGlyphAtlas( const char* atlas_filename,
+                                const char* page_filenames[], int num_pages,
+                                int glyph_width, int glyph_height );
+
+/*
+ * Free a glyph atlas and its texture
+ */
+void e_FreeGlyphAtlas( GlyphArray_t* glyphs );
+
+/*
+ * Atlas rect index of `glyph` in code page `page`
+ */
+int e_GlyphIndex( GlyphArray_t* glyphs, int page, int glyph );
+
+#endif
+
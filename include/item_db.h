@@ -0,0 +1,135 @@
+#include "structs.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef __ITEM_DB_H__
+#define __ITEM_DB_H__
+
+// =============================================================================
+// LOADING & SAVING
+// =============================================================================
+
+/*
+ * Load the item database, from its compiled cache when it is up to date
+ *
+ * `source_path` - JSON item definitions, e.g. ITEM_DB_FILE
+ * `cache_path` - Compiled cache, e.g. ITEM_DB_CACHE_FILE, NULL to not use one
+ *
+ * `int` - Number of item definitions loaded, or -1 on failure
+ *
+ * -- The cache is mapped and used in place, startup does no parsing
+ * -- The cache is rebuilt when the source's size or modification time change
+ * -- With no source on disk an existing cache is still used
+ * -- Replaces whatever database was loaded before
+ */
+int load_item_database(const char* source_path, const char* cache_path);
+
+/*
+ * Write the loaded item definitions back out as JSON
+ *
+ * `path` - File to write, e.g. ITEM_DB_FILE
+ *
+ * `bool` - True if every definition was written
+ *
+ * -- Definitions are written sorted by id, "type" first in each object
+ * -- Material properties are only written when they aren't all 1.0
+ * -- The cache goes stale with the source and is rebuilt on the next load
+ */
+bool save_item_database(const char* path);
+
+/*
+ * Free the loaded item definitions, unmapping the cache
+ *
+ * -- Items created from the definitions are not affected
+ */
+void destroy_item_database(void);
+
+/*
+ * Check if the definitions were mapped from the compiled cache
+ *
+ * `bool` - True if the cache was used, false if the source was parsed
+ */
+bool is_item_database_cached(void);
+
+// =============================================================================
+// ITEM DEFINITIONS
+// =============================================================================
+
+/*
+ * Get the number of loaded item definitions
+ *
+ * `uint32_t` - Definition count
+ */
+uint32_t get_item_def_count(void);
+
+/*
+ * Get an item definition by position
+ *
+ * `index` - Position in the database, definitions are sorted by id
+ *
+ * `const ItemDef_t*` - The definition, or NULL if index is out of range
+ */
+const ItemDef_t* get_item_def(uint32_t index);
+
+/*
+ * Find an item definition by id
+ *
+ * `id` - Id to look for (must be null-terminated)
+ *
+ * `const ItemDef_t*` - The definition, or NULL if there is none
+ *
+ * -- Binary search, the database is kept sorted by id
+ */
+const ItemDef_t* find_item_def(const char* id);
+
+/*
+ * Add an item definition, or replace the one with the same id
+ *
+ * `def` - Definition to copy into the database
+ *
+ * `bool` - True if stored, false if its id, name or type is invalid
+ *
+ * -- A mapped cache is copied to memory before the first change
+ * -- Pointers from get_item_def() and find_item_def() become invalid
+ */
+bool set_item_def(const ItemDef_t* def);
+
+/*
+ * Remove an item definition
+ *
+ * `id` - Id of the definition to remove (must be null-terminated)
+ *
+ * `bool` - True if a definition was removed
+ *
+ * -- Pointers from get_item_def() and find_item_def() become invalid
+ */
+bool remove_item_def(const char* id);
+
+/*
+ * Create an item from its definition
+ *
+ * `def` - Definition to create the item from
+ *
+ * `Item_t*` - New item, or NULL if creation fails
+ *
+ * -- Goes through the create_* functions, so the current item pool is used
+ * -- Consumables need their effect registered with register_item_effect()
+ * -- Must be destroyed with destroy_item()
+ */
+Item_t* create_item_from_def(const ItemDef_t* def);
+
+/*
+ * Give a consumable effect a name item definitions can refer to
+ *
+ * `name` - Name used as "effect" in the JSON source
+ * `on_consume` - Function called when the item is consumed
+ *
+ * `bool` - True if registered, false if the table is full or input is NULL
+ *
+ * -- Registering a name again replaces its function
+ * -- At most MAX_ITEM_EFFECTS names
+ */
+bool register_item_effect(const char* name, void (*on_consume)(uint8_t));
+
+#endif
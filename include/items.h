@@ -154,10 +154,11 @@ void destroy_lock(Lock_t* lock);
  *
  * `item` - Pointer to item to destroy
  *
- * -- Currently performs basic memory cleanup
+ * -- Frees the item and, for keys, their copy of the lock strings
  * -- Safe to call with NULL pointer (does nothing)
- * -- Does not handle complex cleanup of internal dString_t fields (potential memory leak)
- * -- TODO: Implement proper cleanup of all dynamically allocated fields
+ * -- Interned strings stay, they are shared with other items
+ * -- Items from a pool go back to it instead of the heap
+ * -- A pooled item destroyed twice, or after its pool was cleared, is ignored
  * -- After calling, the item pointer becomes invalid
  */
 void destroy_item(Item_t* item);
@@ -897,4 +898,316 @@ void trigger_consumable_duration_end(Item_t* item);
  */
 bool can_key_open_lock(const Item_t* key, const Lock_t* lock);
 
-#endif
\ No newline at end of file
+// =============================================================================
+// ITEM PROTOTYPES & INSTANCES
+// =============================================================================
+
+/*
+ * Register an item as the shared definition for every instance of it
+ *
+ * `item` - Item from one of the create_* functions, ownership moves to the registry
+ *
+ * `uint16_t` - Prototype handle, or ITEM_PROTOTYPE_NONE on failure
+ *
+ * -- The registry destroys the item in destroy_item_prototypes()
+ * -- Fails if item is NULL, its id is already registered or the registry is full
+ * -- On failure the caller still owns the item
+ * -- Handles stay valid until destroy_item_prototypes() is called
+ */
+uint16_t register_item_prototype(Item_t* item);
+
+/*
+ * Find the prototype registered under an item ID
+ *
+ * `id` - Item ID to look up (must be null-terminated)
+ *
+ * `uint16_t` - Prototype handle, or ITEM_PROTOTYPE_NONE if not registered
+ */
+uint16_t find_item_prototype(const char* id);
+
+/*
+ * Get the shared definition behind a prototype handle
+ *
+ * `handle` - Handle from register_item_prototype() or find_item_prototype()
+ *
+ * `const Item_t*` - Prototype item, or NULL if the handle is not registered
+ *
+ * -- The prototype is read only, per item state lives in ItemInstance_t
+ */
+const Item_t* get_item_prototype(uint16_t handle);
+
+/*
+ * Get the number of registered prototypes
+ *
+ * `uint16_t` - Prototype count, handles run from 0 to count - 1
+ */
+uint16_t get_item_prototype_count(void);
+
+/*
+ * Destroy every registered prototype and empty the registry
+ *
+ * -- Instances and inventory slots made from prototypes must not be used after
+ * -- Safe to call on an empty registry
+ */
+void destroy_item_prototypes(void);
+
+/*
+ * Create an item instance of a registered prototype
+ *
+ * `handle` - Prototype handle
+ * `quantity` - Number of items in this instance (1-255)
+ *
+ * `ItemInstance_t` - New instance, prototype is ITEM_PROTOTYPE_NONE on failure
+ *
+ * -- Durability and enchant value start at the prototype's values
+ * -- Quantity is capped at the prototype's max stack size (1 if it can't stack)
+ * -- Nothing is allocated, instances can be copied and dropped freely
+ */
+ItemInstance_t create_item_instance(uint16_t handle, uint8_t quantity);
+
+/*
+ * Get the shared definition of an instance
+ *
+ * `instance` - Pointer to item instance
+ *
+ * `const Item_t*` - Prototype item, or NULL if instance is NULL or empty
+ */
+const Item_t* get_instance_prototype(const ItemInstance_t* instance);
+
+/*
+ * Reduce an instance's durability, see damage_item_durability()
+ *
+ * `instance` - Pointer to item instance to damage
+ * `damage` - Amount of durability damage to apply (0-65535)
+ *
+ * -- Only weapons and armor degrade, the prototype's material may resist
+ */
+void damage_item_instance(ItemInstance_t* instance, uint16_t damage);
+
+/*
+ * Restore an instance's durability, see repair_item()
+ *
+ * `instance` - Pointer to item instance to repair
+ * `repair_amount` - Amount of durability to restore (0-65535)
+ */
+void repair_item_instance(ItemInstance_t* instance, uint16_t repair_amount);
+
+/*
+ * Check if an instance is broken (durability = 0)
+ *
+ * `instance` - Pointer to item instance to check
+ *
+ * `bool` - true if broken, NULL or empty, false otherwise
+ */
+bool is_item_instance_broken(const ItemInstance_t* instance);
+
+/*
+ * Get the weight of every item in an instance
+ *
+ * `instance` - Pointer to item instance
+ *
+ * `float` - Prototype weight times quantity, or 0.0f if NULL or empty
+ */
+float get_item_instance_weight(const ItemInstance_t* instance);
+
+/*
+ * Add an instance to an inventory, see add_item_to_inventory()
+ *
+ * `inventory` - Pointer to target inventory
+ * `instance` - Pointer to item instance to add
+ *
+ * `bool` - true if the whole quantity was added, false otherwise
+ *
+ * -- The slot gets a copy of the prototype with the instance's durability
+ *    and enchant value, its strings are shared with the prototype
+ */
+bool add_item_instance_to_inventory(Inventory_t* inventory, const ItemInstance_t* instance);
+
+// =============================================================================
+// ITEM POOLS
+// =============================================================================
+
+/*
+ * Create an empty item pool
+ *
+ * `ItemPool_t*` - Pointer to the new pool, or NULL if allocation fails
+ *
+ * -- Items are carved from slabs of ITEM_POOL_SLAB_SIZE, allocated as needed
+ * -- Pass it to set_item_pool() so the create_* functions use it
+ */
+ItemPool_t* create_item_pool(void);
+
+/*
+ * Make the create_* functions take their items from a pool
+ *
+ * `pool` - Pool to allocate from, NULL to go back to malloc
+ *
+ * `ItemPool_t*` - The pool that was set before, restore it when done
+ *
+ * -- destroy_item() always gives an item back to the pool it came from
+ */
+ItemPool_t* set_item_pool(ItemPool_t* pool);
+
+/*
+ * Release every item of a pool at once, keeping its slabs for reuse
+ *
+ * `pool` - Pool to clear
+ *
+ * -- Much cheaper than destroying the items one by one, e.g. a level's loot
+ * -- Every item from the pool is invalid afterwards, destroying one does nothing
+ *    until its slot is handed out again
+ */
+void clear_item_pool(ItemPool_t* pool);
+
+/*
+ * Release every item of a pool and free the pool
+ *
+ * `pool` - Pool to destroy
+ *
+ * -- If it is the current pool the create_* functions go back to malloc
+ */
+void destroy_item_pool(ItemPool_t* pool);
+
+/*
+ * Get the number of items alive in a pool
+ *
+ * `pool` - Pool to check
+ *
+ * `uint32_t` - Items created from the pool and not yet destroyed
+ */
+uint32_t get_item_pool_count(const ItemPool_t* pool);
+
+// =============================================================================
+// STRING INTERNING
+// =============================================================================
+
+/*
+ * Get the atom of a string, storing one shared copy the first time it is seen
+ *
+ * `str` - String to intern (must be null-terminated)
+ *
+ * `uint32_t` - Atom of the string, or ATOM_NONE if str is NULL or allocation fails
+ *
+ * -- Equal strings always get the same atom, compare atoms instead of text
+ * -- Item names, ids, rarities, descriptions and material names are interned
+ * -- Only a string not seen before allocates
+ */
+uint32_t intern_string(const char* str);
+
+/*
+ * Get the atom of a string without interning it
+ *
+ * `str` - String to look up (must be null-terminated)
+ *
+ * `uint32_t` - Atom of the string, or ATOM_NONE if it was never interned
+ *
+ * -- An id that was never interned can't belong to any item
+ */
+uint32_t find_interned_string(const char* str);
+
+/*
+ * Get the text behind an atom
+ *
+ * `atom` - Atom from intern_string()
+ *
+ * `const char*` - Interned string, or NULL if the atom is unknown
+ */
+const char* get_interned_string(uint32_t atom);
+
+/*
+ * Get the number of distinct strings interned
+ *
+ * `uint32_t` - Interned string count
+ */
+uint32_t get_interned_string_count(void);
+
+/*
+ * Free every interned string
+ *
+ * -- Every item's name, id, description, rarity and material name is freed
+ * -- Destroy all items, prototypes and inventories holding them first
+ * -- The material registry is cleared as well
+ */
+void destroy_interned_strings(void);
+
+// =============================================================================
+// MATERIAL REGISTRY
+// =============================================================================
+
+/*
+ * Register a material so items can refer to it by a small id
+ *
+ * `name` - Name of the material (must be null-terminated)
+ * `properties` - Property multipliers of the material
+ *
+ * `uint8_t` - Material id, or MATERIAL_NONE if name is NULL or the registry is full
+ *
+ * -- Registering a name again replaces its properties and keeps its id
+ * -- Factors of all materials live in one table indexed by id
+ * -- At most MAX_MATERIALS - 1 materials
+ */
+uint8_t register_material(const char* name, MaterialProperties_t properties);
+
+/*
+ * Find the id of a registered material
+ *
+ * `name` - Name of the material (must be null-terminated)
+ *
+ * `uint8_t` - Material id, or MATERIAL_NONE if it was never registered
+ */
+uint8_t find_material(const char* name);
+
+/*
+ * Get a registered material to create items with
+ *
+ * `id` - Material id from register_material()
+ *
+ * `Material_t` - The material, or the default material if id is unknown
+ *
+ * -- The name is the interned copy, the material needs no cleanup
+ * -- Unlike create_material() nothing is allocated, use it for bulk creation
+ */
+Material_t get_material(uint8_t id);
+
+/*
+ * Get the property multipliers of a registered material
+ *
+ * `id` - Material id from register_material()
+ *
+ * `const MaterialProperties_t*` - Entry in the factor table, or NULL if id is unknown
+ *
+ * -- Pointer stays valid, registering the material again changes what it points at
+ */
+const MaterialProperties_t* get_material_properties(uint8_t id);
+
+/*
+ * Get the number of registered materials
+ *
+ * `uint32_t` - Material count
+ */
+uint32_t get_material_count(void);
+
+/*
+ * Forget every registered material
+ *
+ * -- Items keep the material data they were given
+ */
+void clear_material_registry(void);
+
+/*
+ * Apply materials to an array of items in a single pass
+ *
+ * `items` - Items to modify, NULL entries are skipped
+ * `material_ids` - Material id for each item, NULL to use each item's own material
+ * `count` - Number of items (and material ids)
+ *
+ * `uint32_t` - Number of items the material was applied to
+ *
+ * -- Same result as apply_material_to_weapon(), _armor() and _ammunition() per item
+ * -- Items given an id take that material's name, id and properties
+ * -- Keys, consumables and items with an unknown id are left unchanged
+ * -- Logs once for the whole array instead of once per item
+ */
+uint32_t apply_materials_to_items(Item_t** items, const uint8_t* material_ids, uint32_t count);
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * jobs.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __JOBS_H__
+#define __JOBS_H__
+
+#include "structs.h"
+
+/*
+ * Start `count` worker threads, 0 picks one less than the CPU count
+ *
+ * -- Capped at JOBS_MAX_THREADS, calling it again does nothing
+ * -- With no workers ( one CPU or a failed start ) every job runs inline in
+ *    g_PushJob, callers never need a second code path
+ * -- Returns 0 on success, 1 if the queue lock could not be created
+ */
+int g_InitJobs( int count );
+
+/*
+ * Stop the workers after the queued jobs have run
+ */
+void g_ShutdownJobs( void );
+
+/*
+ * Queue `func( data )` on the next free worker, jobs start in push order
+ */
+void g_PushJob( JobFunc_t func, void* data );
+
+/*
+ * Block until every pushed job has finished
+ */
+void g_WaitJobs( void );
+
+#endif
+
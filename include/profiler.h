@@ -0,0 +1,92 @@
+/*
+ * profiler.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <stdint.h>
+
+#include "structs.h"
+
+/*
+ * Time the statement or block that follows as zone `name`
+ *
+ * -- `name` must be a string literal, only the pointer is stored
+ * -- Runs the body exactly once, `return`, `break` or `goto` out of the
+ *    body skip the end of the zone so the sample is dropped
+ * -- Safe from any thread, samples go into a lock-free ring
+ *
+ *   PROF_ZONE( "paste" )
+ *   {
+ *     e_PasteClipboard( map, pos );
+ *   }
+ */
+#define PROF_ZONE( name )\
+  for ( uint64_t prof_start_ = g_ProfNow(), prof_once_ = 1; prof_once_;\
+        prof_once_ = 0, g_ProfZoneEnd( name, prof_start_ ) )
+
+/*
+ * Same as PROF_ZONE for one of the PROF_PHASE_* frame phases, the time is
+ * also added to the phase's total for the overlay
+ *
+ * -- A phase opened inside another on the same thread ( a delegate's
+ *    a_DoInput() inside the logic phase ) is taken out of the outer total,
+ *    so the phases add up to the frame
+ * -- The body must not be left with `return`, `break` or `goto`, the
+ *    nesting would no longer match
+ */
+#define PROF_PHASE( phase )\
+  for ( uint64_t prof_start_ = g_ProfPhaseBegin(), prof_once_ = 1;\
+        prof_once_; prof_once_ = 0, g_ProfPhaseEnd( phase, prof_start_ ) )
+
+/*
+ * Fix the clock g_ProfNow() counts from
+ *
+ * -- Must run before a second thread can time anything, g_InitJobs() and
+ *    the threaded main loop call it before they start theirs
+ * -- Calling it again does nothing, single threaded programs may leave it
+ *    to the first g_ProfNow()
+ */
+void g_ProfInit( void );
+
+/*
+ * Nanoseconds since g_ProfInit()
+ */
+uint64_t g_ProfNow( void );
+
+void g_ProfZoneEnd( const char* name, uint64_t start_ns );
+uint64_t g_ProfPhaseBegin( void );
+void g_ProfPhaseEnd( int phase, uint64_t start_ns );
+
+/*
+ * Close the frame, call once at the end of every main loop iteration
+ *
+ * -- Pushes the frame time and the phase totals into the history
+ * -- PROF_OVERLAY_KEY toggles the overlay, PROF_DUMP_KEY dumps the last
+ *    PROF_DUMP_SECONDS to PROF_TRACE_FILE
+ */
+void g_ProfFrame( void );
+
+/*
+ * Draw rolling p50 / p99 per phase and a frame time graph, call between
+ * the delegate draw and a_PresentScene
+ *
+ * -- Does nothing while the overlay is hidden
+ */
+void g_ProfDrawOverlay( void );
+
+/*
+ * Write the samples of the last `seconds` as Chrome trace event JSON
+ *
+ * -- Load the file in chrome://tracing or ui.perfetto.dev
+ * -- Returns 0 on success, 1 if the file could not be written
+ */
+int g_ProfDumpTrace( const char* filename, double seconds );
+
+#endif
+
@@ -16,5 +16,14 @@ World_t* LoadWorld( const char* filename );
 World_t* LoadPartialWorld( const char* filename );
 int LoadPartialRegion( WorldPosition_t* pos, World_t* world, const char* filename );
 
+/*
+ * Read the thumbnail section of a world file, one byte per local column of
+ * every region in world then region order
+ *
+ * -- Returns NULL for version 1 files, they have no thumbnails
+ * -- The caller owns the returned buffer
+ */
+uint8_t* LoadThumbnails( const char* filename );
+
 #endif
 
@@ -41,9 +41,12 @@ typedef enum
 
 typedef struct
 {
-  SDL_Rect rects[MAX_GLYPHS];
+  SDL_Rect rects[GAME_MAX_GLYPHS];
   SDL_Texture* texture;
   int count;
+  int num_pages;
+  int page_start[GLYPH_MAX_PAGES];
+  int page_count[GLYPH_MAX_PAGES];
 
 } GlyphArray_t;
 
@@ -122,22 +125,279 @@ typedef struct // WorldObject_t
 
 } WorldObject_t;
 
+// Box of tiles on one level: x, y, w, h are in cells of that level, z and d
+// are only used on LOCAL_LEVEL
 typedef struct
 {
-  int* data;
-  int count;
-  uint8_t w, h;
-  uint8_t world_index;
-  uint8_t region_index;
-  uint16_t local_index;
+  uint16_t world_index;
+  uint16_t region_index;
   uint8_t level;
-} GameTileArray_t;
+  uint8_t x, y, z;
+  uint8_t w, h, d;
+
+} TileRect_t;
+
+// Undo journal, one entry per e_TilesWillChange / e_TilesChanged pair
+typedef struct
+{
+  uint16_t count;
+  GameTile_t tile;
+
+} TileRun_t;
+
+typedef struct
+{
+  TileRect_t rect;
+  uint32_t transaction; // entries of one transaction undo together
+  int num_old_runs;
+  int num_new_runs;
+  TileRun_t* runs;      // old runs followed by new runs
+  size_t bytes;
+
+} UndoEntry_t;
+
+// Copied tiles, one palette index per tile in e_CopyRect() order
+typedef struct
+{
+  uint8_t w, h, d;
+  uint8_t wide;          // cells are uint16_t, otherwise uint8_t
+  int num_palette;
+  GameTile_t* palette;
+  void* cells;
+
+} Clipboard_t;
+
+// Bucket fill, x and y of a seed are global at LOCAL_LEVEL
+typedef struct
+{
+  uint16_t x, y;
+  uint8_t z;
+
+} FillSeed_t;
+
+typedef struct
+{
+  int slot;          // world_index * region count + region_index
+  uint8_t* visited;  // one bit per claimed tile, same index as the tiles
+  uint8_t min_x, min_y, min_z;
+  uint8_t max_x, max_y, max_z;
+
+} FillRegion_t;
+
+// Tile statistics of a region or of a whole world cell, every count is a
+// bin of one open addressed table keyed by ( SUMMARY_* kind << 32 ) | value
+typedef struct
+{
+  uint64_t key;      // 0 is an empty slot
+  uint32_t count;
+
+} SummaryBin_t;
+
+typedef struct
+{
+  SummaryBin_t* bins;     // NULL until the summary is built
+  int num_bins, used_bins;
+  uint32_t count;         // tiles
+  uint32_t passable;
+  uint32_t columns;       // columns with a non-empty tile
+  uint64_t sum_elevation, sum_temperature;
+
+} TileSummary_t;
+
+// Tile predicate for e_FindTiles() / e_ReplaceTiles(), ranges are
+// inclusive, a negative glyph or passable matches anything
+typedef struct
+{
+  int glyph;
+  uint8_t fg_min, fg_max;
+  uint8_t bg_min, bg_max;
+  uint8_t elevation_min, elevation_max;
+  uint8_t temperature_min, temperature_max;
+  int passable;
+
+} TileQuery_t;
+
+// What a region may hold, a superset between scans since writes only add
+typedef struct
+{
+  uint8_t valid;
+  uint8_t glyphs[GAME_MAX_GLYPHS / 8];  // glyph % GAME_MAX_GLYPHS
+  uint8_t fg[32], bg[32];
+  uint8_t elevation_min, elevation_max;
+  uint8_t temperature_min, temperature_max;
+  uint8_t any_passable, any_blocked;
+
+} RegionMask_t;
+
+// Matches of one region, the box is only set when count > 0
+typedef struct
+{
+  uint32_t count;
+  uint32_t first;    // lowest matching tile index
+  uint8_t min_x, min_y, min_z;
+  uint8_t max_x, max_y, max_z;
+
+} QueryHit_t;
+
+// World generation, the tile a column gets for its elevation, temperature
+// and moisture
+typedef struct
+{
+  uint16_t glyph;
+  uint8_t fg, bg;
+  uint8_t is_passable;
+
+} Biome_t;
+
+// Prefab library file, the header is followed by the prefabs, each a
+// palette then one index per tile like Clipboard_t, then the index
+typedef struct
+{
+  char magic[8];
+  uint16_t version;
+  uint32_t count;
+  uint32_t index_offset;
+
+} PrefabHeader_t;
+
+typedef struct
+{
+  char name[PREFAB_NAME_LENGTH];
+  uint8_t w, h, d;
+  uint32_t num_palette;
+  uint32_t offset;
+
+} PrefabEntry_t;
+
+typedef struct
+{
+  PrefabEntry_t entry;
+  Clipboard_t tiles;      // cells is NULL until the prefab is first used
+  SDL_Texture* preview;   // one pixel per column, made on first draw
+
+} Prefab_t;
+
+// Headless ANSI rendering, fg/bg index AnsiRenderer_t.palette
+typedef struct
+{
+  uint16_t glyph;
+  uint8_t fg;
+  uint8_t bg;
+
+} AnsiCell_t;
+
+typedef struct
+{
+  int width, height;
+  int truecolor;
+  int full_redraw;
+
+  AnsiCell_t* cells;
+  AnsiCell_t* previous;
+
+  aColor_t palette[ANSI_PALETTE_SIZE];
+  uint8_t xterm[ANSI_PALETTE_SIZE]; // nearest 256 colour index
+
+  char* out;
+  size_t out_len, out_cap;
+
+} AnsiRenderer_t;
+
+// Draw command lists, recorded by the logic and replayed with SDL
+enum
+{
+  DRAW_RECT,
+  DRAW_FILLED_RECT,
+  DRAW_GLYPH_SPAN,
+  DRAW_TEXT
+};
+
+typedef struct
+{
+  uint16_t glyph;
+  aColor_t fg;
+  aColor_t bg;
+
+} DrawCell_t;
+
+typedef struct
+{
+  uint8_t type;
+  uint8_t scale;     // glyph span
+  uint8_t font_type; // text
+  uint8_t align;     // text
+  int16_t x, y;
+  int16_t w, h;      // rects, for glyph spans the step between cells
+  aColor_t color;
+  uint32_t first;    // first cell of a span or offset of the text
+  uint32_t count;    // cells in the span
+
+} DrawCommand_t;
+
+typedef struct
+{
+  DrawCommand_t* commands;
+  int num_commands, max_commands;
+
+  DrawCell_t* cells;
+  int num_cells, max_cells;
+
+  char* text;
+  int text_len, text_cap;
+
+} DrawList_t;
+
+typedef struct
+{
+  DrawList_t lists[2];
+  int back;      // list the logic is recording into
+  int front;     // last complete list, -1 until the first publish
+  int reading;   // front is being replayed
+  int frame;     // bumped on every publish
+
+  SDL_mutex* lock;
+  SDL_cond* replayed;
+
+} DrawBuffers_t;
+
+// Profiler samples, `name` must be a string literal
+enum
+{
+  PROF_PHASE_INPUT,
+  PROF_PHASE_LOGIC,
+  PROF_PHASE_DRAW,
+  PROF_PHASE_PRESENT,
+  PROF_PHASE_MAX
+};
+
+typedef struct
+{
+  SDL_atomic_t seq; // ring position + 1 once the sample is complete
+  const char* name;
+  uint64_t start_ns;
+  uint32_t duration_ns;
+  uint32_t thread;
+
+} ProfSample_t;
+
+// Worker Pool Structs
+typedef void ( *JobFunc_t )( void* data );
+
+typedef struct
+{
+  JobFunc_t func;
+  void* data;
+
+} Job_t;
+
 
 typedef struct // Lock_t
 {
   dString_t* name;
   dString_t* description;
 
+  uint32_t name_atom; // keys open locks with the same name atom
+
   uint8_t pick_difficulty; // if its 255 it is unpickable
   // TODO: make a timer system and integrate jammed
   uint8_t jammed_seconds; // 0 is unjammed
@@ -164,6 +424,8 @@ typedef struct // Material_t
     // Every Item in our game will have a Material
     // The material will effect properties like weight, damage, armor, stealth, and enchantment
     dString_t* name;
+    uint32_t name_atom;
+    uint8_t id; // registry id, MATERIAL_NONE if it was never registered
 
     MaterialProperties_t properties;
 
@@ -222,6 +484,8 @@ typedef struct // Consumable__Item_t
 
 } Consumable__Item_t;
 
+struct ItemPool_t; // defined below, items only point at their pool
+
 typedef struct
 {
     ItemType_t type;
@@ -237,18 +501,105 @@ typedef struct
 
     char glyph;
 
+    // interned, shared by every item with the same string, never modify
     dString_t* description;
     dString_t* name;
     dString_t* id;
     dString_t* rarity;
 
+    // atoms of the strings above, compare these instead of the text
+    uint32_t name_atom;
+    uint32_t id_atom;
+    uint32_t rarity_atom;
+
     float weight_kg;
 
     uint8_t value_coins;
     uint8_t stackable; // 0 or 1 cannot stack , 255 is max stackable
 
+    struct ItemPool_t* pool; // pool the item came from, NULL if malloc'd
+    uint8_t slot; // ITEM_SLOT_DEAD once a pooled item was given back
+
 } Item_t;
 
+// -- Item pools, items are carved from fixed size slabs and released in bulk
+
+typedef struct ItemSlab_t
+{
+    struct ItemSlab_t* next; // slabs are kept oldest first
+    uint32_t used;
+    Item_t items[ITEM_POOL_SLAB_SIZE];
+
+} ItemSlab_t;
+
+typedef struct ItemPool_t
+{
+    ItemSlab_t* slabs;
+    ItemSlab_t* current_slab; // slab new items are carved from
+    Item_t* free_list; // destroyed items, linked through their first bytes
+    uint32_t live;
+
+} ItemPool_t;
+
+// -- Item instances, the definition lives once in the prototype registry and
+// -- only the state that changes per item is kept here
+
+typedef struct // ItemInstance_t
+{
+    uint16_t prototype; // handle from register_item_prototype()
+    uint8_t durability; // 255 is 100%
+    uint8_t enchant_value;
+    uint8_t quantity;
+
+} ItemInstance_t;
+
+// -- Item definitions, what the item database holds for each item. Plain
+// -- fixed size data so the compiled cache is used in place once mapped
+
+typedef struct // ItemDef_t
+{
+    char id[ITEM_DEF_ID_LENGTH];
+    char name[ITEM_DEF_NAME_LENGTH];
+    char material[MAX_NAME_LENGTH];
+    MaterialProperties_t material_properties;
+
+    uint8_t type; // ItemType_t
+    char glyph;
+
+    union {
+        struct {
+            uint8_t min_damage;
+            uint8_t max_damage;
+            uint8_t range_tiles;
+        } weapon;
+
+        struct {
+            uint8_t armor_value;
+            uint8_t evasion_value;
+            uint8_t stealth_value;
+            uint8_t enchant_value;
+        } armor;
+
+        struct {
+            char lock_name[ITEM_DEF_NAME_LENGTH];
+            char lock_description[MAX_DESCRIPTION_LENGTH];
+            uint8_t pick_difficulty;
+            uint8_t jammed_seconds;
+        } key;
+
+        struct {
+            char effect[MAX_NAME_LENGTH]; // name given to register_item_effect()
+            uint8_t value;
+        } consumable;
+
+        struct {
+            uint8_t min_damage;
+            uint8_t max_damage;
+        } ammo;
+    } data;
+
+} ItemDef_t;
+
 // -- Final Inventory and Slots
 
 typedef struct
@@ -0,0 +1,41 @@
+/*
+ * text_cache.h:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#ifndef __TEXT_CACHE_H__
+#define __TEXT_CACHE_H__
+
+#include "Archimedes.h"
+#include "defs.h"
+
+/*
+ * Draw text through the text texture cache
+ *
+ * `text` - String to draw, same rules as a_DrawText
+ * `x` - Anchor X coordinate, meaning depends on `align`
+ * `y` - Top Y coordinate
+ * `color` - Text colour
+ * `font_type` - Font to rasterize with
+ * `align` - TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER or TEXT_ALIGN_RIGHT
+ *
+ * -- Textures are keyed by ( string, font, colour ) and made once with
+ *    a_GetTextTexture, a hit costs one hash lookup and one texture copy
+ * -- When full the least recently drawn entry is evicted
+ * -- Strings of TEXT_CACHE_MAX_LEN or longer fall back to a_DrawText
+ */
+void g_DrawCachedText( const char* text, int x, int y, aColor_t color,
+                       int font_type, int align );
+
+/*
+ * Destroy every cached text texture
+ *
+ * -- Call before a_Quit and whenever the fonts are reloaded
+ */
+void g_ClearTextCache( void );
+
+#endif
+
@@ -21,6 +21,8 @@ enum
   WEM_PASTE,
   WEM_MASS_CHANGE,
   WEM_SELECT,
+  WEM_FILL,
+  WEM_STAMP,
   WEM_MAX
 };
 
@@ -100,6 +102,21 @@ void we_Load( void );
 void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos,
     WorldPosition_t highlight );
 
+/*
+ * Draw every cell of the current level
+ *
+ * -- Backgrounds go first, runs of same coloured cells along a screen row
+ *    are merged into one filled rect, then every glyph is blitted
+ * -- Prefer this over calling we_DrawWorldCell() per cell
+ */
+void we_DrawWorldCells( World_t* map, WorldPosition_t pos,
+                        WorldPosition_t highlight );
+
+/*
+ * Width and height in cells of `level`
+ */
+void we_GridSize( World_t* map, uint8_t level, int* width, int* height );
+
 void we_DrawEditorHotKeys( int x, int y, int key, int abbv0, int abbv1,
                            int abbv2, int abbv3 );
 
@@ -108,4 +125,118 @@ void wec_GenerateWorld( void );
 void wes_SaveYes( void );
 void wes_SaveNo( void );
 
+/*
+ * Level-of-detail view used when zoom_level drops below 1 at LOCAL_LEVEL
+ *
+ * -- Every region keeps lazily built aggregate levels, one tile per
+ *    2^k x 2^k block, rebuilt per block by wez_LodTilesChanged()
+ * -- wez_DrawLodView() draws the whole world around the current region and
+ *    only visits blocks that are on screen
+ * -- Regions that are not loaded are drawn with their world cell tile
+ * -- wez_ResetLod() must be called whenever map is replaced or freed
+ */
+void wez_DrawLodView( World_t* map, WorldPosition_t pos );
+void wez_LodMouseCheck( World_t* map, WorldPosition_t* pos );
+void wez_LodTilesChanged( World_t* map, TileRect_t rect );
+void wez_ResetLod( void );
+
+/*
+ * Composite local view, each column shows the highest non-empty tile at or
+ * below the current z, darker the further down it is
+ *
+ * -- Every region lazily keeps one z occupancy mask per column, patched per
+ *    column by wed_TilesChanged() so edits never rescan the region
+ * -- wed_TopZ() returns the z to draw for `index`, -1 if the column is empty
+ *    down to 0
+ * -- wed_ResetDepth() must be called whenever map is replaced or freed
+ */
+int wed_TopZ( World_t* map, int world_index, int region_index, int index,
+              int z );
+void wed_TilesChanged( World_t* map, TileRect_t rect );
+void wed_ResetDepth( void );
+aColor_t wed_ShadeColor( aColor_t color, int depth );
+
+/*
+ * Region thumbnails for the world and region views, one pixel per local
+ * column coloured like the column seen from above
+ *
+ * -- wet_QueueThumbnails() builds every world cell whose regions are loaded
+ *    and that has no thumbnail yet on the worker pool
+ * -- wet_AdoptThumbnails() takes the thumbnail section of a world file, so
+ *    the overview draws real content before any region is loaded
+ * -- wet_TilesChanged() redoes only the edited columns, a world cell edited
+ *    while its job runs is built again afterwards
+ * -- wet_DrawThumbnail() returns 0 when the cell has nothing to draw yet
+ * -- wet_CopyThumbnail() fills `out` with the thumbnails of every region of
+ *    a world cell for the save, building them if the cache is behind
+ * -- wet_ResetThumbnails() must be called whenever map is replaced or freed
+ */
+void wet_QueueThumbnails( World_t* map );
+void wet_AdoptThumbnails( World_t* map, uint8_t* pixels );
+void wet_TilesChanged( World_t* map, TileRect_t rect );
+int wet_DrawThumbnail( World_t* map, WorldPosition_t pos, int index,
+                       int x, int y, int w, int h );
+void wet_CopyThumbnail( World_t* map, int world_index, uint8_t* out );
+void wet_ResetThumbnails( void );
+
+/*
+ * Summaries behind e_RegionSummary(), see editor.h
+ *
+ * -- wea_TilesWillChange() takes the box out of the counts before it is
+ *    written, wea_TilesChanged() puts it back and derives the region and
+ *    world cell tiles, undo calls the pair around its own writes
+ * -- wea_DeriveTile() is the only way region and world cell tiles are made
+ *    from local tiles, generation builds its own summaries with
+ *    wea_InitSummary() and wea_CountColumn() and frees their bins itself
+ * -- wea_ResetSummaries() must be called whenever map is replaced or freed
+ */
+void wea_TilesWillChange( World_t* map, TileRect_t rect );
+void wea_TilesChanged( World_t* map, TileRect_t rect );
+int wea_InitSummary( TileSummary_t* summary );
+void wea_CountColumn( World_t* map, TileSummary_t* summary,
+                      GameTile_t* column );
+void wea_DeriveTile( TileSummary_t* summary, GameTile_t* tile );
+void wea_ResetSummaries( void );
+
+/*
+ * Region masks behind e_FindTiles(), see editor.h
+ *
+ * -- weq_TilesChanged() adds what the box now holds to the masks, only a
+ *    scan clears bits again
+ * -- weq_ResetQuery() must be called whenever map is replaced or freed
+ */
+void weq_TilesChanged( World_t* map, TileRect_t rect );
+void weq_ResetQuery( void );
+
+/*
+ * Procedural world, fills every loaded region of map from seeded noise
+ *
+ * -- Elevation, temperature and moisture are fBm gradient noise over the
+ *    global position of each local column, the world cell and region
+ *    *_factor fields multiply elevation and temperature
+ * -- The biome of a column gives its surface glyph, fg and bg, with rock
+ *    below, water up to sea level and air above
+ * -- Region and world tiles are derived from their columns by
+ *    wea_DeriveTile(), so an edit that leaves the local tiles as they were
+ *    leaves them as they were too
+ * -- Every world cell is one job, the same seed and sizes give the same
+ *    tiles whatever the number of workers
+ * -- The LOD, depth, thumbnail, undo, summary and query state of the old
+ *    tiles is reset first, callers need not do it themselves
+ */
+void weg_GenerateWorld( World_t* map, uint32_t seed );
+
+/*
+ * Undo journal behind e_TilesWillChange() / e_TilesChanged()
+ *
+ * -- weu_Snapshot() keeps the old tiles of the box, weu_Commit() pairs them
+ *    with the new ones as one entry, both run-length encoded
+ * -- e_TilesChanged() without a snapshot ( undo itself, generation ) is not
+ *    recorded
+ * -- weu_ResetUndo() must be called whenever map is replaced or freed
+ */
+void weu_Snapshot( World_t* map, TileRect_t rect );
+void weu_Commit( World_t* map );
+void weu_ResetUndo( void );
+
 #endif
@@ -1507,12 +1507,19 @@ run_test "Items creation Destruction" "run-test-items-creation-destruction"
 run_test "Items Durability" "run-test-items-durability"
 run_test "Items Helper Functions" "run-test-items-helper-functions"
 run_test "Items Integration Tests" "run-test-items-integration-tests"
+run_test "Items String Interning" "run-test-items-interning"
+run_test "Items Pools" "run-test-items-pool"
+run_test "Items Database" "run-test-items-database"
+run_test "Items Logging" "run-test-items-logging"
+run_test "Items Materials" "run-test-items-materials"
 run_test "Items Material System" "run-test-items-material-system"
 run_test "Items properties" "run-test-items-properties"
 run_test "Items properties type checking and access" "run-test-items-type-checking"
+run_test "Items Prototypes" "run-test-items-prototypes"
 run_test "Items Usage" "run-test-items-usage"
 run_test "World Editor Basic" "run-test-world-editor-basic"
 run_test "World Editor Advanced" "run-test-world-editor-advanced"
+run_test "World Editor Undo" "run-test-world-editor-undo"
 
 
 # Calculate overall execution time
@@ -0,0 +1,434 @@
+/*
+ * ansi_render.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ansi_render.h"
+
+#define ANSI_GLYPH_SPACE 31
+
+// CP437 code -> unicode, 0x20 - 0x7e are plain ASCII
+static const uint16_t cp437_unicode[256] = {
+  0x0020, 0x263a, 0x263b, 0x2665, 0x2666, 0x2663, 0x2660, 0x2022,
+  0x25d8, 0x25cb, 0x25d9, 0x2642, 0x2640, 0x266a, 0x266b, 0x263c,
+  0x25ba, 0x25c4, 0x2195, 0x203c, 0x00b6, 0x00a7, 0x25ac, 0x21a8,
+  0x2191, 0x2193, 0x2192, 0x2190, 0x221f, 0x2194, 0x25b2, 0x25bc,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x2302,
+  0x00c7, 0x00fc, 0x00e9, 0x00e2, 0x00e4, 0x00e0, 0x00e5, 0x00e7,
+  0x00ea, 0x00eb, 0x00e8, 0x00ef, 0x00ee, 0x00ec, 0x00c4, 0x00c5,
+  0x00c9, 0x00e6, 0x00c6, 0x00f4, 0x00f6, 0x00f2, 0x00fb, 0x00f9,
+  0x00ff, 0x00d6, 0x00dc, 0x00a2, 0x00a3, 0x00a5, 0x20a7, 0x0192,
+  0x00e1, 0x00ed, 0x00f3, 0x00fa, 0x00f1, 0x00d1, 0x00aa, 0x00ba,
+  0x00bf, 0x2310, 0x00ac, 0x00bd, 0x00bc, 0x00a1, 0x00ab, 0x00bb,
+  0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+  0x2555, 0x2563, 0x2551, 0x2557, 0x255d, 0x255c, 0x255b, 0x2510,
+  0x2514, 0x2534, 0x252c, 0x251c, 0x2500, 0x253c, 0x255e, 0x255f,
+  0x255a, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256c, 0x2567,
+  0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256b,
+  0x256a, 0x2518, 0x250c, 0x2588, 0x2584, 0x258c, 0x2590, 0x2580,
+  0x03b1, 0x00df, 0x0393, 0x03c0, 0x03a3, 0x03c3, 0x00b5, 0x03c4,
+  0x03a6, 0x0398, 0x03a9, 0x03b4, 0x221e, 0x03c6, 0x03b5, 0x2229,
+  0x2261, 0x00b1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00f7, 0x2248,
+  0x00b0, 0x2219, 0x00b7, 0x221a, 0x207f, 0x00b2, 0x25a0, 0x00a0
+};
+
+static uint8_t ar_NearestXterm( aColor_t color );
+static void ar_SetColor( AnsiRenderer_t* renderer, int index, aColor_t color );
+static int ar_Reserve( AnsiRenderer_t* renderer, size_t bytes );
+static void ar_Append( AnsiRenderer_t* renderer, const char* fmt, ... );
+static void ar_AppendUtf8( AnsiRenderer_t* renderer, uint32_t code );
+
+AnsiRenderer_t* g_AnsiCreate( int width, int height, int truecolor )
+{
+  if ( width <= 0 || height <= 0 )
+  {
+    printf( "Failed to create ansi renderer %dx%d\n", width, height );
+    return NULL;
+  }
+
+  AnsiRenderer_t* renderer = calloc( 1, sizeof( AnsiRenderer_t ) );
+  if ( renderer == NULL )
+  {
+    printf( "Failed to allocate memory for ansi renderer\n" );
+    return NULL;
+  }
+
+  renderer->width       = width;
+  renderer->height      = height;
+  renderer->truecolor   = truecolor;
+  renderer->full_redraw = 1;
+  renderer->cells    = calloc( width * height, sizeof( AnsiCell_t ) );
+  renderer->previous = calloc( width * height, sizeof( AnsiCell_t ) );
+
+  if ( renderer->cells == NULL || renderer->previous == NULL )
+  {
+    printf( "Failed to allocate memory for ansi cells\n" );
+    g_AnsiDestroy( renderer );
+    return NULL;
+  }
+
+  for ( int i = 0; i < MAX_COLOR_PALETTE; i++ )
+  {
+    uint8_t v = ( i * 255 ) / ( MAX_COLOR_PALETTE - 1 );
+    ar_SetColor( renderer, i, ( aColor_t ){ v, v, v, 255 } );
+  }
+
+  ar_SetColor( renderer, ANSI_COLOR_CURSOR,    ( aColor_t ){ 255, 255, 0, 255 } );
+  ar_SetColor( renderer, ANSI_COLOR_HIGHLIGHT, ( aColor_t ){ 255, 0, 255, 255 } );
+
+  g_AnsiClear( renderer, 0 );
+
+  return renderer;
+}
+
+void g_AnsiDestroy( AnsiRenderer_t* renderer )
+{
+  if ( renderer == NULL )
+  {
+    return;
+  }
+
+  free( renderer->cells );
+  free( renderer->previous );
+  free( renderer->out );
+  free( renderer );
+}
+
+int g_AnsiLoadPalette( AnsiRenderer_t* renderer, const char* filename )
+{
+  char line[16];
+  int i = 0;
+
+  FILE* file = fopen( filename, "rb" );
+  if ( file == NULL )
+  {
+    printf( "Failed to open file %s\n", filename );
+    return 1;
+  }
+
+  while ( fgets( line, sizeof( line ), file ) != NULL &&
+          i < MAX_COLOR_PALETTE )
+  {
+    unsigned int hex_value = ( unsigned int )strtol( line, NULL, 16 );
+    ar_SetColor( renderer, i++, ( aColor_t ){ hex_value >> 16,
+                 hex_value >> 8, hex_value, 255 } );
+  }
+
+  fclose( file );
+  renderer->full_redraw = 1;
+
+  return 0;
+}
+
+void g_AnsiClear( AnsiRenderer_t* renderer, uint8_t bg )
+{
+  AnsiCell_t blank = { ANSI_GLYPH_SPACE, bg, bg };
+
+  for ( int i = 0; i < renderer->width * renderer->height; i++ )
+  {
+    renderer->cells[i] = blank;
+  }
+}
+
+void g_AnsiPut( AnsiRenderer_t* renderer, int x, int y, uint16_t glyph,
+                uint8_t fg, uint8_t bg )
+{
+  if ( x < 0 || y < 0 || x >= renderer->width || y >= renderer->height )
+  {
+    return;
+  }
+
+  renderer->cells[y * renderer->width + x] = ( AnsiCell_t ){ glyph, fg, bg };
+}
+
+void g_AnsiText( AnsiRenderer_t* renderer, int x, int y, const char* text,
+                 uint8_t fg, uint8_t bg )
+{
+  for ( int i = 0; text[i] != '\0' && text[i] != '\n'; i++ )
+  {
+    g_AnsiPut( renderer, x + i, y, ( uint8_t )text[i] - 1, fg, bg );
+  }
+}
+
+void g_AnsiDrawView( AnsiRenderer_t* renderer, World_t* map,
+                     WorldPosition_t pos )
+{
+  int width = 0, height = 0, current = 0;
+  GameTile_t* tiles = NULL;
+  int stride = 1;
+
+  switch ( pos.level )
+  {
+    case WORLD_LEVEL:
+      width   = map->world_width;
+      height  = map->world_height;
+      current = pos.world_index;
+      tiles   = &map[0].tile;
+      stride  = sizeof( World_t );
+      break;
+
+    case REGION_LEVEL:
+      if ( map[pos.world_index].regions == NULL )
+      {
+        return;
+      }
+
+      width   = map->region_width;
+      height  = map->region_height;
+      current = pos.region_index;
+      tiles   = &map[pos.world_index].regions[0].tile;
+      stride  = sizeof( RegionCell_t );
+      break;
+
+    case LOCAL_LEVEL:
+      if ( map[pos.world_index].regions == NULL ||
+           map[pos.world_index].regions[pos.region_index].tiles == NULL )
+      {
+        return;
+      }
+
+      width   = map->local_width;
+      height  = map->local_height;
+      current = pos.local_index;
+      tiles   = &map[pos.world_index].regions[pos.region_index].
+        tiles[pos.local_z * width * height];
+      stride  = sizeof( GameTile_t );
+      break;
+
+    default:
+      return;
+  }
+
+  int origin_x = ( renderer->width  - width  ) / 2;
+  int origin_y = ( renderer->height - height ) / 2;
+
+  for ( int i = 0; i < width * height; i++ )
+  {
+    GameTile_t* tile = ( GameTile_t* )( ( char* )tiles + ( size_t )i * stride );
+    uint8_t bg = ( i == current ) ? ANSI_COLOR_CURSOR : tile->bg;
+
+    g_AnsiPut( renderer, origin_x + ( i / height ), origin_y + ( i % height ),
+               tile->glyph, tile->fg, bg );
+  }
+}
+
+size_t g_AnsiPresent( AnsiRenderer_t* renderer, FILE* out )
+{
+  int cursor_x = -1, cursor_y = -1;
+  int fg = -1, bg = -1;
+
+  renderer->out_len = 0;
+
+  if ( renderer->full_redraw )
+  {
+    ar_Append( renderer, "\x1b[0m\x1b[2J" );
+  }
+
+  for ( int y = 0; y < renderer->height; y++ )
+  {
+    for ( int x = 0; x < renderer->width; x++ )
+    {
+      int i = y * renderer->width + x;
+      AnsiCell_t cell = renderer->cells[i];
+
+      if ( !renderer->full_redraw &&
+           memcmp( &cell, &renderer->previous[i], sizeof( AnsiCell_t ) ) == 0 )
+      {
+        continue;
+      }
+
+      if ( cursor_x != x || cursor_y != y )
+      {
+        ar_Append( renderer, "\x1b[%d;%dH", y + 1, x + 1 );
+      }
+
+      if ( cell.fg != fg || cell.bg != bg )
+      {
+        uint8_t f = cell.fg < ANSI_PALETTE_SIZE ? cell.fg : 0;
+        uint8_t b = cell.bg < ANSI_PALETTE_SIZE ? cell.bg : 0;
+
+        if ( renderer->truecolor )
+        {
+          aColor_t cf = renderer->palette[f];
+          aColor_t cb = renderer->palette[b];
+          ar_Append( renderer, "\x1b[38;2;%d;%d;%d;48;2;%d;%d;%dm",
+                     cf.r, cf.g, cf.b, cb.r, cb.g, cb.b );
+        }
+
+        else
+        {
+          ar_Append( renderer, "\x1b[38;5;%d;48;5;%dm", renderer->xterm[f],
+                     renderer->xterm[b] );
+        }
+
+        fg = cell.fg;
+        bg = cell.bg;
+      }
+
+      ar_AppendUtf8( renderer, g_AnsiGlyphToUnicode( cell.glyph ) );
+      cursor_x = x + 1;
+      cursor_y = y;
+    }
+  }
+
+  if ( renderer->out_len > 0 )
+  {
+    ar_Append( renderer, "\x1b[0m" );
+    fwrite( renderer->out, 1, renderer->out_len, out );
+    fflush( out );
+  }
+
+  memcpy( renderer->previous, renderer->cells,
+          renderer->width * renderer->height * sizeof( AnsiCell_t ) );
+  renderer->full_redraw = 0;
+
+  return renderer->out_len;
+}
+
+void g_AnsiInvalidate( AnsiRenderer_t* renderer )
+{
+  renderer->full_redraw = 1;
+}
+
+uint32_t g_AnsiGlyphToUnicode( uint16_t glyph )
+{
+  if ( glyph >= 255 )
+  {
+    return '?';
+  }
+
+  return cp437_unicode[glyph + 1];
+}
+
+static uint8_t ar_NearestXterm( aColor_t color )
+{
+  static const int levels[6] = { 0, 95, 135, 175, 215, 255 };
+  int best = 16, best_dist = 1 << 30;
+
+  for ( int i = 0; i < 216; i++ )
+  {
+    int dr = levels[i / 36] - color.r;
+    int dg = levels[( i / 6 ) % 6] - color.g;
+    int db = levels[i % 6] - color.b;
+    int dist = dr * dr + dg * dg + db * db;
+
+    if ( dist < best_dist )
+    {
+      best_dist = dist;
+      best = 16 + i;
+    }
+  }
+
+  for ( int i = 0; i < 24; i++ )
+  {
+    int v = 8 + i * 10;
+    int dist = ( v - color.r ) * ( v - color.r ) +
+      ( v - color.g ) * ( v - color.g ) + ( v - color.b ) * ( v - color.b );
+
+    if ( dist < best_dist )
+    {
+      best_dist = dist;
+      best = 232 + i;
+    }
+  }
+
+  return best;
+}
+
+static void ar_SetColor( AnsiRenderer_t* renderer, int index, aColor_t color )
+{
+  renderer->palette[index] = color;
+  renderer->xterm[index]   = ar_NearestXterm( color );
+}
+
+static int ar_Reserve( AnsiRenderer_t* renderer, size_t bytes )
+{
+  if ( renderer->out_len + bytes <= renderer->out_cap )
+  {
+    return 1;
+  }
+
+  size_t cap = renderer->out_cap ? renderer->out_cap : 4096;
+  while ( cap < renderer->out_len + bytes )
+  {
+    cap *= 2;
+  }
+
+  char* out = realloc( renderer->out, cap );
+  if ( out == NULL )
+  {
+    return 0;
+  }
+
+  renderer->out     = out;
+  renderer->out_cap = cap;
+
+  return 1;
+}
+
+static void ar_Append( AnsiRenderer_t* renderer, const char* fmt, ... )
+{
+  char buffer[64];
+  va_list args;
+
+  va_start( args, fmt );
+  int len = vsnprintf( buffer, sizeof( buffer ), fmt, args );
+  va_end( args );
+
+  if ( len > 0 && ar_Reserve( renderer, len ) )
+  {
+    memcpy( renderer->out + renderer->out_len, buffer, len );
+    renderer->out_len += len;
+  }
+}
+
+static void ar_AppendUtf8( AnsiRenderer_t* renderer, uint32_t code )
+{
+  if ( !ar_Reserve( renderer, 4 ) )
+  {
+    return;
+  }
+
+  char* out = renderer->out + renderer->out_len;
+
+  if ( code < 0x80 )
+  {
+    out[0] = code;
+    renderer->out_len += 1;
+  }
+
+  else if ( code < 0x800 )
+  {
+    out[0] = 0xc0 | ( code >> 6 );
+    out[1] = 0x80 | ( code & 0x3f );
+    renderer->out_len += 2;
+  }
+
+  else
+  {
+    out[0] = 0xe0 | ( code >> 12 );
+    out[1] = 0x80 | ( ( code >> 6 ) & 0x3f );
+    out[2] = 0x80 | ( code & 0x3f );
+    renderer->out_len += 3;
+  }
+}
+
@@ -0,0 +1,323 @@
+/*
+ * draw_list.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "draw_list.h"
+#include "text_cache.h"
+
+static int dl_Grow( void** array, int* max, int needed, size_t size );
+static DrawCommand_t* dl_PushCommand( DrawList_t* list, int type );
+
+int g_InitDrawList( DrawList_t* list )
+{
+  memset( list, 0, sizeof( DrawList_t ) );
+
+  list->max_commands = DRAW_LIST_COMMANDS;
+  list->max_cells    = DRAW_LIST_CELLS;
+  list->text_cap     = DRAW_LIST_TEXT;
+
+  list->commands = malloc( sizeof( DrawCommand_t ) * list->max_commands );
+  list->cells    = malloc( sizeof( DrawCell_t ) * list->max_cells );
+  list->text     = malloc( list->text_cap );
+
+  if ( list->commands == NULL || list->cells == NULL || list->text == NULL )
+  {
+    printf( "Failed to allocate memory for draw list\n" );
+    g_FreeDrawList( list );
+    return 1;
+  }
+
+  return 0;
+}
+
+void g_FreeDrawList( DrawList_t* list )
+{
+  free( list->commands );
+  free( list->cells );
+  free( list->text );
+  memset( list, 0, sizeof( DrawList_t ) );
+}
+
+void g_ClearDrawList( DrawList_t* list )
+{
+  list->num_commands = 0;
+  list->num_cells    = 0;
+  list->text_len     = 0;
+}
+
+void g_PushRect( DrawList_t* list, int x, int y, int w, int h,
+                 aColor_t color, int filled )
+{
+  DrawCommand_t* command = dl_PushCommand( list, filled ? DRAW_FILLED_RECT
+                                                        : DRAW_RECT );
+  if ( command == NULL )
+  {
+    return;
+  }
+
+  command->x     = x;
+  command->y     = y;
+  command->w     = w;
+  command->h     = h;
+  command->color = color;
+}
+
+void g_PushGlyphSpan( DrawList_t* list, int x, int y, int dx, int dy,
+                      int scale )
+{
+  DrawCommand_t* command = dl_PushCommand( list, DRAW_GLYPH_SPAN );
+  if ( command == NULL )
+  {
+    return;
+  }
+
+  command->x     = x;
+  command->y     = y;
+  command->w     = dx;
+  command->h     = dy;
+  command->scale = scale;
+  command->first = list->num_cells;
+  command->count = 0;
+}
+
+void g_PushGlyph( DrawList_t* list, uint16_t glyph, aColor_t fg, aColor_t bg )
+{
+  if ( list->num_commands == 0 ||
+       list->commands[list->num_commands - 1].type != DRAW_GLYPH_SPAN )
+  {
+    return;
+  }
+
+  if ( !dl_Grow( ( void** )&list->cells, &list->max_cells,
+                 list->num_cells + 1, sizeof( DrawCell_t ) ) )
+  {
+    return;
+  }
+
+  list->cells[list->num_cells++] = ( DrawCell_t ){ glyph, fg, bg };
+  list->commands[list->num_commands - 1].count++;
+}
+
+void g_PushText( DrawList_t* list, const char* text, int x, int y,
+                 aColor_t color, int font_type, int align )
+{
+  int len = strlen( text ) + 1;
+
+  if ( !dl_Grow( ( void** )&list->text, &list->text_cap,
+                 list->text_len + len, 1 ) )
+  {
+    return;
+  }
+
+  DrawCommand_t* command = dl_PushCommand( list, DRAW_TEXT );
+  if ( command == NULL )
+  {
+    return;
+  }
+
+  command->x         = x;
+  command->y         = y;
+  command->color     = color;
+  command->font_type = font_type;
+  command->align     = align;
+  command->first     = list->text_len;
+
+  memcpy( list->text + list->text_len, text, len );
+  list->text_len += len;
+}
+
+void g_ReplayDrawList( DrawList_t* list, GlyphArray_t* glyphs )
+{
+  for ( int i = 0; i < list->num_commands; i++ )
+  {
+    DrawCommand_t* command = &list->commands[i];
+    aColor_t c = command->color;
+
+    switch ( command->type )
+    {
+      case DRAW_RECT:
+        a_DrawRect( command->x, command->y, command->w, command->h,
+                    c.r, c.g, c.b, c.a );
+        break;
+
+      case DRAW_FILLED_RECT:
+        a_DrawFilledRect( command->x, command->y, command->w, command->h,
+                          c.r, c.g, c.b, c.a );
+        break;
+
+      case DRAW_GLYPH_SPAN:
+      {
+        int x = command->x;
+        int y = command->y;
+
+        for ( uint32_t j = 0; j < command->count; j++ )
+        {
+          DrawCell_t* cell = &list->cells[command->first + j];
+          SDL_Rect rect = glyphs->rects[cell->glyph];
+
+          a_DrawFilledRect( x, y, rect.w * command->scale,
+                            rect.h * command->scale, cell->bg.r, cell->bg.g,
+                            cell->bg.b, cell->bg.a );
+          a_BlitTextureRect( glyphs->texture, rect, x, y, command->scale,
+                             cell->fg );
+
+          x += command->w;
+          y += command->h;
+        }
+        break;
+      }
+
+      case DRAW_TEXT:
+        g_DrawCachedText( list->text + command->first, command->x, command->y,
+                          c, command->font_type, command->align );
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+int g_InitDrawBuffers( DrawBuffers_t* buffers )
+{
+  memset( buffers, 0, sizeof( DrawBuffers_t ) );
+  buffers->back  = 0;
+  buffers->front = -1;
+
+  if ( g_InitDrawList( &buffers->lists[0] ) ||
+       g_InitDrawList( &buffers->lists[1] ) )
+  {
+    g_FreeDrawBuffers( buffers );
+    return 1;
+  }
+
+  buffers->lock     = SDL_CreateMutex();
+  buffers->replayed = SDL_CreateCond();
+  if ( buffers->lock == NULL || buffers->replayed == NULL )
+  {
+    printf( "Failed to create draw buffer lock, %s\n", SDL_GetError() );
+    g_FreeDrawBuffers( buffers );
+    return 1;
+  }
+
+  return 0;
+}
+
+void g_FreeDrawBuffers( DrawBuffers_t* buffers )
+{
+  g_FreeDrawList( &buffers->lists[0] );
+  g_FreeDrawList( &buffers->lists[1] );
+
+  if ( buffers->replayed != NULL )
+  {
+    SDL_DestroyCond( buffers->replayed );
+    buffers->replayed = NULL;
+  }
+
+  if ( buffers->lock != NULL )
+  {
+    SDL_DestroyMutex( buffers->lock );
+    buffers->lock = NULL;
+  }
+}
+
+DrawList_t* g_BeginDrawBuffer( DrawBuffers_t* buffers )
+{
+  // back is never the front list, so the logic owns it without the lock
+  DrawList_t* list = &buffers->lists[buffers->back];
+  g_ClearDrawList( list );
+
+  return list;
+}
+
+void g_PublishDrawBuffer( DrawBuffers_t* buffers )
+{
+  SDL_LockMutex( buffers->lock );
+
+  while ( buffers->reading )
+  {
+    SDL_CondWait( buffers->replayed, buffers->lock );
+  }
+
+  buffers->front = buffers->back;
+  buffers->back  = 1 - buffers->back;
+  buffers->frame++;
+
+  SDL_UnlockMutex( buffers->lock );
+}
+
+DrawList_t* g_AcquireDrawBuffer( DrawBuffers_t* buffers )
+{
+  DrawList_t* list = NULL;
+
+  SDL_LockMutex( buffers->lock );
+
+  if ( buffers->front != -1 )
+  {
+    buffers->reading = 1;
+    list = &buffers->lists[buffers->front];
+  }
+
+  SDL_UnlockMutex( buffers->lock );
+
+  return list;
+}
+
+void g_ReleaseDrawBuffer( DrawBuffers_t* buffers )
+{
+  SDL_LockMutex( buffers->lock );
+  buffers->reading = 0;
+  SDL_CondSignal( buffers->replayed );
+  SDL_UnlockMutex( buffers->lock );
+}
+
+static int dl_Grow( void** array, int* max, int needed, size_t size )
+{
+  if ( needed <= *max )
+  {
+    return 1;
+  }
+
+  int new_max = *max > 0 ? *max : 16;
+  while ( new_max < needed )
+  {
+    new_max *= 2;
+  }
+
+  void* grown = realloc( *array, new_max * size );
+  if ( grown == NULL )
+  {
+    printf( "Failed to grow draw list to %d\n", new_max );
+    return 0;
+  }
+
+  *array = grown;
+  *max   = new_max;
+
+  return 1;
+}
+
+static DrawCommand_t* dl_PushCommand( DrawList_t* list, int type )
+{
+  if ( !dl_Grow( ( void** )&list->commands, &list->max_commands,
+                 list->num_commands + 1, sizeof( DrawCommand_t ) ) )
+  {
+    return NULL;
+  }
+
+  DrawCommand_t* command = &list->commands[list->num_commands++];
+  memset( command, 0, sizeof( DrawCommand_t ) );
+  command->type = type;
+
+  return command;
+}
+
@@ -4,105 +4,6 @@
 
 GlyphArray_t* game_glyphs = NULL;
 
-World_t* init_world( const int world_width, const int world_height,
-                     const int region_width, const int region_height,
-                     const int local_width, const int local_height, const int z_height )
-{
-  World_t* new_world = ( World_t* )malloc( sizeof( World_t ) * ( world_width * world_height ) );
-  if ( new_world == NULL )
-  {
-    printf("Failed to allocate memory for world\n");
-    free( new_world );
-    return NULL;
-  }
-
-  new_world->world_width   = world_width;
-  new_world->world_height  = world_height;
-  new_world->region_width  = region_width;
-  new_world->region_height = region_height;
-  new_world->local_width   = local_width;
-  new_world->local_height  = local_height;
-  new_world->z_height      = z_height;
-  
-  for ( int i = 0; i < ( world_width * world_height ); i++ )
-  {
-    new_world[i].tile = (GameTile_t){.glyph = 0, .elevation = 0, 
-      .temperature = 20, .is_passable = 0 };
-    
-    new_world[i].world_width   = world_width;
-    new_world[i].world_height  = world_height;
-    new_world[i].region_width  = region_width;
-    new_world[i].region_height = region_height;
-    new_world[i].local_width   = local_width;
-    new_world[i].local_height  = local_height;
-    new_world[i].z_height      = z_height;
-
-    new_world[i].regions = ( RegionCell_t* )malloc( sizeof( RegionCell_t ) *
-                                                    ( region_width * region_height ) );
-    
-    if ( new_world[i].regions == NULL )
-    {
-      free_world( new_world, i, 0 );
-      return NULL;
-    }
-
-    for ( int j = 0; j < ( region_width * region_height ); j++ )
-    {
-      new_world[i].regions[j].tile = (GameTile_t){.glyph = 1, .elevation = 0,
-        .temperature = 20, .is_passable = 0 };
-      
-      new_world[i].regions[j].tiles = ( GameTile_t* )malloc( sizeof( GameTile_t ) *
-                                                           ( local_width * local_height * z_height ) );
-  
-      if ( new_world[i].regions[j].tiles == NULL )
-      {
-        free_world( new_world, i, j );
-        return NULL;
-      }
-
-      for( int k = 0; k < ( local_width * local_height * z_height); k++ )
-      {
-        new_world[i].regions[j].tiles[k] = (GameTile_t){.glyph = 2, .elevation = 0,
-        .temperature = 20, .is_passable = 0 };
-
-      }
-
-    }
-  }
-
-  return new_world;
-}
-
-void free_world( World_t* world, int world_index, int region_index )
-{
-  if ( world == NULL ) return;
-  
-  for ( int i = 0; i < world_index; i++ )
-  {
-    if ( world[i].regions != NULL)
-    {
-      int max_regions = ( i == world_index ) ? region_index : ( 
-        ( world->region_width * world->region_height ) - 1 );
-
-      for ( int j = 0; j < max_regions; j++ )
-      {
-        if ( world[i].regions[j].tiles != NULL )
-        {
-          free( world[i].regions[j].tiles );
-          world[i].regions[j].tiles = NULL;
-        }
-      }
-
-      free( world[i].regions );
-      world[i].regions = NULL;
-    }
-
-  }
-
-  free( world );
-  world = NULL;
-}
-
 void e_GetCellSize( int index, int width, int height,
                     int* x, int* y, int* w, int* h )
 {
@@ -194,12 +95,15 @@ void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos )
       break;
   }
 
+  // the game draws its tiles with the 737 code page
+  current_glyph = e_GlyphIndex( game_glyphs, GLYPH_PAGE_737, current_glyph );
+
   if ( i == current_index )
   {
     a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
                       game_glyphs->rects[current_glyph].h * 2, 255, 255, 0, 255 );
     a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                      x, y, 2 );
+                      x, y, 2, white );
   } 
 
   else
@@ -207,70 +111,72 @@ void we_DrawWorldCell( int index, World_t* map, WorldPosition_t pos )
     a_DrawFilledRect( x, y, game_glyphs->rects[current_glyph].w * 2,
                       game_glyphs->rects[current_glyph].h * 2, 0, 0, 0, 255 );
     a_BlitTextureRect( game_glyphs->texture, game_glyphs->rects[current_glyph],
-                      x, y, 2 );
+                      x, y, 2, white );
   }
 
 }
 
-GlyphArray_t* e_InitGlyphs( const char* filename, int glyph_width,
-                            int glyph_height )
+void g_RecordWorldView( DrawList_t* list, World_t* map, WorldPosition_t pos )
 {
-  SDL_Surface* surface, *glyph_surf;
-  SDL_Rect dest, rect;
-  
-  GlyphArray_t* new_glyphs = ( GlyphArray_t* )malloc( sizeof( GlyphArray_t ) );
-  if ( new_glyphs == NULL )
-  {
-    printf( "Failed to allocate memory for new_glyphs %s\n", filename );
-    return NULL;
-  }
-  new_glyphs->texture = NULL;
-  new_glyphs->count = 0;
-  
-  glyph_surf = a_Image( filename );
-  if( glyph_surf == NULL )
+  int width = 0, height = 0, current = 0;
+
+  switch ( pos.level )
   {
-    printf( "Failed to open font surface %s, %s", filename, SDL_GetError() );
-    return NULL;
-  }
+    case WORLD_LEVEL:
+      width   = map->world_width;
+      height  = map->world_height;
+      current = pos.world_index;
+      break;
 
-  surface = SDL_CreateRGBSurface( 0, FONT_TEXTURE_SIZE, FONT_TEXTURE_SIZE, 32,
-                                  0, 0, 0, 0xff );
+    case REGION_LEVEL:
+      width   = map->region_width;
+      height  = map->region_height;
+      current = pos.region_index;
+      break;
 
-  SDL_SetColorKey( surface, SDL_TRUE, SDL_MapRGBA( surface->format, 0, 0, 0,
-                                                   0 ) );
+    case LOCAL_LEVEL:
+      width   = map->local_width;
+      height  = map->local_height;
+      current = pos.local_index;
+      break;
 
-  dest.x = dest.y = 0;
-  rect.x = rect.y = 0;
-  rect.w = dest.w = glyph_width;
-  rect.h = dest.h = glyph_height;
+    default:
+      return;
+  }
 
-  while ( rect.x < glyph_surf->w )
+  // one span per column, cells run down the column like INDEX_2
+  for ( int column = 0; column < width; column++ )
   {
-    if ( dest.x + dest.w >= GAME_GLYPH_TEXTURE_SIZE )
+    int x, y, w, h;
+    e_GetCellSize( column * height, width, height, &x, &y, &w, &h );
+    g_PushGlyphSpan( list, x, y, 0, CELL_HEIGHT, 2 );
+
+    for ( int row = 0; row < height; row++ )
     {
-      dest.x = 0;
-      dest.y += dest.h + 1;
-      if ( dest.y + dest.h >= GAME_GLYPH_TEXTURE_SIZE )
+      int i = INDEX_2( column, row, height );
+      uint16_t glyph = 0;
+
+      switch ( pos.level )
       {
-        SDL_LogMessage( SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_CRITICAL,
-                        "Out of glyph space in %dx%d font atlas texture map.",
-                        FONT_TEXTURE_SIZE, FONT_TEXTURE_SIZE );
-        return NULL;
+        case WORLD_LEVEL:
+          glyph = map[i].tile.glyph;
+          break;
+
+        case REGION_LEVEL:
+          glyph = map[pos.world_index].regions[i].tile.glyph;
+          break;
+
+        default:
+          glyph = map[pos.world_index].regions[pos.region_index].
+            tiles[pos.local_z * width * height + i].glyph;
+          break;
       }
-    }
 
-    SDL_BlitSurface( glyph_surf, &rect, surface, &dest );
-    
-    new_glyphs->rects[new_glyphs->count++] = dest;
-
-    dest.x += dest.w;
-    rect.x += rect.w;
+      g_PushGlyph( list, e_GlyphIndex( game_glyphs, GLYPH_PAGE_737, glyph ),
+                   white, ( i == current ) ? yellow : black );
+    }
   }
 
-  new_glyphs->texture = a_ToTexture( surface, 1 );
-  
-  return new_glyphs;
 }
 
 void e_MapMouseCheck( World_t* map, WorldPosition_t* pos )
@@ -0,0 +1,395 @@
+/*
+ * glyph_atlas.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "Archimedes.h"
+#include "glyph_atlas.h"
+
+#define GLYPH_ATLAS_MAGIC    "GATL"
+#define GLYPH_ATLAS_VERSION  1
+#define GLYPH_ATLAS_NAME_LEN 64
+
+/*
+ * On disk: GlyphAtlasHeader_t, count GlyphAtlasRect_t, then
+ * atlas_width * atlas_height RGBA32 pixels. Every field is fixed width
+ * and naturally aligned so the structs are written as is.
+ */
+typedef struct
+{
+  char name[GLYPH_ATLAS_NAME_LEN];
+  int64_t mtime;
+  int64_t size;
+  uint32_t start;
+  uint32_t count;
+
+} GlyphAtlasPage_t;
+
+typedef struct
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t glyph_width;
+  uint32_t glyph_height;
+  uint32_t num_pages;
+  uint32_t atlas_width;
+  uint32_t atlas_height;
+  uint32_t count;
+  GlyphAtlasPage_t pages[GLYPH_MAX_PAGES];
+
+} GlyphAtlasHeader_t;
+
+typedef struct
+{
+  int32_t x, y, w, h;
+
+} GlyphAtlasRect_t;
+
+static int ga_StatPage( const char* filename, GlyphAtlasPage_t* page );
+static uint8_t* ga_ReadCache( const char* atlas_filename,
+                              const char* page_filenames[], int num_pages,
+                              int glyph_width, int glyph_height );
+static uint8_t* ga_BuildCache( const char* atlas_filename,
+                               const char* page_filenames[], int num_pages,
+                               int glyph_width, int glyph_height );
+static GlyphArray_t* ga_Upload( uint8_t* cache );
+
+GlyphArray_t* e_LoadGlyphAtlas( const char* atlas_filename,
+                                const char* page_filenames[], int num_pages,
+                                int glyph_width, int glyph_height )
+{
+  if ( num_pages <= 0 || num_pages > GLYPH_MAX_PAGES )
+  {
+    printf( "Failed to load glyph atlas %s, %d code pages\n", atlas_filename,
+            num_pages );
+    return NULL;
+  }
+
+  uint8_t* cache = ga_ReadCache( atlas_filename, page_filenames, num_pages,
+                                 glyph_width, glyph_height );
+  if ( cache == NULL )
+  {
+    cache = ga_BuildCache( atlas_filename, page_filenames, num_pages,
+                           glyph_width, glyph_height );
+    if ( cache == NULL )
+    {
+      return NULL;
+    }
+  }
+
+  GlyphArray_t* glyphs = ga_Upload( cache );
+  free( cache );
+
+  return glyphs;
+}
+
+void e_FreeGlyphAtlas( GlyphArray_t* glyphs )
+{
+  if ( glyphs == NULL )
+  {
+    return;
+  }
+
+  if ( glyphs->texture != NULL )
+  {
+    SDL_DestroyTexture( glyphs->texture );
+  }
+
+  free( glyphs );
+}
+
+int e_GlyphIndex( GlyphArray_t* glyphs, int page, int glyph )
+{
+  if ( page < 0 || page >= glyphs->num_pages ||
+       glyph < 0 || glyph >= glyphs->page_count[page] )
+  {
+    return 0;
+  }
+
+  return glyphs->page_start[page] + glyph;
+}
+
+static int ga_StatPage( const char* filename, GlyphAtlasPage_t* page )
+{
+  struct stat st;
+
+  memset( page, 0, sizeof( GlyphAtlasPage_t ) );
+  snprintf( page->name, GLYPH_ATLAS_NAME_LEN, "%s", filename );
+
+  if ( stat( filename, &st ) != 0 )
+  {
+    return 0;
+  }
+
+  page->mtime = ( int64_t )st.st_mtime;
+  page->size  = ( int64_t )st.st_size;
+
+  return 1;
+}
+
+/*
+ * Whole file in one read, the header is checked against the requested
+ * pages and their sources before anything is handed to SDL.
+ */
+static uint8_t* ga_ReadCache( const char* atlas_filename,
+                              const char* page_filenames[], int num_pages,
+                              int glyph_width, int glyph_height )
+{
+  FILE* file = fopen( atlas_filename, "rb" );
+  if ( file == NULL )
+  {
+    return NULL;
+  }
+
+  fseek( file, 0, SEEK_END );
+  long file_size = ftell( file );
+  fseek( file, 0, SEEK_SET );
+
+  if ( file_size < ( long )sizeof( GlyphAtlasHeader_t ) )
+  {
+    fclose( file );
+    return NULL;
+  }
+
+  uint8_t* cache = malloc( file_size );
+  if ( cache == NULL )
+  {
+    fclose( file );
+    return NULL;
+  }
+
+  size_t read = fread( cache, 1, file_size, file );
+  fclose( file );
+
+  GlyphAtlasHeader_t* header = ( GlyphAtlasHeader_t* )cache;
+
+  if ( read != ( size_t )file_size ||
+       memcmp( header->magic, GLYPH_ATLAS_MAGIC, 4 ) != 0 ||
+       header->version != GLYPH_ATLAS_VERSION ||
+       header->glyph_width  != ( uint32_t )glyph_width ||
+       header->glyph_height != ( uint32_t )glyph_height ||
+       header->num_pages != ( uint32_t )num_pages ||
+       header->count > GAME_MAX_GLYPHS ||
+       ( long )( sizeof( GlyphAtlasHeader_t ) +
+                 header->count * sizeof( GlyphAtlasRect_t ) +
+                 ( size_t )header->atlas_width * header->atlas_height * 4 )
+         != file_size )
+  {
+    free( cache );
+    return NULL;
+  }
+
+  for ( int i = 0; i < num_pages; i++ )
+  {
+    GlyphAtlasPage_t source;
+
+    if ( strncmp( header->pages[i].name, page_filenames[i],
+                  GLYPH_ATLAS_NAME_LEN ) != 0 )
+    {
+      free( cache );
+      return NULL;
+    }
+
+    if ( ga_StatPage( page_filenames[i], &source ) &&
+         ( source.mtime != header->pages[i].mtime ||
+           source.size  != header->pages[i].size ) )
+    {
+      free( cache );
+      return NULL;
+    }
+  }
+
+  return cache;
+}
+
+static uint8_t* ga_BuildCache( const char* atlas_filename,
+                               const char* page_filenames[], int num_pages,
+                               int glyph_width, int glyph_height )
+{
+  SDL_Surface* sources[GLYPH_MAX_PAGES] = { NULL };
+  GlyphAtlasHeader_t header;
+  uint8_t* cache = NULL;
+
+  memset( &header, 0, sizeof( GlyphAtlasHeader_t ) );
+  memcpy( header.magic, GLYPH_ATLAS_MAGIC, 4 );
+  header.version      = GLYPH_ATLAS_VERSION;
+  header.glyph_width  = glyph_width;
+  header.glyph_height = glyph_height;
+  header.num_pages    = num_pages;
+
+  for ( int i = 0; i < num_pages; i++ )
+  {
+    SDL_Surface* surf = a_Image( page_filenames[i] );
+    if ( surf == NULL )
+    {
+      printf( "Failed to open font surface %s, %s\n", page_filenames[i],
+              SDL_GetError() );
+      goto cleanup;
+    }
+
+    sources[i] = SDL_ConvertSurfaceFormat( surf, SDL_PIXELFORMAT_RGBA32, 0 );
+    SDL_FreeSurface( surf );
+    if ( sources[i] == NULL )
+    {
+      printf( "Failed to convert font surface %s, %s\n", page_filenames[i],
+              SDL_GetError() );
+      goto cleanup;
+    }
+
+    ga_StatPage( page_filenames[i], &header.pages[i] );
+    header.pages[i].start = header.count;
+    header.pages[i].count = sources[i]->w / glyph_width;
+    header.count += header.pages[i].count;
+  }
+
+  if ( header.count == 0 || header.count > GAME_MAX_GLYPHS )
+  {
+    printf( "Failed to build glyph atlas %s, %u glyphs\n", atlas_filename,
+            header.count );
+    goto cleanup;
+  }
+
+  // rows keep the one pixel gap the old packer used so scaled blits
+  // never sample the next row
+  int row_height = glyph_height + 1;
+  uint32_t atlas_width = 64;
+  while ( ( atlas_width / glyph_width ) * ( atlas_width / row_height )
+          < header.count )
+  {
+    atlas_width *= 2;
+  }
+
+  int columns = atlas_width / glyph_width;
+  int rows    = ( header.count + columns - 1 ) / columns;
+  header.atlas_width  = atlas_width;
+  header.atlas_height = rows * row_height;
+
+  size_t rects_size  = header.count * sizeof( GlyphAtlasRect_t );
+  size_t pixels_size = ( size_t )header.atlas_width * header.atlas_height * 4;
+  size_t cache_size  = sizeof( GlyphAtlasHeader_t ) + rects_size + pixels_size;
+
+  cache = calloc( 1, cache_size );
+  if ( cache == NULL )
+  {
+    printf( "Failed to allocate glyph atlas %s\n", atlas_filename );
+    goto cleanup;
+  }
+
+  memcpy( cache, &header, sizeof( GlyphAtlasHeader_t ) );
+  GlyphAtlasRect_t* rects =
+    ( GlyphAtlasRect_t* )( cache + sizeof( GlyphAtlasHeader_t ) );
+  uint8_t* pixels = cache + sizeof( GlyphAtlasHeader_t ) + rects_size;
+
+  int glyph = 0;
+  for ( int i = 0; i < num_pages; i++ )
+  {
+    SDL_Surface* src = sources[i];
+    SDL_LockSurface( src );
+
+    for ( uint32_t j = 0; j < header.pages[i].count; j++, glyph++ )
+    {
+      GlyphAtlasRect_t* rect = &rects[glyph];
+      rect->x = ( glyph % columns ) * glyph_width;
+      rect->y = ( glyph / columns ) * row_height;
+      rect->w = glyph_width;
+      rect->h = glyph_height;
+
+      for ( int y = 0; y < glyph_height && y < src->h; y++ )
+      {
+        uint8_t* in  = ( uint8_t* )src->pixels + y * src->pitch
+          + j * glyph_width * 4;
+        uint8_t* out = pixels + ( ( size_t )( rect->y + y ) * atlas_width
+          + rect->x ) * 4;
+
+        // black was the colour key, bake it into alpha
+        for ( int x = 0; x < glyph_width; x++, in += 4, out += 4 )
+        {
+          out[0] = in[0];
+          out[1] = in[1];
+          out[2] = in[2];
+          out[3] = ( in[0] | in[1] | in[2] ) ? in[3] : 0;
+        }
+      }
+    }
+
+    SDL_UnlockSurface( src );
+  }
+
+  FILE* file = fopen( atlas_filename, "wb" );
+  if ( file == NULL || fwrite( cache, 1, cache_size, file ) != cache_size )
+  {
+    printf( "Failed to write glyph atlas cache %s\n", atlas_filename );
+  }
+  if ( file != NULL )
+  {
+    fclose( file );
+  }
+
+cleanup:
+  for ( int i = 0; i < num_pages; i++ )
+  {
+    if ( sources[i] != NULL )
+    {
+      SDL_FreeSurface( sources[i] );
+    }
+  }
+
+  return cache;
+}
+
+static GlyphArray_t* ga_Upload( uint8_t* cache )
+{
+  GlyphAtlasHeader_t* header = ( GlyphAtlasHeader_t* )cache;
+  GlyphAtlasRect_t* rects =
+    ( GlyphAtlasRect_t* )( cache + sizeof( GlyphAtlasHeader_t ) );
+  uint8_t* pixels = cache + sizeof( GlyphAtlasHeader_t ) +
+    header->count * sizeof( GlyphAtlasRect_t );
+
+  GlyphArray_t* glyphs = ( GlyphArray_t* )calloc( 1, sizeof( GlyphArray_t ) );
+  if ( glyphs == NULL )
+  {
+    printf( "Failed to allocate memory for glyphs\n" );
+    return NULL;
+  }
+
+  glyphs->texture = SDL_CreateTexture( app.renderer, SDL_PIXELFORMAT_RGBA32,
+                                       SDL_TEXTUREACCESS_STATIC,
+                                       header->atlas_width,
+                                       header->atlas_height );
+  if ( glyphs->texture == NULL )
+  {
+    printf( "Failed to create glyph atlas texture, %s\n", SDL_GetError() );
+    free( glyphs );
+    return NULL;
+  }
+
+  SDL_UpdateTexture( glyphs->texture, NULL, pixels, header->atlas_width * 4 );
+  SDL_SetTextureBlendMode( glyphs->texture, SDL_BLENDMODE_BLEND );
+
+  glyphs->count     = header->count;
+  glyphs->num_pages = header->num_pages;
+
+  for ( uint32_t i = 0; i < header->num_pages; i++ )
+  {
+    glyphs->page_start[i] = header->pages[i].start;
+    glyphs->page_count[i] = header->pages[i].count;
+  }
+
+  for ( uint32_t i = 0; i < header->count; i++ )
+  {
+    glyphs->rects[i] = ( SDL_Rect ){ rects[i].x, rects[i].y,
+                                     rects[i].w, rects[i].h };
+  }
+
+  return glyphs;
+}
+
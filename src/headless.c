@@ -0,0 +1,286 @@
+/*
+ * headless.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+/*
+ * Renders the world to a terminal with no SDL window.
+ *
+ *   headless [--frames N] [--truecolor] [--out FILE] [--play]
+ *
+ * Without --play the cursor walks every cell of the world, region and
+ * local views for N frames and the timing goes to stderr, with --play
+ * the keys are wasd to move, enter / backspace to change level, + / - for
+ * z and q to quit.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "ansi_render.h"
+#include "game.h"
+
+#define HEADLESS_WIDTH  80
+#define HEADLESS_HEIGHT 24
+
+static void h_Bench( AnsiRenderer_t* renderer, World_t* world, FILE* out,
+                     int frames );
+static void h_Play( AnsiRenderer_t* renderer, World_t* world );
+static void h_Draw( AnsiRenderer_t* renderer, World_t* world,
+                    WorldPosition_t pos );
+static void h_LevelSize( World_t* world, int level, int* w, int* h );
+static void h_SetIndex( World_t* world, WorldPosition_t* pos );
+static double h_Now( void );
+
+int main( int argc, char** argv )
+{
+  int frames    = 1000;
+  int truecolor = 0;
+  int play      = 0;
+  const char* out_filename = NULL;
+
+  for ( int i = 1; i < argc; i++ )
+  {
+    if ( strcmp( argv[i], "--frames" ) == 0 && i + 1 < argc )
+    {
+      frames = atoi( argv[++i] );
+    }
+
+    else if ( strcmp( argv[i], "--truecolor" ) == 0 )
+    {
+      truecolor = 1;
+    }
+
+    else if ( strcmp( argv[i], "--out" ) == 0 && i + 1 < argc )
+    {
+      out_filename = argv[++i];
+    }
+
+    else if ( strcmp( argv[i], "--play" ) == 0 )
+    {
+      play = 1;
+    }
+
+    else
+    {
+      fprintf( stderr, "usage: %s [--frames N] [--truecolor] [--out FILE] "
+               "[--play]\n", argv[0] );
+      return 1;
+    }
+  }
+
+  World_t* world = init_world( WORLD_WIDTH_SMALL, WORLD_HEIGHT_SMALL,
+                               REGION_WIDTH_SMALL, REGION_HEIGHT_SMALL,
+                               LOCAL_WIDTH_SMALL, LOCAL_HEIGHT_SMALL,
+                               Z_HEIGHT_SMALL );
+  AnsiRenderer_t* renderer = g_AnsiCreate( HEADLESS_WIDTH, HEADLESS_HEIGHT,
+                                           truecolor );
+  if ( world == NULL || renderer == NULL )
+  {
+    return 1;
+  }
+
+  g_AnsiLoadPalette( renderer, ANSI_PALETTE_FILE );
+
+  if ( play )
+  {
+    h_Play( renderer, world );
+  }
+
+  else
+  {
+    FILE* out = stdout;
+    if ( out_filename != NULL )
+    {
+      out = fopen( out_filename, "wb" );
+      if ( out == NULL )
+      {
+        printf( "Failed to open file %s\n", out_filename );
+        return 1;
+      }
+    }
+
+    h_Bench( renderer, world, out, frames );
+
+    if ( out != stdout )
+    {
+      fclose( out );
+    }
+  }
+
+  g_AnsiDestroy( renderer );
+  free_world( world, ( world->world_width * world->world_height ),
+                     ( world->region_width * world->region_height ) );
+
+  return 0;
+}
+
+static void h_Bench( AnsiRenderer_t* renderer, World_t* world, FILE* out,
+                     int frames )
+{
+  WorldPosition_t pos = { 0 };
+  size_t bytes = 0;
+  int w, h;
+
+  double start = h_Now();
+
+  for ( int frame = 0; frame < frames; frame++ )
+  {
+    // a third of the frames per level, the cursor walks the cells
+    pos.level = ( frame * 3 ) / ( frames > 0 ? frames : 1 );
+    h_LevelSize( world, pos.level, &w, &h );
+    pos.x = ( frame / h ) % w;
+    pos.y = frame % h;
+    h_SetIndex( world, &pos );
+
+    h_Draw( renderer, world, pos );
+    bytes += g_AnsiPresent( renderer, out );
+  }
+
+  double elapsed = h_Now() - start;
+
+  fprintf( stderr, "%d frames, %.2f us/frame, %.1f bytes/frame\n", frames,
+           frames > 0 ? ( elapsed * 1e6 ) / frames : 0.0,
+           frames > 0 ? ( double )bytes / frames : 0.0 );
+}
+
+static void h_Play( AnsiRenderer_t* renderer, World_t* world )
+{
+  struct termios saved, raw;
+  WorldPosition_t pos = { 0 };
+  int running = 1;
+  int w, h;
+
+  tcgetattr( STDIN_FILENO, &saved );
+  raw = saved;
+  raw.c_lflag &= ~( ICANON | ECHO );
+  tcsetattr( STDIN_FILENO, TCSANOW, &raw );
+  printf( "\x1b[?25l" );
+
+  while ( running )
+  {
+    h_Draw( renderer, world, pos );
+    g_AnsiPresent( renderer, stdout );
+
+    int key = getchar();
+    h_LevelSize( world, pos.level, &w, &h );
+
+    switch ( key )
+    {
+      case 'w': if ( pos.y > 0 )     pos.y--; break;
+      case 's': if ( pos.y < h - 1 ) pos.y++; break;
+      case 'a': if ( pos.x > 0 )     pos.x--; break;
+      case 'd': if ( pos.x < w - 1 ) pos.x++; break;
+
+      case '\n':
+        if ( pos.level < LOCAL_LEVEL )
+        {
+          pos.level++;
+          pos.x = pos.y = 0;
+        }
+        break;
+
+      case 127:
+        if ( pos.level > WORLD_LEVEL )
+        {
+          pos.level--;
+          pos.x = pos.y = 0;
+        }
+        break;
+
+      case '+':
+      case '=':
+        if ( pos.local_z < world->z_height - 1 ) pos.local_z++;
+        break;
+
+      case '-':
+        if ( pos.local_z > 0 ) pos.local_z--;
+        break;
+
+      case 'q':
+      case EOF:
+        running = 0;
+        break;
+
+      default:
+        break;
+    }
+
+    h_SetIndex( world, &pos );
+  }
+
+  printf( "\x1b[0m\x1b[?25h\x1b[%d;1H\n", HEADLESS_HEIGHT );
+  tcsetattr( STDIN_FILENO, TCSANOW, &saved );
+}
+
+static void h_Draw( AnsiRenderer_t* renderer, World_t* world,
+                    WorldPosition_t pos )
+{
+  char pos_text[50];
+
+  g_AnsiClear( renderer, 0 );
+  g_AnsiDrawView( renderer, world, pos );
+
+  snprintf( pos_text, 50, "%d,%d,%d,%d,%d", pos.world_index, pos.region_index,
+            pos.local_index, pos.level, pos.local_z );
+  g_AnsiText( renderer, 0, 0, pos_text, MAX_COLOR_PALETTE - 1, 0 );
+}
+
+static void h_LevelSize( World_t* world, int level, int* w, int* h )
+{
+  switch ( level )
+  {
+    case WORLD_LEVEL:
+      *w = world->world_width;
+      *h = world->world_height;
+      break;
+
+    case REGION_LEVEL:
+      *w = world->region_width;
+      *h = world->region_height;
+      break;
+
+    default:
+      *w = world->local_width;
+      *h = world->local_height;
+      break;
+  }
+}
+
+static void h_SetIndex( World_t* world, WorldPosition_t* pos )
+{
+  int w, h;
+  h_LevelSize( world, pos->level, &w, &h );
+
+  switch ( pos->level )
+  {
+    case WORLD_LEVEL:
+      pos->world_index = INDEX_2( pos->x, pos->y, h );
+      break;
+
+    case REGION_LEVEL:
+      pos->region_index = INDEX_2( pos->x, pos->y, h );
+      break;
+
+    default:
+      pos->local_index = INDEX_2( pos->x, pos->y, h );
+      break;
+  }
+}
+
+static double h_Now( void )
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
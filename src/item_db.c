@@ -0,0 +1,1008 @@
+#include "Daedalus.h"
+#include "item_db.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ITEM_DB_MAGIC   "ITEMDB"
+#define ITEM_DB_VERSION 1
+
+/*
+ * On disk: ItemDbHeader_t then count ItemDef_t sorted by id. The header
+ * remembers the source it was compiled from, a source with a different
+ * size or modification time makes the cache stale.
+ */
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t def_size; // sizeof(ItemDef_t) when written, catches layout changes
+    uint32_t count;
+    uint32_t reserved;
+    int64_t source_mtime;
+    int64_t source_size;
+
+} ItemDbHeader_t;
+
+// A key of the JSON source that only some item types have
+typedef struct
+{
+    const char* key;
+    ItemType_t type;
+    size_t offset;
+    size_t size; // 0 for a uint8_t, else the size of the char array
+
+} ItemDefField_t;
+
+typedef struct
+{
+    const char* key;
+    size_t offset;
+
+} MaterialField_t;
+
+typedef struct
+{
+    const char* text;
+    const char* filename;
+    size_t pos;
+    int line;
+    bool failed;
+
+} JsonReader_t;
+
+static const char* item_type_names[] = {
+    [ITEM_TYPE_WEAPON] = "weapon",
+    [ITEM_TYPE_ARMOR] = "armor",
+    [ITEM_TYPE_KEY] = "key",
+    [ITEM_TYPE_CONSUMABLE] = "consumable",
+    [ITEM_TYPE_AMMUNITION] = "ammunition"
+};
+
+#define ITEM_TYPE_COUNT (sizeof(item_type_names) / sizeof(item_type_names[0]))
+
+#define DEF_FIELD(key, type, member, size) \
+    { key, type, offsetof(ItemDef_t, data.member), size }
+
+// Loading and saving both walk this table, in this order
+static const ItemDefField_t item_def_fields[] = {
+    DEF_FIELD("min_damage", ITEM_TYPE_WEAPON, weapon.min_damage, 0),
+    DEF_FIELD("max_damage", ITEM_TYPE_WEAPON, weapon.max_damage, 0),
+    DEF_FIELD("range_tiles", ITEM_TYPE_WEAPON, weapon.range_tiles, 0),
+    DEF_FIELD("armor_value", ITEM_TYPE_ARMOR, armor.armor_value, 0),
+    DEF_FIELD("evasion_value", ITEM_TYPE_ARMOR, armor.evasion_value, 0),
+    DEF_FIELD("stealth_value", ITEM_TYPE_ARMOR, armor.stealth_value, 0),
+    DEF_FIELD("enchant_value", ITEM_TYPE_ARMOR, armor.enchant_value, 0),
+    DEF_FIELD("lock_name", ITEM_TYPE_KEY, key.lock_name, ITEM_DEF_NAME_LENGTH),
+    DEF_FIELD("lock_description", ITEM_TYPE_KEY, key.lock_description, MAX_DESCRIPTION_LENGTH),
+    DEF_FIELD("pick_difficulty", ITEM_TYPE_KEY, key.pick_difficulty, 0),
+    DEF_FIELD("jammed_seconds", ITEM_TYPE_KEY, key.jammed_seconds, 0),
+    DEF_FIELD("effect", ITEM_TYPE_CONSUMABLE, consumable.effect, MAX_NAME_LENGTH),
+    DEF_FIELD("value", ITEM_TYPE_CONSUMABLE, consumable.value, 0),
+    DEF_FIELD("min_damage", ITEM_TYPE_AMMUNITION, ammo.min_damage, 0),
+    DEF_FIELD("max_damage", ITEM_TYPE_AMMUNITION, ammo.max_damage, 0)
+};
+
+#define ITEM_DEF_FIELD_COUNT (sizeof(item_def_fields) / sizeof(item_def_fields[0]))
+
+#define MATERIAL_FIELD(member) { #member, offsetof(MaterialProperties_t, member) }
+
+static const MaterialField_t material_fields[] = {
+    MATERIAL_FIELD(weight_fact),
+    MATERIAL_FIELD(value_coins_fact),
+    MATERIAL_FIELD(durability_fact),
+    MATERIAL_FIELD(min_damage_fact),
+    MATERIAL_FIELD(max_damage_fact),
+    MATERIAL_FIELD(armor_value_fact),
+    MATERIAL_FIELD(evasion_value_fact),
+    MATERIAL_FIELD(stealth_value_fact),
+    MATERIAL_FIELD(enchant_value_fact)
+};
+
+#define MATERIAL_FIELD_COUNT (sizeof(material_fields) / sizeof(material_fields[0]))
+
+// Definitions sorted by id. While item_def_capacity is 0 they point into
+// the mapped cache and are read only, the first change copies them out.
+static ItemDef_t* item_defs = NULL;
+static uint32_t item_def_count = 0;
+static uint32_t item_def_capacity = 0;
+static void* item_db_map = NULL;
+static size_t item_db_map_size = 0;
+
+static struct {
+    char name[MAX_NAME_LENGTH];
+    void (*on_consume)(uint8_t);
+} item_effects[MAX_ITEM_EFFECTS];
+static int item_effect_count = 0;
+
+static bool _map_item_cache(const char* cache_path, const struct stat* source);
+static bool _write_item_cache(const char* cache_path, const struct stat* source);
+static bool _compile_item_source(const char* source_path);
+static bool _parse_item_def(JsonReader_t* reader, ItemDef_t* def);
+static bool _own_item_defs(void);
+static int _compare_item_defs(const void* a, const void* b);
+static uint32_t _lower_bound_item_def(const char* id);
+static void _write_json_string(FILE* file, const char* str);
+
+static void _json_error(JsonReader_t* reader, const char* message);
+static char _json_peek(JsonReader_t* reader);
+static bool _json_accept(JsonReader_t* reader, char c);
+static bool _json_expect(JsonReader_t* reader, char c);
+static bool _json_read_string(JsonReader_t* reader, char* out, size_t size, const char* key);
+static bool _json_read_number(JsonReader_t* reader, double* out);
+static bool _json_read_u8(JsonReader_t* reader, uint8_t* out, const char* key);
+static bool _json_skip_value(JsonReader_t* reader);
+
+// =============================================================================
+// LOADING & SAVING
+// =============================================================================
+
+int load_item_database(const char* source_path, const char* cache_path)
+{
+    destroy_item_database();
+
+    struct stat source;
+    bool have_source = (source_path != NULL && stat(source_path, &source) == 0);
+
+    if (cache_path != NULL && _map_item_cache(cache_path, have_source ? &source : NULL)) {
+        d_LogInfoF("Mapped %u item definitions from %s", item_def_count, cache_path);
+        return (int)item_def_count;
+    }
+
+    if (!have_source) {
+        d_LogErrorF("Failed to load item database, no source at %s",
+                    source_path ? source_path : "NULL");
+        return -1;
+    }
+
+    if (!_compile_item_source(source_path)) {
+        destroy_item_database();
+        return -1;
+    }
+
+    if (cache_path != NULL && !_write_item_cache(cache_path, &source)) {
+        d_LogWarningF("Failed to write item cache %s, the source will be parsed next time", cache_path);
+    }
+
+    d_LogInfoF("Compiled %u item definitions from %s", item_def_count, source_path);
+    return (int)item_def_count;
+}
+
+bool save_item_database(const char* path)
+{
+    if (path == NULL) {
+        d_LogError("save_item_database: NULL path");
+        return false;
+    }
+
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        d_LogErrorF("Failed to open %s for writing", path);
+        return false;
+    }
+
+    MaterialProperties_t neutral = create_default_material_properties();
+
+    fprintf(file, "[");
+    for (uint32_t i = 0; i < item_def_count; i++) {
+        const ItemDef_t* def = &item_defs[i];
+
+        fprintf(file, "%s\n  {\n", i > 0 ? "," : "");
+        fprintf(file, "    \"type\": \"%s\",\n", item_type_names[def->type]);
+        fprintf(file, "    \"id\": ");
+        _write_json_string(file, def->id);
+        fprintf(file, ",\n    \"name\": ");
+        _write_json_string(file, def->name);
+        fprintf(file, ",\n    \"glyph\": ");
+        char glyph[2] = { def->glyph, '\0' };
+        _write_json_string(file, glyph);
+
+        if (def->material[0] != '\0') {
+            fprintf(file, ",\n    \"material\": ");
+            _write_json_string(file, def->material);
+        }
+
+        if (memcmp(&def->material_properties, &neutral, sizeof(MaterialProperties_t)) != 0) {
+            fprintf(file, ",\n    \"material_properties\": {");
+            for (size_t f = 0; f < MATERIAL_FIELD_COUNT; f++) {
+                const float* value = (const float*)((const char*)&def->material_properties +
+                                                    material_fields[f].offset);
+                fprintf(file, "%s\n      \"%s\": %.9g", f > 0 ? "," : "",
+                        material_fields[f].key, *value);
+            }
+            fprintf(file, "\n    }");
+        }
+
+        for (size_t f = 0; f < ITEM_DEF_FIELD_COUNT; f++) {
+            const ItemDefField_t* field = &item_def_fields[f];
+            if (field->type != def->type) {
+                continue;
+            }
+
+            const char* data = (const char*)def + field->offset;
+            fprintf(file, ",\n    \"%s\": ", field->key);
+            if (field->size == 0) {
+                fprintf(file, "%u", *(const uint8_t*)data);
+            } else {
+                _write_json_string(file, data);
+            }
+        }
+
+        fprintf(file, "\n  }");
+    }
+    fprintf(file, "\n]\n");
+
+    bool written = !ferror(file);
+    if (fclose(file) != 0) {
+        written = false;
+    }
+
+    if (!written) {
+        d_LogErrorF("Failed to write item database %s", path);
+    }
+
+    return written;
+}
+
+void destroy_item_database(void)
+{
+    if (item_db_map != NULL) {
+        munmap(item_db_map, item_db_map_size);
+    } else {
+        free(item_defs);
+    }
+
+    item_defs = NULL;
+    item_def_count = 0;
+    item_def_capacity = 0;
+    item_db_map = NULL;
+    item_db_map_size = 0;
+}
+
+bool is_item_database_cached(void)
+{
+    return item_db_map != NULL;
+}
+
+// =============================================================================
+// ITEM DEFINITIONS
+// =============================================================================
+
+uint32_t get_item_def_count(void)
+{
+    return item_def_count;
+}
+
+const ItemDef_t* get_item_def(uint32_t index)
+{
+    if (index >= item_def_count) {
+        return NULL;
+    }
+
+    return &item_defs[index];
+}
+
+const ItemDef_t* find_item_def(const char* id)
+{
+    if (id == NULL) {
+        return NULL;
+    }
+
+    uint32_t index = _lower_bound_item_def(id);
+    if (index < item_def_count && strncmp(item_defs[index].id, id, ITEM_DEF_ID_LENGTH) == 0) {
+        return &item_defs[index];
+    }
+
+    return NULL;
+}
+
+bool set_item_def(const ItemDef_t* def)
+{
+    if (def == NULL || def->type >= ITEM_TYPE_COUNT ||
+        def->id[0] == '\0' || def->name[0] == '\0' ||
+        memchr(def->id, '\0', ITEM_DEF_ID_LENGTH) == NULL ||
+        memchr(def->name, '\0', ITEM_DEF_NAME_LENGTH) == NULL) {
+        d_LogError("set_item_def: Invalid item definition");
+        return false;
+    }
+
+    if (!_own_item_defs()) {
+        return false;
+    }
+
+    uint32_t index = _lower_bound_item_def(def->id);
+    if (index < item_def_count && strcmp(item_defs[index].id, def->id) == 0) {
+        item_defs[index] = *def;
+        return true;
+    }
+
+    if (item_def_count == item_def_capacity) {
+        uint32_t capacity = item_def_capacity ? item_def_capacity * 2 : 64;
+        ItemDef_t* defs = (ItemDef_t*)realloc(item_defs, capacity * sizeof(ItemDef_t));
+        if (defs == NULL) {
+            d_LogError("Memory allocation failed for item definitions");
+            return false;
+        }
+
+        item_defs = defs;
+        item_def_capacity = capacity;
+    }
+
+    memmove(&item_defs[index + 1], &item_defs[index],
+            (item_def_count - index) * sizeof(ItemDef_t));
+    item_defs[index] = *def;
+    item_def_count++;
+    return true;
+}
+
+bool remove_item_def(const char* id)
+{
+    const ItemDef_t* def = find_item_def(id);
+    if (def == NULL || !_own_item_defs()) {
+        return false;
+    }
+
+    // Owning may have moved the table, look it up again
+    uint32_t index = _lower_bound_item_def(id);
+    memmove(&item_defs[index], &item_defs[index + 1],
+            (item_def_count - index - 1) * sizeof(ItemDef_t));
+    item_def_count--;
+    return true;
+}
+
+Item_t* create_item_from_def(const ItemDef_t* def)
+{
+    if (def == NULL) {
+        d_LogError("create_item_from_def: NULL definition");
+        return NULL;
+    }
+
+    Item_t* item = NULL;
+
+    switch (def->type) {
+        case ITEM_TYPE_KEY: {
+            Lock_t lock = create_lock(def->data.key.lock_name, def->data.key.lock_description,
+                                      def->data.key.pick_difficulty, def->data.key.jammed_seconds);
+            item = create_key(def->name, def->id, lock, def->glyph);
+            destroy_lock(&lock);
+            return item;
+        }
+
+        case ITEM_TYPE_CONSUMABLE:
+            for (int i = 0; i < item_effect_count; i++) {
+                if (strcmp(item_effects[i].name, def->data.consumable.effect) == 0) {
+                    return create_consumable(def->name, def->id, def->data.consumable.value,
+                                             item_effects[i].on_consume, def->glyph);
+                }
+            }
+
+            d_LogErrorF("Consumable '%s' has unregistered effect '%s'",
+                        def->id, def->data.consumable.effect);
+            return NULL;
+
+        default:
+            break;
+    }
+
+    Material_t material = create_material(def->material[0] ? def->material : "default",
+                                          def->material_properties);
+
+    switch (def->type) {
+        case ITEM_TYPE_WEAPON:
+            item = create_weapon(def->name, def->id, material, def->data.weapon.min_damage,
+                                 def->data.weapon.max_damage, def->data.weapon.range_tiles, def->glyph);
+            break;
+
+        case ITEM_TYPE_ARMOR:
+            item = create_armor(def->name, def->id, material, def->data.armor.armor_value,
+                                def->data.armor.evasion_value, def->glyph,
+                                def->data.armor.stealth_value, def->data.armor.enchant_value);
+            break;
+
+        case ITEM_TYPE_AMMUNITION:
+            item = create_ammunition(def->name, def->id, material, def->data.ammo.min_damage,
+                                     def->data.ammo.max_damage, def->glyph);
+            break;
+
+        default:
+            d_LogErrorF("Item definition '%s' has unknown type %u", def->id, def->type);
+            break;
+    }
+
+    // The item keeps the interned material name, not this copy
+    d_DestroyString(material.name);
+    return item;
+}
+
+bool register_item_effect(const char* name, void (*on_consume)(uint8_t))
+{
+    if (name == NULL || on_consume == NULL) {
+        d_LogError("register_item_effect: Invalid input");
+        return false;
+    }
+
+    for (int i = 0; i < item_effect_count; i++) {
+        if (strcmp(item_effects[i].name, name) == 0) {
+            item_effects[i].on_consume = on_consume;
+            return true;
+        }
+    }
+
+    if (item_effect_count == MAX_ITEM_EFFECTS) {
+        d_LogErrorF("Failed to register item effect '%s', table is full", name);
+        return false;
+    }
+
+    snprintf(item_effects[item_effect_count].name, MAX_NAME_LENGTH, "%s", name);
+    item_effects[item_effect_count].on_consume = on_consume;
+    item_effect_count++;
+    return true;
+}
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+/*
+ * Maps the cache if it matches this build and the source, if there is one
+ */
+static bool _map_item_cache(const char* cache_path, const struct stat* source)
+{
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat cache;
+    if (fstat(fd, &cache) != 0 || (size_t)cache.st_size < sizeof(ItemDbHeader_t)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)cache.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    const ItemDbHeader_t* header = (const ItemDbHeader_t*)map;
+
+    if (memcmp(header->magic, ITEM_DB_MAGIC, sizeof(ITEM_DB_MAGIC)) != 0 ||
+        header->version != ITEM_DB_VERSION ||
+        header->def_size != sizeof(ItemDef_t) ||
+        sizeof(ItemDbHeader_t) + (size_t)header->count * sizeof(ItemDef_t) != size ||
+        (source != NULL && (header->source_mtime != (int64_t)source->st_mtime ||
+                            header->source_size != (int64_t)source->st_size))) {
+        munmap(map, size);
+        return false;
+    }
+
+    item_db_map = map;
+    item_db_map_size = size;
+    item_defs = (ItemDef_t*)((char*)map + sizeof(ItemDbHeader_t));
+    item_def_count = header->count;
+    item_def_capacity = 0;
+    return true;
+}
+
+static bool _write_item_cache(const char* cache_path, const struct stat* source)
+{
+    ItemDbHeader_t header = {
+        .version = ITEM_DB_VERSION,
+        .def_size = sizeof(ItemDef_t),
+        .count = item_def_count,
+        .source_mtime = (int64_t)source->st_mtime,
+        .source_size = (int64_t)source->st_size
+    };
+    memcpy(header.magic, ITEM_DB_MAGIC, sizeof(ITEM_DB_MAGIC));
+
+    FILE* file = fopen(cache_path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool written = fwrite(&header, sizeof(ItemDbHeader_t), 1, file) == 1 &&
+                   (item_def_count == 0 ||
+                    fwrite(item_defs, sizeof(ItemDef_t), item_def_count, file) == item_def_count);
+
+    if (fclose(file) != 0 || !written) {
+        remove(cache_path);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Parses a JSON array of item objects into a sorted heap table
+ */
+static bool _compile_item_source(const char* source_path)
+{
+    FILE* file = fopen(source_path, "rb");
+    if (file == NULL) {
+        d_LogErrorF("Failed to open item database %s", source_path);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = (file_size >= 0) ? (char*)malloc((size_t)file_size + 1) : NULL;
+    if (text == NULL || fread(text, 1, (size_t)file_size, file) != (size_t)file_size) {
+        d_LogErrorF("Failed to read item database %s", source_path);
+        free(text);
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+    text[file_size] = '\0';
+
+    JsonReader_t reader = { .text = text, .filename = source_path, .line = 1 };
+
+    if (_json_expect(&reader, '[') && !_json_accept(&reader, ']')) {
+        do {
+            ItemDef_t def;
+            if (!_parse_item_def(&reader, &def)) {
+                break;
+            }
+
+            if (item_def_count == item_def_capacity) {
+                uint32_t capacity = item_def_capacity ? item_def_capacity * 2 : 64;
+                ItemDef_t* defs = (ItemDef_t*)realloc(item_defs, capacity * sizeof(ItemDef_t));
+                if (defs == NULL) {
+                    d_LogError("Memory allocation failed for item definitions");
+                    reader.failed = true;
+                    break;
+                }
+
+                item_defs = defs;
+                item_def_capacity = capacity;
+            }
+
+            item_defs[item_def_count++] = def;
+        } while (_json_accept(&reader, ','));
+
+        _json_expect(&reader, ']');
+    }
+
+    if (!reader.failed && _json_peek(&reader) != '\0') {
+        _json_error(&reader, "unexpected text after the item array");
+    }
+
+    free(text);
+
+    if (reader.failed) {
+        return false;
+    }
+
+    if (item_def_count > 1) {
+        qsort(item_defs, item_def_count, sizeof(ItemDef_t), _compare_item_defs);
+    }
+
+    for (uint32_t i = 1; i < item_def_count; i++) {
+        if (strcmp(item_defs[i - 1].id, item_defs[i].id) == 0) {
+            d_LogErrorF("%s: item id '%s' is defined more than once", source_path, item_defs[i].id);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * One item object, "type" has to come first so every other key is known
+ */
+static bool _parse_item_def(JsonReader_t* reader, ItemDef_t* def)
+{
+    char key[32];
+
+    memset(def, 0, sizeof(ItemDef_t));
+    def->material_properties = create_default_material_properties();
+    def->glyph = '?';
+
+    if (!_json_expect(reader, '{') ||
+        !_json_read_string(reader, key, sizeof(key), "key") ||
+        !_json_expect(reader, ':')) {
+        return false;
+    }
+
+    char type_name[16];
+    if (strcmp(key, "type") != 0) {
+        _json_error(reader, "\"type\" must be the first key of an item");
+        return false;
+    }
+
+    if (!_json_read_string(reader, type_name, sizeof(type_name), "type")) {
+        return false;
+    }
+
+    def->type = ITEM_TYPE_COUNT;
+    for (size_t t = 0; t < ITEM_TYPE_COUNT; t++) {
+        if (strcmp(type_name, item_type_names[t]) == 0) {
+            def->type = (uint8_t)t;
+        }
+    }
+
+    if (def->type == ITEM_TYPE_COUNT) {
+        _json_error(reader, "unknown item type");
+        return false;
+    }
+
+    while (_json_accept(reader, ',')) {
+        if (!_json_read_string(reader, key, sizeof(key), "key") || !_json_expect(reader, ':')) {
+            return false;
+        }
+
+        bool ok = true;
+
+        if (strcmp(key, "id") == 0) {
+            ok = _json_read_string(reader, def->id, ITEM_DEF_ID_LENGTH, key);
+        } else if (strcmp(key, "name") == 0) {
+            ok = _json_read_string(reader, def->name, ITEM_DEF_NAME_LENGTH, key);
+        } else if (strcmp(key, "material") == 0) {
+            ok = _json_read_string(reader, def->material, MAX_NAME_LENGTH, key);
+        } else if (strcmp(key, "glyph") == 0) {
+            char glyph[2];
+            ok = _json_read_string(reader, glyph, sizeof(glyph), key);
+            def->glyph = glyph[0];
+        } else if (strcmp(key, "material_properties") == 0) {
+            if (!_json_expect(reader, '{')) {
+                return false;
+            }
+
+            if (!_json_accept(reader, '}')) {
+                do {
+                    char factor[32];
+                    if (!_json_read_string(reader, factor, sizeof(factor), "key") ||
+                        !_json_expect(reader, ':')) {
+                        return false;
+                    }
+
+                    size_t f = 0;
+                    while (f < MATERIAL_FIELD_COUNT && strcmp(factor, material_fields[f].key) != 0) {
+                        f++;
+                    }
+
+                    double value;
+                    if (f == MATERIAL_FIELD_COUNT) {
+                        d_LogWarningF("%s:%d: unknown material property \"%s\"",
+                                      reader->filename, reader->line, factor);
+                        ok = _json_skip_value(reader);
+                    } else if ((ok = _json_read_number(reader, &value))) {
+                        *(float*)((char*)&def->material_properties + material_fields[f].offset) =
+                            (float)value;
+                    }
+                } while (ok && _json_accept(reader, ','));
+
+                ok = ok && _json_expect(reader, '}');
+            }
+        } else {
+            const ItemDefField_t* field = NULL;
+            for (size_t f = 0; f < ITEM_DEF_FIELD_COUNT; f++) {
+                if (item_def_fields[f].type == def->type && strcmp(item_def_fields[f].key, key) == 0) {
+                    field = &item_def_fields[f];
+                    break;
+                }
+            }
+
+            if (field == NULL) {
+                d_LogWarningF("%s:%d: \"%s\" is not a %s key, skipped",
+                              reader->filename, reader->line, key, type_name);
+                ok = _json_skip_value(reader);
+            } else if (field->size == 0) {
+                ok = _json_read_u8(reader, (uint8_t*)((char*)def + field->offset), key);
+            } else {
+                ok = _json_read_string(reader, (char*)def + field->offset, field->size, key);
+            }
+        }
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (!_json_expect(reader, '}')) {
+        return false;
+    }
+
+    if (def->id[0] == '\0' || def->name[0] == '\0') {
+        _json_error(reader, "item needs an \"id\" and a \"name\"");
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Copies a mapped cache to the heap so it can be changed
+ */
+static bool _own_item_defs(void)
+{
+    if (item_db_map == NULL) {
+        return true;
+    }
+
+    uint32_t capacity = item_def_count ? item_def_count : 64;
+    ItemDef_t* defs = (ItemDef_t*)malloc(capacity * sizeof(ItemDef_t));
+    if (defs == NULL) {
+        d_LogError("Memory allocation failed for item definitions");
+        return false;
+    }
+
+    memcpy(defs, item_defs, item_def_count * sizeof(ItemDef_t));
+    munmap(item_db_map, item_db_map_size);
+
+    item_db_map = NULL;
+    item_db_map_size = 0;
+    item_defs = defs;
+    item_def_capacity = capacity;
+    return true;
+}
+
+static int _compare_item_defs(const void* a, const void* b)
+{
+    return strcmp(((const ItemDef_t*)a)->id, ((const ItemDef_t*)b)->id);
+}
+
+/*
+ * First definition whose id is not less than id
+ */
+static uint32_t _lower_bound_item_def(const char* id)
+{
+    uint32_t low = 0;
+    uint32_t high = item_def_count;
+
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (strncmp(item_defs[mid].id, id, ITEM_DEF_ID_LENGTH) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static void _write_json_string(FILE* file, const char* str)
+{
+    fputc('"', file);
+    for (const unsigned char* c = (const unsigned char*)str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(file, "\\%c", *c);
+        } else if (*c == '\n') {
+            fprintf(file, "\\n");
+        } else if (*c == '\t') {
+            fprintf(file, "\\t");
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+// =============================================================================
+// JSON READER
+// =============================================================================
+
+static void _json_error(JsonReader_t* reader, const char* message)
+{
+    if (!reader->failed) {
+        d_LogErrorF("%s:%d: %s", reader->filename, reader->line, message);
+        reader->failed = true;
+    }
+}
+
+/*
+ * Skips whitespace and returns the next character without consuming it
+ */
+static char _json_peek(JsonReader_t* reader)
+{
+    for (;;) {
+        char c = reader->text[reader->pos];
+        if (c == '\n') {
+            reader->line++;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return c;
+        }
+        reader->pos++;
+    }
+}
+
+static bool _json_accept(JsonReader_t* reader, char c)
+{
+    if (reader->failed || _json_peek(reader) != c) {
+        return false;
+    }
+
+    reader->pos++;
+    return true;
+}
+
+static bool _json_expect(JsonReader_t* reader, char c)
+{
+    if (_json_accept(reader, c)) {
+        return true;
+    }
+
+    char message[32];
+    snprintf(message, sizeof(message), "expected '%c'", c);
+    _json_error(reader, message);
+    return false;
+}
+
+/*
+ * Reads a string into out, NULL out just skips it. Too long is truncated
+ */
+static bool _json_read_string(JsonReader_t* reader, char* out, size_t size, const char* key)
+{
+    if (!_json_expect(reader, '"')) {
+        return false;
+    }
+
+    size_t length = 0;
+    bool truncated = false;
+
+    for (;;) {
+        char c = reader->text[reader->pos++];
+
+        if (c == '"') {
+            break;
+        }
+
+        if (c == '\0' || c == '\n') {
+            reader->pos--;
+            _json_error(reader, "unterminated string");
+            return false;
+        }
+
+        if (c == '\\') {
+            char escape = reader->text[reader->pos++];
+            switch (escape) {
+                case '"': case '\\': case '/': c = escape; break;
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'u': {
+                    // Item text is ASCII, anything past it becomes '?'
+                    unsigned int code = 0;
+                    for (int i = 0; i < 4; i++) {
+                        char h = reader->text[reader->pos++];
+                        int digit = (h >= '0' && h <= '9') ? h - '0' :
+                                    (h >= 'a' && h <= 'f') ? h - 'a' + 10 :
+                                    (h >= 'A' && h <= 'F') ? h - 'A' + 10 : -1;
+                        if (digit < 0) {
+                            reader->pos--;
+                            _json_error(reader, "bad \\u escape");
+                            return false;
+                        }
+                        code = (code << 4) | (unsigned int)digit;
+                    }
+                    c = (code < 0x80) ? (char)code : '?';
+                    break;
+                }
+                default:
+                    reader->pos--;
+                    _json_error(reader, "bad escape in string");
+                    return false;
+            }
+        }
+
+        if (out != NULL) {
+            if (length + 1 < size) {
+                out[length++] = c;
+            } else {
+                truncated = true;
+            }
+        }
+    }
+
+    if (out != NULL) {
+        out[length] = '\0';
+    }
+
+    if (truncated) {
+        d_LogWarningF("%s:%d: \"%s\" is longer than %zu characters, truncated",
+                      reader->filename, reader->line, key, size - 1);
+    }
+
+    return true;
+}
+
+static bool _json_read_number(JsonReader_t* reader, double* out)
+{
+    if (reader->failed) {
+        return false;
+    }
+
+    _json_peek(reader);
+
+    const char* start = reader->text + reader->pos;
+    char* end = NULL;
+    *out = strtod(start, &end);
+
+    if (end == start) {
+        _json_error(reader, "expected a number");
+        return false;
+    }
+
+    reader->pos += (size_t)(end - start);
+    return true;
+}
+
+static bool _json_read_u8(JsonReader_t* reader, uint8_t* out, const char* key)
+{
+    double value;
+    if (!_json_read_number(reader, &value)) {
+        return false;
+    }
+
+    if (value < 0.0 || value > 255.0 || value != (double)(int)value) {
+        char message[64];
+        snprintf(message, sizeof(message), "\"%s\" must be a whole number 0 to 255", key);
+        _json_error(reader, message);
+        return false;
+    }
+
+    *out = (uint8_t)value;
+    return true;
+}
+
+static bool _json_skip_value(JsonReader_t* reader)
+{
+    char c = _json_peek(reader);
+
+    if (c == '"') {
+        return _json_read_string(reader, NULL, 0, "value");
+    }
+
+    if (c == '{' || c == '[') {
+        char close = (c == '{') ? '}' : ']';
+        reader->pos++;
+
+        if (_json_accept(reader, close)) {
+            return true;
+        }
+
+        do {
+            if (c == '{' && (!_json_read_string(reader, NULL, 0, "key") || !_json_expect(reader, ':'))) {
+                return false;
+            }
+            if (!_json_skip_value(reader)) {
+                return false;
+            }
+        } while (_json_accept(reader, ','));
+
+        return _json_expect(reader, close);
+    }
+
+    const char* literals[] = { "true", "false", "null" };
+    for (int i = 0; i < 3; i++) {
+        size_t length = strlen(literals[i]);
+        if (strncmp(reader->text + reader->pos, literals[i], length) == 0) {
+            reader->pos += length;
+            return true;
+        }
+    }
+
+    double ignored;
+    return _json_read_number(reader, &ignored);
+}
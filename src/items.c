@@ -1,8 +1,8 @@
-#define LOG( msg ) printf( "%s | File: %s, Line: %d\n", msg, __FILE__, __LINE__ )
 #include "Daedalus.h"
 #include "items.h"
 #include "structs.h"
 #include "defs.h"
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
@@ -13,18 +13,54 @@
 #define MAX_ITEM_NAME_LENGTH 64
 #define MAX_ITEM_ID_LENGTH 32
 
+// Logging below ITEMS_LOG_LEVEL is compiled out entirely, arguments and all.
+// Release builds pass e.g. -DITEMS_LOG_LEVEL=D_LOG_LEVEL_ERROR so the hot
+// getters are left with nothing but their NULL check and field load.
+#ifndef ITEMS_LOG_LEVEL
+#define ITEMS_LOG_LEVEL D_LOG_LEVEL_DEBUG
+#endif
+
+#define ITEMS_LOG_ON( level ) ( ( level ) >= ITEMS_LOG_LEVEL )
+
+#define ITEMS_LOG( level, ... ) \
+    do { if (ITEMS_LOG_ON(level)) d_LogF((level), __VA_ARGS__); } while (0)
+
+#define ITEMS_LOG_IF( condition, level, ... ) \
+    do { if (ITEMS_LOG_ON(level) && (condition)) d_LogF((level), __VA_ARGS__); } while (0)
+
+// Every call site keeps its own token, so a dropped message costs a level
+// check and a counter instead of formatting and hashing the format string
+#define ITEMS_LOG_RATE_LIMITED( level, max_count, time_window, ... ) \
+    do { \
+        if (ITEMS_LOG_ON(level)) { \
+            static ItemsLogToken_t _token; \
+            if (_take_log_token(&_token, (level), (max_count), (time_window))) { \
+                d_LogF((level), __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+typedef struct
+{
+    double window_start;
+    uint32_t count;
+
+} ItemsLogToken_t;
+
 // Static Helper Functions to have at top of file
-static bool _populate_consumable_desc(dString_t* dest, uint8_t value);
 static Material_t _create_default_material(void);
-static bool _populate_key_desc(dString_t* dest, const Lock_t* lock);
-static bool _populate_ammunition_desc(dString_t* dest, const Material_t* material, uint8_t min_dmg, uint8_t max_dmg);
 static Material_t _create_consumable_material(void);
-static bool _populate_rarity(dString_t* dest, const char* rarity);
-static bool _populate_armor_desc(dString_t* dest, const Material_t* material);
 static bool item_resists_durability_loss(const Item_t* item);
-static bool _populate_weapon_desc(dString_t* dest, const Material_t* material);
 static bool _populate_string_field(dString_t* dest, const char* src);
+static bool _intern_item_strings(Item_t* item, const char* name, const char* id, const Material_t* material, const char* kind);
+static dString_t* _intern_field(const char* src, size_t max_length, const char* field_name, uint32_t* atom);
+static dString_t* _intern_description(const char* format, ...);
+static Item_t* _alloc_item(void);
+static void _free_item(Item_t* item);
+static void _release_item_strings(Item_t* item);
 static bool _validate_and_truncate_string(dString_t* dest, const char* src, size_t max_length, const char* field_name);
+static bool _take_log_token(ItemsLogToken_t* token, dLogLevel_t level, uint32_t max_count, double time_window);
+static void _apply_material_factors(Item_t* item, const MaterialProperties_t* factors);
 /*
  * Safely validates a material structure for basic sanity
  */
@@ -36,20 +72,286 @@ static bool _is_material_valid(const Material_t* material) {
     if (material->name != NULL) {
         if ((void*)material->name <= (void*)0x1000) {
             // RATE LIMIT THIS:
-            d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_WARNING,
-                              1, 10.0, "Material has suspicious name pointer");
+            ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_WARNING, 1, 10.0,
+                                   "Material has suspicious name pointer");
             return false;
         }
         if (material->name->str != NULL && (void*)material->name->str <= (void*)0x1000) {
             // RATE LIMIT THIS:
-            d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_WARNING,
-                              1, 10.0, "Material name has suspicious str pointer");
+            ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_WARNING, 1, 10.0,
+                                   "Material name has suspicious str pointer");
             return false;
         }
     }
     return true;
 }
 
+// =============================================================================
+// STRING INTERNING
+// =============================================================================
+
+// Every distinct string is stored once, an atom is its index in
+// intern_strings and ATOM_NONE is never handed out. The hash table holds
+// atoms, open addressed and kept at most half full.
+static dString_t** intern_strings = NULL;
+static uint32_t* intern_hashes = NULL;
+static uint32_t intern_count = 1;
+static uint32_t intern_capacity = 0;
+static uint32_t* intern_table = NULL;
+static uint32_t intern_table_size = 0; // power of two
+
+/*
+ * FNV-1a over the string bytes
+ */
+static uint32_t _hash_string(const char* str)
+{
+    uint32_t hash = 2166136261u;
+
+    for (const unsigned char* c = (const unsigned char*)str; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+ * Probes for a string, leaves the empty slot it would go in when missing
+ */
+static uint32_t _find_atom(const char* str, uint32_t hash, uint32_t* slot)
+{
+    if (intern_table_size == 0) {
+        return ATOM_NONE;
+    }
+
+    uint32_t mask = intern_table_size - 1;
+    uint32_t i = hash & mask;
+
+    while (intern_table[i] != ATOM_NONE) {
+        uint32_t atom = intern_table[i];
+        if (intern_hashes[atom] == hash && strcmp(intern_strings[atom]->str, str) == 0) {
+            return atom;
+        }
+        i = (i + 1) & mask;
+    }
+
+    if (slot != NULL) {
+        *slot = i;
+    }
+    return ATOM_NONE;
+}
+
+static bool _grow_intern_table(void)
+{
+    uint32_t new_size = (intern_table_size == 0) ? 256 : intern_table_size * 2;
+    uint32_t* new_table = (uint32_t*)calloc(new_size, sizeof(uint32_t));
+    if (new_table == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for string intern table");
+        return false;
+    }
+
+    // Stored hashes mean no string is read again while rehashing
+    for (uint32_t atom = 1; atom < intern_count; atom++) {
+        uint32_t i = intern_hashes[atom] & (new_size - 1);
+        while (new_table[i] != ATOM_NONE) {
+            i = (i + 1) & (new_size - 1);
+        }
+        new_table[i] = atom;
+    }
+
+    free(intern_table);
+    intern_table = new_table;
+    intern_table_size = new_size;
+    return true;
+}
+
+/*
+ * Returns the atom of a string, storing a copy the first time it is seen
+ */
+uint32_t intern_string(const char* str)
+{
+    if (str == NULL) {
+        return ATOM_NONE;
+    }
+
+    uint32_t hash = _hash_string(str);
+    uint32_t slot = 0;
+    uint32_t atom = _find_atom(str, hash, &slot);
+    if (atom != ATOM_NONE) {
+        return atom;
+    }
+
+    if ((intern_count + 1) * 2 > intern_table_size) {
+        if (!_grow_intern_table()) {
+            return ATOM_NONE;
+        }
+        _find_atom(str, hash, &slot);
+    }
+
+    if (intern_count >= intern_capacity) {
+        uint32_t new_capacity = (intern_capacity == 0) ? 128 : intern_capacity * 2;
+        dString_t** new_strings = (dString_t**)realloc(intern_strings, sizeof(dString_t*) * new_capacity);
+        if (new_strings == NULL) {
+            ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for interned strings");
+            return ATOM_NONE;
+        }
+        intern_strings = new_strings;
+
+        uint32_t* new_hashes = (uint32_t*)realloc(intern_hashes, sizeof(uint32_t) * new_capacity);
+        if (new_hashes == NULL) {
+            ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for interned strings");
+            return ATOM_NONE;
+        }
+        intern_hashes = new_hashes;
+        intern_capacity = new_capacity;
+    }
+
+    dString_t* copy = d_InitString();
+    if (copy == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to intern string '%s'", str);
+        return ATOM_NONE;
+    }
+    d_AppendString(copy, str, 0);
+
+    atom = intern_count++;
+    intern_strings[atom] = copy;
+    intern_hashes[atom] = hash;
+    intern_table[slot] = atom;
+
+    return atom;
+}
+
+uint32_t find_interned_string(const char* str)
+{
+    if (str == NULL) {
+        return ATOM_NONE;
+    }
+
+    return _find_atom(str, _hash_string(str), NULL);
+}
+
+const char* get_interned_string(uint32_t atom)
+{
+    if (atom == ATOM_NONE || atom >= intern_count) {
+        return NULL;
+    }
+
+    return intern_strings[atom]->str;
+}
+
+uint32_t get_interned_string_count(void)
+{
+    return intern_count - 1;
+}
+
+/*
+ * Frees every interned string, items pointing at them must be gone first
+ */
+void destroy_interned_strings(void)
+{
+    for (uint32_t atom = 1; atom < intern_count; atom++) {
+        d_DestroyString(intern_strings[atom]);
+    }
+
+    free(intern_strings);
+    free(intern_hashes);
+    free(intern_table);
+    intern_strings = NULL;
+    intern_hashes = NULL;
+    intern_table = NULL;
+    intern_count = 1;
+    intern_capacity = 0;
+    intern_table_size = 0;
+
+    // Registered materials are keyed by atoms that no longer exist
+    clear_material_registry();
+}
+
+// =============================================================================
+// ITEM POOLS
+// =============================================================================
+
+// Pool the create_* functions take items from, NULL is plain malloc
+static ItemPool_t* current_item_pool = NULL;
+
+/*
+ * Creates an empty pool, slabs are only allocated once items are made
+ */
+ItemPool_t* create_item_pool(void)
+{
+    ItemPool_t* pool = (ItemPool_t*)calloc(1, sizeof(ItemPool_t));
+    if (pool == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for item pool");
+        return NULL;
+    }
+
+    return pool;
+}
+
+ItemPool_t* set_item_pool(ItemPool_t* pool)
+{
+    ItemPool_t* previous = current_item_pool;
+    current_item_pool = pool;
+    return previous;
+}
+
+/*
+ * Releases every item of the pool at once, the slabs stay for reuse
+ */
+void clear_item_pool(ItemPool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    for (ItemSlab_t* slab = pool->slabs; slab != NULL; slab = slab->next) {
+        for (uint32_t i = 0; i < slab->used; i++) {
+            Item_t* item = &slab->items[i];
+
+            // Destroyed items are already on the free list
+            if (item->slot == ITEM_SLOT_LIVE) {
+                _release_item_strings(item);
+                item->slot = ITEM_SLOT_DEAD;
+            }
+        }
+        slab->used = 0;
+    }
+
+    pool->current_slab = pool->slabs;
+    pool->free_list = NULL;
+    pool->live = 0;
+}
+
+void destroy_item_pool(ItemPool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    clear_item_pool(pool);
+
+    ItemSlab_t* slab = pool->slabs;
+    while (slab != NULL) {
+        ItemSlab_t* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    if (current_item_pool == pool) {
+        current_item_pool = NULL;
+    }
+
+    free(pool);
+}
+
+uint32_t get_item_pool_count(const ItemPool_t* pool)
+{
+    if (pool == NULL) {
+        return 0;
+    }
+
+    return pool->live;
+}
+
 // =============================================================================
 // ITEM CREATION & DESTRUCTION
 // =============================================================================
@@ -62,69 +364,41 @@ Item_t* create_weapon(const char* name, const char* id, Material_t material,
 {   
     // Validate material before using it
     if (!_is_material_valid(&material)) {
-        d_LogWarningF("Invalid material passed to create_%s, using default", "weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid material passed to create_%s, using default", "weapon");
         material = _create_default_material();
     }
     
     // Early parameter validation
-    d_LogIf(name == NULL || id == NULL, D_LOG_LEVEL_ERROR, 
-            "Invalid weapon parameters - name or ID is NULL");
+    ITEMS_LOG_IF(name == NULL || id == NULL, D_LOG_LEVEL_ERROR, 
+                 "Invalid weapon parameters - name or ID is NULL");
     
     if (name == NULL || id == NULL) {
         return NULL;
     }
 
-    Item_t* item = (Item_t*)malloc(sizeof(Item_t));
+    Item_t* item = _alloc_item();
     if (item == NULL) {
-        d_LogErrorF("Memory allocation failed for weapon '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for weapon '%s'", name);
         return NULL;
     }
 
-    // Initialize ALL pointers to NULL first - critical for safe cleanup
-    item->name = NULL;
-    item->id = NULL;
-    item->description = NULL;
-    item->rarity = NULL;
-    item->material_data.name = NULL;
-
     // Set item type early
     item->type = ITEM_TYPE_WEAPON;
 
-    // Populate name using helper FIRST
-    item->name = d_InitString();
-    if (item->name == NULL || !_validate_and_truncate_string(item->name, name, MAX_ITEM_NAME_LENGTH, "Item name")) {
-        d_LogErrorF("Failed to populate name for weapon '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate id using helper
-    item->id = d_InitString();
-    if (item->id == NULL || !_validate_and_truncate_string(item->id, id, MAX_ITEM_ID_LENGTH, "Item ID")) {
-        d_LogErrorF("Failed to populate ID for weapon '%s'", name);
-        goto cleanup_and_fail;
+    // Strings are interned, the item only points at the shared copies
+    if (!_intern_item_strings(item, name, id, &material, "weapon")) {
+        _free_item(item);
+        return NULL;
     }
 
     // NOW log weapon creation attempt with validated names - no more spam!
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating weapon: %s (%s) [dmg:%d-%d, range:%d]", 
-                      item->name->str, item->id->str, min_dmg, max_dmg, range);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating weapon: %s (%s) [dmg:%d-%d, range:%d]", 
+                           item->name->str, item->id->str, min_dmg, max_dmg, range);
 
     // Set basic properties
     item->glyph = glyph;
     item->material_data.properties = material.properties;
-    
-    // Create a COPY of the material name to avoid double-free
-    item->material_data.name = d_InitString();
-    if (item->material_data.name == NULL) {
-        d_LogErrorF("Failed to allocate material name for weapon '%s'", name);
-        goto cleanup_and_fail;
-    }
-    
-    if (material.name && material.name->str) {
-        d_AppendString(item->material_data.name, material.name->str, 0);
-    } else {
-        d_AppendString(item->material_data.name, "unknown", 0);
-    }
 
     // Initialize weapon-specific data
     item->data.weapon.min_damage = min_dmg;
@@ -143,49 +417,19 @@ Item_t* create_weapon(const char* name, const char* id, Material_t material,
     item->stackable = 0; // Weapons don't stack
 
     // Populate description using helper
-    item->description = d_InitString();
-    if (item->description == NULL || !_populate_weapon_desc(item->description, &item->material_data)) {
-        d_LogErrorF("Failed to populate description for weapon '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate rarity using helper
-    item->rarity = d_InitString();
-    if (item->rarity == NULL || !_populate_rarity(item->rarity, "common")) {
-        d_LogErrorF("Failed to populate rarity for weapon '%s'", name);
-        goto cleanup_and_fail;
+    item->description = _intern_description("A weapon made of %s", item->material_data.name->str);
+    if (item->description == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate description for weapon '%s'", name);
+        _free_item(item);
+        return NULL;
     }
 
     // Log successful creation with validated name
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG, 3, 5.0,
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 3, 5.0,
          "Weapon '%s' forged successfully [value:%d coins, weight:%.2f kg]", 
                item->name->str, item->value_coins, item->weight_kg);
 
     return item;
-
-cleanup_and_fail:
-    // Clean up any allocated resources - destroy_item handles NULL pointers safely
-    if (item != NULL) {
-        // Clean up dString_t fields properly
-        if (item->name != NULL) {
-            d_DestroyString(item->name);
-        }
-        if (item->id != NULL) {
-            d_DestroyString(item->id);
-        }
-        if (item->description != NULL) {
-            d_DestroyString(item->description);
-        }
-        if (item->rarity != NULL) {
-            d_DestroyString(item->rarity);
-        }
-        if (item->material_data.name != NULL) {
-            d_DestroyString(item->material_data.name);
-        }
-        
-        free(item);
-    }
-    return NULL;
 }
 /*
  * Creates armor with specified protection and stealth values
@@ -196,68 +440,40 @@ Item_t* create_armor(const char* name, const char* id, Material_t material,
 {
     // Validate material before using it
     if (!_is_material_valid(&material)) {
-        d_LogWarningF("Invalid material passed to create_%s, using default", "armor");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid material passed to create_%s, using default", "armor");
         material = _create_default_material();
     }
     
-    d_LogIf(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
-            "Invalid armor parameters - name or ID is NULL");
+    ITEMS_LOG_IF(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
+                 "Invalid armor parameters - name or ID is NULL");
     
     if (name == NULL || id == NULL) {
         return NULL;
     }
 
-    Item_t* item = (Item_t*)malloc(sizeof(Item_t));
+    Item_t* item = _alloc_item();
     if (item == NULL) {
-        d_LogErrorF("Memory allocation failed for armor '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for armor '%s'", name);
         return NULL;
     }
 
-    // Initialize ALL pointers to NULL first - CRITICAL!
-    item->name = NULL;
-    item->id = NULL;
-    item->description = NULL;
-    item->rarity = NULL;
-    item->material_data.name = NULL;
-
     // Set item type early
     item->type = ITEM_TYPE_ARMOR;
 
-    // Populate name using helper FIRST
-    item->name = d_InitString();
-    if (item->name == NULL || !_validate_and_truncate_string(item->name, name, MAX_ITEM_NAME_LENGTH, "Item name")) {
-        d_LogErrorF("Failed to populate name for armor '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate id using helper
-    item->id = d_InitString();
-    if (item->id == NULL || !_validate_and_truncate_string(item->id, id, MAX_ITEM_ID_LENGTH, "Item ID")) {
-        d_LogErrorF("Failed to populate ID for armor '%s'", name);
-        goto cleanup_and_fail;
+    // Strings are interned, the item only points at the shared copies
+    if (!_intern_item_strings(item, name, id, &material, "armor")) {
+        _free_item(item);
+        return NULL;
     }
 
     // NOW log armor creation attempt with validated names - no more spam!
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating armor: %s (%s) [armor:%d, evasion:%d, stealth:%d]", 
-                      item->name->str, item->id->str, armor_val, evasion_val, stealth_val);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating armor: %s (%s) [armor:%d, evasion:%d, stealth:%d]", 
+                           item->name->str, item->id->str, armor_val, evasion_val, stealth_val);
 
     // Set basic properties
     item->glyph = glyph;
     item->material_data.properties = material.properties;
-    
-    // Create a COPY of the material name to avoid double-free
-    item->material_data.name = d_InitString();
-    if (item->material_data.name == NULL) {
-        d_LogErrorF("Failed to allocate material name for armor '%s'", name);
-        goto cleanup_and_fail;
-    }
-    
-    if (material.name && material.name->str) {
-        d_AppendString(item->material_data.name, material.name->str, 0);
-    } else {
-        d_AppendString(item->material_data.name, "unknown", 0);
-    }
 
     // Initialize armor-specific data
     item->data.armor.armor_value = armor_val;
@@ -272,140 +488,93 @@ Item_t* create_armor(const char* name, const char* id, Material_t material,
     item->stackable = 0; // Armor doesn't stack
 
     // Populate description using helper
-    item->description = d_InitString();
-    if (item->description == NULL || !_populate_armor_desc(item->description, &item->material_data)) {
-        d_LogErrorF("Failed to populate description for armor '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate rarity using helper
-    item->rarity = d_InitString();
-    if (item->rarity == NULL || !_populate_rarity(item->rarity, "common")) {
-        d_LogErrorF("Failed to populate rarity for armor '%s'", name);
-        goto cleanup_and_fail;
+    item->description = _intern_description("Armor made of %s", item->material_data.name->str);
+    if (item->description == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate description for armor '%s'", name);
+        _free_item(item);
+        return NULL;
     }
 
     // Log successful creation with validated name
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG, 1, 6.0,
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 1, 6.0,
         "Armor '%s' crafted successfully [protection:%d, value:%d coins]", 
                item->name->str, armor_val, item->value_coins);
 
     return item;
-
-cleanup_and_fail:
-    // Clean up any allocated resources
-    if (item != NULL) {
-        if (item->name != NULL) {
-            d_DestroyString(item->name);
-        }
-        if (item->id != NULL) {
-            d_DestroyString(item->id);
-        }
-        if (item->description != NULL) {
-            d_DestroyString(item->description);
-        }
-        if (item->rarity != NULL) {
-            d_DestroyString(item->rarity);
-        }
-        if (item->material_data.name != NULL) {
-            d_DestroyString(item->material_data.name);
-        }
-        
-        free(item);
-    }
-    return NULL;
 }
 /*
  * Creates a key that can open a specific lock
  */
 Item_t* create_key(const char* name, const char* id, Lock_t lock, char glyph)
 {
-    d_LogIf(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
-            "Invalid key parameters - name or ID is NULL");
+    ITEMS_LOG_IF(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
+                 "Invalid key parameters - name or ID is NULL");
     
     if (name == NULL || id == NULL) {
         return NULL;
     }
 
-    Item_t* item = (Item_t*)malloc(sizeof(Item_t));
+    Item_t* item = _alloc_item();
     if (item == NULL) {
-        d_LogErrorF("Memory allocation failed for key '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for key '%s'", name);
         return NULL;
     }
 
-    // Initialize ALL pointers to NULL first - CRITICAL!
-    item->name = NULL;
-    item->id = NULL;
-    item->description = NULL;
-    item->rarity = NULL;
-    item->material_data.name = NULL;
+    // Initialize the owned lock pointers first - CRITICAL!
     item->data.key.lock.name = NULL;
     item->data.key.lock.description = NULL;
 
     // Set item type early
     item->type = ITEM_TYPE_KEY;
-    d_LogDebug("Item type set to ITEM_TYPE_KEY");
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Item type set to ITEM_TYPE_KEY");
 
-    // Populate name using helper
-    item->name = d_InitString();
-    if (item->name == NULL || !_validate_and_truncate_string(item->name, name, MAX_ITEM_NAME_LENGTH, "Item name")) {
-        d_LogErrorF("Failed to populate name for key '%s'", name);
-        goto cleanup_and_fail;
-    }
-    d_LogDebugF("Key name populated: %s", item->name->str);
+    // Keys don't have materials, so create default neutral material
+    Material_t material = _create_default_material();
+    item->material_data.properties = material.properties;
 
-    // Populate id using helper
-    item->id = d_InitString();
-    if (item->id == NULL || !_validate_and_truncate_string(item->id, id, MAX_ITEM_ID_LENGTH, "Item ID")) {
-        d_LogErrorF("Failed to populate ID for key '%s'", name);
-        goto cleanup_and_fail;
+    // Strings are interned, the item only points at the shared copies
+    if (!_intern_item_strings(item, name, id, &material, "key")) {
+        _free_item(item);
+        return NULL;
     }
-    d_LogDebugF("Key ID populated: %s", item->id->str);
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Key name populated: %s", item->name->str);
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Key ID populated: %s", item->id->str);
 
     // Set basic properties
     item->glyph = glyph;
-
-    // Keys don't have materials, so create default neutral material
-    item->material_data.properties = create_default_material_properties();
-    d_LogDebug("Creating default material properties with neutral factors");
-    d_LogDebug("Default material properties initialized");
-    
-    item->material_data.name = d_InitString();
-    if (item->material_data.name == NULL) {
-        d_LogErrorF("Failed to allocate material name for key '%s'", name);
-        goto cleanup_and_fail;
-    }
-    d_AppendString(item->material_data.name, "default", 0);
-    d_LogDebugF("Key material set to: %s", item->material_data.name->str);
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Key material set to: %s", item->material_data.name->str);
 
     // Initialize key-specific data - DEEP COPY the lock with length limiting
     item->data.key.lock.name = d_InitString();
     if (item->data.key.lock.name == NULL) {
-        d_LogErrorF("Failed to allocate lock name copy for key '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to allocate lock name copy for key '%s'", name);
         goto cleanup_and_fail;
     }
 
     if (lock.name && lock.name->str) {
         // Apply length limiting to prevent absurdly long lock names in logs
         if (!_validate_and_truncate_string(item->data.key.lock.name, lock.name->str, MAX_ITEM_NAME_LENGTH, "Lock name")) {
-            d_LogErrorF("Failed to populate lock name for key '%s'", name);
+            ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate lock name for key '%s'", name);
             goto cleanup_and_fail;
         }
     } else {
         d_AppendString(item->data.key.lock.name, "Unknown Lock", 0);
     }
 
+    // Keys and locks match on the atom of the lock name
+    item->data.key.lock.name_atom = intern_string(item->data.key.lock.name->str);
+
     // NOW log the key creation with the truncated lock name - no more spam!
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      3, 2.0, "Creating key: %s (%s) for lock '%s'", 
-                      item->name->str, item->id->str, 
-                      item->data.key.lock.name->str);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 3, 2.0,
+                           "Creating key: %s (%s) for lock '%s'", 
+                           item->name->str, item->id->str, 
+                           item->data.key.lock.name->str);
 
-    d_LogDebug("Entering key description population");
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Entering key description population");
     
     item->data.key.lock.description = d_InitString();
     if (item->data.key.lock.description == NULL) {
-        d_LogErrorF("Failed to allocate lock description copy for key '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to allocate lock description copy for key '%s'", name);
         goto cleanup_and_fail;
     }
     
@@ -418,7 +587,7 @@ Item_t* create_key(const char* name, const char* id, Lock_t lock, char glyph)
     item->data.key.lock.pick_difficulty = lock.pick_difficulty;
     item->data.key.lock.jammed_seconds = lock.jammed_seconds;
 
-    d_LogDebugF("Key description generated for lock: %s", item->data.key.lock.name->str);
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Key description generated for lock: %s", item->data.key.lock.name->str);
 
     // Set default values
     item->weight_kg = 0.1f; // Keys are light but not weightless
@@ -426,52 +595,33 @@ Item_t* create_key(const char* name, const char* id, Lock_t lock, char glyph)
     item->stackable = 1; // Keys can stack
 
     // Populate description using helper
-    item->description = d_InitString();
-    if (item->description == NULL || !_populate_key_desc(item->description, &lock)) {
-        d_LogErrorF("Failed to populate description for key '%s'", name);
+    if (lock.name == NULL || lock.name->str == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Lock name is NULL - cannot generate key description");
         goto cleanup_and_fail;
     }
 
-    // Populate rarity using helper
-    item->rarity = d_InitString();
-    if (item->rarity == NULL || !_populate_rarity(item->rarity, "common")) {
-        d_LogErrorF("Failed to populate rarity for key '%s'", name);
+    item->description = _intern_description("A key that opens: %s", lock.name->str);
+    if (item->description == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate description for key '%s'", name);
         goto cleanup_and_fail;
     }
 
     // Log successful key creation with truncated lock name
-    d_LogInfoF("Key '%s' forged successfully [opens:%s, difficulty:%d]", 
-               item->name->str, item->data.key.lock.name->str, lock.pick_difficulty);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Key '%s' forged successfully [opens:%s, difficulty:%d]", 
+              item->name->str, item->data.key.lock.name->str, lock.pick_difficulty);
 
     return item;
 
 cleanup_and_fail:
-    // Clean up any allocated resources - PROPER dString_t cleanup
-    if (item != NULL) {
-        if (item->name != NULL) {
-            d_DestroyString(item->name);
-        }
-        if (item->id != NULL) {
-            d_DestroyString(item->id);
-        }
-        if (item->description != NULL) {
-            d_DestroyString(item->description);
-        }
-        if (item->rarity != NULL) {
-            d_DestroyString(item->rarity);
-        }
-        if (item->material_data.name != NULL) {
-            d_DestroyString(item->material_data.name);
-        }
-        if (item->data.key.lock.name != NULL) {
-            d_DestroyString(item->data.key.lock.name);
-        }
-        if (item->data.key.lock.description != NULL) {
-            d_DestroyString(item->data.key.lock.description);
-        }
-        
-        free(item);
+    // Only the lock copy is owned by the key, the rest is interned
+    if (item->data.key.lock.name != NULL) {
+        d_DestroyString(item->data.key.lock.name);
+    }
+    if (item->data.key.lock.description != NULL) {
+        d_DestroyString(item->data.key.lock.description);
     }
+
+    _free_item(item);
     return NULL;
 }
 
@@ -485,41 +635,45 @@ Lock_t create_lock(const char* name, const char* description, uint8_t pick_diffi
     // Initialize all pointers to NULL first for safe cleanup
     lock.name = NULL;
     lock.description = NULL;
+    lock.name_atom = ATOM_NONE;
     lock.pick_difficulty = 0;
     lock.jammed_seconds = 0;
 
     // Initialize dString_t fields
     lock.name = d_InitString();
     if (lock.name == NULL) {
-        d_LogError("Lock name string initialization failed");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Lock name string initialization failed");
         goto cleanup_and_fail;
     }
 
     lock.description = d_InitString();
     if (lock.description == NULL) {
-        d_LogError("Lock description string initialization failed");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Lock description string initialization failed");
         goto cleanup_and_fail;
     }
 
     // Validate and populate name field FIRST, then log with truncated name
     if (name != NULL) {
         if (!_validate_and_truncate_string(lock.name, name, MAX_ITEM_NAME_LENGTH, "Lock name")) {
-            d_LogErrorF("Failed to populate lock name: %s", name);
+            ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate lock name: %s", name);
             goto cleanup_and_fail;
         }
     } else {
         d_AppendString(lock.name, "Unnamed Lock", 0);
     }
 
+    // Keys and locks match on the atom of the lock name
+    lock.name_atom = intern_string(lock.name->str);
+
     // NOW log lock creation with the validated/truncated name - no more spam!
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating lock: %s [difficulty:%d, jammed:%ds]", 
-                      lock.name->str, pick_difficulty, jammed_seconds);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating lock: %s [difficulty:%d, jammed:%ds]", 
+                           lock.name->str, pick_difficulty, jammed_seconds);
 
     // Populate description field
     if (description != NULL) {
         if (!_validate_and_truncate_string(lock.description, description, MAX_ITEM_NAME_LENGTH * 2, "Lock description")) {
-            d_LogWarningF("Failed to populate lock description, using default");
+            ITEMS_LOG(D_LOG_LEVEL_WARNING, "Failed to populate lock description, using default");
             d_AppendString(lock.description, "No description", 0);
         }
     } else {
@@ -531,8 +685,8 @@ Lock_t create_lock(const char* name, const char* description, uint8_t pick_diffi
     lock.jammed_seconds = jammed_seconds;
 
     // Log successful lock creation with validated name
-    d_LogInfoF("Lock '%s' assembled successfully [security level:%d]", 
-               lock.name->str, pick_difficulty);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Lock '%s' assembled successfully [security level:%d]", 
+              lock.name->str, pick_difficulty);
 
     return lock;
 
@@ -556,14 +710,14 @@ cleanup_and_fail:
 void destroy_lock(Lock_t* lock)
 {
     if (lock == NULL) {
-        d_LogWarning("Cannot destroy NULL lock");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Cannot destroy NULL lock");
         return;
     }
 
     // Log destruction with lock name if available
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Destroying lock: %s", 
-                      (lock->name && lock->name->str) ? lock->name->str : "Unknown");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Destroying lock: %s", 
+                           (lock->name && lock->name->str) ? lock->name->str : "Unknown");
 
     if (lock->name != NULL) {
         d_DestroyString(lock->name);
@@ -578,8 +732,8 @@ void destroy_lock(Lock_t* lock)
     lock->pick_difficulty = 0;
     lock->jammed_seconds = 0;
 
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                  1, 1.0, "Lock destruction completed");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 1, 1.0,
+                  "Lock destruction completed");
 }
 
 /*
@@ -588,26 +742,19 @@ void destroy_lock(Lock_t* lock)
 Item_t* create_consumable(const char* name, const char* id, int value,
                          void (*on_consume)(uint8_t), char glyph)
 {
-    d_LogIf(name == NULL || id == NULL || on_consume == NULL, D_LOG_LEVEL_ERROR,
-            "Invalid consumable parameters - name, ID, or callback is NULL");
+    ITEMS_LOG_IF(name == NULL || id == NULL || on_consume == NULL, D_LOG_LEVEL_ERROR,
+                 "Invalid consumable parameters - name, ID, or callback is NULL");
     
     if (name == NULL || id == NULL || on_consume == NULL) {
         return NULL;
     }
 
-    Item_t* item = (Item_t*)malloc(sizeof(Item_t));
+    Item_t* item = _alloc_item();
     if (item == NULL) {
-        d_LogErrorF("Memory allocation failed for consumable '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for consumable '%s'", name);
         return NULL;
     }
 
-    // Initialize ALL pointers to NULL first - CRITICAL!
-    item->name = NULL;
-    item->id = NULL;
-    item->description = NULL;
-    item->rarity = NULL;
-    item->material_data.name = NULL;
-
     // Set item type early
     item->type = ITEM_TYPE_CONSUMABLE;
 
@@ -615,53 +762,27 @@ Item_t* create_consumable(const char* name, const char* id, int value,
     uint8_t clamped_value = value;
     if (value > 255) {
         clamped_value = 255;
-        d_LogWarningF("Consumable value %d exceeds uint8_t maximum, clamping to 255", value);
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Consumable value %d exceeds uint8_t maximum, clamping to 255", value);
     }
 
-    // Populate name using helper FIRST
-    item->name = d_InitString();
-    if (item->name == NULL || !_validate_and_truncate_string(item->name, name, MAX_ITEM_NAME_LENGTH, "Item name")) {
-        d_LogErrorF("Failed to populate name for consumable '%s'", name);
-        goto cleanup_and_fail;
-    }
+    // Create consumable material, its name is interned like the item strings
+    Material_t consumable_material = _create_consumable_material();
+    item->material_data.properties = consumable_material.properties;
 
-    // Populate id using helper
-    item->id = d_InitString();
-    if (item->id == NULL || !_validate_and_truncate_string(item->id, id, MAX_ITEM_ID_LENGTH, "Item ID")) {
-        d_LogErrorF("Failed to populate ID for consumable '%s'", name);
-        goto cleanup_and_fail;
+    // Strings are interned, the item only points at the shared copies
+    if (!_intern_item_strings(item, name, id, &consumable_material, "consumable")) {
+        _free_item(item);
+        return NULL;
     }
 
     // NOW log consumable creation attempt with validated names - use clamped_value
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating consumable: %s (%s) [value:%d]", 
-                      item->name->str, item->id->str, clamped_value);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating consumable: %s (%s) [value:%d]", 
+                           item->name->str, item->id->str, clamped_value);
 
     // Set basic properties
     item->glyph = glyph;
 
-    // Create consumable material - get the properties and copy the name
-    Material_t consumable_material = _create_consumable_material();
-    item->material_data.properties = consumable_material.properties;
-    
-    // Create a COPY of the consumable material name
-    item->material_data.name = d_InitString();
-    if (item->material_data.name == NULL) {
-        d_LogErrorF("Failed to allocate material name for consumable '%s'", name);
-        goto cleanup_and_fail;
-    }
-    
-    if (consumable_material.name && consumable_material.name->str) {
-        d_AppendString(item->material_data.name, consumable_material.name->str, 0);
-    } else {
-        d_AppendString(item->material_data.name, "organic", 0);
-    }
-
-    // Clean up the temporary material name to prevent memory leak
-    if (consumable_material.name) {
-        d_DestroyString(consumable_material.name);
-    }
-
     // Initialize consumable-specific data - use clamped_value consistently
     item->data.consumable.on_consume = on_consume;
     item->data.consumable.on_duration_end = NULL; // Optional
@@ -675,47 +796,18 @@ Item_t* create_consumable(const char* name, const char* id, int value,
     item->stackable = 16; // Can stack up to 16
 
     // Populate description using helper - use clamped_value
-    item->description = d_InitString();
-    if (item->description == NULL || !_populate_consumable_desc(item->description, clamped_value)) {
-        d_LogErrorF("Failed to populate description for consumable '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate rarity using helper
-    item->rarity = d_InitString();
-    if (item->rarity == NULL || !_populate_rarity(item->rarity, "common")) {
-        d_LogErrorF("Failed to populate rarity for consumable '%s'", name);
-        goto cleanup_and_fail;
+    item->description = _intern_description("A consumable item with magical properties (Potency: %d)", clamped_value);
+    if (item->description == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate description for consumable '%s'", name);
+        _free_item(item);
+        return NULL;
     }
 
     // Log successful consumable creation with clamped value
-    d_LogInfoF("Consumable '%s' brewed successfully [potency:%d, stacks:%d]", 
-               item->name->str, clamped_value, item->stackable);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Consumable '%s' brewed successfully [potency:%d, stacks:%d]", 
+              item->name->str, clamped_value, item->stackable);
 
     return item;
-
-cleanup_and_fail:
-    // Clean up any allocated resources
-    if (item != NULL) {
-        if (item->name != NULL) {
-            d_DestroyString(item->name);
-        }
-        if (item->id != NULL) {
-            d_DestroyString(item->id);
-        }
-        if (item->description != NULL) {
-            d_DestroyString(item->description);
-        }
-        if (item->rarity != NULL) {
-            d_DestroyString(item->rarity);
-        }
-        if (item->material_data.name != NULL) {
-            d_DestroyString(item->material_data.name);
-        }
-        
-        free(item);
-    }
-    return NULL;
 }
 /*
  * Creates ammunition with specified damage range and material
@@ -725,68 +817,40 @@ Item_t* create_ammunition(const char* name, const char* id, Material_t material,
 {
     // Validate material before using it
     if (!_is_material_valid(&material)) {
-        d_LogWarningF("Invalid material passed to create_%s, using default", "ammunition");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid material passed to create_%s, using default", "ammunition");
         material = _create_default_material();
     }
     
-    d_LogIf(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
-            "Invalid ammunition parameters - name or ID is NULL");
+    ITEMS_LOG_IF(name == NULL || id == NULL, D_LOG_LEVEL_ERROR,
+                 "Invalid ammunition parameters - name or ID is NULL");
     
     if (name == NULL || id == NULL) {
         return NULL;
     }
 
-    Item_t* item = (Item_t*)malloc(sizeof(Item_t));
+    Item_t* item = _alloc_item();
     if (item == NULL) {
-        d_LogErrorF("Memory allocation failed for ammunition '%s'", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for ammunition '%s'", name);
         return NULL;
     }
 
-    // Initialize ALL pointers to NULL first - CRITICAL!
-    item->name = NULL;
-    item->id = NULL;
-    item->description = NULL;
-    item->rarity = NULL;
-    item->material_data.name = NULL;
-
     // Set item type early
     item->type = ITEM_TYPE_AMMUNITION;
 
-    // Populate name using helper FIRST
-    item->name = d_InitString();
-    if (item->name == NULL || !_validate_and_truncate_string(item->name, name, MAX_ITEM_NAME_LENGTH, "Item name")) {
-        d_LogErrorF("Failed to populate name for ammunition '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate id using helper
-    item->id = d_InitString();
-    if (item->id == NULL || !_validate_and_truncate_string(item->id, id, MAX_ITEM_ID_LENGTH, "Item ID")) {
-        d_LogErrorF("Failed to populate ID for ammunition '%s'", name);
-        goto cleanup_and_fail;
+    // Strings are interned, the item only points at the shared copies
+    if (!_intern_item_strings(item, name, id, &material, "ammunition")) {
+        _free_item(item);
+        return NULL;
     }
 
     // NOW log ammunition creation attempt with validated names - no more spam!
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating ammunition: %s (%s) [dmg:%d-%d]", 
-                      item->name->str, item->id->str, min_dmg, max_dmg);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating ammunition: %s (%s) [dmg:%d-%d]", 
+                           item->name->str, item->id->str, min_dmg, max_dmg);
 
     // Set basic properties
     item->glyph = glyph;
     item->material_data.properties = material.properties;
-    
-    // Create a COPY of the material name to avoid double-free
-    item->material_data.name = d_InitString();
-    if (item->material_data.name == NULL) {
-        d_LogErrorF("Failed to allocate material name for ammunition '%s'", name);
-        goto cleanup_and_fail;
-    }
-    
-    if (material.name && material.name->str) {
-        d_AppendString(item->material_data.name, material.name->str, 0);
-    } else {
-        d_AppendString(item->material_data.name, "unknown", 0);
-    }
 
     // Initialize ammunition-specific data
     item->data.ammo.min_damage = min_dmg;
@@ -798,48 +862,20 @@ Item_t* create_ammunition(const char* name, const char* id, Material_t material,
     item->stackable = 255; // Ammo stacks very well
 
     // Populate description using helper
-    item->description = d_InitString();
-    if (item->description == NULL || !_populate_ammunition_desc(item->description, &item->material_data, min_dmg, max_dmg)) {
-        d_LogErrorF("Failed to populate description for ammunition '%s'", name);
-        goto cleanup_and_fail;
-    }
-
-    // Populate rarity using helper
-    item->rarity = d_InitString();
-    if (item->rarity == NULL || !_populate_rarity(item->rarity, "common")) {
-        d_LogErrorF("Failed to populate rarity for ammunition '%s'", name);
-        goto cleanup_and_fail;
+    item->description = _intern_description("Ammunition made of %s (Damage: %d-%d)",
+                                            item->material_data.name->str, min_dmg, max_dmg);
+    if (item->description == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate description for ammunition '%s'", name);
+        _free_item(item);
+        return NULL;
     }
 
    // RATE LIMIT THIS - Called during every ammunition creation in stress tests
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_INFO,
-                    5, 3.0, "Ammunition '%s' crafted successfully [damage:%d-%d, stacks:%d]", 
-                    item->name->str, min_dmg, max_dmg, item->stackable);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_INFO, 5, 3.0,
+                         "Ammunition '%s' crafted successfully [damage:%d-%d, stacks:%d]", 
+                         item->name->str, min_dmg, max_dmg, item->stackable);
 
     return item;
-
-cleanup_and_fail:
-    // Clean up any allocated resources
-    if (item != NULL) {
-        if (item->name != NULL) {
-            d_DestroyString(item->name);
-        }
-        if (item->id != NULL) {
-            d_DestroyString(item->id);
-        }
-        if (item->description != NULL) {
-            d_DestroyString(item->description);
-        }
-        if (item->rarity != NULL) {
-            d_DestroyString(item->rarity);
-        }
-        if (item->material_data.name != NULL) {
-            d_DestroyString(item->material_data.name);
-        }
-        
-        free(item);
-    }
-    return NULL;
 }
 /*
  * Destroys an item and frees all associated memory
@@ -847,7 +883,13 @@ cleanup_and_fail:
 void destroy_item(Item_t* item)
 {
     if (item == NULL) {
-        d_LogWarning("Cannot destroy NULL item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Cannot destroy NULL item");
+        return;
+    }
+
+    // A pooled slot that was destroyed or cleared already must not reach free()
+    if (item->pool != NULL && item->slot == ITEM_SLOT_DEAD) {
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item was already destroyed or its pool cleared");
         return;
     }
 
@@ -857,70 +899,19 @@ void destroy_item(Item_t* item)
     };
     const char* type_name = (item->type < 5) ? type_names[item->type] : type_names[5];
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Destroying %s: %s", type_name,
-                      (item->name && item->name->str) ? item->name->str : "Unknown");
-
-    // Clean up all string fields - ONLY if they appear to be valid dString_t pointers
-    if (item->name != NULL) {
-        // Additional safety check - ensure it looks like a valid dString_t
-        if ((void*)item->name > (void*)0x1000) {  // Basic sanity check for valid pointer
-            d_DestroyString(item->name);
-            item->name = NULL;
-        }
-    }
-    
-    if (item->id != NULL) {
-        if ((void*)item->id > (void*)0x1000) {
-            d_DestroyString(item->id);
-            item->id = NULL;
-        }
-    }
-    
-    if (item->description != NULL) {
-        if ((void*)item->description > (void*)0x1000) {
-            d_DestroyString(item->description);
-            item->description = NULL;
-        }
-    }
-    
-    if (item->rarity != NULL) {
-        if ((void*)item->rarity > (void*)0x1000) {
-            d_DestroyString(item->rarity);
-            item->rarity = NULL;
-        }
-    }
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Destroying %s: %s", type_name,
+                           (item->name && item->name->str) ? item->name->str : "Unknown");
 
-    // Clean up material string if allocated - BE EXTRA CAREFUL
-    if (item->material_data.name != NULL) {
-        // Verify this looks like a valid dString_t pointer before destroying
-        if ((void*)item->material_data.name > (void*)0x1000) {
-            d_DestroyString(item->material_data.name);
-            item->material_data.name = NULL;
-        }
-    }
+    // Name, id, description, rarity and material name are interned and
+    // shared with every other item, they live until destroy_interned_strings()
+    _release_item_strings(item);
 
-    // For keys, clean up the embedded lock strings
-    if (item->type == ITEM_TYPE_KEY) {
-        if (item->data.key.lock.name != NULL) {
-            if ((void*)item->data.key.lock.name > (void*)0x1000) {
-                d_DestroyString(item->data.key.lock.name);
-                item->data.key.lock.name = NULL;
-            }
-        }
-        if (item->data.key.lock.description != NULL) {
-            if ((void*)item->data.key.lock.description > (void*)0x1000) {
-                d_DestroyString(item->data.key.lock.description);
-                item->data.key.lock.description = NULL;
-            }
-        }
-    }
-
-    // Finally free the item itself
-    free(item);
+    // Finally free the item itself, or hand it back to its pool
+    _free_item(item);
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                  1, 1.0, "Item destruction completed");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 1, 1.0,
+                  "Item destruction completed");
 }
 
 // =============================================================================
@@ -932,17 +923,17 @@ void destroy_item(Item_t* item)
  */
 bool is_weapon(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_DEBUG, "Type check requested for NULL item - returning false");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_DEBUG, "Type check requested for NULL item - returning false");
     
     if (item == NULL) {
         return false;
     }
     
     bool result = item->type == ITEM_TYPE_WEAPON;
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item '%s' weapon check: %s", 
-                      item->name ? item->name->str : "Unknown", 
-                      result ? "TRUE" : "FALSE");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Item '%s' weapon check: %s", 
+                           item->name ? item->name->str : "Unknown", 
+                           result ? "TRUE" : "FALSE");
     
     return result;
 }
@@ -952,17 +943,17 @@ bool is_weapon(const Item_t* item)
  */
 bool is_armor(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_DEBUG, "Armor type check requested for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_DEBUG, "Armor type check requested for NULL item");
     
     if (item == NULL) {
         return false;
     }
     
     bool result = item->type == ITEM_TYPE_ARMOR;
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item '%s' armor check: %s", 
-                      item->name ? item->name->str : "Unknown", 
-                      result ? "TRUE" : "FALSE");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Item '%s' armor check: %s", 
+                           item->name ? item->name->str : "Unknown", 
+                           result ? "TRUE" : "FALSE");
     
     return result;
 }
@@ -972,17 +963,17 @@ bool is_armor(const Item_t* item)
  */
 bool is_key(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_DEBUG, "Key type check requested for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_DEBUG, "Key type check requested for NULL item");
     
     if (item == NULL) {
         return false;
     }
     
     bool result = item->type == ITEM_TYPE_KEY;
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item '%s' key check: %s", 
-                      item->name ? item->name->str : "Unknown", 
-                      result ? "TRUE" : "FALSE");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Item '%s' key check: %s", 
+                           item->name ? item->name->str : "Unknown", 
+                           result ? "TRUE" : "FALSE");
     
     return result;
 }
@@ -992,17 +983,17 @@ bool is_key(const Item_t* item)
  */
 bool is_consumable(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_DEBUG, "Consumable type check requested for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_DEBUG, "Consumable type check requested for NULL item");
     
     if (item == NULL) {
         return false;
     }
     
     bool result = item->type == ITEM_TYPE_CONSUMABLE;
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item '%s' consumable check: %s", 
-                      item->name ? item->name->str : "Unknown", 
-                      result ? "TRUE" : "FALSE");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Item '%s' consumable check: %s", 
+                           item->name ? item->name->str : "Unknown", 
+                           result ? "TRUE" : "FALSE");
     
     return result;
 }
@@ -1012,17 +1003,17 @@ bool is_consumable(const Item_t* item)
  */
 bool is_ammunition(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_DEBUG, "Ammunition type check requested for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_DEBUG, "Ammunition type check requested for NULL item");
     
     if (item == NULL) {
         return false;
     }
     
     bool result = item->type == ITEM_TYPE_AMMUNITION;
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item '%s' ammunition check: %s", 
-                      item->name ? item->name->str : "Unknown", 
-                      result ? "TRUE" : "FALSE");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Item '%s' ammunition check: %s", 
+                           item->name ? item->name->str : "Unknown", 
+                           result ? "TRUE" : "FALSE");
     
     return result;
 }
@@ -1032,17 +1023,17 @@ bool is_ammunition(const Item_t* item)
  */
 Weapon__Item_t* get_weapon_data(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve weapon data from NULL item");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_WEAPON, D_LOG_LEVEL_WARNING, 
-            "Attempted to get weapon data from non-weapon item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve weapon data from NULL item");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_WEAPON, D_LOG_LEVEL_WARNING, 
+                 "Attempted to get weapon data from non-weapon item");
     
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
         return NULL;
     }
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Weapon data accessed for '%s' [dmg:%d-%d]", 
-                      item->name->str, item->data.weapon.min_damage, item->data.weapon.max_damage);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Weapon data accessed for '%s' [dmg:%d-%d]", 
+                           item->name->str, item->data.weapon.min_damage, item->data.weapon.max_damage);
     
     return &item->data.weapon;
 }
@@ -1052,17 +1043,17 @@ Weapon__Item_t* get_weapon_data(Item_t* item)
  */
 Armor__Item_t* get_armor_data(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve armor data from NULL item");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_ARMOR, D_LOG_LEVEL_WARNING, 
-            "Attempted to get armor data from non-armor item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve armor data from NULL item");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_ARMOR, D_LOG_LEVEL_WARNING, 
+                 "Attempted to get armor data from non-armor item");
     
     if (item == NULL || item->type != ITEM_TYPE_ARMOR) {
         return NULL;
     }
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Armor data accessed for '%s' [armor:%d, evasion:%d]", 
-                      item->name->str, item->data.armor.armor_value, item->data.armor.evasion_value);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Armor data accessed for '%s' [armor:%d, evasion:%d]", 
+                           item->name->str, item->data.armor.armor_value, item->data.armor.evasion_value);
     
     return &item->data.armor;
 }
@@ -1072,18 +1063,18 @@ Armor__Item_t* get_armor_data(Item_t* item)
  */
 Key__Item_t* get_key_data(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve key data from NULL item");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_KEY, D_LOG_LEVEL_WARNING, 
-            "Attempted to get key data from non-key item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve key data from NULL item");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_KEY, D_LOG_LEVEL_WARNING, 
+                 "Attempted to get key data from non-key item");
     
     if (item == NULL || item->type != ITEM_TYPE_KEY) {
         return NULL;
     }
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Key data accessed for '%s' [opens:%s]", 
-                      item->name->str, 
-                      item->data.key.lock.name ? item->data.key.lock.name->str : "Unknown");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Key data accessed for '%s' [opens:%s]", 
+                           item->name->str, 
+                           item->data.key.lock.name ? item->data.key.lock.name->str : "Unknown");
     
     return &item->data.key;
 }
@@ -1093,17 +1084,17 @@ Key__Item_t* get_key_data(Item_t* item)
  */
 Consumable__Item_t* get_consumable_data(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve consumable data from NULL item");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_CONSUMABLE, D_LOG_LEVEL_WARNING, 
-            "Attempted to get consumable data from non-consumable item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve consumable data from NULL item");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_CONSUMABLE, D_LOG_LEVEL_WARNING, 
+                 "Attempted to get consumable data from non-consumable item");
     
     if (item == NULL || item->type != ITEM_TYPE_CONSUMABLE) {
         return NULL;
     }
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Consumable data accessed for '%s' [value:%d, duration:%ds]", 
-                      item->name->str, item->data.consumable.value, item->data.consumable.duration_seconds);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Consumable data accessed for '%s' [value:%d, duration:%ds]", 
+                           item->name->str, item->data.consumable.value, item->data.consumable.duration_seconds);
     
     return &item->data.consumable;
 }
@@ -1113,17 +1104,17 @@ Consumable__Item_t* get_consumable_data(Item_t* item)
  */
 Ammunition__Item_t* get_ammunition_data(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve ammunition data from NULL item");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_AMMUNITION, D_LOG_LEVEL_WARNING, 
-            "Attempted to get ammunition data from non-ammunition item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot retrieve ammunition data from NULL item");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_AMMUNITION, D_LOG_LEVEL_WARNING, 
+                 "Attempted to get ammunition data from non-ammunition item");
     
     if (item == NULL || item->type != ITEM_TYPE_AMMUNITION) {
         return NULL;
     }
     
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Ammunition data accessed for '%s' [dmg:%d-%d]", 
-                      item->name->str, item->data.ammo.min_damage, item->data.ammo.max_damage);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Ammunition data accessed for '%s' [dmg:%d-%d]", 
+                           item->name->str, item->data.ammo.min_damage, item->data.ammo.max_damage);
     
     return &item->data.ammo;
 }
@@ -1137,39 +1128,44 @@ Ammunition__Item_t* get_ammunition_data(Item_t* item)
  */
 Material_t create_material(const char* name, MaterialProperties_t properties)
 {
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Creating material: %s", name ? name : "NULL");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Creating material: %s", name ? name : "NULL");
     
     Material_t material;
     material.name = d_InitString();
+    material.name_atom = ATOM_NONE;
+    material.id = MATERIAL_NONE;
     
     if (material.name == NULL) {
-        d_LogError("Failed to initialize material name string");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to initialize material name string");
         memset(&material, 0, sizeof(Material_t));
         return material;
     }
     
     if (name == NULL) {
-        d_LogWarning("Material name is NULL - using default name");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Material name is NULL - using default name");
         _populate_string_field(material.name, "Default Material");
+        material.name_atom = intern_string(material.name->str);
         material.properties = create_default_material_properties();
-        d_LogInfo("Default material created due to NULL name");
+        ITEMS_LOG(D_LOG_LEVEL_INFO, "Default material created due to NULL name");
         return material;
     }
 
     // Copy name safely
     if (!_populate_string_field(material.name, name)) {
-        d_LogErrorF("Failed to populate material name: %s", name);
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate material name: %s", name);
         _populate_string_field(material.name, "Failed Material");
+        material.name_atom = intern_string(material.name->str);
         material.properties = create_default_material_properties();
         return material;
     }
 
     // Set the properties
+    material.name_atom = intern_string(material.name->str);
     material.properties = properties;
     
-    d_LogInfoF("Material '%s' created successfully [weight:%.2f, value:%.2f, durability:%.2f]", 
-               name, properties.weight_fact, properties.value_coins_fact, properties.durability_fact);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Material '%s' created successfully [weight:%.2f, value:%.2f, durability:%.2f]", 
+              name, properties.weight_fact, properties.value_coins_fact, properties.durability_fact);
 
     return material;
 }
@@ -1179,7 +1175,7 @@ Material_t create_material(const char* name, MaterialProperties_t properties)
  */
 MaterialProperties_t create_default_material_properties(void)
 {
-    d_LogDebug("Creating default material properties with neutral factors");
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Creating default material properties with neutral factors");
     
     MaterialProperties_t props = {
         .weight_fact = 1.0f,
@@ -1193,7 +1189,7 @@ MaterialProperties_t create_default_material_properties(void)
         .enchant_value_fact = 1.0f
     };
     
-    d_LogDebug("Default material properties initialized");
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Default material properties initialized");
     return props;
 }
 
@@ -1202,9 +1198,9 @@ MaterialProperties_t create_default_material_properties(void)
  */
 void apply_material_to_weapon(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL weapon");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_WEAPON, D_LOG_LEVEL_ERROR, 
-            "Cannot apply weapon material to non-weapon item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL weapon");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_WEAPON, D_LOG_LEVEL_ERROR, 
+                 "Cannot apply weapon material to non-weapon item");
     
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
         return;
@@ -1219,22 +1215,12 @@ void apply_material_to_weapon(Item_t* item)
     float orig_weight = item->weight_kg;
     uint8_t orig_value = item->value_coins;
 
-    // Apply material factors to weapon stats
-    weapon->min_damage = (uint8_t)(weapon->min_damage * material->properties.min_damage_fact);
-    weapon->max_damage = (uint8_t)(weapon->max_damage * material->properties.max_damage_fact);
-    weapon->stealth_value = (uint8_t)(weapon->stealth_value * material->properties.stealth_value_fact);
-    weapon->enchant_value = (uint8_t)(weapon->enchant_value * material->properties.enchant_value_fact);
-
-    // Apply to base item properties with bounds checking
-    float new_weight = item->weight_kg * material->properties.weight_fact;
-    item->weight_kg = (new_weight < 0.0f) ? 0.0f : new_weight;
-
-    float new_value = item->value_coins * material->properties.value_coins_fact;
-    item->value_coins = (new_value < 0.0f) ? 0 : (uint8_t)new_value;
+    // Apply material factors to weapon stats and base item properties
+    _apply_material_factors(item, &material->properties);
     
-    d_LogInfoF("Material applied to weapon '%s': dmg[%d-%d→%d-%d], weight[%.2f→%.2f], value[%d→%d]", 
-               item->name->str, orig_min, orig_max, weapon->min_damage, weapon->max_damage,
-               orig_weight, item->weight_kg, orig_value, item->value_coins);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Material applied to weapon '%s': dmg[%d-%d→%d-%d], weight[%.2f→%.2f], value[%d→%d]", 
+              item->name->str, orig_min, orig_max, weapon->min_damage, weapon->max_damage,
+              orig_weight, item->weight_kg, orig_value, item->value_coins);
 }
 
 /*
@@ -1242,9 +1228,9 @@ void apply_material_to_weapon(Item_t* item)
  */
 void apply_material_to_armor(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL armor");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_ARMOR, D_LOG_LEVEL_ERROR, 
-            "Cannot apply armor material to non-armor item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL armor");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_ARMOR, D_LOG_LEVEL_ERROR, 
+                 "Cannot apply armor material to non-armor item");
     
     if (item == NULL || item->type != ITEM_TYPE_ARMOR) {
         return;
@@ -1260,23 +1246,12 @@ void apply_material_to_armor(Item_t* item)
     float orig_weight = item->weight_kg;
     uint8_t orig_value = item->value_coins;
 
-    // Apply material factors to armor stats
-    armor->armor_value = (uint8_t)(armor->armor_value * material->properties.armor_value_fact);
-    armor->evasion_value = (uint8_t)(armor->evasion_value * material->properties.evasion_value_fact);
-    armor->durability = (uint8_t)(armor->durability * material->properties.durability_fact);
-    armor->stealth_value = (uint8_t)(armor->stealth_value * material->properties.stealth_value_fact);
-    armor->enchant_value = (uint8_t)(armor->enchant_value * material->properties.enchant_value_fact);
-
-    // Apply to base item properties with bounds checking
-    float new_weight = item->weight_kg * material->properties.weight_fact;
-    item->weight_kg = (new_weight < 0.0f) ? 0.0f : new_weight;
-
-    float new_value = item->value_coins * material->properties.value_coins_fact;
-    item->value_coins = (new_value < 0.0f) ? 0 : (uint8_t)new_value;
+    // Apply material factors to armor stats and base item properties
+    _apply_material_factors(item, &material->properties);
     
-    d_LogInfoF("Material applied to armor '%s': armor[%d→%d], evasion[%d→%d], durability[%d→%d], weight[%.2f→%.2f]", 
-               item->name->str, orig_armor, armor->armor_value, orig_evasion, armor->evasion_value,
-               orig_durability, armor->durability, orig_weight, item->weight_kg);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Material applied to armor '%s': armor[%d→%d], evasion[%d→%d], durability[%d→%d], weight[%.2f→%.2f]", 
+              item->name->str, orig_armor, armor->armor_value, orig_evasion, armor->evasion_value,
+              orig_durability, armor->durability, orig_weight, item->weight_kg);
 }
 
 /*
@@ -1284,9 +1259,9 @@ void apply_material_to_armor(Item_t* item)
  */
 void apply_material_to_ammunition(Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL ammunition");
-    d_LogIf(item != NULL && item->type != ITEM_TYPE_AMMUNITION, D_LOG_LEVEL_ERROR, 
-            "Cannot apply ammunition material to non-ammunition item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_ERROR, "Cannot apply material to NULL ammunition");
+    ITEMS_LOG_IF(item != NULL && item->type != ITEM_TYPE_AMMUNITION, D_LOG_LEVEL_ERROR, 
+                 "Cannot apply ammunition material to non-ammunition item");
     
     if (item == NULL || item->type != ITEM_TYPE_AMMUNITION) {
         return;
@@ -1301,20 +1276,12 @@ void apply_material_to_ammunition(Item_t* item)
     float orig_weight = item->weight_kg;
     uint8_t orig_value = item->value_coins;
 
-    // Apply material factors to ammunition stats
-    ammo->min_damage = (uint8_t)(ammo->min_damage * material->properties.min_damage_fact);
-    ammo->max_damage = (uint8_t)(ammo->max_damage * material->properties.max_damage_fact);
-
-    // Apply to base item properties with bounds checking
-    float new_weight = item->weight_kg * material->properties.weight_fact;
-    item->weight_kg = (new_weight < 0.0f) ? 0.0f : new_weight;
-
-    float new_value = item->value_coins * material->properties.value_coins_fact;
-    item->value_coins = (new_value < 0.0f) ? 0 : (uint8_t)new_value;
+    // Apply material factors to ammunition stats and base item properties
+    _apply_material_factors(item, &material->properties);
     
-    d_LogInfoF("Material applied to ammunition '%s': dmg[%d-%d→%d-%d], weight[%.2f→%.2f], value[%d→%d]", 
-               item->name->str, orig_min, orig_max, ammo->min_damage, ammo->max_damage,
-               orig_weight, item->weight_kg, orig_value, item->value_coins);
+    ITEMS_LOG(D_LOG_LEVEL_INFO, "Material applied to ammunition '%s': dmg[%d-%d→%d-%d], weight[%.2f→%.2f], value[%d→%d]", 
+              item->name->str, orig_min, orig_max, ammo->min_damage, ammo->max_damage,
+              orig_weight, item->weight_kg, orig_value, item->value_coins);
 }
 
 /*
@@ -1322,16 +1289,16 @@ void apply_material_to_ammunition(Item_t* item)
  */
 float calculate_final_weight(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot calculate weight for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot calculate weight for NULL item");
     
     if (item == NULL) {
         return 0.0f;
     }
 
     // Weight is already calculated with material factors applied
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Final weight for '%s': %.2f kg", 
-                      item->name->str, item->weight_kg);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Final weight for '%s': %.2f kg", 
+                           item->name->str, item->weight_kg);
     
     return item->weight_kg;
 }
@@ -1341,16 +1308,16 @@ float calculate_final_weight(const Item_t* item)
  */
 uint8_t calculate_final_value(const Item_t* item)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot calculate value for NULL item");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot calculate value for NULL item");
     
     if (item == NULL) {
         return 0;
     }
 
     // Value is already calculated with material factors applied
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Final value for '%s': %d coins", 
-                      item->name->str, item->value_coins);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Final value for '%s': %d coins", 
+                           item->name->str, item->value_coins);
     
     return item->value_coins;
 }
@@ -1363,7 +1330,7 @@ uint8_t calculate_final_value(const Item_t* item)
 uint8_t get_weapon_min_damage(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
-        LOG("get_weapon_min_damage: Item is NULL or not a weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_weapon_min_damage: Item is NULL or not a weapon");
         return 0;
     }
     return item->data.weapon.min_damage;
@@ -1372,7 +1339,7 @@ uint8_t get_weapon_min_damage(const Item_t* item)
 uint8_t get_weapon_max_damage(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
-        LOG("get_weapon_max_damage: Item is NULL or not a weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_weapon_max_damage: Item is NULL or not a weapon");
         return 0;
     }
     return item->data.weapon.max_damage;
@@ -1380,7 +1347,7 @@ uint8_t get_weapon_max_damage(const Item_t* item)
 uint8_t get_ammunition_min_damage(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_AMMUNITION) {
-        LOG("get_ammunition_min_damage: Item is NULL or not ammunition");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_ammunition_min_damage: Item is NULL or not ammunition");
         return 0;
     }
     return item->data.ammo.min_damage;
@@ -1389,7 +1356,7 @@ uint8_t get_ammunition_min_damage(const Item_t* item)
 uint8_t get_ammunition_max_damage(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_AMMUNITION) {
-        LOG("get_ammunition_max_damage: Item is NULL or not ammunition");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_ammunition_max_damage: Item is NULL or not ammunition");
         return 0;
     }
     return item->data.ammo.max_damage;
@@ -1398,7 +1365,7 @@ uint8_t get_ammunition_max_damage(const Item_t* item)
 uint8_t get_weapon_range(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
-        LOG("get_weapon_range: Item is NULL or not a weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_weapon_range: Item is NULL or not a weapon");
         return 0;
     }
     return item->data.weapon.range_tiles;
@@ -1407,7 +1374,7 @@ uint8_t get_weapon_range(const Item_t* item)
 bool weapon_needs_ammo(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_WEAPON) {
-        LOG("weapon_needs_ammo: Item is NULL or not a weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "weapon_needs_ammo: Item is NULL or not a weapon");
         return false;
     }
 
@@ -1418,12 +1385,12 @@ bool weapon_needs_ammo(const Item_t* item)
 bool weapon_can_use_ammo(const Item_t* weapon, const Item_t* ammo)
 {
     if (weapon == NULL || ammo == NULL) {
-        LOG("weapon_can_use_ammo: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "weapon_can_use_ammo: Item is NULL");
         return false;
     }
 
     if (weapon->type != ITEM_TYPE_WEAPON || ammo->type != ITEM_TYPE_AMMUNITION) {
-        LOG("weapon_can_use_ammo: Type mismatch");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "weapon_can_use_ammo: Type mismatch");
         return false;
     }
 
@@ -1436,7 +1403,7 @@ bool weapon_can_use_ammo(const Item_t* weapon, const Item_t* ammo)
 uint8_t get_armor_value(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_ARMOR) {
-        LOG("get_armor_value: Item is NULL or not armor");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_armor_value: Item is NULL or not armor");
         return 0;
     }
     return item->data.armor.armor_value;
@@ -1445,7 +1412,7 @@ uint8_t get_armor_value(const Item_t* item)
 uint8_t get_evasion_value(const Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_ARMOR) {
-        LOG("get_evasion_value: Item is NULL or not armor");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_evasion_value: Item is NULL or not armor");
         return 0;
     }
     return item->data.armor.evasion_value;
@@ -1455,7 +1422,7 @@ uint8_t get_evasion_value(const Item_t* item)
 float get_item_weight(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_item_weight: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_item_weight: Item is NULL");
         return 0.0f;
     }
     return item->weight_kg;
@@ -1464,7 +1431,7 @@ float get_item_weight(const Item_t* item)
 uint8_t get_item_value_coins(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_item_value_coins: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_item_value_coins: Item is NULL");
         return 0;
     }
     return item->value_coins;
@@ -1473,7 +1440,7 @@ uint8_t get_item_value_coins(const Item_t* item)
 uint8_t get_stealth_value(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_stealth_value: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_stealth_value: Item is NULL");
         return 0;
     }
 
@@ -1494,7 +1461,7 @@ uint8_t get_stealth_value(const Item_t* item)
 uint8_t get_durability(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_durability: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_durability: Item is NULL");
         return 0;
     }
 
@@ -1515,7 +1482,7 @@ uint8_t get_durability(const Item_t* item)
 bool is_item_stackable(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("is_item_stackable: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "is_item_stackable: Item is NULL");
         return false;
     }
 
@@ -1526,7 +1493,7 @@ bool is_item_stackable(const Item_t* item)
 uint8_t get_max_stack_size(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_max_stack_size: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_max_stack_size: Item is NULL");
         return 0;
     }
 
@@ -1540,13 +1507,13 @@ uint8_t get_max_stack_size(const Item_t* item)
 void damage_item_durability(Item_t* item, uint16_t damage)
 {
     if (item == NULL) {
-        LOG("damage_item_durability: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "damage_item_durability: Item is NULL");
         return;
     }
 
     // Check if item resists durability loss due to material properties
     if (item_resists_durability_loss(item)) {
-        LOG("Item resisted durability loss due to material properties");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item resisted durability loss due to material properties");
         return;
     }
 
@@ -1580,7 +1547,7 @@ void damage_item_durability(Item_t* item, uint16_t damage)
 void repair_item(Item_t* item, uint16_t repair_amount)
 {
     if (item == NULL) {
-        LOG("repair_item: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "repair_item: Item is NULL");
         return;
     }
 
@@ -1614,7 +1581,7 @@ void repair_item(Item_t* item, uint16_t repair_amount)
 bool is_item_broken(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("is_item_broken: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "is_item_broken: Item is NULL");
         return true; // NULL items are considered "broken"
     }
 
@@ -1638,7 +1605,7 @@ bool is_item_broken(const Item_t* item)
 float get_durability_percentage(const Item_t* item)
 {
     if (item == NULL) {
-        LOG("get_durability_percentage: Item is NULL");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "get_durability_percentage: Item is NULL");
         return 0.0f;
     }
 
@@ -1666,20 +1633,20 @@ float get_durability_percentage(const Item_t* item)
 Inventory_t* create_inventory(uint8_t size)
 {
     if (size == 0) {
-        LOG("create_inventory: Invalid inventory size");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "create_inventory: Invalid inventory size");
         return NULL; // Invalid inventory size
     }
 
     Inventory_t* inventory = (Inventory_t*)malloc(sizeof(Inventory_t));
     if (inventory == NULL) {
-        LOG("create_inventory: Memory allocation failed");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "create_inventory: Memory allocation failed");
         return NULL; // Memory allocation failed
     }
 
     inventory->slots = (Inventory_slot_t*)calloc(size, sizeof(Inventory_slot_t));
     if (inventory->slots == NULL) {
         free(inventory);
-        LOG("create_inventory: Memory allocation failed");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "create_inventory: Memory allocation failed");
         return NULL; // Memory allocation failed
     }
 
@@ -1698,7 +1665,7 @@ Inventory_t* create_inventory(uint8_t size)
 void destroy_inventory(Inventory_t* inventory)
 {
     if (inventory == NULL) {
-        LOG("destroy_inventory: Invalid inventory");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "destroy_inventory: Invalid inventory");
         return;
     }
 
@@ -1714,7 +1681,7 @@ void destroy_inventory(Inventory_t* inventory)
 bool add_item_to_inventory(Inventory_t* inventory, Item_t* item, uint8_t quantity)
 {
     if (inventory == NULL || item == NULL || quantity == 0) {
-        LOG("add_item_to_inventory: Invalid input");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "add_item_to_inventory: Invalid input");
         return false;
     }
 
@@ -1752,7 +1719,7 @@ bool add_item_to_inventory(Inventory_t* inventory, Item_t* item, uint8_t quantit
         }
 
         if (empty_slot >= inventory->size) {
-            LOG("Adding items to inventory failed: No empty slots");
+            ITEMS_LOG(D_LOG_LEVEL_WARNING, "Adding items to inventory failed: No empty slots");
             return false; // No empty slots, couldn't add all items
         }
 
@@ -1777,7 +1744,13 @@ bool add_item_to_inventory(Inventory_t* inventory, Item_t* item, uint8_t quantit
 bool remove_item_from_inventory(Inventory_t* inventory, const char* item_id, uint8_t quantity)
 {
     if (inventory == NULL || item_id == NULL || quantity == 0) {
-        LOG("Invalid input for remove_item_from_inventory");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for remove_item_from_inventory");
+        return false;
+    }
+
+    // An id that was never interned can't be on any item
+    uint32_t id_atom = find_interned_string(item_id);
+    if (id_atom == ATOM_NONE) {
         return false;
     }
 
@@ -1786,7 +1759,7 @@ bool remove_item_from_inventory(Inventory_t* inventory, const char* item_id, uin
     // Find and remove items with matching ID
     for (uint8_t i = 0; i < inventory->size && remaining_to_remove > 0; i++) {
         if (inventory->slots[i].quantity > 0 &&
-            strcmp(inventory->slots[i].item.id->str, item_id) == 0) {
+            inventory->slots[i].item.id_atom == id_atom) {
 
             if (inventory->slots[i].quantity <= remaining_to_remove) {
                 // Remove entire stack
@@ -1807,53 +1780,55 @@ bool remove_item_from_inventory(Inventory_t* inventory, const char* item_id, uin
 Inventory_slot_t* find_item_in_inventory(Inventory_t* inventory, const char* item_id)
 {
     if (inventory == NULL || item_id == NULL) {
-        LOG("Invalid input for find_item_in_inventory");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for find_item_in_inventory");
         return NULL;
     }
 
-    for (uint8_t i = 0; i < inventory->size; i++) {
+    uint32_t id_atom = find_interned_string(item_id);
+
+    for (uint8_t i = 0; id_atom != ATOM_NONE && i < inventory->size; i++) {
         if (inventory->slots[i].quantity > 0 &&
-            strcmp(inventory->slots[i].item.id->str, item_id) == 0) {
+            inventory->slots[i].item.id_atom == id_atom) {
             return &inventory->slots[i];
         }
     }
-    LOG("Item not found in inventory");
+    ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item not found in inventory");
     return NULL; // Item not found
 }
 
 bool can_stack_items(const Item_t* item1, const Item_t* item2)
 {
     if (item1 == NULL || item2 == NULL) {
-        LOG("Invalid input for can_stack_items");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for can_stack_items");
         return false;
     }
 
     // Items can stack if they have the same ID and are stackable
-    return (strcmp(item1->id->str, item2->id->str) == 0) && is_item_stackable(item1);
+    return (item1->id_atom == item2->id_atom) && is_item_stackable(item1);
 }
 
 bool equip_item(Inventory_t* inventory, const char* item_id)
 {
     if (inventory == NULL || item_id == NULL) {
-        LOG("Invalid input for equip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for equip_item");
         return false;
     }
 
     Inventory_slot_t* slot = find_item_in_inventory(inventory, item_id);
     if (slot == NULL) {
-        LOG("Item not found in inventory for equip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item not found in inventory for equip_item");
         return false;
     }
 
     // Only weapons and armor can be equipped
     if (slot->item.type != ITEM_TYPE_WEAPON && slot->item.type != ITEM_TYPE_ARMOR) {
-        LOG("Invalid item type for equip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid item type for equip_item");
         return false;
     }
 
     // Check if item is broken
     if (is_item_broken(&slot->item)) {
-        LOG("Item is broken for equip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item is broken for equip_item");
         return false;
     }
 
@@ -1874,13 +1849,13 @@ bool equip_item(Inventory_t* inventory, const char* item_id)
 bool unequip_item(Inventory_t* inventory, const char* item_id)
 {
     if (inventory == NULL || item_id == NULL) {
-        LOG("Invalid input for unequip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for unequip_item");
         return false;
     }
 
     Inventory_slot_t* slot = find_item_in_inventory(inventory, item_id);
     if (slot == NULL || !slot->is_equipped) {
-        LOG("Item not found or not equipped for unequip_item");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item not found or not equipped for unequip_item");
         return false;
     }
 
@@ -1890,7 +1865,7 @@ bool unequip_item(Inventory_t* inventory, const char* item_id)
 Inventory_slot_t* get_equipped_weapon(Inventory_t* inventory)
 {
     if (inventory == NULL) {
-        LOG("Invalid input for get_equipped_weapon");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for get_equipped_weapon");
         return NULL;
     }
 
@@ -1901,7 +1876,7 @@ Inventory_slot_t* get_equipped_weapon(Inventory_t* inventory)
 
             // Check if the equipped weapon is broken
             if (is_item_broken(&inventory->slots[i].item)) {
-                LOG("Auto-unequipping broken weapon");
+                ITEMS_LOG(D_LOG_LEVEL_WARNING, "Auto-unequipping broken weapon");
                 inventory->slots[i].is_equipped = false;
                 return NULL;
             }
@@ -1927,7 +1902,7 @@ Inventory_slot_t* get_equipped_armor(Inventory_t* inventory)
 
             // Check if the equipped armor is broken
             if (is_item_broken(&inventory->slots[i].item)) {
-                LOG("Auto-unequipping broken armor");
+                ITEMS_LOG(D_LOG_LEVEL_WARNING, "Auto-unequipping broken armor");
                 inventory->slots[i].is_equipped = false;
                 return NULL;
             }
@@ -1942,7 +1917,7 @@ Inventory_slot_t* get_equipped_armor(Inventory_t* inventory)
 uint8_t get_inventory_free_slots(const Inventory_t* inventory)
 {
     if (inventory == NULL) {
-        LOG("Invalid input for get_inventory_free_slots");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for get_inventory_free_slots");
         return 0;
     }
 
@@ -1959,7 +1934,7 @@ uint8_t get_inventory_free_slots(const Inventory_t* inventory)
 uint8_t get_total_inventory_weight(const Inventory_t* inventory)
 {
     if (inventory == NULL) {
-        LOG("Invalid input for get_total_inventory_weight");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for get_total_inventory_weight");
         return 0;
     }
 
@@ -1978,7 +1953,7 @@ uint8_t get_total_inventory_weight(const Inventory_t* inventory)
 bool is_inventory_full(const Inventory_t* inventory)
 {
     if (inventory == NULL) {
-        LOG("Invalid input for is_inventory_full");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Invalid input for is_inventory_full");
         return true; // NULL inventory is considered "full"
     }
 
@@ -1992,7 +1967,7 @@ bool is_inventory_full(const Inventory_t* inventory)
 bool use_consumable(Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_CONSUMABLE) {
-        d_LogError("Invalid input for use_consumable - item is NULL or not consumable");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Invalid input for use_consumable - item is NULL or not consumable");
         return false;
     }
 
@@ -2000,15 +1975,15 @@ bool use_consumable(Item_t* item)
 
     // Check if the consumable has a valid on_consume callback
     if (consumable->on_consume == NULL) {
-        d_LogWarningF("Consumable '%s' has no effect callback - cannot be used", 
-                      item->name ? item->name->str : "Unknown");
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Consumable '%s' has no effect callback - cannot be used", 
+                  item->name ? item->name->str : "Unknown");
         return false;
     }
 
     // Log successful usage with rate limiting to prevent spam during testing
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_INFO,
-                      3, 2.0, "Using consumable '%s' with value %d", 
-                      item->name->str, consumable->value);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_INFO, 3, 2.0,
+                           "Using consumable '%s' with value %d", 
+                           item->name->str, consumable->value);
 
     // Execute the consumable effect
     consumable->on_consume(consumable->value);
@@ -2019,7 +1994,7 @@ bool use_consumable(Item_t* item)
 void trigger_consumable_duration_tick(Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_CONSUMABLE) {
-        d_LogError("Invalid input for trigger_consumable_duration_tick");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Invalid input for trigger_consumable_duration_tick");
         return;
     }
 
@@ -2029,9 +2004,9 @@ void trigger_consumable_duration_tick(Item_t* item)
     if (consumable->duration_seconds > 0) {
         // Execute tick callback if it exists
         if (consumable->on_duration_tick != NULL) {
-            d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                              1, 5.0, "Duration tick for '%s': %d seconds remaining", 
-                              item->name->str, consumable->duration_seconds);
+            ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 1, 5.0,
+                                   "Duration tick for '%s': %d seconds remaining", 
+                                   item->name->str, consumable->duration_seconds);
             consumable->on_duration_tick(consumable->value);
         }
 
@@ -2040,7 +2015,7 @@ void trigger_consumable_duration_tick(Item_t* item)
 
         // Trigger end effect when duration reaches 0
         if (consumable->duration_seconds == 0) {
-            d_LogInfoF("Duration effect ended for consumable '%s'", item->name->str);
+            ITEMS_LOG(D_LOG_LEVEL_INFO, "Duration effect ended for consumable '%s'", item->name->str);
             trigger_consumable_duration_end(item);
         }
     }
@@ -2049,7 +2024,7 @@ void trigger_consumable_duration_tick(Item_t* item)
 void trigger_consumable_duration_end(Item_t* item)
 {
     if (item == NULL || item->type != ITEM_TYPE_CONSUMABLE) {
-        d_LogError("Invalid input for trigger_consumable_duration_end");
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Invalid input for trigger_consumable_duration_end");
         return;
     }
 
@@ -2057,7 +2032,7 @@ void trigger_consumable_duration_end(Item_t* item)
 
     // Trigger the end effect if it exists
     if (consumable->on_duration_end != NULL) {
-        d_LogDebugF("Triggering end effect for consumable '%s'", item->name->str);
+        ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Triggering end effect for consumable '%s'", item->name->str);
         consumable->on_duration_end(consumable->value);
     }
 
@@ -2068,8 +2043,8 @@ void trigger_consumable_duration_end(Item_t* item)
 bool can_key_open_lock(const Item_t* key, const Lock_t* lock)
 {
     // Use LogIf for efficient conditional logging
-    d_LogIf(key == NULL, D_LOG_LEVEL_WARNING, "Key/Lock check failed: key is NULL");
-    d_LogIf(lock == NULL, D_LOG_LEVEL_WARNING, "Key/Lock check failed: lock is NULL");
+    ITEMS_LOG_IF(key == NULL, D_LOG_LEVEL_WARNING, "Key/Lock check failed: key is NULL");
+    ITEMS_LOG_IF(lock == NULL, D_LOG_LEVEL_WARNING, "Key/Lock check failed: lock is NULL");
     
     if (key == NULL || lock == NULL) {
         return false;
@@ -2077,237 +2052,498 @@ bool can_key_open_lock(const Item_t* key, const Lock_t* lock)
 
     // Only keys can open locks
     if (key->type != ITEM_TYPE_KEY) {
-        d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                          2, 3.0, "Item '%s' is not a key (type: %d)", 
-                          key->name->str, key->type);
+        ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 2, 3.0,
+                               "Item '%s' is not a key (type: %d)", 
+                               key->name->str, key->type);
         return false;
     }
 
     // Check if the lock is jammed - THIS WAS THE SPAM SOURCE!
     if (lock->jammed_seconds > 0) {
         // Aggressive rate limiting for jammed lock messages - only 1 per 10 seconds
-        d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_WARNING,
-                          1, 10.0, "Lock '%s' is jammed (%d seconds remaining)", 
-                          lock->name->str, lock->jammed_seconds);
+        ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_WARNING, 1, 10.0,
+                               "Lock '%s' is jammed (%d seconds remaining)", 
+                               lock->name->str, lock->jammed_seconds);
         return false;
     }
 
+    // Locks built without create_lock() have no atom yet, look theirs up
     const Lock_t* key_lock = &key->data.key.lock;
-    bool can_open = strcmp(key_lock->name->str, lock->name->str) == 0;
+    uint32_t lock_atom = lock->name_atom;
+    if (lock_atom == ATOM_NONE && lock->name != NULL) {
+        lock_atom = find_interned_string(lock->name->str);
+    }
+    bool can_open = key_lock->name_atom != ATOM_NONE && key_lock->name_atom == lock_atom;
 
     // Log successful/failed key attempts with moderate rate limiting
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      2, 5.0, "Key '%s' %s open lock '%s'", 
-                      key->name->str, can_open ? "CAN" : "CANNOT", lock->name->str);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 2, 5.0,
+                           "Key '%s' %s open lock '%s'", 
+                           key->name->str, can_open ? "CAN" : "CANNOT", lock->name->str);
 
     return can_open;
 }
 // =============================================================================
-// HELPER FUNCTIONS
+// ITEM PROTOTYPES & INSTANCES
 // =============================================================================
 
+// Every definition is stored once here, instances only carry a handle into it
+static Item_t** item_prototypes = NULL;
+static uint16_t item_prototype_count = 0;
+static uint16_t item_prototype_capacity = 0;
+
 /*
- * Safely copies string data into dString_t structure
+ * Takes ownership of a created item as the definition for its id
  */
-static bool _populate_string_field(dString_t* dest, const char* src) 
+uint16_t register_item_prototype(Item_t* item)
 {
-    d_LogIf(src == NULL || dest == NULL, D_LOG_LEVEL_ERROR,
-            "Cannot populate string field with NULL parameters");
-    
-    if (src == NULL || dest == NULL) {
-        return false;
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_ERROR, "Cannot register NULL item as prototype");
+
+    if (item == NULL || item->id == NULL) {
+        return ITEM_PROTOTYPE_NONE;
     }
 
-    dString_t* temp = d_InitString();
-    if (temp == NULL) {
-        d_LogError("Failed to initialize temporary string for field population");
-        return false;
+    if (find_item_prototype(item->id->str) != ITEM_PROTOTYPE_NONE) {
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "Item prototype '%s' is already registered", item->id->str);
+        return ITEM_PROTOTYPE_NONE;
     }
 
-    d_AppendString(temp, src, 0);
-    *dest = *temp;  // Copy struct content
-    free(temp);     // Free wrapper, keep string data
-    
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "String field populated: %s", src);
-    
-    return true;
+    if (item_prototype_count >= MAX_ITEM_PROTOTYPES) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Item prototype registry is full, cannot register '%s'", item->id->str);
+        return ITEM_PROTOTYPE_NONE;
+    }
+
+    if (item_prototype_count == item_prototype_capacity) {
+        uint32_t new_capacity = (item_prototype_capacity == 0) ? 16 : item_prototype_capacity * 2;
+        if (new_capacity > MAX_ITEM_PROTOTYPES) {
+            new_capacity = MAX_ITEM_PROTOTYPES;
+        }
+
+        Item_t** temp = (Item_t**)realloc(item_prototypes, sizeof(Item_t*) * new_capacity);
+        if (temp == NULL) {
+            ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for item prototype '%s'", item->id->str);
+            return ITEM_PROTOTYPE_NONE;
+        }
+
+        item_prototypes = temp;
+        item_prototype_capacity = (uint16_t)new_capacity;
+    }
+
+    uint16_t handle = item_prototype_count++;
+    item_prototypes[handle] = item;
+
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Item prototype '%s' registered [handle:%d]",
+                           item->id->str, handle);
+
+    return handle;
 }
 
 /*
- * Generates descriptive text for weapon items based on material
+ * Looks up a prototype handle by item id
  */
-static bool _populate_weapon_desc(dString_t* dest, const Material_t* material) 
+uint16_t find_item_prototype(const char* id)
 {
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate weapon description - destination NULL");
-    d_LogIf(material == NULL, D_LOG_LEVEL_ERROR, "Cannot populate weapon description - material NULL");
-    
-    if (dest == NULL || material == NULL) {
-        return false;
+    uint32_t id_atom = find_interned_string(id);
+    if (id_atom == ATOM_NONE) {
+        return ITEM_PROTOTYPE_NONE;
     }
 
-    // Check if material->name is valid
-    if (material->name == NULL || material->name->str == NULL) {
-        d_LogError("Material name is NULL - cannot generate weapon description");
-        return false;
+    for (uint16_t i = 0; i < item_prototype_count; i++) {
+        if (item_prototypes[i]->id_atom == id_atom) {
+            return i;
+        }
     }
 
-    dString_t* temp = d_InitString();
-    if (temp == NULL) {
-        d_LogError("Failed to allocate temporary string for weapon description");
-        return false;
+    return ITEM_PROTOTYPE_NONE;
+}
+
+const Item_t* get_item_prototype(uint16_t handle)
+{
+    if (handle >= item_prototype_count) {
+        return NULL;
     }
 
-    d_AppendString(temp, "A weapon made of ", 0);
-    d_AppendString(temp, material->name->str, 0);
-    *dest = *temp;
-    free(temp);
-    
-    // RATE LIMIT THIS - Called during every weapon creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Weapon description generated for material: %s", 
-                      material->name->str);
-    return true;
+    return item_prototypes[handle];
+}
+
+uint16_t get_item_prototype_count(void)
+{
+    return item_prototype_count;
 }
 
 /*
- * Calculates durability resistance based on material properties
+ * Destroys every prototype and releases the registry
  */
-static bool item_resists_durability_loss(const Item_t* item)
+void destroy_item_prototypes(void)
 {
-    d_LogIf(item == NULL, D_LOG_LEVEL_WARNING, "Cannot check durability resistance for NULL item");
-    
-    if (item == NULL) {
-        return false;
+    for (uint16_t i = 0; i < item_prototype_count; i++) {
+        destroy_item(item_prototypes[i]);
     }
 
-    // Base chance is 5% to avoid durability loss
-    float base_chance = 0.05f;
-    float resistance_chance = base_chance * item->material_data.properties.durability_fact;
+    free(item_prototypes);
+    item_prototypes = NULL;
+    item_prototype_count = 0;
+    item_prototype_capacity = 0;
+}
 
-    // Cap at 95% maximum resistance (always have some chance of wear)
-    if (resistance_chance > 0.95f) {
-        resistance_chance = 0.95f;
+/*
+ * Creates the per item state of a prototype, nothing is allocated
+ */
+ItemInstance_t create_item_instance(uint16_t handle, uint8_t quantity)
+{
+    ItemInstance_t instance = { .prototype = ITEM_PROTOTYPE_NONE };
+    const Item_t* prototype = get_item_prototype(handle);
+
+    ITEMS_LOG_IF(prototype == NULL, D_LOG_LEVEL_WARNING, "Cannot create instance of unregistered item prototype");
+
+    if (prototype == NULL || quantity == 0) {
+        return instance;
     }
 
-    // Generate random number between 0.0 and 1.0
-    float random_roll = (float)rand() / (float)RAND_MAX;
-    bool resists = random_roll < resistance_chance;
+    uint8_t max_stack = (prototype->stackable > 0) ? prototype->stackable : 1;
 
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 10.0, "Durability check for '%s': %.1f%% resistance, %s", 
-                      item->name->str, resistance_chance * 100.0f, 
-                      resists ? "RESISTED" : "damaged");
+    instance.prototype = handle;
+    instance.durability = get_durability(prototype);
+    instance.quantity = (quantity <= max_stack) ? quantity : max_stack;
 
-    return resists;
+    switch (prototype->type) {
+        case ITEM_TYPE_WEAPON:
+            instance.enchant_value = prototype->data.weapon.enchant_value;
+            break;
+
+        case ITEM_TYPE_ARMOR:
+            instance.enchant_value = prototype->data.armor.enchant_value;
+            break;
+
+        default:
+            instance.enchant_value = 0;
+            break;
+    }
+
+    return instance;
+}
+
+const Item_t* get_instance_prototype(const ItemInstance_t* instance)
+{
+    if (instance == NULL) {
+        return NULL;
+    }
+
+    return get_item_prototype(instance->prototype);
+}
+
+void damage_item_instance(ItemInstance_t* instance, uint16_t damage)
+{
+    const Item_t* prototype = get_instance_prototype(instance);
+    if (prototype == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "damage_item_instance: Instance is NULL or empty");
+        return;
+    }
+
+    // Only weapons and armor have durability that can be damaged
+    if (prototype->type != ITEM_TYPE_WEAPON && prototype->type != ITEM_TYPE_ARMOR) {
+        return;
+    }
+
+    if (item_resists_durability_loss(prototype)) {
+        return;
+    }
+
+    instance->durability = (instance->durability > damage) ? instance->durability - damage : 0;
+}
+
+void repair_item_instance(ItemInstance_t* instance, uint16_t repair_amount)
+{
+    const Item_t* prototype = get_instance_prototype(instance);
+    if (prototype == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "repair_item_instance: Instance is NULL or empty");
+        return;
+    }
+
+    // Only weapons and armor can be repaired
+    if (prototype->type != ITEM_TYPE_WEAPON && prototype->type != ITEM_TYPE_ARMOR) {
+        return;
+    }
+
+    if (instance->durability + repair_amount > 255) {
+        instance->durability = 255; // Cap at max durability
+    } else {
+        instance->durability += repair_amount;
+    }
+}
+
+bool is_item_instance_broken(const ItemInstance_t* instance)
+{
+    if (get_instance_prototype(instance) == NULL) {
+        return true; // Empty instances are considered "broken"
+    }
+
+    return instance->durability == 0;
+}
+
+float get_item_instance_weight(const ItemInstance_t* instance)
+{
+    const Item_t* prototype = get_instance_prototype(instance);
+    if (prototype == NULL) {
+        return 0.0f;
+    }
+
+    return prototype->weight_kg * instance->quantity;
 }
 
 /*
- * Generates descriptive text for armor items based on material
+ * Adds an instance through the by value inventory path
  */
-static bool _populate_armor_desc(dString_t* dest, const Material_t* material) 
+bool add_item_instance_to_inventory(Inventory_t* inventory, const ItemInstance_t* instance)
 {
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate armor description - destination NULL");
-    d_LogIf(material == NULL, D_LOG_LEVEL_ERROR, "Cannot populate armor description - material NULL");
-    
-    if (dest == NULL || material == NULL) {
+    const Item_t* prototype = get_instance_prototype(instance);
+    if (inventory == NULL || prototype == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_WARNING, "add_item_instance_to_inventory: Invalid input");
         return false;
     }
 
-    // Validate material name
-    if (material->name == NULL || material->name->str == NULL) {
-        d_LogError("Material name is NULL - cannot generate armor description");
-        return false;
+    // The slot copies the item, so the prototype itself is never written
+    Item_t item = *prototype;
+
+    switch (item.type) {
+        case ITEM_TYPE_WEAPON:
+            item.data.weapon.durability = instance->durability;
+            item.data.weapon.enchant_value = instance->enchant_value;
+            break;
+
+        case ITEM_TYPE_ARMOR:
+            item.data.armor.durability = instance->durability;
+            item.data.armor.enchant_value = instance->enchant_value;
+            break;
+
+        default:
+            break;
     }
 
-    dString_t* temp = d_InitString();
-    if (temp == NULL) {
-        d_LogError("Failed to allocate temporary string for armor description");
-        return false;
+    return add_item_to_inventory(inventory, &item, instance->quantity);
+}
+
+// =============================================================================
+// MATERIAL REGISTRY
+// =============================================================================
+
+// Factors of every registered material in one table, a material id indexes
+// both arrays and MATERIAL_NONE is never handed out
+static MaterialProperties_t material_table[MAX_MATERIALS];
+static uint32_t material_atoms[MAX_MATERIALS];
+static uint32_t material_count = 1;
+
+/*
+ * Registers a material under its interned name, replacing the factors of an existing one
+ */
+uint8_t register_material(const char* name, MaterialProperties_t properties)
+{
+    ITEMS_LOG_IF(name == NULL, D_LOG_LEVEL_ERROR, "Cannot register material with NULL name");
+
+    if (name == NULL) {
+        return MATERIAL_NONE;
     }
 
-    d_AppendString(temp, "Armor made of ", 0);
-    d_AppendString(temp, material->name->str, 0);
-    *dest = *temp;
-    free(temp);
-    
-    // RATE LIMIT THIS - Called during every armor creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Armor description generated for material: %s", 
-                      material->name->str);
-    return true;
+    uint8_t id = find_material(name);
+    if (id != MATERIAL_NONE) {
+        material_table[id] = properties;
+        return id;
+    }
+
+    if (material_count >= MAX_MATERIALS) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Material registry is full, cannot register '%s'", name);
+        return MATERIAL_NONE;
+    }
+
+    uint32_t atom = intern_string(name);
+    if (atom == ATOM_NONE) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to intern material name '%s'", name);
+        return MATERIAL_NONE;
+    }
+
+    id = (uint8_t)material_count++;
+    material_atoms[id] = atom;
+    material_table[id] = properties;
+
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Material '%s' registered as id %d", name, id);
+    return id;
+}
+
+uint8_t find_material(const char* name)
+{
+    uint32_t atom = find_interned_string(name);
+    if (atom == ATOM_NONE) {
+        return MATERIAL_NONE;
+    }
+
+    for (uint32_t id = 1; id < material_count; id++) {
+        if (material_atoms[id] == atom) {
+            return (uint8_t)id;
+        }
+    }
+
+    return MATERIAL_NONE;
 }
 
 /*
- * Sets item rarity string using standard rarity levels
+ * Builds a material from the registry, the name is the interned copy so nothing is allocated
+ */
+Material_t get_material(uint8_t id)
+{
+    if (id == MATERIAL_NONE || id >= material_count) {
+        ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_WARNING, 5, 5.0,
+                               "Unknown material id %d - using default material", id);
+        return _create_default_material();
+    }
+
+    Material_t material;
+    material.name_atom = material_atoms[id];
+    material.name = intern_strings[material.name_atom];
+    material.id = id;
+    material.properties = material_table[id];
+    return material;
+}
+
+const MaterialProperties_t* get_material_properties(uint8_t id)
+{
+    if (id == MATERIAL_NONE || id >= material_count) {
+        return NULL;
+    }
+
+    return &material_table[id];
+}
+
+uint32_t get_material_count(void)
+{
+    return material_count - 1;
+}
+
+void clear_material_registry(void)
+{
+    material_count = 1;
+}
+
+/*
+ * Applies materials to a whole array of items in one pass, without per item logging
+ */
+uint32_t apply_materials_to_items(Item_t** items, const uint8_t* material_ids, uint32_t count)
+{
+    ITEMS_LOG_IF(items == NULL, D_LOG_LEVEL_ERROR, "Cannot apply materials to NULL item array");
+
+    if (items == NULL) {
+        return 0;
+    }
+
+    uint32_t applied = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        Item_t* item = items[i];
+        if (item == NULL) {
+            continue;
+        }
+
+        if (material_ids != NULL) {
+            uint8_t id = material_ids[i];
+            if (id == MATERIAL_NONE || id >= material_count) {
+                continue;
+            }
+
+            // The item takes over the registered material, its name is already interned
+            item->material_data.name_atom = material_atoms[id];
+            item->material_data.name = intern_strings[material_atoms[id]];
+            item->material_data.id = id;
+            item->material_data.properties = material_table[id];
+        }
+
+        if (item->type == ITEM_TYPE_WEAPON || item->type == ITEM_TYPE_ARMOR ||
+            item->type == ITEM_TYPE_AMMUNITION) {
+            _apply_material_factors(item, &item->material_data.properties);
+            applied++;
+        }
+    }
+
+    ITEMS_LOG(D_LOG_LEVEL_DEBUG, "Materials applied to %u of %u items", applied, count);
+    return applied;
+}
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+/*
+ * Safely copies string data into dString_t structure
  */
-static bool _populate_rarity(dString_t* dest, const char* rarity) 
+static bool _populate_string_field(dString_t* dest, const char* src) 
 {
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate rarity - destination NULL");
-    d_LogIf(rarity == NULL, D_LOG_LEVEL_ERROR, "Cannot populate rarity - rarity string NULL");
+    ITEMS_LOG_IF(src == NULL || dest == NULL, D_LOG_LEVEL_ERROR,
+                 "Cannot populate string field with NULL parameters");
     
-    if (dest == NULL || rarity == NULL) {
+    if (src == NULL || dest == NULL) {
+        return false;
+    }
+
+    dString_t* temp = d_InitString();
+    if (temp == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to initialize temporary string for field population");
         return false;
     }
 
-    bool success = _populate_string_field(dest, rarity);
+    d_AppendString(temp, src, 0);
+    *dest = *temp;  // Copy struct content
+    free(temp);     // Free wrapper, keep string data
     
-    d_LogIf(!success, D_LOG_LEVEL_ERROR, "Failed to populate rarity field");
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Item rarity set to: %s", rarity);
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "String field populated: %s", src);
     
-    return success;
+    return true;
 }
 
-static bool _populate_key_desc(dString_t* dest, const Lock_t* lock) 
+/*
+ * Calculates durability resistance based on material properties
+ */
+static bool item_resists_durability_loss(const Item_t* item)
 {
-    // RATE LIMIT THIS - Entry logging can spam during bulk key creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      8, 4.0, "Entering key description population");
-    
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate key description - destination NULL");
-    d_LogIf(lock == NULL, D_LOG_LEVEL_ERROR, "Cannot populate key description - lock NULL");
+    ITEMS_LOG_IF(item == NULL, D_LOG_LEVEL_WARNING, "Cannot check durability resistance for NULL item");
     
-    if (dest == NULL || lock == NULL) {
+    if (item == NULL) {
         return false;
     }
 
-    // Check if lock->name is valid
-    if (lock->name == NULL || lock->name->str == NULL) {
-        d_LogError("Lock name is NULL - cannot generate key description");
-        return false;
+    // Base chance is 5% to avoid durability loss
+    float base_chance = 0.05f;
+    float resistance_chance = base_chance * item->material_data.properties.durability_fact;
+
+    // Cap at 95% maximum resistance (always have some chance of wear)
+    if (resistance_chance > 0.95f) {
+        resistance_chance = 0.95f;
     }
 
-    // Directly populate the destination string
-    d_AppendString(dest, "A key that opens: ", 0);
-    d_AppendString(dest, lock->name->str, 0);
+    // Generate random number between 0.0 and 1.0
+    float random_roll = (float)rand() / (float)RAND_MAX;
+    bool resists = random_roll < resistance_chance;
 
-    // RATE LIMIT THIS - Success logging can flood during key generation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Key description generated for lock: %s", 
-                      lock->name->str);
-    return true;
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 10.0,
+                           "Durability check for '%s': %.1f%% resistance, %s", 
+                           item->name->str, resistance_chance * 100.0f, 
+                           resists ? "RESISTED" : "damaged");
+
+    return resists;
 }
+
 /*
  * Creates neutral material properties for basic items
  */
 static Material_t _create_default_material(void) 
 {
     // RATE LIMIT THIS - Called frequently as fallback material
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 5.0, "Creating default neutral material");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 5.0,
+                           "Creating default neutral material");
     
+    // The name is interned, the material owns nothing and needs no cleanup
     Material_t material;
-
-    material.name = d_InitString();
-    if (material.name == NULL) {
-        d_LogError("Failed to initialize default material name");
-        // Return zeroed material on failure
-        memset(&material, 0, sizeof(Material_t));
-        return material;
-    }
-    
-    d_AppendString(material.name, "default", 0);
+    material.name_atom = intern_string("default");
+    material.name = (material.name_atom != ATOM_NONE) ? intern_strings[material.name_atom] : NULL;
+    material.id = MATERIAL_NONE;
 
     // Initialize all properties to neutral (1.0f)
     material.properties.weight_fact = 1.0f;
@@ -2321,8 +2557,8 @@ static Material_t _create_default_material(void)
     material.properties.enchant_value_fact = 1.0f;
 
     // RATE LIMIT THIS - Success logging during bulk operations
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 5.0, "Default material created with neutral properties");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 5.0,
+                           "Default material created with neutral properties");
     return material;
 }
 
@@ -2332,25 +2568,14 @@ static Material_t _create_default_material(void)
 static Material_t _create_consumable_material(void) 
 {
     // RATE LIMIT THIS - Called during every consumable creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      10, 3.0, "Creating organic material for consumables");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 10, 3.0,
+                           "Creating organic material for consumables");
     
+    // The name is interned, the material owns nothing and needs no cleanup
     Material_t material;
-
-    // Set material name to "organic" using helper
-    material.name = d_InitString();
-    if (material.name == NULL) {
-        d_LogError("Failed to initialize consumable material name");
-        memset(&material, 0, sizeof(Material_t));
-        return material;
-    }
-    
-    if (!_populate_string_field(material.name, "organic")) {
-        d_LogError("Failed to populate organic material name");
-        d_DestroyString(material.name);
-        memset(&material, 0, sizeof(Material_t));
-        return material;
-    }
+    material.name_atom = intern_string("organic");
+    material.name = (material.name_atom != ATOM_NONE) ? intern_strings[material.name_atom] : NULL;
+    material.id = MATERIAL_NONE;
 
     // Initialize all properties to neutral (1.0f)
     material.properties.weight_fact = 1.0f;
@@ -2364,79 +2589,255 @@ static Material_t _create_consumable_material(void)
     material.properties.enchant_value_fact = 1.0f;
 
     // RATE LIMIT THIS - Success logging for consumable material creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 5.0, "Organic material created for consumables");
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 5.0,
+                           "Organic material created for consumables");
     return material;
 }
 
 /*
- * Generates descriptive text for consumable items with potency value
+ * Interns the name, id, rarity and material name every item carries
  */
-static bool _populate_consumable_desc(dString_t* dest, uint8_t value) 
+static bool _intern_item_strings(Item_t* item, const char* name, const char* id,
+                                 const Material_t* material, const char* kind)
 {
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate consumable description - destination NULL");
-    
-    if (dest == NULL) {
+    item->name = _intern_field(name, MAX_ITEM_NAME_LENGTH, "Item name", &item->name_atom);
+    if (item->name == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate name for %s '%s'", kind, name);
         return false;
     }
 
-    dString_t* temp = d_InitString();
-    if (temp == NULL) {
-        d_LogError("Failed to allocate temporary string for consumable description");
+    item->id = _intern_field(id, MAX_ITEM_ID_LENGTH, "Item ID", &item->id_atom);
+    if (item->id == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate ID for %s '%s'", kind, name);
         return false;
     }
 
-    d_AppendString(temp, "A consumable item with magical properties (Potency: ", 0);
-    d_AppendInt(temp, value);
-    d_AppendChar(temp, ')');
-    *dest = *temp;
-    free(temp);
-    
-    // RATE LIMIT THIS - Called during every consumable creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      8, 4.0, "Consumable description generated with potency: %d", value);
+    item->rarity = _intern_field("common", 0, "Item rarity", &item->rarity_atom);
+    if (item->rarity == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to populate rarity for %s '%s'", kind, name);
+        return false;
+    }
+
+    const char* material_name = (material->name && material->name->str) ? material->name->str : "unknown";
+    item->material_data.name = _intern_field(material_name, 0, "Material name", &item->material_data.name_atom);
+    if (item->material_data.name == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Failed to allocate material name for %s '%s'", kind, name);
+        return false;
+    }
+    item->material_data.id = material->id;
+
     return true;
 }
+
 /*
- * Generates descriptive text for ammunition items with damage range
+ * Interns a string cut to max_length (0 is no limit), returns the shared copy
  */
-static bool _populate_ammunition_desc(dString_t* dest, const Material_t* material, uint8_t min_dmg, uint8_t max_dmg) 
+static dString_t* _intern_field(const char* src, size_t max_length, const char* field_name, uint32_t* atom)
 {
-    d_LogIf(dest == NULL, D_LOG_LEVEL_ERROR, "Cannot populate ammunition description - destination NULL");
-    d_LogIf(material == NULL, D_LOG_LEVEL_ERROR, "Cannot populate ammunition description - material NULL");
-    
-    if (dest == NULL || material == NULL) {
-        return false;
+    if (src == NULL) {
+        ITEMS_LOG(D_LOG_LEVEL_ERROR, "Source string is NULL for field: %s", field_name);
+        return NULL;
+    }
+
+    char truncated[MAX_ITEM_NAME_LENGTH + 1];
+    size_t src_len = strlen(src);
+
+    if (max_length > 0 && src_len > max_length) {
+        fprintf(stderr, "WARNING: Truncating %s from %zu to %zu characters\n", 
+                field_name, src_len, max_length);
+
+        memcpy(truncated, src, max_length);
+        truncated[max_length] = '\0';
+        src = truncated;
+    }
+
+    uint32_t interned = intern_string(src);
+    if (interned == ATOM_NONE) {
+        return NULL;
+    }
+
+    if (atom != NULL) {
+        *atom = interned;
+    }
+    return intern_strings[interned];
+}
+
+/*
+ * Formats an item description and interns it
+ */
+static dString_t* _intern_description(const char* format, ...)
+{
+    char description[MAX_DESCRIPTION_LENGTH];
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(description, sizeof(description), format, args);
+    va_end(args);
+
+    ITEMS_LOG_RATE_LIMITED(D_LOG_LEVEL_DEBUG, 5, 3.0,
+                           "Item description generated: %s", description);
+
+    return _intern_field(description, 0, "Item description", NULL);
+}
+
+/*
+ * Takes an item from the current pool, or the heap when there is none
+ */
+static Item_t* _alloc_item(void)
+{
+    ItemPool_t* pool = current_item_pool;
+    Item_t* item = NULL;
+
+    if (pool == NULL) {
+        item = (Item_t*)malloc(sizeof(Item_t));
+        if (item != NULL) {
+            item->pool = NULL;
+            item->slot = ITEM_SLOT_LIVE;
+        }
+        return item;
+    }
+
+    if (pool->free_list != NULL) {
+        item = pool->free_list;
+        pool->free_list = *(Item_t**)item;
+    } else {
+        ItemSlab_t* slab = pool->current_slab;
+
+        // Move on to a slab kept by clear_item_pool(), or add one
+        if (slab != NULL && slab->used == ITEM_POOL_SLAB_SIZE) {
+            slab = slab->next;
+        }
+
+        if (slab == NULL) {
+            slab = (ItemSlab_t*)malloc(sizeof(ItemSlab_t));
+            if (slab == NULL) {
+                ITEMS_LOG(D_LOG_LEVEL_ERROR, "Memory allocation failed for item pool slab");
+                return NULL;
+            }
+
+            slab->next = NULL;
+            slab->used = 0;
+
+            if (pool->current_slab != NULL) {
+                pool->current_slab->next = slab;
+            } else {
+                pool->slabs = slab;
+            }
+        }
+
+        pool->current_slab = slab;
+        item = &slab->items[slab->used++];
+    }
+
+    item->pool = pool;
+    item->slot = ITEM_SLOT_LIVE;
+    pool->live++;
+    return item;
+}
+
+/*
+ * Gives an item back to its pool's free list, or the heap
+ */
+static void _free_item(Item_t* item)
+{
+    ItemPool_t* pool = item->pool;
+
+    if (pool == NULL) {
+        free(item);
+        return;
     }
 
-    // Validate material name
-    if (material->name == NULL || material->name->str == NULL) {
-        d_LogError("Material name is NULL - cannot generate ammunition description");
+    // The slot keeps its pool, destroy_item() and clear_item_pool() skip it
+    item->slot = ITEM_SLOT_DEAD;
+    *(Item_t**)item = pool->free_list;
+    pool->free_list = item;
+    pool->live--;
+}
+
+/*
+ * Frees the strings an item owns, only a key's copy of its lock
+ */
+static void _release_item_strings(Item_t* item)
+{
+    if (item->type != ITEM_TYPE_KEY) {
+        return;
+    }
+
+    if (item->data.key.lock.name != NULL) {
+        d_DestroyString(item->data.key.lock.name);
+        item->data.key.lock.name = NULL;
+    }
+    if (item->data.key.lock.description != NULL) {
+        d_DestroyString(item->data.key.lock.description);
+        item->data.key.lock.description = NULL;
+    }
+}
+
+/*
+ * Scales an item's stats and base properties by a material's factors
+ */
+static void _apply_material_factors(Item_t* item, const MaterialProperties_t* factors)
+{
+    switch (item->type) {
+        case ITEM_TYPE_WEAPON: {
+            Weapon__Item_t* weapon = &item->data.weapon;
+            weapon->min_damage = (uint8_t)(weapon->min_damage * factors->min_damage_fact);
+            weapon->max_damage = (uint8_t)(weapon->max_damage * factors->max_damage_fact);
+            weapon->stealth_value = (uint8_t)(weapon->stealth_value * factors->stealth_value_fact);
+            weapon->enchant_value = (uint8_t)(weapon->enchant_value * factors->enchant_value_fact);
+            break;
+        }
+        case ITEM_TYPE_ARMOR: {
+            Armor__Item_t* armor = &item->data.armor;
+            armor->armor_value = (uint8_t)(armor->armor_value * factors->armor_value_fact);
+            armor->evasion_value = (uint8_t)(armor->evasion_value * factors->evasion_value_fact);
+            armor->durability = (uint8_t)(armor->durability * factors->durability_fact);
+            armor->stealth_value = (uint8_t)(armor->stealth_value * factors->stealth_value_fact);
+            armor->enchant_value = (uint8_t)(armor->enchant_value * factors->enchant_value_fact);
+            break;
+        }
+        case ITEM_TYPE_AMMUNITION: {
+            Ammunition__Item_t* ammo = &item->data.ammo;
+            ammo->min_damage = (uint8_t)(ammo->min_damage * factors->min_damage_fact);
+            ammo->max_damage = (uint8_t)(ammo->max_damage * factors->max_damage_fact);
+            break;
+        }
+        default:
+            return;
+    }
+
+    // Apply to base item properties with bounds checking
+    float new_weight = item->weight_kg * factors->weight_fact;
+    item->weight_kg = (new_weight < 0.0f) ? 0.0f : new_weight;
+
+    float new_value = item->value_coins * factors->value_coins_fact;
+    item->value_coins = (new_value < 0.0f) ? 0 : (uint8_t)new_value;
+}
+
+/*
+ * Counts a message against its call site's window, false if it is dropped
+ */
+static bool _take_log_token(ItemsLogToken_t* token, dLogLevel_t level, uint32_t max_count, double time_window)
+{
+    // Checked first so a message the logger would drop is never formatted
+    if (level < d_GetLogLevel(NULL)) {
         return false;
     }
 
-    dString_t* temp = d_InitString();
-    if (temp == NULL) {
-        d_LogError("Failed to allocate temporary string for ammunition description");
+    double now = d_GetTimestamp();
+    if (token->count == 0 || now - token->window_start >= time_window) {
+        token->window_start = now;
+        token->count = 0;
+    }
+
+    if (token->count >= max_count) {
         return false;
     }
 
-    d_AppendString(temp, "Ammunition made of ", 0);
-    d_AppendString(temp, material->name->str, 0);
-    d_AppendString(temp, " (Damage: ", 0);
-    d_AppendInt(temp, min_dmg);
-    d_AppendChar(temp, '-');
-    d_AppendInt(temp, max_dmg);
-    d_AppendChar(temp, ')');
-    *dest = *temp;
-    free(temp);
-    
-    // RATE LIMIT THIS - Called during every ammunition creation
-    d_LogRateLimitedF(D_LOG_RATE_LIMIT_FLAG_HASH_FORMAT_STRING, D_LOG_LEVEL_DEBUG,
-                      5, 3.0, "Ammunition description generated: %s [%d-%d dmg]", 
-                      material->name->str, min_dmg, max_dmg);
+    token->count++;
     return true;
 }
+
 static bool _validate_and_truncate_string(dString_t* dest, const char* src, size_t max_length, const char* field_name)
 {
     // Extremely aggressive NULL checks with explicit logging
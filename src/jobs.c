@@ -0,0 +1,239 @@
+/*
+ * jobs.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "jobs.h"
+#include "profiler.h"
+
+static SDL_Thread* threads[JOBS_MAX_THREADS];
+static int num_threads = 0;
+
+static SDL_mutex* job_lock = NULL;
+static SDL_cond* job_ready = NULL;
+static SDL_cond* job_done  = NULL;
+
+// queued jobs are jobs[job_head..job_tail), pending also counts running ones
+static Job_t* jobs = NULL;
+static int job_head = 0;
+static int job_tail = 0;
+static int job_max  = 0;
+static int pending  = 0;
+static int quitting = 0;
+
+static int jb_Worker( void* data );
+static int jb_Reserve( void );
+
+int g_InitJobs( int count )
+{
+  if ( job_lock != NULL )
+  {
+    return 0;
+  }
+
+  if ( count <= 0 )
+  {
+    count = SDL_GetCPUCount() - 1;
+  }
+
+  if ( count > JOBS_MAX_THREADS )
+  {
+    count = JOBS_MAX_THREADS;
+  }
+
+  if ( count < 1 )
+  {
+    return 0;
+  }
+
+  job_lock  = SDL_CreateMutex();
+  job_ready = SDL_CreateCond();
+  job_done  = SDL_CreateCond();
+  if ( job_lock == NULL || job_ready == NULL || job_done == NULL )
+  {
+    printf( "Failed to create job queue lock, %s\n", SDL_GetError() );
+    g_ShutdownJobs();
+    return 1;
+  }
+
+  // the workers time zones with the clock, it has to be set before them
+  g_ProfInit();
+
+  quitting = 0;
+  for ( int i = 0; i < count; i++ )
+  {
+    threads[i] = SDL_CreateThread( jb_Worker, "worker", NULL );
+    if ( threads[i] == NULL )
+    {
+      printf( "Failed to create worker thread, %s\n", SDL_GetError() );
+      break;
+    }
+
+    num_threads++;
+  }
+
+  return 0;
+}
+
+void g_ShutdownJobs( void )
+{
+  if ( job_lock != NULL )
+  {
+    SDL_LockMutex( job_lock );
+    quitting = 1;
+    SDL_CondBroadcast( job_ready );
+    SDL_UnlockMutex( job_lock );
+  }
+
+  for ( int i = 0; i < num_threads; i++ )
+  {
+    SDL_WaitThread( threads[i], NULL );
+  }
+
+  num_threads = 0;
+
+  if ( job_done != NULL )
+  {
+    SDL_DestroyCond( job_done );
+    job_done = NULL;
+  }
+
+  if ( job_ready != NULL )
+  {
+    SDL_DestroyCond( job_ready );
+    job_ready = NULL;
+  }
+
+  if ( job_lock != NULL )
+  {
+    SDL_DestroyMutex( job_lock );
+    job_lock = NULL;
+  }
+
+  free( jobs );
+  jobs = NULL;
+  job_head = job_tail = job_max = pending = 0;
+}
+
+void g_PushJob( JobFunc_t func, void* data )
+{
+  if ( num_threads == 0 )
+  {
+    func( data );
+    return;
+  }
+
+  SDL_LockMutex( job_lock );
+
+  if ( !jb_Reserve() )
+  {
+    SDL_UnlockMutex( job_lock );
+    func( data );
+    return;
+  }
+
+  jobs[job_tail++] = ( Job_t ){ func, data };
+  pending++;
+
+  SDL_CondSignal( job_ready );
+  SDL_UnlockMutex( job_lock );
+}
+
+void g_WaitJobs( void )
+{
+  if ( num_threads == 0 )
+  {
+    return;
+  }
+
+  SDL_LockMutex( job_lock );
+
+  while ( pending > 0 )
+  {
+    SDL_CondWait( job_done, job_lock );
+  }
+
+  SDL_UnlockMutex( job_lock );
+}
+
+static int jb_Worker( void* data )
+{
+  ( void )data;
+
+  SDL_LockMutex( job_lock );
+
+  for ( ;; )
+  {
+    while ( job_head == job_tail && !quitting )
+    {
+      SDL_CondWait( job_ready, job_lock );
+    }
+
+    // quitting only stops a worker once the queue is drained
+    if ( job_head == job_tail )
+    {
+      break;
+    }
+
+    Job_t job = jobs[job_head++];
+    if ( job_head == job_tail )
+    {
+      job_head = job_tail = 0;
+    }
+
+    SDL_UnlockMutex( job_lock );
+    job.func( job.data );
+    SDL_LockMutex( job_lock );
+
+    pending--;
+    if ( pending == 0 )
+    {
+      SDL_CondBroadcast( job_done );
+    }
+  }
+
+  SDL_UnlockMutex( job_lock );
+
+  return 0;
+}
+
+/*
+ * Make room for one more job at job_tail, called with job_lock held
+ */
+static int jb_Reserve( void )
+{
+  if ( job_tail < job_max )
+  {
+    return 1;
+  }
+
+  if ( job_head > 0 )
+  {
+    memmove( jobs, jobs + job_head, sizeof( Job_t ) * ( job_tail - job_head ) );
+    job_tail -= job_head;
+    job_head  = 0;
+    return 1;
+  }
+
+  int new_max = job_max > 0 ? job_max * 2 : JOBS_QUEUE_SIZE;
+  Job_t* grown = realloc( jobs, sizeof( Job_t ) * new_max );
+  if ( grown == NULL )
+  {
+    printf( "Failed to grow job queue to %d\n", new_max );
+    return 0;
+  }
+
+  jobs    = grown;
+  job_max = new_max;
+
+  return 1;
+}
+
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #ifdef __EMSCRIPTEN__
@@ -9,20 +10,39 @@
 
 #include "Archimedes.h"
 #include "game.h"
+#include "profiler.h"
+#include "text_cache.h"
 
 void g_ChangeColor( uint32_t hex_color_value );
 static void aDoLoop( float );
 static void aRenderLoop( float );
+static void g_UpdateGame( float );
+static void g_RecordFrame( DrawList_t* list );
 
 World_t* g_world;
 aColor_t grid_color;
 
 WorldPosition_t current_pos;
+WorldPosition_t drawn_pos;
 char* pos_text;
 
 int originX;
 int originY;
 
+DrawList_t frame_list;
+
+#ifndef __EMSCRIPTEN__
+static void g_ThreadedMainloop( void );
+static int g_LogicThread( void* data );
+
+// --threaded: logic records into draw_buffers on its own thread, the main
+// thread polls input and replays, input_lock keeps a_DoInput and the
+// logic off app.keyboard / app.mouse at the same time
+DrawBuffers_t draw_buffers;
+SDL_mutex* input_lock;
+SDL_atomic_t logic_running;
+#endif
+
 #ifdef __EMSCRIPTEN__
 EMSCRIPTEN_KEEPALIVE
 #endif
@@ -49,8 +69,9 @@ void aInitGame( void )
            current_pos.region_index, current_pos.local_index, current_pos.level,
            current_pos.local_z );
   
-  game_glyphs = e_InitGlyphs( "resources/fonts/CodePage737Font.png",
-                               9, 16 );
+  const char* glyph_pages[GLYPH_NUM_PAGES] = GLYPH_PAGE_FILES;
+  game_glyphs = e_LoadGlyphAtlas( GLYPH_ATLAS_FILE, glyph_pages,
+                                  GLYPH_NUM_PAGES, GLYPH_WIDTH, GLYPH_HEIGHT );
   g_world = init_world( WORLD_WIDTH_SMALL, WORLD_HEIGHT_SMALL, 
                         REGION_WIDTH_SMALL, REGION_HEIGHT_SMALL,
                         LOCAL_WIDTH_SMALL, LOCAL_HEIGHT_SMALL, Z_HEIGHT_SMALL );
@@ -60,12 +81,27 @@ void aInitGame( void )
 
   grid_color = blue;
   //g_ChangeColor( 0xff0000 );
+
+  g_InitDrawList( &frame_list );
 }
 
 static void aDoLoop( float dt )
 {
-  a_DoInput();
-  
+  PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
+  PROF_PHASE( PROF_PHASE_LOGIC ) g_UpdateGame( dt );
+}
+
+static void aRenderLoop( float dt )
+{
+  PROF_PHASE( PROF_PHASE_DRAW )
+  {
+    g_RecordFrame( &frame_list );
+    g_ReplayDrawList( &frame_list, game_glyphs );
+  }
+}
+
+static void g_UpdateGame( float dt )
+{
   if ( app.mouse.button == 1 )
   {
     app.mouse.button = 0;
@@ -124,35 +160,21 @@ static void aDoLoop( float dt )
   }
 }
 
-static void aRenderLoop( float dt )
+static void g_RecordFrame( DrawList_t* list )
 {
   if ( g_world != NULL )
   {
-    int draw_size = 0;
-    switch ( current_pos.level )
-    {
-      case WORLD_LEVEL:
-        draw_size = g_world->world_width * g_world->world_height;         
-        break;
-
-      case REGION_LEVEL:
-        draw_size = g_world->region_width * g_world->region_height;
-        break;
-
-      case LOCAL_LEVEL:
-        draw_size = g_world->local_width * g_world->local_height;                      
-        break;
-    }
+    g_RecordWorldView( list, g_world, current_pos );
 
-    for ( uint16_t i = 0; i < draw_size; i++ )
+    if ( memcmp( &current_pos, &drawn_pos, sizeof( WorldPosition_t ) ) != 0 )
     {
-      we_DrawWorldCell( i, g_world, current_pos );
+      drawn_pos = current_pos;
+      snprintf(pos_text, 50, "%d,%d,%d,%d,%d\n", current_pos.world_index,
+             current_pos.region_index, current_pos.local_index, current_pos.level,
+             current_pos.local_z );
     }
-
-    snprintf(pos_text, 50, "%d,%d,%d,%d,%d\n", current_pos.world_index,
-           current_pos.region_index, current_pos.local_index, current_pos.level,
-           current_pos.local_z );
-    a_DrawText( pos_text, 750, 10, 255, 255, 255, app.font_type, TEXT_ALIGN_CENTER, 0 );
+    g_PushText( list, pos_text, 750, 10, white, app.font_type,
+                TEXT_ALIGN_CENTER );
 
   }
 
@@ -164,22 +186,126 @@ void aMainloop( void )
 
   app.delegate.logic( a_GetDeltaTime() );
   app.delegate.draw( a_GetDeltaTime() );
+  g_ProfDrawOverlay();
   
-  a_PresentScene();
+  PROF_PHASE( PROF_PHASE_PRESENT ) a_PresentScene();
+  g_ProfFrame();
+}
+
+#ifndef __EMSCRIPTEN__
+static void g_ThreadedMainloop( void )
+{
+  int running = 1;
+
+  g_ProfInit();
+  SDL_AtomicSet( &logic_running, 1 );
+  SDL_Thread* logic = SDL_CreateThread( g_LogicThread, "logic", NULL );
+  if ( logic == NULL )
+  {
+    printf( "Failed to create logic thread, %s\n", SDL_GetError() );
+    return;
+  }
+
+  while ( running )
+  {
+    SDL_LockMutex( input_lock );
+    PROF_PHASE( PROF_PHASE_INPUT ) a_DoInput();
+    running = app.running;
+    SDL_UnlockMutex( input_lock );
+
+    a_PrepareScene();
+
+    DrawList_t* list = g_AcquireDrawBuffer( &draw_buffers );
+    if ( list != NULL )
+    {
+      PROF_PHASE( PROF_PHASE_DRAW ) g_ReplayDrawList( list, game_glyphs );
+      g_ReleaseDrawBuffer( &draw_buffers );
+    }
+    g_ProfDrawOverlay();
+
+    PROF_PHASE( PROF_PHASE_PRESENT ) a_PresentScene();
+    g_ProfFrame();
+  }
+
+  SDL_AtomicSet( &logic_running, 0 );
+  SDL_WaitThread( logic, NULL );
 }
 
-int main( void )
+static int g_LogicThread( void* data )
 {
+  ( void )data;
+
+  const Uint32 frame_ms = 1000 / LOGIC_HZ;
+  Uint32 last = SDL_GetTicks();
+
+  while ( SDL_AtomicGet( &logic_running ) )
+  {
+    Uint32 start = SDL_GetTicks();
+    float dt = ( start - last ) / 1000.0f;
+    last = start;
+
+    SDL_LockMutex( input_lock );
+    PROF_PHASE( PROF_PHASE_LOGIC ) g_UpdateGame( dt );
+    SDL_UnlockMutex( input_lock );
+
+    PROF_ZONE( "record" ) g_RecordFrame( g_BeginDrawBuffer( &draw_buffers ) );
+    g_PublishDrawBuffer( &draw_buffers );
+
+    Uint32 spent = SDL_GetTicks() - start;
+    if ( spent < frame_ms )
+    {
+      SDL_Delay( frame_ms - spent );
+    }
+  }
+
+  return 0;
+}
+#endif
+
+int main( int argc, char** argv )
+{
+  int threaded = 0;
+
+  for ( int i = 1; i < argc; i++ )
+  {
+    if ( strcmp( argv[i], "--threaded" ) == 0 )
+    {
+      threaded = 1;
+    }
+  }
+
   a_Init( SCREEN_WIDTH, SCREEN_HEIGHT, "Archimedes" );
 
   aInitGame();
 
   #ifdef __EMSCRIPTEN__
+    ( void )threaded;
     emscripten_set_main_loop( aMainloop, 0, 1 );
   #endif
 
   #ifndef __EMSCRIPTEN__
-    while( app.running ) {
+    if ( threaded )
+    {
+      input_lock = SDL_CreateMutex();
+      if ( input_lock != NULL && g_InitDrawBuffers( &draw_buffers ) == 0 )
+      {
+        g_ThreadedMainloop();
+        g_FreeDrawBuffers( &draw_buffers );
+      }
+
+      else
+      {
+        threaded = 0;
+      }
+
+      if ( input_lock != NULL )
+      {
+        SDL_DestroyMutex( input_lock );
+        input_lock = NULL;
+      }
+    }
+
+    while( !threaded && app.running ) {
       aMainloop();
     }
   #endif
@@ -189,6 +315,10 @@ int main( void )
   g_world = NULL;
   free( pos_text );
   pos_text = NULL;
+  e_FreeGlyphAtlas( game_glyphs );
+  game_glyphs = NULL;
+  g_ClearTextCache();
+  g_FreeDrawList( &frame_list );
   
   a_Quit();
 
@@ -0,0 +1,320 @@
+/*
+ * profiler.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "profiler.h"
+#include "text_cache.h"
+
+#define PROF_RING_MASK          ( PROF_RING_SIZE - 1 )
+#define PROF_OVERLAY_REFRESH_NS 250000000ull
+#define PROF_LINE_LEN           48
+
+static const char* phase_names[PROF_PHASE_MAX] = {
+  "input", "logic", "draw", "present"
+};
+
+static ProfSample_t ring[PROF_RING_SIZE];
+static SDL_atomic_t ring_pos;
+static SDL_atomic_t phase_ns[PROF_PHASE_MAX];
+
+static uint64_t base_counter = 0;
+static double ns_per_tick    = 0.0;
+
+// open phases of this thread, each collects the time of the ones inside it
+static _Thread_local uint64_t nested_ns[PROF_PHASE_MAX];
+static _Thread_local int phase_depth = 0;
+
+// history and overlay, main thread only
+static float frame_ms[PROF_HISTORY];
+static float phase_ms[PROF_PHASE_MAX][PROF_HISTORY];
+static int history_pos   = 0;
+static int history_count = 0;
+static uint64_t last_frame_ns = 0;
+
+static int overlay_visible = 0;
+static uint64_t overlay_refreshed_ns = 0;
+static char overlay_lines[PROF_PHASE_MAX + 1][PROF_LINE_LEN];
+
+static void prof_Push( const char* name, uint64_t start_ns, uint64_t end_ns );
+static void prof_Percentiles( float* values, int count, float* p50,
+                              float* p99 );
+static int prof_CompareFloat( const void* a, const void* b );
+static void prof_RefreshOverlay( void );
+
+void g_ProfInit( void )
+{
+  if ( ns_per_tick != 0.0 ) return;
+
+  base_counter = SDL_GetPerformanceCounter();
+  ns_per_tick  = 1e9 / ( double )SDL_GetPerformanceFrequency();
+}
+
+uint64_t g_ProfNow( void )
+{
+  if ( ns_per_tick == 0.0 )
+  {
+    g_ProfInit();
+  }
+
+  return ( uint64_t )( ( SDL_GetPerformanceCounter() - base_counter )
+                       * ns_per_tick );
+}
+
+void g_ProfZoneEnd( const char* name, uint64_t start_ns )
+{
+  prof_Push( name, start_ns, g_ProfNow() );
+}
+
+uint64_t g_ProfPhaseBegin( void )
+{
+  if ( phase_depth < PROF_PHASE_MAX )
+  {
+    nested_ns[phase_depth] = 0;
+  }
+
+  phase_depth++;
+
+  return g_ProfNow();
+}
+
+void g_ProfPhaseEnd( int phase, uint64_t start_ns )
+{
+  uint64_t end_ns   = g_ProfNow();
+  uint64_t total_ns = end_ns - start_ns;
+  uint64_t own_ns   = total_ns;
+
+  phase_depth--;
+
+  if ( phase_depth < PROF_PHASE_MAX && nested_ns[phase_depth] < total_ns )
+  {
+    own_ns -= nested_ns[phase_depth];
+  }
+
+  if ( phase_depth > 0 && phase_depth <= PROF_PHASE_MAX )
+  {
+    nested_ns[phase_depth - 1] += total_ns;
+  }
+
+  // the trace keeps the whole span, nesting shows there as it is
+  prof_Push( phase_names[phase], start_ns, end_ns );
+  SDL_AtomicAdd( &phase_ns[phase], ( int )own_ns );
+}
+
+void g_ProfFrame( void )
+{
+  uint64_t now = g_ProfNow();
+
+  if ( last_frame_ns != 0 )
+  {
+    frame_ms[history_pos] = ( now - last_frame_ns ) / 1e6f;
+
+    for ( int i = 0; i < PROF_PHASE_MAX; i++ )
+    {
+      phase_ms[i][history_pos] = SDL_AtomicSet( &phase_ns[i], 0 ) / 1e6f;
+    }
+
+    history_pos = ( history_pos + 1 ) % PROF_HISTORY;
+    if ( history_count < PROF_HISTORY )
+    {
+      history_count++;
+    }
+  }
+
+  last_frame_ns = now;
+
+  if ( app.keyboard[PROF_OVERLAY_KEY] == 1 )
+  {
+    app.keyboard[PROF_OVERLAY_KEY] = 0;
+    overlay_visible = !overlay_visible;
+    overlay_refreshed_ns = 0;
+  }
+
+  if ( app.keyboard[PROF_DUMP_KEY] == 1 )
+  {
+    app.keyboard[PROF_DUMP_KEY] = 0;
+    if ( g_ProfDumpTrace( PROF_TRACE_FILE, PROF_DUMP_SECONDS ) == 0 )
+    {
+      printf( "Wrote %s\n", PROF_TRACE_FILE );
+    }
+  }
+}
+
+void g_ProfDrawOverlay( void )
+{
+  if ( !overlay_visible )
+  {
+    return;
+  }
+
+  // the numbers only change a few times a second so the text cache
+  // keeps hitting in between
+  uint64_t now = g_ProfNow();
+  if ( now - overlay_refreshed_ns > PROF_OVERLAY_REFRESH_NS )
+  {
+    overlay_refreshed_ns = now;
+    prof_RefreshOverlay();
+  }
+
+  int x = 10, y = 10;
+  int line_height = 24;
+  int graph_height = 64;
+
+  a_DrawFilledRect( x - 5, y - 5, PROF_HISTORY * 3 + 10,
+                    ( PROF_PHASE_MAX + 1 ) * line_height + graph_height + 15,
+                    0, 0, 0, 192 );
+
+  for ( int i = 0; i < PROF_PHASE_MAX + 1; i++ )
+  {
+    g_DrawCachedText( overlay_lines[i], x, y + i * line_height, white,
+                      app.font_type, TEXT_ALIGN_LEFT );
+  }
+
+  // frame graph, oldest on the left, 16.6ms and 33.3ms marked
+  int base_y = y + ( PROF_PHASE_MAX + 1 ) * line_height + graph_height;
+  for ( int i = 0; i < history_count; i++ )
+  {
+    int index = ( history_pos - history_count + i + PROF_HISTORY )
+      % PROF_HISTORY;
+    float ms = frame_ms[index];
+    int h = ( int )( ms * 2.0f );
+    if ( h > graph_height )
+    {
+      h = graph_height;
+    }
+
+    if ( ms < 16.7f )
+    {
+      a_DrawFilledRect( x + i * 3, base_y - h, 2, h, 0, 255, 0, 255 );
+    }
+
+    else if ( ms < 33.4f )
+    {
+      a_DrawFilledRect( x + i * 3, base_y - h, 2, h, 255, 255, 0, 255 );
+    }
+
+    else
+    {
+      a_DrawFilledRect( x + i * 3, base_y - h, 2, h, 255, 0, 0, 255 );
+    }
+  }
+
+  a_DrawFilledRect( x, base_y - 33, PROF_HISTORY * 3, 1, 255, 255, 255, 96 );
+  a_DrawFilledRect( x, base_y - 64, PROF_HISTORY * 3, 1, 255, 255, 255, 96 );
+}
+
+int g_ProfDumpTrace( const char* filename, double seconds )
+{
+  FILE* file = fopen( filename, "wb" );
+  if ( file == NULL )
+  {
+    printf( "Failed to open file %s\n", filename );
+    return 1;
+  }
+
+  uint64_t now    = g_ProfNow();
+  uint64_t window = ( uint64_t )( seconds * 1e9 );
+  uint32_t end    = ( uint32_t )SDL_AtomicGet( &ring_pos );
+  uint32_t begin  = end > PROF_RING_SIZE ? end - PROF_RING_SIZE : 0;
+  int first = 1;
+
+  fprintf( file, "{\"traceEvents\":[\n" );
+
+  for ( uint32_t pos = begin; pos != end; pos++ )
+  {
+    ProfSample_t* slot = &ring[pos & PROF_RING_MASK];
+    ProfSample_t sample;
+
+    // skip slots still being written or already reused
+    if ( ( uint32_t )SDL_AtomicGet( &slot->seq ) != pos + 1 )
+    {
+      continue;
+    }
+
+    sample.name        = slot->name;
+    sample.start_ns    = slot->start_ns;
+    sample.duration_ns = slot->duration_ns;
+    sample.thread      = slot->thread;
+
+    if ( ( uint32_t )SDL_AtomicGet( &slot->seq ) != pos + 1 ||
+         sample.start_ns + window < now )
+    {
+      continue;
+    }
+
+    fprintf( file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+             "\"dur\":%.3f,\"pid\":1,\"tid\":%u}", first ? "" : ",\n",
+             sample.name, sample.start_ns / 1000.0,
+             sample.duration_ns / 1000.0, sample.thread );
+    first = 0;
+  }
+
+  fprintf( file, "\n],\"displayTimeUnit\":\"ms\"}\n" );
+  fclose( file );
+
+  return 0;
+}
+
+static void prof_Push( const char* name, uint64_t start_ns, uint64_t end_ns )
+{
+  uint32_t pos = ( uint32_t )SDL_AtomicAdd( &ring_pos, 1 );
+  ProfSample_t* slot = &ring[pos & PROF_RING_MASK];
+
+  SDL_AtomicSet( &slot->seq, 0 );
+  slot->name        = name;
+  slot->start_ns    = start_ns;
+  slot->duration_ns = ( uint32_t )( end_ns - start_ns );
+  slot->thread      = ( uint32_t )SDL_ThreadID();
+  SDL_AtomicSet( &slot->seq, ( int )( pos + 1 ) );
+}
+
+static void prof_Percentiles( float* values, int count, float* p50,
+                              float* p99 )
+{
+  float sorted[PROF_HISTORY];
+
+  if ( count == 0 )
+  {
+    *p50 = *p99 = 0.0f;
+    return;
+  }
+
+  memcpy( sorted, values, sizeof( float ) * count );
+  qsort( sorted, count, sizeof( float ), prof_CompareFloat );
+
+  *p50 = sorted[( count * 50 ) / 100];
+  *p99 = sorted[( count * 99 ) / 100];
+}
+
+static int prof_CompareFloat( const void* a, const void* b )
+{
+  float fa = *( const float* )a;
+  float fb = *( const float* )b;
+
+  return ( fa > fb ) - ( fa < fb );
+}
+
+static void prof_RefreshOverlay( void )
+{
+  float p50, p99;
+
+  prof_Percentiles( frame_ms, history_count, &p50, &p99 );
+  snprintf( overlay_lines[0], PROF_LINE_LEN, "frame   p50 %6.2f p99 %6.2f ms",
+            p50, p99 );
+
+  for ( int i = 0; i < PROF_PHASE_MAX; i++ )
+  {
+    prof_Percentiles( phase_ms[i], history_count, &p50, &p99 );
+    snprintf( overlay_lines[i + 1], PROF_LINE_LEN,
+              "%-7s p50 %6.2f p99 %6.2f ms", phase_names[i], p50, p99 );
+  }
+}
+
@@ -0,0 +1,253 @@
+/*
+ * text_cache.c:
+ *
+ * Copyright (c) 2025 Jacob Kellum <jkellum819@gmail.com>
+ *                    Mathew Storm <smattymat@gmail.com>
+ ************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Archimedes.h"
+#include "text_cache.h"
+
+/*
+ * Entries live in a fixed array. Each one is chained into a hash bucket
+ * and into one LRU list, head is the most recently drawn.
+ */
+typedef struct
+{
+  char text[TEXT_CACHE_MAX_LEN];
+  uint32_t hash;
+  int font_type;
+  aColor_t color;
+  SDL_Texture* texture;
+  int w, h;
+  int bucket_next;
+  int lru_prev, lru_next;
+
+} TextCacheEntry_t;
+
+static TextCacheEntry_t entries[TEXT_CACHE_SIZE];
+static int buckets[TEXT_CACHE_BUCKETS];
+static int num_entries = 0;
+static int lru_head    = -1;
+static int lru_tail    = -1;
+static int initialized = 0;
+
+static uint32_t tc_Hash( const char* text, int font_type, aColor_t color );
+static TextCacheEntry_t* tc_Find( const char* text, uint32_t hash,
+                                  int font_type, aColor_t color );
+static TextCacheEntry_t* tc_Insert( const char* text, uint32_t hash,
+                                    int font_type, aColor_t color );
+static void tc_Unlink( int index );
+static void tc_PushFront( int index );
+
+void g_DrawCachedText( const char* text, int x, int y, aColor_t color,
+                       int font_type, int align )
+{
+  if ( text == NULL || text[0] == '\0' )
+  {
+    return;
+  }
+
+  if ( strlen( text ) >= TEXT_CACHE_MAX_LEN )
+  {
+    a_DrawText( ( char* )text, x, y, color.r, color.g, color.b, font_type,
+                align, 0 );
+    return;
+  }
+
+  if ( !initialized )
+  {
+    g_ClearTextCache();
+  }
+
+  uint32_t hash = tc_Hash( text, font_type, color );
+  TextCacheEntry_t* entry = tc_Find( text, hash, font_type, color );
+  if ( entry == NULL )
+  {
+    entry = tc_Insert( text, hash, font_type, color );
+    if ( entry == NULL )
+    {
+      return;
+    }
+  }
+
+  SDL_Rect dest = { x, y, entry->w, entry->h };
+  if ( align == TEXT_ALIGN_CENTER )
+  {
+    dest.x -= entry->w / 2;
+  }
+
+  else if ( align == TEXT_ALIGN_RIGHT )
+  {
+    dest.x -= entry->w;
+  }
+
+  SDL_RenderCopy( app.renderer, entry->texture, NULL, &dest );
+}
+
+void g_ClearTextCache( void )
+{
+  for ( int i = 0; i < num_entries; i++ )
+  {
+    if ( entries[i].texture != NULL )
+    {
+      SDL_DestroyTexture( entries[i].texture );
+      entries[i].texture = NULL;
+    }
+  }
+
+  for ( int i = 0; i < TEXT_CACHE_BUCKETS; i++ )
+  {
+    buckets[i] = -1;
+  }
+
+  num_entries = 0;
+  lru_head    = -1;
+  lru_tail    = -1;
+  initialized = 1;
+}
+
+// FNV-1a over the string, then the font and colour
+static uint32_t tc_Hash( const char* text, int font_type, aColor_t color )
+{
+  uint32_t hash = 2166136261u;
+
+  for ( const char* c = text; *c != '\0'; c++ )
+  {
+    hash = ( hash ^ ( uint8_t )*c ) * 16777619u;
+  }
+
+  hash = ( hash ^ ( uint32_t )font_type ) * 16777619u;
+  hash = ( hash ^ ( ( uint32_t )color.r << 24 | ( uint32_t )color.g << 16 |
+                    ( uint32_t )color.b << 8  | color.a ) ) * 16777619u;
+
+  return hash;
+}
+
+static TextCacheEntry_t* tc_Find( const char* text, uint32_t hash,
+                                  int font_type, aColor_t color )
+{
+  int index = buckets[hash % TEXT_CACHE_BUCKETS];
+
+  while ( index != -1 )
+  {
+    TextCacheEntry_t* entry = &entries[index];
+
+    if ( entry->hash == hash && entry->font_type == font_type &&
+         entry->color.r == color.r && entry->color.g == color.g &&
+         entry->color.b == color.b && entry->color.a == color.a &&
+         strcmp( entry->text, text ) == 0 )
+    {
+      if ( lru_head != index )
+      {
+        tc_Unlink( index );
+        tc_PushFront( index );
+      }
+
+      return entry;
+    }
+
+    index = entry->bucket_next;
+  }
+
+  return NULL;
+}
+
+static TextCacheEntry_t* tc_Insert( const char* text, uint32_t hash,
+                                    int font_type, aColor_t color )
+{
+  SDL_Texture* texture = a_GetTextTexture( ( char* )text, font_type );
+  if ( texture == NULL )
+  {
+    printf( "Failed to create text texture %s\n", text );
+    return NULL;
+  }
+
+  int index;
+  if ( num_entries < TEXT_CACHE_SIZE )
+  {
+    index = num_entries++;
+  }
+
+  else
+  {
+    // evict the least recently drawn entry and drop it from its bucket
+    index = lru_tail;
+    tc_Unlink( index );
+
+    int* link = &buckets[entries[index].hash % TEXT_CACHE_BUCKETS];
+    while ( *link != index )
+    {
+      link = &entries[*link].bucket_next;
+    }
+    *link = entries[index].bucket_next;
+
+    SDL_DestroyTexture( entries[index].texture );
+  }
+
+  TextCacheEntry_t* entry = &entries[index];
+  memcpy( entry->text, text, strlen( text ) + 1 );
+  entry->hash      = hash;
+  entry->font_type = font_type;
+  entry->color     = color;
+  entry->texture   = texture;
+
+  SDL_QueryTexture( texture, NULL, NULL, &entry->w, &entry->h );
+  SDL_SetTextureColorMod( texture, color.r, color.g, color.b );
+  SDL_SetTextureAlphaMod( texture, color.a );
+
+  entry->bucket_next = buckets[hash % TEXT_CACHE_BUCKETS];
+  buckets[hash % TEXT_CACHE_BUCKETS] = index;
+  tc_PushFront( index );
+
+  return entry;
+}
+
+static void tc_Unlink( int index )
+{
+  TextCacheEntry_t* entry = &entries[index];
+
+  if ( entry->lru_prev != -1 )
+  {
+    entries[entry->lru_prev].lru_next = entry->lru_next;
+  }
+
+  else
+  {
+    lru_head = entry->lru_next;
+  }
+
+  if ( entry->lru_next != -1 )
+  {
+    entries[entry->lru_next].lru_prev = entry->lru_prev;
+  }
+
+  else
+  {
+    lru_tail = entry->lru_prev;
+  }
+}
+
+static void tc_PushFront( int index )
+{
+  entries[index].lru_prev = -1;
+  entries[index].lru_next = lru_head;
+
+  if ( lru_head != -1 )
+  {
+    entries[lru_head].lru_prev = index;
+  }
+
+  lru_head = index;
+
+  if ( lru_tail == -1 )
+  {
+    lru_tail = index;
+  }
+}
+
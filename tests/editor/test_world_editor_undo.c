@@ -0,0 +1,185 @@
+// ASCIIGame/tests/editor/test_world_editor_undo.c
+// Test file for undo on a generated world, compared through SaveWorld().
+
+#include "tests.h"
+#include "Archimedes.h"
+#include "Daedalus.h"
+#include "editor.h"
+#include "init_editor.h"
+#include "jobs.h"
+#include "save_editor.h"
+#include "world_editor.h"
+#include "structs.h"
+#include "defs.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// The editor keeps these in editor.c and world_editor.c, which need a window
+World_t* map = NULL;
+GlyphArray_t* game_glyphs = NULL;
+aColor_t master_colors[MAX_COLOR_GROUPS][48] = {0};
+float zoom_level = ZOOM_DEFAULT;
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST_BEFORE "test_world_editor_undo_before.sav"
+#define TEST_EDITED "test_world_editor_undo_edited.sav"
+#define TEST_AFTER  "test_world_editor_undo_after.sav"
+
+static uint8_t* read_file(const char* path, size_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    *size = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* bytes = malloc(*size);
+    if (bytes != NULL && fread(bytes, 1, *size, file) != *size) {
+        free(bytes);
+        bytes = NULL;
+    }
+
+    fclose(file);
+    return bytes;
+}
+
+// The regions and tiles pointers are saved as they were in memory, zero them
+static void clear_pointers(World_t* world, uint8_t* bytes)
+{
+    int num_cells = world->world_width * world->world_height;
+    int num_regions = world->region_width * world->region_height;
+    size_t num_tiles = (size_t)world->local_width * world->local_height * world->z_height;
+    uint8_t* at = bytes + sizeof(FileHeader_t);
+
+    for (int i = 0; i < num_cells; i++) {
+        memset(at + i * sizeof(World_t) + offsetof(World_t, regions), 0, sizeof(RegionCell_t*));
+    }
+    at += num_cells * sizeof(World_t);
+
+    for (int i = 0; i < num_cells; i++) {
+        for (int j = 0; j < num_regions; j++) {
+            memset(at + j * sizeof(RegionCell_t) + offsetof(RegionCell_t, tiles), 0, sizeof(GameTile_t*));
+        }
+        at += num_regions * sizeof(RegionCell_t) + num_regions * num_tiles * sizeof(GameTile_t);
+    }
+}
+
+// Number of bytes that differ between two saves of world, -1 if they can't be read
+static long diff_saves(World_t* world, const char* a, const char* b)
+{
+    size_t size_a = 0, size_b = 0;
+    uint8_t* bytes_a = read_file(a, &size_a);
+    uint8_t* bytes_b = read_file(b, &size_b);
+    long differ = -1;
+
+    if (bytes_a != NULL && bytes_b != NULL && size_a == size_b) {
+        clear_pointers(world, bytes_a);
+        clear_pointers(world, bytes_b);
+
+        differ = 0;
+        for (size_t i = 0; i < size_a; i++) {
+            differ += bytes_a[i] != bytes_b[i];
+        }
+    }
+
+    free(bytes_a);
+    free(bytes_b);
+    return differ;
+}
+
+// =============================================================================
+// UNDO TESTS
+// =============================================================================
+
+int test_undo_restores_generated_world(void)
+{
+    map = init_world(WORLD_WIDTH_SMALL, WORLD_HEIGHT_SMALL,
+                     REGION_WIDTH_SMALL, REGION_HEIGHT_SMALL,
+                     LOCAL_WIDTH_SMALL, LOCAL_HEIGHT_SMALL, Z_HEIGHT_SMALL);
+    TEST_ASSERT(map != NULL, "Small world should be created");
+    if (map == NULL) return 0;
+
+    weg_GenerateWorld(map, 7);
+    int saved = SaveWorld(map, TEST_BEFORE);
+    TEST_ASSERT(saved == 0, "Generated world should save");
+
+    // Full columns, so the surfaces the region and world tiles come from change
+    TileRect_t local = { .level = LOCAL_LEVEL, .world_index = 0, .region_index = 0,
+        .x = 0, .y = 0, .z = 0, .w = 4, .h = 4, .d = map->z_height };
+    TileRect_t region = { .level = REGION_LEVEL, .world_index = 1, .region_index = 0,
+        .x = 0, .y = 0, .z = 0, .w = 2, .h = 2, .d = 1 };
+
+    e_FillRect(map, local, 5, 2, 3);
+    e_FillRect(map, region, 5, 2, 3);
+    saved = SaveWorld(map, TEST_EDITED);
+    TEST_ASSERT(saved == 0, "Edited world should save");
+
+    long edited = diff_saves(map, TEST_BEFORE, TEST_EDITED);
+    TEST_ASSERT(edited > 0, "The fills should change the saved world");
+
+    int undone = e_Undo(map);
+    TEST_ASSERT(undone, "The region fill should undo");
+    undone = e_Undo(map);
+    TEST_ASSERT(undone, "The local fill should undo");
+    saved = SaveWorld(map, TEST_AFTER);
+    TEST_ASSERT(saved == 0, "Undone world should save");
+
+    // Parent tiles included, generation and edits derive them the same way
+    long after = diff_saves(map, TEST_BEFORE, TEST_AFTER);
+    TEST_ASSERT(after == 0, "Undo should give back the generated world byte for byte");
+
+    weu_ResetUndo();
+    wea_ResetSummaries();
+    wet_ResetThumbnails();
+    free_world(map, (map->world_width * map->world_height),
+                    (map->region_width * map->region_height));
+    map = NULL;
+
+    remove(TEST_BEFORE);
+    remove(TEST_EDITED);
+    remove(TEST_AFTER);
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_DEBUG,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    g_InitJobs(0);
+
+    TEST_SUITE_START("World Editor Undo Tests");
+
+    RUN_TEST(test_undo_restores_generated_world);
+
+    g_ShutdownJobs();
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
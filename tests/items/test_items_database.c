@@ -0,0 +1,393 @@
+// ASCIIGame/tests/items/test_items_database.c
+// Test file for the JSON item database and its compiled binary cache.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "item_db.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <utime.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST_SOURCE "test_items_database.json"
+#define TEST_CACHE  "test_items_database.cache"
+#define TEST_SAVED  "test_items_database_saved.json"
+
+static int healed = 0;
+
+static void heal(uint8_t value)
+{
+    healed += value;
+}
+
+static void write_file(const char* path, const char* text)
+{
+    FILE* file = fopen(path, "w");
+    fputs(text, file);
+    fclose(file);
+}
+
+// Moves the file's modification time so the cache sees it as changed
+static void touch_file(const char* path, time_t mtime)
+{
+    struct utimbuf times = { mtime, mtime };
+    utime(path, &times);
+}
+
+static const char* test_items =
+    "[\n"
+    "  {\n"
+    "    \"type\": \"weapon\",\n"
+    "    \"id\": \"iron_sword\",\n"
+    "    \"name\": \"Iron Sword\",\n"
+    "    \"glyph\": \"/\",\n"
+    "    \"material\": \"iron\",\n"
+    "    \"min_damage\": 10,\n"
+    "    \"max_damage\": 20,\n"
+    "    \"range_tiles\": 0,\n"
+    "    \"comment\": { \"unknown\": [ 1, true, null ] }\n"
+    "  },\n"
+    "  {\n"
+    "    \"type\": \"armor\",\n"
+    "    \"id\": \"leather_armor\",\n"
+    "    \"name\": \"Leather \\\"Armor\\\"\",\n"
+    "    \"glyph\": \"[\",\n"
+    "    \"material\": \"leather\",\n"
+    "    \"material_properties\": { \"weight_fact\": 0.5, \"stealth_value_fact\": 1.25 },\n"
+    "    \"armor_value\": 5,\n"
+    "    \"evasion_value\": 3\n"
+    "  },\n"
+    "  {\n"
+    "    \"type\": \"key\",\n"
+    "    \"id\": \"cellar_key\",\n"
+    "    \"name\": \"Cellar Key\",\n"
+    "    \"glyph\": \"k\",\n"
+    "    \"lock_name\": \"Cellar Door\",\n"
+    "    \"lock_description\": \"A heavy door\",\n"
+    "    \"pick_difficulty\": 10\n"
+    "  },\n"
+    "  {\n"
+    "    \"type\": \"consumable\",\n"
+    "    \"id\": \"healing_potion\",\n"
+    "    \"name\": \"Healing Potion\",\n"
+    "    \"glyph\": \"!\",\n"
+    "    \"effect\": \"heal\",\n"
+    "    \"value\": 7\n"
+    "  },\n"
+    "  {\n"
+    "    \"type\": \"ammunition\",\n"
+    "    \"id\": \"iron_arrows\",\n"
+    "    \"name\": \"Iron Arrows\",\n"
+    "    \"glyph\": \"^\",\n"
+    "    \"material\": \"iron\",\n"
+    "    \"min_damage\": 2,\n"
+    "    \"max_damage\": 4\n"
+    "  }\n"
+    "]\n";
+
+// =============================================================================
+// LOADING TESTS
+// =============================================================================
+
+int test_load_source(void)
+{
+    int count;
+
+    remove(TEST_CACHE);
+    write_file(TEST_SOURCE, test_items);
+
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Five items should be loaded");
+    TEST_ASSERT(!is_item_database_cached(), "First load should parse the source");
+
+    const ItemDef_t* sword = find_item_def("iron_sword");
+    TEST_ASSERT(sword != NULL, "Sword should be found");
+    TEST_ASSERT(sword->type == ITEM_TYPE_WEAPON, "Sword should be a weapon");
+    TEST_ASSERT(sword->data.weapon.max_damage == 20, "Sword max damage should be read");
+    TEST_ASSERT(sword->glyph == '/', "Sword glyph should be read");
+
+    const ItemDef_t* armor = find_item_def("leather_armor");
+    TEST_ASSERT(armor != NULL && strcmp(armor->name, "Leather \"Armor\"") == 0, "Escapes should be decoded");
+    TEST_ASSERT(armor->material_properties.weight_fact == 0.5f, "Listed factor should be read");
+    TEST_ASSERT(armor->material_properties.durability_fact == 1.0f, "Missing factor should stay neutral");
+
+    TEST_ASSERT(find_item_def("mithril_sword") == NULL, "Unknown id should not be found");
+
+    // Definitions are kept sorted by id
+    bool sorted = true;
+    for (uint32_t i = 1; i < get_item_def_count(); i++) {
+        if (strcmp(get_item_def(i - 1)->id, get_item_def(i)->id) >= 0) {
+            sorted = false;
+        }
+    }
+    TEST_ASSERT(sorted, "Definitions should be sorted by id");
+    TEST_ASSERT(get_item_def(get_item_def_count()) == NULL, "Index past the end should be NULL");
+    return 1;
+}
+
+int test_cache_reuse_and_rebuild(void)
+{
+    int count;
+
+    // The cache written by the last test is mapped as is
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Cache should hold five items");
+    TEST_ASSERT(is_item_database_cached(), "Unchanged source should use the cache");
+    TEST_ASSERT(find_item_def("cellar_key")->data.key.pick_difficulty == 10, "Mapped definitions should be readable");
+
+    // A changed source is parsed again and the cache rewritten
+    touch_file(TEST_SOURCE, time(NULL) - 60);
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Touched source should load");
+    TEST_ASSERT(!is_item_database_cached(), "Touched source should be parsed");
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Rebuilt cache should load");
+    TEST_ASSERT(is_item_database_cached(), "Rebuilt cache should be used");
+
+    // Without the source the cache still works
+    remove(TEST_SOURCE);
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Cache should load without source");
+
+    write_file(TEST_SOURCE, test_items);
+    return 1;
+}
+
+int test_malformed_source(void)
+{
+    int count;
+
+    const char* bad_sources[] = {
+        "[ { \"id\": \"no_type\", \"name\": \"No Type\" } ]",
+        "[ { \"type\": \"wand\", \"id\": \"wand\", \"name\": \"Wand\" } ]",
+        "[ { \"type\": \"weapon\", \"id\": \"big\", \"name\": \"Big\", \"max_damage\": 300 } ]",
+        "[ { \"type\": \"weapon\", \"name\": \"No Id\" } ]",
+        "[ { \"type\": \"weapon\", \"id\": \"a\", \"name\": \"A\" }, { \"type\": \"armor\", \"id\": \"a\", \"name\": \"A\" } ]",
+        "[ { \"type\": \"weapon\", \"id\": \"open\", \"name\": \"Open\" ",
+        "[ { \"type\": \"weapon\", \"id\": \"a\", \"name\": \"A\" } ] trailing"
+    };
+
+    for (size_t i = 0; i < sizeof(bad_sources) / sizeof(bad_sources[0]); i++) {
+        write_file(TEST_SOURCE, bad_sources[i]);
+        touch_file(TEST_SOURCE, time(NULL) - 120 - (time_t)i);
+        count = load_item_database(TEST_SOURCE, TEST_CACHE);
+        TEST_ASSERT(count == -1, "Malformed source should fail to load");
+        TEST_ASSERT(get_item_def_count() == 0, "Failed load should leave no definitions");
+    }
+
+    write_file(TEST_SOURCE, "[]");
+    touch_file(TEST_SOURCE, time(NULL) - 200);
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 0, "Empty array should load nothing");
+    count = load_item_database("missing_items.json", NULL);
+    TEST_ASSERT(count == -1, "Missing source should fail");
+
+    write_file(TEST_SOURCE, test_items);
+    touch_file(TEST_SOURCE, time(NULL) - 300);
+    count = load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(count == 5, "Restored source should compile");
+    return 1;
+}
+
+// =============================================================================
+// EDITING & SAVING TESTS
+// =============================================================================
+
+int test_edit_and_save(void)
+{
+    bool ok;
+
+    load_item_database(TEST_SOURCE, TEST_CACHE);
+    TEST_ASSERT(is_item_database_cached(), "Edits should start from the mapped cache");
+
+    ItemDef_t bolts = *find_item_def("iron_arrows");
+    strcpy(bolts.id, "iron_bolts");
+    strcpy(bolts.name, "Iron Bolts");
+    bolts.data.ammo.max_damage = 6;
+
+    ok = set_item_def(&bolts);
+    TEST_ASSERT(ok, "New definition should be added");
+    TEST_ASSERT(!is_item_database_cached(), "Editing should copy the cache out");
+    TEST_ASSERT(get_item_def_count() == 6, "Count should grow");
+    TEST_ASSERT(find_item_def("iron_bolts")->data.ammo.max_damage == 6, "Added definition should be found");
+
+    ItemDef_t sword = *find_item_def("iron_sword");
+    sword.data.weapon.min_damage = 12;
+    ok = set_item_def(&sword);
+    TEST_ASSERT(ok, "Existing definition should be replaced");
+    TEST_ASSERT(get_item_def_count() == 6, "Replacing should not grow the count");
+
+    ok = remove_item_def("healing_potion");
+    TEST_ASSERT(ok, "Definition should be removed");
+    ok = remove_item_def("healing_potion");
+    TEST_ASSERT(!ok, "Removed definition should be gone");
+
+    ItemDef_t invalid = { 0 };
+    ok = set_item_def(&invalid);
+    TEST_ASSERT(!ok, "Definition with no id should be rejected");
+    ok = set_item_def(NULL);
+    TEST_ASSERT(!ok, "NULL definition should be rejected");
+
+    ok = save_item_database(TEST_SAVED);
+    TEST_ASSERT(ok, "Database should be saved");
+
+    // What was saved loads back the same
+    ItemDef_t saved[8];
+    int count = (int)get_item_def_count();
+    for (int i = 0; i < count; i++) {
+        saved[i] = *get_item_def(i);
+    }
+
+    int loaded = load_item_database(TEST_SAVED, NULL);
+    TEST_ASSERT(loaded == count, "Saved file should load");
+
+    bool same = true;
+    for (int i = 0; i < count; i++) {
+        const ItemDef_t* def = get_item_def(i);
+        if (strcmp(def->id, saved[i].id) != 0 || strcmp(def->name, saved[i].name) != 0 ||
+            def->type != saved[i].type || def->glyph != saved[i].glyph ||
+            memcmp(&def->material_properties, &saved[i].material_properties, sizeof(MaterialProperties_t)) != 0 ||
+            memcmp(&def->data, &saved[i].data, sizeof(def->data)) != 0) {
+            same = false;
+        }
+    }
+    TEST_ASSERT(same, "Saved definitions should round trip");
+    TEST_ASSERT(find_item_def("iron_sword")->data.weapon.min_damage == 12, "Edit should be saved");
+
+    remove(TEST_SAVED);
+    return 1;
+}
+
+// =============================================================================
+// ITEM CREATION TESTS
+// =============================================================================
+
+int test_create_from_def(void)
+{
+    bool ok;
+
+    load_item_database(TEST_SOURCE, TEST_CACHE);
+
+    Item_t* sword = create_item_from_def(find_item_def("iron_sword"));
+    TEST_ASSERT(sword != NULL && is_weapon(sword), "Sword should be created");
+    TEST_ASSERT(strcmp(sword->id->str, "iron_sword") == 0, "Sword should carry its id");
+    TEST_ASSERT(sword->material_data.name_atom == find_interned_string("iron"), "Sword should be iron");
+
+    Item_t* armor = create_item_from_def(find_item_def("leather_armor"));
+    TEST_ASSERT(armor != NULL && is_armor(armor), "Armor should be created");
+
+    Item_t* key = create_item_from_def(find_item_def("cellar_key"));
+    Lock_t door = create_lock("Cellar Door", "A heavy door", 10, 0);
+    TEST_ASSERT(key != NULL && can_key_open_lock(key, &door), "Key should open its lock");
+
+    Item_t* arrows = create_item_from_def(find_item_def("iron_arrows"));
+    TEST_ASSERT(arrows != NULL && is_ammunition(arrows), "Arrows should be created");
+
+    const ItemDef_t* potion_def = find_item_def("healing_potion");
+    TEST_ASSERT(create_item_from_def(potion_def) == NULL, "Unregistered effect should fail");
+
+    ok = register_item_effect("heal", heal);
+    TEST_ASSERT(ok, "Effect should be registered");
+    Item_t* potion = create_item_from_def(potion_def);
+    TEST_ASSERT(potion != NULL && is_consumable(potion), "Potion should be created");
+    potion->data.consumable.on_consume(potion->data.consumable.value);
+    TEST_ASSERT(healed == 7, "Potion should call its registered effect");
+
+    TEST_ASSERT(create_item_from_def(NULL) == NULL, "NULL definition should fail");
+
+    destroy_item(sword);
+    destroy_item(armor);
+    destroy_item(key);
+    destroy_item(arrows);
+    destroy_item(potion);
+    destroy_lock(&door);
+    return 1;
+}
+
+// =============================================================================
+// LARGE DATABASE
+// =============================================================================
+
+int test_large_database(void)
+{
+    enum { ITEM_COUNT = 5000 };
+
+    FILE* file = fopen(TEST_SOURCE, "w");
+    fprintf(file, "[\n");
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        fprintf(file, "  { \"type\": \"weapon\", \"id\": \"sword_%05d\", \"name\": \"Sword %d\", "
+                      "\"glyph\": \"/\", \"material\": \"iron\", \"min_damage\": %d, \"max_damage\": %d }%s\n",
+                i, i, i % 200, i % 200 + 10, i + 1 < ITEM_COUNT ? "," : "");
+    }
+    fprintf(file, "]\n");
+    fclose(file);
+    touch_file(TEST_SOURCE, time(NULL) - 400);
+
+    clock_t start = clock();
+    int compiled = load_item_database(TEST_SOURCE, TEST_CACHE);
+    double compile_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+    start = clock();
+    int mapped = load_item_database(TEST_SOURCE, TEST_CACHE);
+    double map_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+    TEST_ASSERT(compiled == ITEM_COUNT && mapped == ITEM_COUNT, "Every definition should load");
+    TEST_ASSERT(is_item_database_cached(), "Second load should map the cache");
+    TEST_ASSERT(find_item_def("sword_04321")->data.weapon.min_damage == 4321 % 200, "Lookup should find the right sword");
+
+    d_LogInfoF("%d item definitions: parse and compile %.2f ms, mapped cache %.2f ms",
+               ITEM_COUNT, compile_ms, map_ms);
+
+    destroy_item_database();
+    TEST_ASSERT(get_item_def_count() == 0, "Destroy should empty the database");
+
+    remove(TEST_SOURCE);
+    remove(TEST_CACHE);
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_INFO,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item Database Tests");
+
+    RUN_TEST(test_load_source);
+    RUN_TEST(test_cache_reuse_and_rebuild);
+    RUN_TEST(test_malformed_source);
+    RUN_TEST(test_edit_and_save);
+    RUN_TEST(test_create_from_def);
+    RUN_TEST(test_large_database);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
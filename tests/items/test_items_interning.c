@@ -0,0 +1,204 @@
+// ASCIIGame/tests/items/test_items_interning.c
+// Test file for the string interning table behind item names, ids, rarities and materials.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+// =============================================================================
+// ATOM TESTS
+// =============================================================================
+
+int test_intern_atoms(void)
+{
+    uint32_t iron = intern_string("iron");
+    uint32_t steel = intern_string("steel");
+    char iron_copy[] = "iron";
+
+    TEST_ASSERT(iron != ATOM_NONE && steel != ATOM_NONE, "Strings should get atoms");
+    TEST_ASSERT(iron != steel, "Different strings should get different atoms");
+    TEST_ASSERT(intern_string(iron_copy) == iron, "Equal strings should get the same atom");
+    TEST_ASSERT(strcmp(get_interned_string(iron), "iron") == 0, "Atom should resolve to its text");
+
+    TEST_ASSERT(find_interned_string("steel") == steel, "Lookup should find an interned string");
+    uint32_t count = get_interned_string_count();
+    TEST_ASSERT(find_interned_string("mithril") == ATOM_NONE, "Lookup should not find a new string");
+    TEST_ASSERT(get_interned_string_count() == count, "Lookup should not intern");
+
+    TEST_ASSERT(intern_string(NULL) == ATOM_NONE, "NULL should not be interned");
+    TEST_ASSERT(find_interned_string(NULL) == ATOM_NONE, "NULL should not be found");
+    TEST_ASSERT(get_interned_string(ATOM_NONE) == NULL, "ATOM_NONE should have no text");
+    TEST_ASSERT(get_interned_string(count + 100) == NULL, "Unknown atom should have no text");
+    return 1;
+}
+
+int test_intern_growth(void)
+{
+    enum { STRING_COUNT = 5000 };
+    static uint32_t atoms[STRING_COUNT];
+    char buffer[32];
+
+    for (int i = 0; i < STRING_COUNT; i++) {
+        snprintf(buffer, sizeof(buffer), "loot_%d", i);
+        atoms[i] = intern_string(buffer);
+    }
+
+    // Atoms handed out before the table grew must still resolve the same way
+    bool stable = true;
+    for (int i = 0; i < STRING_COUNT; i++) {
+        snprintf(buffer, sizeof(buffer), "loot_%d", i);
+        if (find_interned_string(buffer) != atoms[i] ||
+            strcmp(get_interned_string(atoms[i]), buffer) != 0) {
+            stable = false;
+            break;
+        }
+    }
+
+    TEST_ASSERT(stable, "Atoms should survive the table growing");
+    return 1;
+}
+
+// =============================================================================
+// ITEM STRING TESTS
+// =============================================================================
+
+int test_item_strings_shared(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+
+    Item_t* first = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    Item_t* second = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    TEST_ASSERT(first != NULL && second != NULL, "Swords should be created");
+
+    TEST_ASSERT(first->id_atom == second->id_atom, "Same id should give the same atom");
+    TEST_ASSERT(first->name == second->name, "Same name should share one string");
+    TEST_ASSERT(first->description == second->description, "Same description should share one string");
+    TEST_ASSERT(first->rarity_atom == intern_string("common"), "Rarity should be the common atom");
+    TEST_ASSERT(first->material_data.name_atom == iron.name_atom, "Material atom should match the material");
+
+    // Creating more of an existing item adds no strings
+    uint32_t count = get_interned_string_count();
+    for (int i = 0; i < 100; i++) {
+        destroy_item(create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/'));
+    }
+    TEST_ASSERT(get_interned_string_count() == count, "Repeated items should not intern new strings");
+
+    // Truncated ids are interned truncated
+    char long_id[80];
+    memset(long_id, 'x', sizeof(long_id) - 1);
+    long_id[sizeof(long_id) - 1] = '\0';
+    Item_t* long_item = create_weapon("Long Sword", long_id, iron, 1, 2, 0, '/');
+    TEST_ASSERT(long_item != NULL, "Item with a long id should be created");
+    TEST_ASSERT(strlen(get_interned_string(long_item->id_atom)) < strlen(long_id), "Long id should be truncated");
+
+    // Destroying one item leaves the shared strings to the other
+    destroy_item(first);
+    TEST_ASSERT(strcmp(second->name->str, "Iron Sword") == 0, "Shared name should outlive the first sword");
+
+    destroy_item(second);
+    destroy_item(long_item);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_atom_comparisons(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+
+    Item_t* arrows = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+    Item_t* bolts = create_ammunition("Iron Bolts", "iron_bolts", iron, 3, 5, '^');
+    Item_t* more_arrows = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+
+    TEST_ASSERT(can_stack_items(arrows, more_arrows), "Same id should stack");
+    TEST_ASSERT(!can_stack_items(arrows, bolts), "Different ids should not stack");
+
+    Inventory_t* inventory = create_inventory(4);
+    add_item_to_inventory(inventory, arrows, 20);
+    add_item_to_inventory(inventory, bolts, 10);
+
+    TEST_ASSERT(find_item_in_inventory(inventory, "iron_bolts") != NULL, "Bolts should be found");
+    TEST_ASSERT(find_item_in_inventory(inventory, "never_interned_id") == NULL, "Unknown id should not be found");
+    TEST_ASSERT(remove_item_from_inventory(inventory, "iron_arrows", 5), "Arrows should be removed");
+    TEST_ASSERT(find_item_in_inventory(inventory, "iron_arrows")->quantity == 15, "Fifteen arrows should remain");
+    TEST_ASSERT(!remove_item_from_inventory(inventory, "never_interned_id", 1), "Unknown id should not be removed");
+
+    Lock_t door = create_lock("Cellar Door", "A heavy door", 10, 0);
+    Lock_t gate = create_lock("Garden Gate", "A small gate", 10, 0);
+    Item_t* key = create_key("Cellar Key", "cellar_key", door, 'k');
+
+    TEST_ASSERT(door.name_atom == find_interned_string("Cellar Door"), "Lock should carry its name atom");
+    TEST_ASSERT(can_key_open_lock(key, &door), "Key should open its lock");
+    TEST_ASSERT(!can_key_open_lock(key, &gate), "Key should not open another lock");
+
+    destroy_inventory(inventory);
+    destroy_item(arrows);
+    destroy_item(bolts);
+    destroy_item(more_arrows);
+    destroy_item(key);
+    destroy_lock(&door);
+    destroy_lock(&gate);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_destroy_interned_strings(void)
+{
+    TEST_ASSERT(get_interned_string_count() > 0, "Earlier tests should have interned strings");
+
+    destroy_interned_strings();
+    TEST_ASSERT(get_interned_string_count() == 0, "Table should be empty after destroy");
+    TEST_ASSERT(find_interned_string("iron") == ATOM_NONE, "Old strings should be gone");
+
+    uint32_t atom = intern_string("iron");
+    TEST_ASSERT(atom != ATOM_NONE, "Table should be usable again after destroy");
+    TEST_ASSERT(strcmp(get_interned_string(atom), "iron") == 0, "New atom should resolve");
+
+    destroy_interned_strings();
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_INFO,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item String Interning Tests");
+
+    RUN_TEST(test_intern_atoms);
+    RUN_TEST(test_intern_growth);
+    RUN_TEST(test_item_strings_shared);
+    RUN_TEST(test_atom_comparisons);
+    RUN_TEST(test_destroy_interned_strings);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
@@ -0,0 +1,172 @@
+// ASCIIGame/tests/items/test_items_logging.c
+// Test file for items.c built with ITEMS_LOG_LEVEL=D_LOG_LEVEL_ERROR, where lower logging is compiled out.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define GETTER_CALLS 10000000
+
+// Results are summed here so the timed loops can't be optimized away
+static volatile uint32_t sink;
+
+// Every message that reaches the logger, whatever its level
+static int logged_count = 0;
+
+static void count_log_handler(const dLogEntry_t* entry, void* user_data)
+{
+    (void)entry;
+    (void)user_data;
+    logged_count++;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static double ns_per_call(double start, double end)
+{
+    return (end - start) * 1e9 / GETTER_CALLS;
+}
+
+// =============================================================================
+// ELISION TESTS
+// =============================================================================
+
+int test_low_levels_compiled_out(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    Inventory_t* inventory = create_inventory(4);
+    TEST_ASSERT(sword != NULL && inventory != NULL, "Sword and inventory should be created");
+
+    // The logger takes DEBUG, so only the compile time level can drop these
+    logged_count = 0;
+    for (int i = 0; i < 100; i++) {
+        sink = calculate_final_value(sword) + get_durability(sword) + is_weapon(sword);
+        sink = calculate_final_value(NULL) + get_durability(NULL) + is_weapon(NULL);
+        sink = (find_item_in_inventory(inventory, "iron_sword") == NULL);
+    }
+    int low_count = logged_count;
+    TEST_ASSERT(low_count == 0, "Debug and warning messages should be compiled out");
+
+    // Errors are kept, which shows the hook does see what items.c logs
+    logged_count = 0;
+    apply_material_to_weapon(NULL);
+    int error_count = logged_count;
+    TEST_ASSERT(error_count > 0, "Error messages should still be logged");
+
+    destroy_inventory(inventory);
+    destroy_item(sword);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+// =============================================================================
+// GETTER TESTS
+// =============================================================================
+
+int test_getters_match_fields(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    TEST_ASSERT(sword != NULL, "Sword should be created");
+
+    TEST_ASSERT(calculate_final_weight(sword) == sword->weight_kg, "Weight getter should return the field");
+    TEST_ASSERT(calculate_final_value(sword) == sword->value_coins, "Value getter should return the field");
+    TEST_ASSERT(is_weapon(sword), "Sword should be a weapon");
+    TEST_ASSERT(!is_armor(sword), "Sword should not be armor");
+    TEST_ASSERT(get_durability(sword) == sword->data.weapon.durability, "Durability getter should return the field");
+
+    // NULL checks must survive the logging around them being compiled out
+    TEST_ASSERT(calculate_final_weight(NULL) == 0.0f, "NULL item should weigh nothing");
+    TEST_ASSERT(calculate_final_value(NULL) == 0, "NULL item should be worth nothing");
+    TEST_ASSERT(!is_weapon(NULL), "NULL item should not be a weapon");
+    TEST_ASSERT(get_durability(NULL) == 0, "NULL item should have no durability");
+
+    destroy_item(sword);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_getter_cost(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    TEST_ASSERT(sword != NULL, "Sword should be created");
+
+    uint32_t sum = 0;
+    double start = now_seconds();
+    for (int i = 0; i < GETTER_CALLS; i++) {
+        sum += sword->value_coins + sword->data.weapon.durability + (sword->type == ITEM_TYPE_WEAPON);
+        sum += (uint32_t)sword->weight_kg;
+    }
+    double field_ns = ns_per_call(start, now_seconds()) / 4.0;
+    sink = sum;
+
+    sum = 0;
+    start = now_seconds();
+    for (int i = 0; i < GETTER_CALLS; i++) {
+        sum += calculate_final_value(sword) + get_durability(sword) + is_weapon(sword);
+        sum += (uint32_t)calculate_final_weight(sword);
+    }
+    double getter_ns = ns_per_call(start, now_seconds()) / 4.0;
+    sink = sum;
+
+    // Timing is only reported, it depends too much on the machine to assert on
+    printf("    %d calls: field read %.2f ns, getter %.2f ns\n", GETTER_CALLS * 4, field_ns, getter_ns);
+    TEST_ASSERT(sink == sum, "Getter loop should have run");
+
+    destroy_item(sword);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_DEBUG,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    d_AddLogHandler(d_GetGlobalLogger(), count_log_handler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item Logging Elision Tests");
+
+    RUN_TEST(test_low_levels_compiled_out);
+    RUN_TEST(test_getters_match_fields);
+    RUN_TEST(test_getter_cost);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
@@ -0,0 +1,326 @@
+// ASCIIGame/tests/items/test_items_materials.c
+// Test file for the material registry and applying materials to arrays of items.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define LOOT_TABLE_SIZE 10000
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static MaterialProperties_t make_properties(float weight, float value, float damage, float armor)
+{
+    MaterialProperties_t properties = create_default_material_properties();
+    properties.weight_fact = weight;
+    properties.value_coins_fact = value;
+    properties.min_damage_fact = damage;
+    properties.max_damage_fact = damage;
+    properties.armor_value_fact = armor;
+    properties.evasion_value_fact = 0.9f;
+    properties.durability_fact = 0.8f;
+    properties.stealth_value_fact = 0.5f;
+    properties.enchant_value_fact = 1.5f;
+    return properties;
+}
+
+static bool items_match(const Item_t* a, const Item_t* b)
+{
+    if (a->type != b->type || a->weight_kg != b->weight_kg || a->value_coins != b->value_coins) {
+        return false;
+    }
+
+    switch (a->type) {
+        case ITEM_TYPE_WEAPON:
+            return memcmp(&a->data.weapon, &b->data.weapon, sizeof(a->data.weapon)) == 0;
+        case ITEM_TYPE_ARMOR:
+            return memcmp(&a->data.armor, &b->data.armor, sizeof(a->data.armor)) == 0;
+        case ITEM_TYPE_AMMUNITION:
+            return memcmp(&a->data.ammo, &b->data.ammo, sizeof(a->data.ammo)) == 0;
+        default:
+            return true;
+    }
+}
+
+// Each kind of loot the table is generated from, cycled through by index
+static Item_t* create_loot(Material_t material, int index)
+{
+    switch (index % 3) {
+        case 0:
+            return create_weapon("Sword", "loot_sword", material, 10, 20, 0, '/');
+        case 1:
+            return create_armor("Mail", "loot_mail", material, 30, 10, '[', 20, 10);
+        default:
+            return create_ammunition("Arrows", "loot_arrows", material, 4, 8, '^');
+    }
+}
+
+// =============================================================================
+// REGISTRY TESTS
+// =============================================================================
+
+int test_register_materials(void)
+{
+    uint8_t iron = register_material("iron", make_properties(1.5f, 1.2f, 1.1f, 1.3f));
+    uint8_t wood = register_material("wood", make_properties(0.5f, 0.8f, 0.9f, 0.7f));
+
+    TEST_ASSERT(iron != MATERIAL_NONE && wood != MATERIAL_NONE, "Materials should get ids");
+    TEST_ASSERT(iron != wood, "Different materials should get different ids");
+    TEST_ASSERT(find_material("iron") == iron, "Lookup should find a registered material");
+    TEST_ASSERT(find_material("mithril") == MATERIAL_NONE, "Lookup should not find an unregistered material");
+    TEST_ASSERT(get_material_count() == 2, "Two materials should be registered");
+
+    // Registering again replaces the factors in place
+    const MaterialProperties_t* iron_properties = get_material_properties(iron);
+    uint8_t again = register_material("iron", make_properties(2.0f, 1.2f, 1.1f, 1.3f));
+    TEST_ASSERT(again == iron, "Registering again should keep the id");
+    TEST_ASSERT(iron_properties->weight_fact == 2.0f, "Registering again should replace the factors");
+    TEST_ASSERT(get_material_count() == 2, "Registering again should not add a material");
+
+    TEST_ASSERT(register_material(NULL, create_default_material_properties()) == MATERIAL_NONE,
+                "NULL name should not be registered");
+    TEST_ASSERT(get_material_properties(MATERIAL_NONE) == NULL, "MATERIAL_NONE should have no factors");
+    TEST_ASSERT(get_material_properties(200) == NULL, "Unknown id should have no factors");
+    return 1;
+}
+
+int test_registry_full(void)
+{
+    char name[32];
+    uint8_t last = MATERIAL_NONE;
+
+    clear_material_registry();
+    TEST_ASSERT(get_material_count() == 0, "Registry should be empty after clear");
+
+    for (int i = 0; i < MAX_MATERIALS - 1; i++) {
+        snprintf(name, sizeof(name), "alloy_%d", i);
+        last = register_material(name, create_default_material_properties());
+    }
+
+    TEST_ASSERT(last == MAX_MATERIALS - 1, "Last material should get the highest id");
+    uint8_t overflow = register_material("one_too_many", create_default_material_properties());
+    TEST_ASSERT(overflow == MATERIAL_NONE, "Full registry should refuse a new material");
+    TEST_ASSERT(register_material("alloy_3", create_default_material_properties()) != MATERIAL_NONE,
+                "Full registry should still replace a known material");
+
+    clear_material_registry();
+    return 1;
+}
+
+int test_get_material(void)
+{
+    uint8_t iron = register_material("iron", make_properties(1.5f, 1.2f, 1.1f, 1.3f));
+
+    Material_t material = get_material(iron);
+    TEST_ASSERT(material.id == iron, "Material should carry its id");
+    TEST_ASSERT(material.name_atom == find_interned_string("iron"), "Material should carry its name atom");
+    TEST_ASSERT(strcmp(material.name->str, "iron") == 0, "Material name should be the interned copy");
+    TEST_ASSERT(material.properties.weight_fact == 1.5f, "Material should carry its factors");
+
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", material, 10, 20, 0, '/');
+    TEST_ASSERT(sword != NULL, "Sword should be created from a registered material");
+    TEST_ASSERT(sword->material_data.id == iron, "Item should remember the material id");
+
+    Material_t unknown = get_material(200);
+    TEST_ASSERT(unknown.id == MATERIAL_NONE, "Unknown id should give the default material");
+    TEST_ASSERT(unknown.properties.weight_fact == 1.0f, "Default material should be neutral");
+
+    destroy_item(sword);
+    return 1;
+}
+
+// =============================================================================
+// BATCH APPLICATION TESTS
+// =============================================================================
+
+int test_batch_matches_single(void)
+{
+    Material_t steel = create_material("steel", make_properties(1.4f, 1.6f, 1.25f, 1.5f));
+    Item_t* single[4];
+    Item_t* batch[4];
+
+    for (int i = 0; i < 2; i++) {
+        Item_t** items = (i == 0) ? single : batch;
+        items[0] = create_weapon("Steel Sword", "steel_sword", steel, 10, 20, 1, '/');
+        items[1] = create_armor("Steel Mail", "steel_mail", steel, 30, 12, '[', 20, 10);
+        items[2] = create_ammunition("Steel Bolts", "steel_bolts", steel, 4, 8, '^');
+        items[3] = create_key("Steel Key", "steel_key", create_lock("Vault", "A vault door", 10, 0), 'k');
+    }
+
+    apply_material_to_weapon(single[0]);
+    apply_material_to_armor(single[1]);
+    apply_material_to_ammunition(single[2]);
+
+    uint32_t applied = apply_materials_to_items(batch, NULL, 4);
+    TEST_ASSERT(applied == 3, "Weapon, armor and ammunition should be modified, the key not");
+
+    bool match = true;
+    for (int i = 0; i < 4; i++) {
+        match = match && items_match(single[i], batch[i]);
+    }
+    TEST_ASSERT(match, "Batch should give the same stats as applying one item at a time");
+
+    TEST_ASSERT(apply_materials_to_items(NULL, NULL, 4) == 0, "NULL array should be ignored");
+
+    for (int i = 0; i < 4; i++) {
+        destroy_item(single[i]);
+        destroy_item(batch[i]);
+    }
+    d_DestroyString(steel.name);
+    return 1;
+}
+
+int test_batch_with_ids(void)
+{
+    uint8_t iron = register_material("iron", make_properties(1.5f, 1.2f, 1.1f, 1.3f));
+    uint8_t wood = register_material("wood", make_properties(0.5f, 0.8f, 0.9f, 0.7f));
+    Material_t plain = get_material(MATERIAL_NONE);
+
+    Item_t* items[3] = {
+        create_weapon("Club", "club", plain, 10, 20, 0, '/'),
+        create_weapon("Club", "club", plain, 10, 20, 0, '/'),
+        create_weapon("Club", "club", plain, 10, 20, 0, '/')
+    };
+    uint8_t ids[3] = { iron, wood, 250 };
+
+    uint32_t applied = apply_materials_to_items(items, ids, 3);
+    TEST_ASSERT(applied == 2, "Only items with a known id should be modified");
+
+    TEST_ASSERT(items[0]->material_data.id == iron, "First club should be iron");
+    TEST_ASSERT(items[0]->material_data.name_atom == find_interned_string("iron"), "First club should carry the iron atom");
+    TEST_ASSERT(items[0]->data.weapon.min_damage == 11, "Iron should raise damage");
+    TEST_ASSERT(items[1]->material_data.id == wood, "Second club should be wood");
+    TEST_ASSERT(items[1]->weight_kg == 0.5f, "Wood should halve the weight");
+    TEST_ASSERT(items[2]->material_data.id == MATERIAL_NONE, "Unknown id should leave the material");
+    TEST_ASSERT(items[2]->data.weapon.min_damage == 10, "Unknown id should leave the stats");
+
+    for (int i = 0; i < 3; i++) {
+        destroy_item(items[i]);
+    }
+    return 1;
+}
+
+int test_loot_table(void)
+{
+    static Item_t* single[LOOT_TABLE_SIZE];
+    static Item_t* batch[LOOT_TABLE_SIZE];
+    static uint8_t ids[LOOT_TABLE_SIZE];
+
+    uint8_t materials[4] = {
+        register_material("iron", make_properties(1.5f, 1.2f, 1.1f, 1.3f)),
+        register_material("wood", make_properties(0.5f, 0.8f, 0.9f, 0.7f)),
+        register_material("steel", make_properties(1.4f, 1.6f, 1.25f, 1.5f)),
+        register_material("bone", make_properties(0.7f, 0.5f, 0.8f, 0.6f))
+    };
+
+    // Both tables are made from the same registered materials, only applying is timed
+    for (int i = 0; i < LOOT_TABLE_SIZE; i++) {
+        ids[i] = materials[i % 4];
+        single[i] = create_loot(get_material(ids[i]), i);
+        batch[i] = create_loot(get_material(ids[i]), i);
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < LOOT_TABLE_SIZE; i++) {
+        switch (single[i]->type) {
+            case ITEM_TYPE_WEAPON:
+                apply_material_to_weapon(single[i]);
+                break;
+            case ITEM_TYPE_ARMOR:
+                apply_material_to_armor(single[i]);
+                break;
+            default:
+                apply_material_to_ammunition(single[i]);
+                break;
+        }
+    }
+    double single_ms = (now_seconds() - start) * 1000.0;
+
+    start = now_seconds();
+    uint32_t applied = apply_materials_to_items(batch, NULL, LOOT_TABLE_SIZE);
+    double batch_ms = (now_seconds() - start) * 1000.0;
+
+    printf("    %d items: one at a time %.2f ms, batch %.2f ms\n", LOOT_TABLE_SIZE, single_ms, batch_ms);
+
+    TEST_ASSERT(applied == LOOT_TABLE_SIZE, "Every loot item should be modified");
+
+    bool match = true;
+    for (int i = 0; i < LOOT_TABLE_SIZE && match; i++) {
+        match = items_match(single[i], batch[i]) &&
+                single[i]->material_data.name_atom == batch[i]->material_data.name_atom;
+    }
+    TEST_ASSERT(match, "Batch loot should match loot made one item at a time");
+
+    for (int i = 0; i < LOOT_TABLE_SIZE; i++) {
+        destroy_item(single[i]);
+        destroy_item(batch[i]);
+    }
+    return 1;
+}
+
+int test_registry_cleared_with_strings(void)
+{
+    register_material("iron", create_default_material_properties());
+    TEST_ASSERT(get_material_count() > 0, "Earlier tests should have registered materials");
+
+    destroy_interned_strings();
+    TEST_ASSERT(get_material_count() == 0, "Destroying interned strings should clear the registry");
+    TEST_ASSERT(find_material("iron") == MATERIAL_NONE, "Old materials should be gone");
+
+    destroy_interned_strings();
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_WARNING,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item Material Registry Tests");
+
+    RUN_TEST(test_register_materials);
+    RUN_TEST(test_registry_full);
+    RUN_TEST(test_get_material);
+    RUN_TEST(test_batch_matches_single);
+    RUN_TEST(test_batch_with_ids);
+    RUN_TEST(test_loot_table);
+    RUN_TEST(test_registry_cleared_with_strings);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
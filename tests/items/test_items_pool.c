@@ -0,0 +1,289 @@
+// ASCIIGame/tests/items/test_items_pool.c
+// Test file for item pools, slab allocation and bulk release of items.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+// =============================================================================
+// POOL ALLOCATION TESTS
+// =============================================================================
+
+int test_pool_allocation(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    ItemPool_t* pool = create_item_pool();
+    TEST_ASSERT(pool != NULL, "Pool should be created");
+    TEST_ASSERT(get_item_pool_count(pool) == 0, "New pool should be empty");
+
+    ItemPool_t* previous = set_item_pool(pool);
+    TEST_ASSERT(previous == NULL, "No pool should have been set before");
+
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    Item_t* arrows = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+    TEST_ASSERT(sword != NULL && arrows != NULL, "Items should be created from the pool");
+    TEST_ASSERT(sword->pool == pool && arrows->pool == pool, "Items should know their pool");
+    TEST_ASSERT(get_item_pool_count(pool) == 2, "Pool should count two items");
+
+    // A destroyed item's slot is handed out again
+    destroy_item(sword);
+    TEST_ASSERT(get_item_pool_count(pool) == 1, "Destroy should give the item back");
+    Item_t* axe = create_weapon("Iron Axe", "iron_axe", iron, 12, 18, 0, '/');
+    TEST_ASSERT(axe == sword, "Freed slot should be reused");
+    TEST_ASSERT(strcmp(axe->name->str, "Iron Axe") == 0, "Reused slot should hold the new item");
+
+    set_item_pool(previous);
+    Item_t* heap_item = create_weapon("Iron Dagger", "iron_dagger", iron, 4, 6, 0, '/');
+    TEST_ASSERT(heap_item != NULL && heap_item->pool == NULL, "Restored NULL pool should malloc");
+    TEST_ASSERT(get_item_pool_count(pool) == 2, "Heap item should not count in the pool");
+
+    // Pool items still destroy normally after the pool is unset
+    destroy_item(heap_item);
+    destroy_item(axe);
+    destroy_item(arrows);
+    TEST_ASSERT(get_item_pool_count(pool) == 0, "Pool should be empty again");
+
+    destroy_item_pool(pool);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_pool_growth(void)
+{
+    enum { ITEM_COUNT = ITEM_POOL_SLAB_SIZE * 3 + 7 };
+    static Item_t* items[ITEM_COUNT];
+    Material_t iron = create_material("iron", create_default_material_properties());
+    ItemPool_t* pool = create_item_pool();
+    ItemPool_t* previous = set_item_pool(pool);
+
+    bool created = true;
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        items[i] = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+        if (items[i] == NULL || items[i]->pool != pool) {
+            created = false;
+        }
+    }
+    TEST_ASSERT(created, "Items past the first slab should come from new slabs");
+    TEST_ASSERT(get_item_pool_count(pool) == ITEM_COUNT, "Pool should count every item");
+
+    bool distinct = true;
+    for (int i = 1; i < ITEM_COUNT; i++) {
+        if (items[i] == items[i - 1]) {
+            distinct = false;
+        }
+    }
+    TEST_ASSERT(distinct, "Every item should get its own slot");
+
+    // Clearing keeps the slabs, so the same memory is carved again
+    Item_t* first = items[0];
+    clear_item_pool(pool);
+    TEST_ASSERT(get_item_pool_count(pool) == 0, "Clear should release every item");
+
+    Item_t* again = create_ammunition("Iron Bolts", "iron_bolts", iron, 3, 5, '^');
+    TEST_ASSERT(again == first, "Cleared pool should start from its first slab");
+    for (int i = 1; i < ITEM_COUNT; i++) {
+        items[i] = create_ammunition("Iron Bolts", "iron_bolts", iron, 3, 5, '^');
+    }
+    TEST_ASSERT(get_item_pool_count(pool) == ITEM_COUNT, "Cleared slabs should be refilled");
+
+    set_item_pool(previous);
+    destroy_item_pool(pool);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+// =============================================================================
+// POOL SCOPE TESTS
+// =============================================================================
+
+int test_pool_nesting(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    ItemPool_t* level = create_item_pool();
+    ItemPool_t* room = create_item_pool();
+
+    ItemPool_t* outer = set_item_pool(level);
+    Item_t* level_item = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+
+    ItemPool_t* inner = set_item_pool(room);
+    TEST_ASSERT(inner == level, "Setting a pool should return the one it replaces");
+    Item_t* room_item = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    set_item_pool(inner);
+
+    Item_t* level_item_2 = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    TEST_ASSERT(level_item->pool == level && level_item_2->pool == level, "Outer scope should use the level pool");
+    TEST_ASSERT(room_item->pool == room, "Inner scope should use the room pool");
+
+    // Destroying the current pool falls back to malloc
+    destroy_item_pool(level);
+    Item_t* heap_item = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    TEST_ASSERT(heap_item != NULL && heap_item->pool == NULL, "Destroyed current pool should not be used");
+    TEST_ASSERT(get_item_pool_count(room) == 1, "Room pool should be untouched");
+
+    destroy_item(heap_item);
+    destroy_item_pool(room);
+    set_item_pool(outer);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_pool_keys(void)
+{
+    ItemPool_t* pool = create_item_pool();
+    ItemPool_t* previous = set_item_pool(pool);
+
+    Lock_t door = create_lock("Cellar Door", "A heavy door", 10, 0);
+    Item_t* kept = create_key("Cellar Key", "cellar_key", door, 'k');
+    Item_t* destroyed = create_key("Spare Key", "spare_key", door, 'k');
+    TEST_ASSERT(kept != NULL && destroyed != NULL, "Keys should be created from the pool");
+    TEST_ASSERT(kept->data.key.lock.name != door.name, "Keys should own a copy of the lock name");
+    TEST_ASSERT(can_key_open_lock(kept, &door), "Pooled key should open its lock");
+
+    // The destroyed key frees its strings now, the kept one when the pool is cleared
+    destroy_item(destroyed);
+    clear_item_pool(pool);
+    TEST_ASSERT(get_item_pool_count(pool) == 0, "Clear should release the key");
+
+    set_item_pool(previous);
+    destroy_item_pool(pool);
+    destroy_lock(&door);
+    return 1;
+}
+
+int test_pool_dead_slots(void)
+{
+    Material_t iron = create_material("iron", create_default_material_properties());
+    ItemPool_t* pool = create_item_pool();
+    ItemPool_t* previous = set_item_pool(pool);
+
+    // Destroying twice must not put the slot on the free list twice
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", iron, 10, 20, 0, '/');
+    Item_t* arrows = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+    destroy_item(sword);
+    destroy_item(sword);
+    TEST_ASSERT(get_item_pool_count(pool) == 1, "Second destroy should be ignored");
+
+    Item_t* first = create_weapon("Iron Axe", "iron_axe", iron, 12, 18, 0, '/');
+    Item_t* second = create_weapon("Iron Axe", "iron_axe", iron, 12, 18, 0, '/');
+    TEST_ASSERT(first == sword && second != sword, "Destroyed slot should be handed out once");
+
+    // Items of a cleared pool are dead, destroying them must not reach free()
+    Lock_t door = create_lock("Cellar Door", "A heavy door", 10, 0);
+    Item_t* key = create_key("Cellar Key", "cellar_key", door, 'k');
+    clear_item_pool(pool);
+    destroy_item(key);
+    destroy_item(arrows);
+    destroy_item(first);
+    TEST_ASSERT(get_item_pool_count(pool) == 0, "Destroy after clear should be ignored");
+
+    Item_t* again = create_ammunition("Iron Bolts", "iron_bolts", iron, 3, 5, '^');
+    TEST_ASSERT(again != NULL && get_item_pool_count(pool) == 1, "Cleared pool should still hand out items");
+
+    set_item_pool(previous);
+    destroy_item_pool(pool);
+    destroy_lock(&door);
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int test_pool_null_handling(void)
+{
+    clear_item_pool(NULL);
+    destroy_item_pool(NULL);
+    TEST_ASSERT(get_item_pool_count(NULL) == 0, "NULL pool should count no items");
+    TEST_ASSERT(set_item_pool(NULL) == NULL, "No pool should be set");
+    return 1;
+}
+
+// =============================================================================
+// THROUGHPUT
+// =============================================================================
+
+int test_pool_throughput(void)
+{
+    enum { ITEM_COUNT = 4096, ROUNDS = 50 };
+    static Item_t* items[ITEM_COUNT];
+    Material_t iron = create_material("iron", create_default_material_properties());
+
+    clock_t start = clock();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            items[i] = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+        }
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            destroy_item(items[i]);
+        }
+    }
+    double heap_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+    ItemPool_t* pool = create_item_pool();
+    ItemPool_t* previous = set_item_pool(pool);
+
+    start = clock();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            items[i] = create_ammunition("Iron Arrows", "iron_arrows", iron, 2, 4, '^');
+        }
+        clear_item_pool(pool);
+    }
+    double pool_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+    set_item_pool(previous);
+    destroy_item_pool(pool);
+
+    d_LogInfoF("%d items x %d rounds: malloc/destroy %.2f ms, pool/clear %.2f ms",
+               ITEM_COUNT, ROUNDS, heap_ms, pool_ms);
+
+    TEST_ASSERT(heap_ms >= 0.0 && pool_ms >= 0.0, "Both runs should complete");
+    d_DestroyString(iron.name);
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_INFO,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item Pool Tests");
+
+    RUN_TEST(test_pool_allocation);
+    RUN_TEST(test_pool_growth);
+    RUN_TEST(test_pool_nesting);
+    RUN_TEST(test_pool_keys);
+    RUN_TEST(test_pool_dead_slots);
+    RUN_TEST(test_pool_null_handling);
+    RUN_TEST(test_pool_throughput);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
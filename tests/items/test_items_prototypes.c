@@ -0,0 +1,277 @@
+// ASCIIGame/tests/items/test_items_prototypes.c
+// Test file for the item prototype registry and the small per item instances built on it.
+
+#include "tests.h"
+#include "Daedalus.h"
+#include "items.h"
+#include "structs.h"
+#include "defs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+
+// Global test counters (managed by tests.h)
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+// Helper function for float comparison
+static bool float_equals(float a, float b, float tolerance)
+{
+    return fabs(a - b) < tolerance;
+}
+
+// Material that never resists durability loss, keeps damage deterministic
+static Material_t create_brittle_material(void)
+{
+    MaterialProperties_t props = create_default_material_properties();
+    props.durability_fact = 0.0f;
+    return create_material("brittle", props);
+}
+
+// =============================================================================
+// PROTOTYPE REGISTRY TESTS
+// =============================================================================
+
+int test_prototype_registration(void)
+{
+    Material_t material = create_brittle_material();
+
+    Item_t* sword = create_weapon("Iron Sword", "iron_sword", material, 10, 20, 0, '/');
+    Item_t* arrows = create_ammunition("Iron Arrows", "iron_arrows", material, 2, 4, '^');
+    TEST_ASSERT(sword != NULL && arrows != NULL, "Prototype items should be created");
+
+    uint16_t sword_handle = register_item_prototype(sword);
+    uint16_t arrows_handle = register_item_prototype(arrows);
+
+    TEST_ASSERT(sword_handle != ITEM_PROTOTYPE_NONE, "Sword should register");
+    TEST_ASSERT(arrows_handle != ITEM_PROTOTYPE_NONE, "Arrows should register");
+    TEST_ASSERT(sword_handle != arrows_handle, "Handles should be unique");
+    TEST_ASSERT(get_item_prototype_count() == 2, "Registry should hold two prototypes");
+
+    TEST_ASSERT(get_item_prototype(sword_handle) == sword, "Handle should resolve to the registered item");
+    TEST_ASSERT(find_item_prototype("iron_arrows") == arrows_handle, "Lookup by id should find arrows");
+    TEST_ASSERT(find_item_prototype("steel_sword") == ITEM_PROTOTYPE_NONE, "Unknown id should not be found");
+    TEST_ASSERT(find_item_prototype(NULL) == ITEM_PROTOTYPE_NONE, "NULL id should not be found");
+
+    // A second definition under the same id is refused and stays with the caller
+    Item_t* duplicate = create_weapon("Other Sword", "iron_sword", material, 1, 2, 0, '/');
+    TEST_ASSERT(register_item_prototype(duplicate) == ITEM_PROTOTYPE_NONE, "Duplicate id should be refused");
+    TEST_ASSERT(get_item_prototype_count() == 2, "Refused prototype should not be counted");
+    destroy_item(duplicate);
+
+    TEST_ASSERT(register_item_prototype(NULL) == ITEM_PROTOTYPE_NONE, "NULL item should be refused");
+    TEST_ASSERT(get_item_prototype(ITEM_PROTOTYPE_NONE) == NULL, "NONE handle should resolve to NULL");
+
+    destroy_item_prototypes();
+    TEST_ASSERT(get_item_prototype_count() == 0, "Registry should be empty after destroy");
+    TEST_ASSERT(get_item_prototype(sword_handle) == NULL, "Old handles should not resolve after destroy");
+
+    d_DestroyString(material.name);
+    return 1;
+}
+
+// =============================================================================
+// INSTANCE TESTS
+// =============================================================================
+
+int test_instance_creation(void)
+{
+    Material_t material = create_brittle_material();
+
+    uint16_t armor = register_item_prototype(create_armor("Chain Mail", "chain_mail", material, 12, 4, '[', 0, 7));
+    uint16_t arrows = register_item_prototype(create_ammunition("Iron Arrows", "iron_arrows", material, 2, 4, '^'));
+    TEST_ASSERT(armor != ITEM_PROTOTYPE_NONE && arrows != ITEM_PROTOTYPE_NONE, "Prototypes should register");
+
+    TEST_ASSERT(sizeof(ItemInstance_t) <= 8, "Instances should only be a few bytes");
+
+    ItemInstance_t mail = create_item_instance(armor, 1);
+    TEST_ASSERT(mail.prototype == armor, "Instance should point at its prototype");
+    TEST_ASSERT(mail.durability == 255, "Instance should start at the prototype's durability");
+    TEST_ASSERT(mail.enchant_value == 7, "Instance should start at the prototype's enchant value");
+    TEST_ASSERT(mail.quantity == 1, "Instance should hold one chain mail");
+    TEST_ASSERT(get_instance_prototype(&mail) == get_item_prototype(armor), "Instance should resolve its prototype");
+
+    // Quantity is capped at what one stack can hold
+    ItemInstance_t many_mail = create_item_instance(armor, 5);
+    ItemInstance_t quiver = create_item_instance(arrows, 200);
+    TEST_ASSERT(many_mail.quantity == 1, "Non-stackable instance should hold one item");
+    TEST_ASSERT(quiver.quantity == 200, "Stackable instance should keep its quantity");
+    TEST_ASSERT(float_equals(get_item_instance_weight(&quiver), 200 * get_item_weight(get_item_prototype(arrows)), 0.001f),
+                "Instance weight should be prototype weight times quantity");
+
+    ItemInstance_t empty = create_item_instance(ITEM_PROTOTYPE_NONE, 1);
+    ItemInstance_t none = create_item_instance(arrows, 0);
+    TEST_ASSERT(empty.prototype == ITEM_PROTOTYPE_NONE, "Unregistered handle should give an empty instance");
+    TEST_ASSERT(none.prototype == ITEM_PROTOTYPE_NONE, "Zero quantity should give an empty instance");
+    TEST_ASSERT(get_instance_prototype(&empty) == NULL, "Empty instance should have no prototype");
+    TEST_ASSERT(get_instance_prototype(NULL) == NULL, "NULL instance should have no prototype");
+    TEST_ASSERT(float_equals(get_item_instance_weight(&empty), 0.0f, 0.001f), "Empty instance should weigh nothing");
+
+    destroy_item_prototypes();
+    d_DestroyString(material.name);
+    return 1;
+}
+
+int test_instance_durability(void)
+{
+    Material_t material = create_brittle_material();
+    Lock_t lock = create_lock("Cellar Lock", "A rusty lock", 10, 0);
+
+    uint16_t sword = register_item_prototype(create_weapon("Iron Sword", "iron_sword", material, 10, 20, 0, '/'));
+    uint16_t key = register_item_prototype(create_key("Cellar Key", "cellar_key", lock, 'k'));
+    TEST_ASSERT(sword != ITEM_PROTOTYPE_NONE && key != ITEM_PROTOTYPE_NONE, "Prototypes should register");
+
+    ItemInstance_t first = create_item_instance(sword, 1);
+    ItemInstance_t second = create_item_instance(sword, 1);
+
+    damage_item_instance(&first, 100);
+    TEST_ASSERT(first.durability == 155, "Damaged instance should lose durability");
+    TEST_ASSERT(second.durability == 255, "Other instances of the prototype should be untouched");
+    TEST_ASSERT(get_durability(get_item_prototype(sword)) == 255, "Prototype should never be written");
+
+    damage_item_instance(&first, 1000);
+    TEST_ASSERT(first.durability == 0, "Durability should stop at 0");
+    TEST_ASSERT(is_item_instance_broken(&first), "Instance at 0 durability should be broken");
+    TEST_ASSERT(!is_item_instance_broken(&second), "Full instance should not be broken");
+
+    repair_item_instance(&first, 300);
+    TEST_ASSERT(first.durability == 255, "Repair should cap at 255");
+
+    ItemInstance_t cellar_key = create_item_instance(key, 1);
+    damage_item_instance(&cellar_key, 100);
+    TEST_ASSERT(cellar_key.durability == 255, "Keys should not degrade");
+
+    damage_item_instance(NULL, 10);
+    repair_item_instance(NULL, 10);
+    TEST_ASSERT(is_item_instance_broken(NULL), "NULL instance should count as broken");
+
+    destroy_item_prototypes();
+    destroy_lock(&lock);
+    d_DestroyString(material.name);
+    return 1;
+}
+
+// =============================================================================
+// INVENTORY BRIDGE TESTS
+// =============================================================================
+
+int test_instance_inventory(void)
+{
+    Material_t material = create_brittle_material();
+
+    uint16_t sword = register_item_prototype(create_weapon("Iron Sword", "iron_sword", material, 10, 20, 0, '/'));
+    uint16_t arrows = register_item_prototype(create_ammunition("Iron Arrows", "iron_arrows", material, 2, 4, '^'));
+
+    Inventory_t* inventory = create_inventory(4);
+    TEST_ASSERT(inventory != NULL, "Inventory should be created");
+
+    ItemInstance_t worn_sword = create_item_instance(sword, 1);
+    damage_item_instance(&worn_sword, 55);
+
+    TEST_ASSERT(add_item_instance_to_inventory(inventory, &worn_sword), "Sword instance should be added");
+    Inventory_slot_t* slot = find_item_in_inventory(inventory, "iron_sword");
+    TEST_ASSERT(slot != NULL, "Sword should be found by id");
+    TEST_ASSERT(get_durability(&slot->item) == 200, "Slot should carry the instance's durability");
+    TEST_ASSERT(slot->item.id == get_item_prototype(sword)->id, "Slot should share the prototype's strings");
+    TEST_ASSERT(get_durability(get_item_prototype(sword)) == 255, "Prototype should keep full durability");
+
+    ItemInstance_t quiver = create_item_instance(arrows, 30);
+    TEST_ASSERT(add_item_instance_to_inventory(inventory, &quiver), "Arrow instance should be added");
+    TEST_ASSERT(add_item_instance_to_inventory(inventory, &quiver), "Second arrow instance should stack");
+    TEST_ASSERT(find_item_in_inventory(inventory, "iron_arrows")->quantity == 60, "Arrows should stack to 60");
+    TEST_ASSERT(get_inventory_free_slots(inventory) == 2, "Two slots should be used");
+
+    ItemInstance_t empty = create_item_instance(ITEM_PROTOTYPE_NONE, 1);
+    TEST_ASSERT(!add_item_instance_to_inventory(inventory, &empty), "Empty instance should be refused");
+    TEST_ASSERT(!add_item_instance_to_inventory(NULL, &quiver), "NULL inventory should be refused");
+
+    destroy_inventory(inventory);
+    destroy_item_prototypes();
+    d_DestroyString(material.name);
+    return 1;
+}
+
+// =============================================================================
+// WORLD SCALE LOOT TESTS
+// =============================================================================
+
+int test_instance_loot_pile(void)
+{
+    Material_t material = create_brittle_material();
+
+    uint16_t handles[3];
+    handles[0] = register_item_prototype(create_weapon("Iron Sword", "iron_sword", material, 10, 20, 0, '/'));
+    handles[1] = register_item_prototype(create_armor("Chain Mail", "chain_mail", material, 12, 4, '[', 0, 0));
+    handles[2] = register_item_prototype(create_ammunition("Iron Arrows", "iron_arrows", material, 2, 4, '^'));
+
+    const int loot_count = 10000;
+    ItemInstance_t* loot = (ItemInstance_t*)malloc(sizeof(ItemInstance_t) * loot_count);
+    TEST_ASSERT(loot != NULL, "Loot pile should be allocated");
+    if (loot == NULL) { return 0; }
+
+    for (int i = 0; i < loot_count; i++) {
+        loot[i] = create_item_instance(handles[i % 3], 10);
+        damage_item_instance(&loot[i], i % 256);
+    }
+
+    int broken = 0;
+    int arrows = 0;
+    for (int i = 0; i < loot_count; i++) {
+        if (is_item_instance_broken(&loot[i])) {
+            broken++;
+        }
+        if (loot[i].prototype == handles[2]) {
+            arrows += loot[i].quantity;
+        }
+    }
+
+    d_LogInfoF("Loot pile: %d instances in %zu bytes, %d broken, %d arrows",
+               loot_count, sizeof(ItemInstance_t) * loot_count, broken, arrows);
+
+    TEST_ASSERT(get_item_prototype_count() == 3, "Loot should share three prototypes");
+    TEST_ASSERT(broken > 0, "Some swords and mail should be broken");
+    TEST_ASSERT(arrows == 3333 * 10, "Every arrow instance should hold ten arrows");
+
+    free(loot);
+    destroy_item_prototypes();
+    d_DestroyString(material.name);
+    return 1;
+}
+
+int main(void)
+{
+    // =========================================================================
+    // DAEDALUS LOGGER INITIALIZATION
+    // =========================================================================
+    dLogConfig_t config = {
+        .default_level = D_LOG_LEVEL_INFO,
+        .colorize_output = true,
+        .include_timestamp = false,
+        .include_file_info = false,
+        .include_function = false
+    };
+
+    dLogger_t* logger = d_CreateLogger(config);
+    d_SetGlobalLogger(logger);
+    d_AddLogHandler(d_GetGlobalLogger(), d_ConsoleLogHandler, NULL);
+    // =========================================================================
+
+    TEST_SUITE_START("Item Prototype & Instance Tests");
+
+    RUN_TEST(test_prototype_registration);
+    RUN_TEST(test_instance_creation);
+    RUN_TEST(test_instance_durability);
+    RUN_TEST(test_instance_inventory);
+    RUN_TEST(test_instance_loot_pile);
+
+    TEST_SUITE_END();
+
+    // =========================================================================
+    // DAEDALUS LOGGER SHUTDOWN
+    // =========================================================================
+    d_DestroyLogger(d_GetGlobalLogger());
+    // =========================================================================
+}
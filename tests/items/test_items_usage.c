@@ -699,6 +699,7 @@ int test_usage_corrupted_data(void) {
     // Simulate lock name corruption
     if (corrupt_key && corrupt_key->data.key.lock.name) {
         d_ClearString(corrupt_key->data.key.lock.name); // Empty the lock name
+        corrupt_key->data.key.lock.name_atom = ATOM_NONE; // Keys match on the atom
     }
     
     bool corrupt_opens = can_key_open_lock(corrupt_key, &valid_lock);